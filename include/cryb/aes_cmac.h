@@ -0,0 +1,78 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CRYB_AES_CMAC_H_INCLUDED
+#define CRYB_AES_CMAC_H_INCLUDED
+
+#ifndef CRYB_TO
+#include <cryb/to.h>
+#endif
+
+#include <cryb/aes.h>
+#include <cryb/mac.h>
+
+CRYB_BEGIN
+
+#define AES_CMAC_MAC_LEN		16
+
+#define aes_cmac_mac			cryb_aes_cmac_mac
+#define aes_cmac_ctx			cryb_aes_cmac_ctx
+#define aes_cmac_key			cryb_aes_cmac_key
+#define aes_cmac_init			cryb_aes_cmac_init
+#define aes_cmac_setkey			cryb_aes_cmac_setkey
+#define aes_cmac_reset			cryb_aes_cmac_reset
+#define aes_cmac_update			cryb_aes_cmac_update
+#define aes_cmac_final			cryb_aes_cmac_final
+#define aes_cmac_complete		cryb_aes_cmac_complete
+
+extern mac_algorithm aes_cmac_mac;
+
+typedef struct {
+	aes_ctx		 aes;
+	uint8_t		 k1[AES_BLOCK_LEN];
+	uint8_t		 k2[AES_BLOCK_LEN];
+} aes_cmac_key;
+
+typedef struct {
+	aes_cmac_key	 key;
+	uint8_t		 x[AES_BLOCK_LEN];	/* chaining value */
+	uint8_t		 buf[AES_BLOCK_LEN];	/* last block */
+	unsigned int	 buflen;
+} aes_cmac_ctx;
+
+void aes_cmac_init(aes_cmac_ctx *, const void *, size_t);
+void aes_cmac_setkey(aes_cmac_key *, const void *, size_t);
+void aes_cmac_reset(aes_cmac_ctx *, const aes_cmac_key *);
+void aes_cmac_update(aes_cmac_ctx *, const void *, size_t);
+void aes_cmac_final(aes_cmac_ctx *, uint8_t *);
+void aes_cmac_complete(const void *, size_t, const void *, size_t, uint8_t *);
+
+CRYB_END
+
+#endif
@@ -0,0 +1,65 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CRYB_AES_GMAC_H_INCLUDED
+#define CRYB_AES_GMAC_H_INCLUDED
+
+#ifndef CRYB_TO
+#include <cryb/to.h>
+#endif
+
+#include <cryb/aes.h>
+#include <cryb/ghash.h>
+
+CRYB_BEGIN
+
+#define AES_GMAC_MAC_LEN		16
+
+#define aes_gmac_ctx			cryb_aes_gmac_ctx
+#define aes_gmac_init			cryb_aes_gmac_init
+#define aes_gmac_update			cryb_aes_gmac_update
+#define aes_gmac_final			cryb_aes_gmac_final
+#define aes_gmac_complete		cryb_aes_gmac_complete
+
+typedef struct {
+	ghash_ctx	 ghash;
+	uint8_t		 ekj0[AES_BLOCK_LEN];	/* encrypted pre-counter block */
+	uint64_t	 len;			/* bytes hashed so far */
+} aes_gmac_ctx;
+
+void aes_gmac_init(aes_gmac_ctx *, const void *, size_t,
+    const void *, size_t);
+void aes_gmac_update(aes_gmac_ctx *, const void *, size_t);
+void aes_gmac_final(aes_gmac_ctx *, uint8_t *);
+void aes_gmac_complete(const void *, size_t, const void *, size_t,
+    const void *, size_t, uint8_t *);
+
+CRYB_END
+
+#endif
@@ -0,0 +1,67 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CRYB_CDC_H_INCLUDED
+#define CRYB_CDC_H_INCLUDED
+
+#ifndef CRYB_TO
+#include <cryb/to.h>
+#endif
+
+CRYB_BEGIN
+
+/*
+ * Content-defined chunking
+ */
+
+#define cdc_ctx				cryb_cdc_ctx
+#define cdc_init			cryb_cdc_init
+#define cdc_reset			cryb_cdc_reset
+#define cdc_next			cryb_cdc_next
+#define cdc_scan			cryb_cdc_scan
+
+/* bounds on the average chunk size, which must be a power of two */
+#define CDC_MIN_AVG_SIZE		64
+#define CDC_MAX_AVG_SIZE		(1U << 30)
+
+typedef struct {
+	size_t min, avg, max;		/* chunk size limits */
+	uint64_t mask_s, mask_l;	/* before and after avg */
+	uint64_t fp;			/* Gear fingerprint */
+	size_t pos;			/* length of the current chunk */
+} cdc_ctx;
+
+int	 cdc_init(cdc_ctx *, size_t, size_t, size_t);
+void	 cdc_reset(cdc_ctx *);
+size_t	 cdc_next(cdc_ctx *, const void *, size_t);
+size_t	 cdc_scan(cdc_ctx *, const void *, size_t, size_t *, size_t);
+
+CRYB_END
+
+#endif
@@ -50,6 +50,11 @@ typedef void (*digest_update_func)(digest_ctx *, const void *, size_t);
 typedef void (*digest_final_func)(digest_ctx *, uint8_t *);
 typedef int (*digest_complete_func)(const void *, size_t, uint8_t *);
 
+/* upper bounds for all digest algorithms provided by this library */
+#define DIGEST_MAX_BLOCK_LEN		128
+#define DIGEST_MAX_DIGEST_LEN		64
+#define DIGEST_MAX_CONTEXT_LEN		256
+
 typedef struct {
 	const char		*name;		/* algorithm name */
 	size_t			 contextlen;	/* size of context structure */
@@ -65,6 +70,19 @@ typedef struct {
 
 const digest_algorithm *get_digest_algorithm(const char *);
 
+#define digest_fd			cryb_digest_fd
+#define digest_file			cryb_digest_file
+
+int digest_fd(const digest_algorithm *, int, uint8_t *);
+int digest_file(const digest_algorithm *, const char *, uint8_t *);
+
+struct iovec;
+
+#define digest_updatev			cryb_digest_updatev
+
+void digest_updatev(const digest_algorithm *, digest_ctx *,
+    const struct iovec *, int);
+
 #define digest_init(alg, ctx)						\
 	(alg)->init((ctx))
 #define digest_update(alg, ctx, buf, len)				\
@@ -0,0 +1,104 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CRYB_FILTER_H_INCLUDED
+#define CRYB_FILTER_H_INCLUDED
+
+#ifndef CRYB_TO
+#include <cryb/to.h>
+#endif
+
+#include <cryb/hash.h>
+
+CRYB_BEGIN
+
+/*
+ * Every filter is stored as a single image consisting of a 64-byte
+ * header followed by the filter data, which can be written to disk as
+ * is and later mapped back into memory.
+ */
+#define FILTER_HEADER_LEN		64
+
+/*
+ * Bloom filters
+ */
+
+#define bloom_new			cryb_bloom_new
+#define bloom_load			cryb_bloom_load
+#define bloom_delete			cryb_bloom_delete
+#define bloom_image			cryb_bloom_image
+#define bloom_add			cryb_bloom_add
+#define bloom_query			cryb_bloom_query
+#define bloom_query_many		cryb_bloom_query_many
+
+typedef struct cryb_bloom bloom;
+
+/* flags for bloom_new() */
+#define BLOOM_BLOCKED			0x0001	/* one cache line per key */
+
+/* upper bound on the number of hash functions */
+#define BLOOM_MAX_HASHES		32
+
+bloom	*bloom_new(size_t, unsigned int, uint32_t, unsigned int);
+bloom	*bloom_load(void *, size_t);
+void	 bloom_delete(bloom *);
+const void *bloom_image(const bloom *, size_t *);
+void	 bloom_add(bloom *, const void *, size_t);
+int	 bloom_query(const bloom *, const void *, size_t);
+size_t	 bloom_query_many(const bloom *, const hash_key *, size_t, int *);
+
+/*
+ * Cuckoo filters
+ */
+
+#define cuckoo_new			cryb_cuckoo_new
+#define cuckoo_load			cryb_cuckoo_load
+#define cuckoo_delete			cryb_cuckoo_delete
+#define cuckoo_image			cryb_cuckoo_image
+#define cuckoo_count			cryb_cuckoo_count
+#define cuckoo_add			cryb_cuckoo_add
+#define cuckoo_remove			cryb_cuckoo_remove
+#define cuckoo_query			cryb_cuckoo_query
+#define cuckoo_query_many		cryb_cuckoo_query_many
+
+typedef struct cryb_cuckoo cuckoo;
+
+cuckoo	*cuckoo_new(size_t, uint32_t);
+cuckoo	*cuckoo_load(void *, size_t);
+void	 cuckoo_delete(cuckoo *);
+const void *cuckoo_image(const cuckoo *, size_t *);
+size_t	 cuckoo_count(const cuckoo *);
+int	 cuckoo_add(cuckoo *, const void *, size_t);
+int	 cuckoo_remove(cuckoo *, const void *, size_t);
+int	 cuckoo_query(const cuckoo *, const void *, size_t);
+size_t	 cuckoo_query_many(const cuckoo *, const hash_key *, size_t, int *);
+
+CRYB_END
+
+#endif
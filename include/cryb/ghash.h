@@ -0,0 +1,62 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CRYB_GHASH_H_INCLUDED
+#define CRYB_GHASH_H_INCLUDED
+
+#ifndef CRYB_TO
+#include <cryb/to.h>
+#endif
+
+CRYB_BEGIN
+
+#define GHASH_BLOCK_LEN			16
+
+#define ghash_ctx			cryb_ghash_ctx
+#define ghash_init			cryb_ghash_init
+#define ghash_update			cryb_ghash_update
+#define ghash_pad			cryb_ghash_pad
+#define ghash_final			cryb_ghash_final
+
+typedef struct {
+	uint64_t	 hl[16];	/* multiples of H, low halves */
+	uint64_t	 hh[16];	/* multiples of H, high halves */
+	uint8_t		 y[16];		/* running hash */
+	uint8_t		 buf[16];	/* partial block */
+	unsigned int	 buflen;
+} ghash_ctx;
+
+void ghash_init(ghash_ctx *, const uint8_t *);
+void ghash_update(ghash_ctx *, const void *, size_t);
+void ghash_pad(ghash_ctx *);
+void ghash_final(ghash_ctx *, uint8_t *);
+
+CRYB_END
+
+#endif
@@ -27,6 +27,7 @@
  * SUCH DAMAGE.
  */
 
+
 #ifndef CRYB_HASH_H_INCLUDED
 #define CRYB_HASH_H_INCLUDED
 
@@ -38,33 +39,495 @@ CRYB_BEGIN
 
 const char *cryb_hash_version(void);
 
-#define adler32_hash		cryb_adler32_hash
-#define fletcher16_hash		cryb_fletcher16_hash
-#define fletcher32_hash		cryb_fletcher32_hash
-#define fletcher64_hash		cryb_fletcher64_hash
-#define fnv0_32_hash		cryb_fnv0_32_hash
-#define fnv0_64_hash		cryb_fnv0_64_hash
-#define fnv1_32_hash		cryb_fnv1_32_hash
-#define fnv1_64_hash		cryb_fnv1_64_hash
-#define fnv1a_32_hash		cryb_fnv1a_32_hash
-#define fnv1a_64_hash		cryb_fnv1a_64_hash
-#define murmur3_32_hash		cryb_murmur3_32_hash
-#define pearson_hash		cryb_pearson_hash
-#define pearson_hash_str	cryb_pearson_hash_str
+/*
+ * Generic interface
+ */
+
+#define hash_ctx			cryb_hash_ctx
+#define hash_init_func			cryb_hash_init_func
+#define hash_update_func		cryb_hash_update_func
+#define hash_final_func			cryb_hash_final_func
+#define hash_complete_func		cryb_hash_complete_func
+#define hash_algorithm			cryb_hash_algorithm
+
+typedef void hash_ctx;
+typedef void (*hash_init_func)(hash_ctx *, const void *);
+typedef void (*hash_update_func)(hash_ctx *, const void *, size_t);
+typedef uint64_t (*hash_final_func)(hash_ctx *);
+typedef uint64_t (*hash_complete_func)(const void *, size_t, const void *);
+
+/* upper bounds for all hash algorithms provided by this library */
+#define HASH_MAX_KEY_LEN		16
+#define HASH_MAX_CONTEXT_LEN		1024
+
+typedef struct {
+	const char		*name;		/* algorithm name */
+	size_t			 contextlen;	/* size of context structure */
+	size_t			 keylen;	/* length of key or seed */
+	size_t			 hashlen;	/* length of the hash in bytes */
+	hash_init_func		 init;		/* initialization method */
+	hash_update_func	 update;	/* update method */
+	hash_final_func		 final;		/* finalization method */
+	hash_complete_func	 complete;	/* one-shot method */
+} hash_algorithm;
+
+#define get_hash_algorithm		cryb_get_hash_algorithm
+
+const hash_algorithm *get_hash_algorithm(const char *);
+
+#define hash_init(alg, ctx, key)					\
+	(alg)->init((ctx), (key))
+#define hash_update(alg, ctx, buf, len)					\
+	(alg)->update((ctx), (buf), (len))
+#define hash_final(alg, ctx)						\
+	(alg)->final((ctx))
+#define hash_complete(alg, buf, len, key)				\
+	(alg)->complete((buf), (len), (key))
+
+/*
+ * A key for the batch interfaces
+ */
+
+#define hash_key			cryb_hash_key
+
+typedef struct {
+	const void		*data;
+	size_t			 len;
+} hash_key;
+
+/*
+ * Adler-32
+ */
 
+#define adler32_ctx			cryb_adler32_ctx
+#define adler32_init			cryb_adler32_init
+#define adler32_update			cryb_adler32_update
+#define adler32_final			cryb_adler32_final
+#define adler32_combine			cryb_adler32_combine
+#define adler32_roll_in			cryb_adler32_roll_in
+#define adler32_roll_out		cryb_adler32_roll_out
+#define adler32_hash			cryb_adler32_hash
+#define adler32_hash_algorithm		cryb_adler32_hash_algorithm
+
+typedef struct {
+	uint32_t c0, c1;
+} adler32_ctx;
+
+void adler32_init(adler32_ctx *);
+void adler32_update(adler32_ctx *, const void *, size_t);
+uint32_t adler32_final(adler32_ctx *);
+uint32_t adler32_combine(uint32_t, uint32_t, uint64_t);
+void adler32_roll_in(adler32_ctx *, uint8_t);
+void adler32_roll_out(adler32_ctx *, uint8_t, uint64_t);
 uint32_t adler32_hash(const void *, size_t);
+extern const hash_algorithm adler32_hash_algorithm;
+
+/*
+ * Buzhash
+ */
+
+#define buzhash_ctx			cryb_buzhash_ctx
+#define buzhash_init			cryb_buzhash_init
+#define buzhash_update			cryb_buzhash_update
+#define buzhash_final			cryb_buzhash_final
+#define buzhash_roll_in			cryb_buzhash_roll_in
+#define buzhash_roll_out		cryb_buzhash_roll_out
+#define buzhash_hash			cryb_buzhash_hash
+#define buzhash_hash_algorithm		cryb_buzhash_hash_algorithm
+
+typedef struct {
+	uint64_t h;
+} buzhash_ctx;
+
+void buzhash_init(buzhash_ctx *);
+void buzhash_update(buzhash_ctx *, const void *, size_t);
+uint64_t buzhash_final(buzhash_ctx *);
+void buzhash_roll_in(buzhash_ctx *, uint8_t);
+void buzhash_roll_out(buzhash_ctx *, uint8_t, uint64_t);
+uint64_t buzhash_hash(const void *, size_t);
+extern const hash_algorithm buzhash_hash_algorithm;
+
+/*
+ * CRC-32 and CRC-32C
+ */
+
+#define crc32_ctx			cryb_crc32_ctx
+#define crc32_init			cryb_crc32_init
+#define crc32_update			cryb_crc32_update
+#define crc32_final			cryb_crc32_final
+#define crc32_combine			cryb_crc32_combine
+#define crc32_hash			cryb_crc32_hash
+#define crc32_hash_algorithm		cryb_crc32_hash_algorithm
+#define crc32c_init			cryb_crc32c_init
+#define crc32c_update			cryb_crc32c_update
+#define crc32c_final			cryb_crc32c_final
+#define crc32c_combine			cryb_crc32c_combine
+#define crc32c_hash			cryb_crc32c_hash
+#define crc32c_hash_algorithm		cryb_crc32c_hash_algorithm
+
+typedef struct {
+	uint32_t crc;
+} crc32_ctx;
+
+void crc32_init(crc32_ctx *);
+void crc32_update(crc32_ctx *, const void *, size_t);
+uint32_t crc32_final(crc32_ctx *);
+uint32_t crc32_combine(uint32_t, uint32_t, uint64_t);
+uint32_t crc32_hash(const void *, size_t);
+extern const hash_algorithm crc32_hash_algorithm;
+
+void crc32c_init(crc32_ctx *);
+void crc32c_update(crc32_ctx *, const void *, size_t);
+uint32_t crc32c_final(crc32_ctx *);
+uint32_t crc32c_combine(uint32_t, uint32_t, uint64_t);
+uint32_t crc32c_hash(const void *, size_t);
+extern const hash_algorithm crc32c_hash_algorithm;
+
+/*
+ * Fletcher
+ */
+
+#define fletcher16_ctx			cryb_fletcher16_ctx
+#define fletcher16_init			cryb_fletcher16_init
+#define fletcher16_update		cryb_fletcher16_update
+#define fletcher16_final		cryb_fletcher16_final
+#define fletcher16_combine		cryb_fletcher16_combine
+#define fletcher16_hash			cryb_fletcher16_hash
+#define fletcher16_hash_algorithm	cryb_fletcher16_hash_algorithm
+#define fletcher32_ctx			cryb_fletcher32_ctx
+#define fletcher32_init			cryb_fletcher32_init
+#define fletcher32_update		cryb_fletcher32_update
+#define fletcher32_final		cryb_fletcher32_final
+#define fletcher32_combine		cryb_fletcher32_combine
+#define fletcher32_hash			cryb_fletcher32_hash
+#define fletcher32_hash_algorithm	cryb_fletcher32_hash_algorithm
+#define fletcher64_ctx			cryb_fletcher64_ctx
+#define fletcher64_init			cryb_fletcher64_init
+#define fletcher64_update		cryb_fletcher64_update
+#define fletcher64_final		cryb_fletcher64_final
+#define fletcher64_combine		cryb_fletcher64_combine
+#define fletcher64_hash			cryb_fletcher64_hash
+#define fletcher64_hash_algorithm	cryb_fletcher64_hash_algorithm
+
+typedef struct {
+	uint16_t c0, c1;
+} fletcher16_ctx;
+
+typedef struct {
+	uint32_t c0, c1;
+	uint8_t buf[1];
+	unsigned int buflen;
+} fletcher32_ctx;
+
+typedef struct {
+	uint64_t c0, c1;
+	uint8_t buf[4];
+	unsigned int buflen;
+} fletcher64_ctx;
+
+void fletcher16_init(fletcher16_ctx *);
+void fletcher16_update(fletcher16_ctx *, const void *, size_t);
+uint16_t fletcher16_final(fletcher16_ctx *);
+uint16_t fletcher16_combine(uint16_t, uint16_t, uint64_t);
 uint16_t fletcher16_hash(const void *, size_t);
+extern const hash_algorithm fletcher16_hash_algorithm;
+
+void fletcher32_init(fletcher32_ctx *);
+void fletcher32_update(fletcher32_ctx *, const void *, size_t);
+uint32_t fletcher32_final(fletcher32_ctx *);
+uint32_t fletcher32_combine(uint32_t, uint32_t, uint64_t);
 uint32_t fletcher32_hash(const void *, size_t);
+extern const hash_algorithm fletcher32_hash_algorithm;
+
+void fletcher64_init(fletcher64_ctx *);
+void fletcher64_update(fletcher64_ctx *, const void *, size_t);
+uint64_t fletcher64_final(fletcher64_ctx *);
+uint64_t fletcher64_combine(uint64_t, uint64_t, uint64_t);
 uint64_t fletcher64_hash(const void *, size_t);
+extern const hash_algorithm fletcher64_hash_algorithm;
+
+/*
+ * Fowler-Noll-Vo
+ */
+
+#define fnv32_ctx			cryb_fnv32_ctx
+#define fnv64_ctx			cryb_fnv64_ctx
+#define fnv0_32_init			cryb_fnv0_32_init
+#define fnv0_32_update			cryb_fnv0_32_update
+#define fnv0_32_final			cryb_fnv0_32_final
+#define fnv0_32_hash			cryb_fnv0_32_hash
+#define fnv0_32_hash_algorithm		cryb_fnv0_32_hash_algorithm
+#define fnv0_64_init			cryb_fnv0_64_init
+#define fnv0_64_update			cryb_fnv0_64_update
+#define fnv0_64_final			cryb_fnv0_64_final
+#define fnv0_64_hash			cryb_fnv0_64_hash
+#define fnv0_64_hash_algorithm		cryb_fnv0_64_hash_algorithm
+#define fnv1_32_init			cryb_fnv1_32_init
+#define fnv1_32_update			cryb_fnv1_32_update
+#define fnv1_32_final			cryb_fnv1_32_final
+#define fnv1_32_hash			cryb_fnv1_32_hash
+#define fnv1_32_hash_algorithm		cryb_fnv1_32_hash_algorithm
+#define fnv1_64_init			cryb_fnv1_64_init
+#define fnv1_64_update			cryb_fnv1_64_update
+#define fnv1_64_final			cryb_fnv1_64_final
+#define fnv1_64_hash			cryb_fnv1_64_hash
+#define fnv1_64_hash_algorithm		cryb_fnv1_64_hash_algorithm
+#define fnv1a_32_init			cryb_fnv1a_32_init
+#define fnv1a_32_update			cryb_fnv1a_32_update
+#define fnv1a_32_final			cryb_fnv1a_32_final
+#define fnv1a_32_hash			cryb_fnv1a_32_hash
+#define fnv1a_32_hash_many		cryb_fnv1a_32_hash_many
+#define fnv1a_32_hash_algorithm		cryb_fnv1a_32_hash_algorithm
+#define fnv1a_64_init			cryb_fnv1a_64_init
+#define fnv1a_64_update			cryb_fnv1a_64_update
+#define fnv1a_64_final			cryb_fnv1a_64_final
+#define fnv1a_64_hash			cryb_fnv1a_64_hash
+#define fnv1a_64_hash_many		cryb_fnv1a_64_hash_many
+#define fnv1a_64_hash_algorithm		cryb_fnv1a_64_hash_algorithm
+
+typedef struct {
+	uint32_t h;
+} fnv32_ctx;
+
+typedef struct {
+	uint64_t h;
+} fnv64_ctx;
+
+void fnv0_32_init(fnv32_ctx *);
+void fnv0_32_update(fnv32_ctx *, const void *, size_t);
+uint32_t fnv0_32_final(fnv32_ctx *);
 uint32_t fnv0_32_hash(const void *, size_t);
+extern const hash_algorithm fnv0_32_hash_algorithm;
+
+void fnv0_64_init(fnv64_ctx *);
+void fnv0_64_update(fnv64_ctx *, const void *, size_t);
+uint64_t fnv0_64_final(fnv64_ctx *);
 uint64_t fnv0_64_hash(const void *, size_t);
+extern const hash_algorithm fnv0_64_hash_algorithm;
+
+void fnv1_32_init(fnv32_ctx *);
+void fnv1_32_update(fnv32_ctx *, const void *, size_t);
+uint32_t fnv1_32_final(fnv32_ctx *);
 uint32_t fnv1_32_hash(const void *, size_t);
+extern const hash_algorithm fnv1_32_hash_algorithm;
+
+void fnv1_64_init(fnv64_ctx *);
+void fnv1_64_update(fnv64_ctx *, const void *, size_t);
+uint64_t fnv1_64_final(fnv64_ctx *);
 uint64_t fnv1_64_hash(const void *, size_t);
+extern const hash_algorithm fnv1_64_hash_algorithm;
+
+void fnv1a_32_init(fnv32_ctx *);
+void fnv1a_32_update(fnv32_ctx *, const void *, size_t);
+uint32_t fnv1a_32_final(fnv32_ctx *);
 uint32_t fnv1a_32_hash(const void *, size_t);
+void fnv1a_32_hash_many(const hash_key *, size_t, uint32_t *);
+extern const hash_algorithm fnv1a_32_hash_algorithm;
+
+void fnv1a_64_init(fnv64_ctx *);
+void fnv1a_64_update(fnv64_ctx *, const void *, size_t);
+uint64_t fnv1a_64_final(fnv64_ctx *);
 uint64_t fnv1a_64_hash(const void *, size_t);
+void fnv1a_64_hash_many(const hash_key *, size_t, uint64_t *);
+extern const hash_algorithm fnv1a_64_hash_algorithm;
+
+/*
+ * MurmurHash3
+ */
+
+#define murmur3_32_ctx			cryb_murmur3_32_ctx
+#define murmur3_32_init			cryb_murmur3_32_init
+#define murmur3_32_update		cryb_murmur3_32_update
+#define murmur3_32_final		cryb_murmur3_32_final
+#define murmur3_32_hash			cryb_murmur3_32_hash
+#define murmur3_32_hash_many		cryb_murmur3_32_hash_many
+#define murmur3_32_hash_algorithm	cryb_murmur3_32_hash_algorithm
+#define murmur3_x86_128_hash		cryb_murmur3_x86_128_hash
+#define murmur3_x64_128_hash		cryb_murmur3_x64_128_hash
+
+typedef struct {
+	uint32_t h;
+	uint8_t buf[4];
+	unsigned int buflen;
+	size_t len;
+} murmur3_32_ctx;
+
+void murmur3_32_init(murmur3_32_ctx *, uint32_t);
+void murmur3_32_update(murmur3_32_ctx *, const void *, size_t);
+uint32_t murmur3_32_final(murmur3_32_ctx *);
 uint32_t murmur3_32_hash(const void *, size_t, uint32_t);
+void murmur3_32_hash_many(const hash_key *, size_t, uint32_t, uint32_t *);
+extern const hash_algorithm murmur3_32_hash_algorithm;
+
+#define MURMUR3_128_HASH_LEN		16
+
+void murmur3_x86_128_hash(const void *, size_t, uint32_t, uint8_t *);
+void murmur3_x64_128_hash(const void *, size_t, uint32_t, uint8_t *);
+
+/*
+ * Pearson
+ */
+
+#define pearson_ctx			cryb_pearson_ctx
+#define pearson_init			cryb_pearson_init
+#define pearson_update			cryb_pearson_update
+#define pearson_final			cryb_pearson_final
+#define pearson_hash			cryb_pearson_hash
+#define pearson_hash_str		cryb_pearson_hash_str
+#define pearson_hash_algorithm		cryb_pearson_hash_algorithm
+
+typedef struct {
+	uint8_t h;
+} pearson_ctx;
+
+void pearson_init(pearson_ctx *);
+void pearson_update(pearson_ctx *, const void *, size_t);
+uint8_t pearson_final(pearson_ctx *);
 uint8_t pearson_hash(const void *, size_t);
 uint8_t pearson_hash_str(const char *);
+extern const hash_algorithm pearson_hash_algorithm;
+
+/*
+ * SipHash
+ */
+
+#define siphash_ctx			cryb_siphash_ctx
+#define siphash24_init			cryb_siphash24_init
+#define siphash24_128_init		cryb_siphash24_128_init
+#define siphash24_update		cryb_siphash24_update
+#define siphash24_final			cryb_siphash24_final
+#define siphash24_128_final		cryb_siphash24_128_final
+#define siphash24_hash			cryb_siphash24_hash
+#define siphash24_128_hash		cryb_siphash24_128_hash
+#define siphash24_hash_algorithm	cryb_siphash24_hash_algorithm
+#define siphash13_init			cryb_siphash13_init
+#define siphash13_128_init		cryb_siphash13_128_init
+#define siphash13_update		cryb_siphash13_update
+#define siphash13_final			cryb_siphash13_final
+#define siphash13_128_final		cryb_siphash13_128_final
+#define siphash13_hash			cryb_siphash13_hash
+#define siphash13_128_hash		cryb_siphash13_128_hash
+#define siphash13_hash_algorithm	cryb_siphash13_hash_algorithm
+#define halfsiphash_ctx			cryb_halfsiphash_ctx
+#define halfsiphash24_init		cryb_halfsiphash24_init
+#define halfsiphash24_64_init		cryb_halfsiphash24_64_init
+#define halfsiphash24_update		cryb_halfsiphash24_update
+#define halfsiphash24_final		cryb_halfsiphash24_final
+#define halfsiphash24_64_final		cryb_halfsiphash24_64_final
+#define halfsiphash24_hash		cryb_halfsiphash24_hash
+#define halfsiphash24_64_hash		cryb_halfsiphash24_64_hash
+#define halfsiphash24_hash_algorithm	cryb_halfsiphash24_hash_algorithm
+#define halfsiphash24_64_hash_algorithm	cryb_halfsiphash24_64_hash_algorithm
+
+#define SIPHASH_KEY_LEN			16
+#define HALFSIPHASH_KEY_LEN		8
+
+typedef struct {
+	uint64_t v0, v1, v2, v3;
+	uint8_t buf[8];
+	unsigned int buflen;
+	size_t len;
+} siphash_ctx;
+
+typedef struct {
+	uint32_t v0, v1, v2, v3;
+	uint8_t buf[4];
+	unsigned int buflen;
+	size_t len;
+} halfsiphash_ctx;
+
+void siphash24_init(siphash_ctx *, const uint8_t *);
+void siphash24_128_init(siphash_ctx *, const uint8_t *);
+void siphash24_update(siphash_ctx *, const void *, size_t);
+uint64_t siphash24_final(siphash_ctx *);
+void siphash24_128_final(siphash_ctx *, uint8_t *);
+uint64_t siphash24_hash(const void *, size_t, const uint8_t *);
+void siphash24_128_hash(const void *, size_t, const uint8_t *, uint8_t *);
+extern const hash_algorithm siphash24_hash_algorithm;
+
+void siphash13_init(siphash_ctx *, const uint8_t *);
+void siphash13_128_init(siphash_ctx *, const uint8_t *);
+void siphash13_update(siphash_ctx *, const void *, size_t);
+uint64_t siphash13_final(siphash_ctx *);
+void siphash13_128_final(siphash_ctx *, uint8_t *);
+uint64_t siphash13_hash(const void *, size_t, const uint8_t *);
+void siphash13_128_hash(const void *, size_t, const uint8_t *, uint8_t *);
+extern const hash_algorithm siphash13_hash_algorithm;
+
+void halfsiphash24_init(halfsiphash_ctx *, const uint8_t *);
+void halfsiphash24_64_init(halfsiphash_ctx *, const uint8_t *);
+void halfsiphash24_update(halfsiphash_ctx *, const void *, size_t);
+uint32_t halfsiphash24_final(halfsiphash_ctx *);
+uint64_t halfsiphash24_64_final(halfsiphash_ctx *);
+uint32_t halfsiphash24_hash(const void *, size_t, const uint8_t *);
+uint64_t halfsiphash24_64_hash(const void *, size_t, const uint8_t *);
+extern const hash_algorithm halfsiphash24_hash_algorithm;
+extern const hash_algorithm halfsiphash24_64_hash_algorithm;
+
+/*
+ * xxHash
+ */
+
+#define xxh64_ctx			cryb_xxh64_ctx
+#define xxh64_init			cryb_xxh64_init
+#define xxh64_update			cryb_xxh64_update
+#define xxh64_final			cryb_xxh64_final
+#define xxh64_hash			cryb_xxh64_hash
+#define xxh64_hash_algorithm		cryb_xxh64_hash_algorithm
+#define xxh3_ctx			cryb_xxh3_ctx
+#define xxh3_init			cryb_xxh3_init
+#define xxh3_init_secret		cryb_xxh3_init_secret
+#define xxh3_update			cryb_xxh3_update
+#define xxh3_64_final			cryb_xxh3_64_final
+#define xxh3_128_final			cryb_xxh3_128_final
+#define xxh3_64_hash			cryb_xxh3_64_hash
+#define xxh3_64_hash_secret		cryb_xxh3_64_hash_secret
+#define xxh3_128_hash			cryb_xxh3_128_hash
+#define xxh3_128_hash_secret		cryb_xxh3_128_hash_secret
+#define xxh3_64_hash_algorithm		cryb_xxh3_64_hash_algorithm
+
+#define XXH_SEED_LEN			8
+#define XXH3_SECRET_LEN			192
+#define XXH3_SECRET_MIN_LEN		136
+#define XXH3_128_HASH_LEN		16
+
+typedef struct {
+	uint64_t v[4];
+	uint8_t buf[32];
+	unsigned int buflen;
+	uint64_t seed;
+	uint64_t len;
+} xxh64_ctx;
+
+typedef struct {
+	uint64_t acc[8];
+	uint8_t buf[256];
+	uint8_t secretbuf[XXH3_SECRET_LEN];
+	const uint8_t *secret;
+	size_t secretlen;
+	size_t buflen;
+	size_t nstripes;
+	uint64_t seed;
+	uint64_t len;
+} xxh3_ctx;
+
+void xxh64_init(xxh64_ctx *, uint64_t);
+void xxh64_update(xxh64_ctx *, const void *, size_t);
+uint64_t xxh64_final(xxh64_ctx *);
+uint64_t xxh64_hash(const void *, size_t, uint64_t);
+extern const hash_algorithm xxh64_hash_algorithm;
+
+void xxh3_init(xxh3_ctx *, uint64_t);
+int xxh3_init_secret(xxh3_ctx *, const uint8_t *, size_t);
+void xxh3_update(xxh3_ctx *, const void *, size_t);
+uint64_t xxh3_64_final(xxh3_ctx *);
+void xxh3_128_final(xxh3_ctx *, uint8_t *);
+uint64_t xxh3_64_hash(const void *, size_t, uint64_t);
+uint64_t xxh3_64_hash_secret(const void *, size_t, const uint8_t *, size_t);
+void xxh3_128_hash(const void *, size_t, uint64_t, uint8_t *);
+void xxh3_128_hash_secret(const void *, size_t, const uint8_t *, size_t,
+    uint8_t *);
+extern const hash_algorithm xxh3_64_hash_algorithm;
 
 CRYB_END
 
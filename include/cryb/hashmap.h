@@ -0,0 +1,64 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CRYB_HASHMAP_H_INCLUDED
+#define CRYB_HASHMAP_H_INCLUDED
+
+#ifndef CRYB_TO
+#include <cryb/to.h>
+#endif
+
+#include <cryb/hash.h>
+
+CRYB_BEGIN
+
+#define hashmap_new			cryb_hashmap_new
+#define hashmap_delete			cryb_hashmap_delete
+#define hashmap_count			cryb_hashmap_count
+#define hashmap_get			cryb_hashmap_get
+#define hashmap_put			cryb_hashmap_put
+#define hashmap_remove			cryb_hashmap_remove
+#define hashmap_next			cryb_hashmap_next
+
+typedef struct cryb_hashmap hashmap;
+
+/* flags for hashmap_new() */
+#define HASHMAP_COPY_KEYS		0x0001	/* store copies of keys */
+
+hashmap	*hashmap_new(const hash_algorithm *, const void *, unsigned int);
+void	 hashmap_delete(hashmap *);
+size_t	 hashmap_count(const hashmap *);
+void	**hashmap_get(hashmap *, const void *, size_t);
+int	 hashmap_put(hashmap *, const void *, size_t, void *);
+int	 hashmap_remove(hashmap *, const void *, size_t, void **);
+int	 hashmap_next(hashmap *, size_t *, const void **, size_t *, void **);
+
+CRYB_END
+
+#endif
@@ -0,0 +1,63 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CRYB_HKDF_H_INCLUDED
+#define CRYB_HKDF_H_INCLUDED
+
+#ifndef CRYB_TO
+#include <cryb/to.h>
+#endif
+
+#include <cryb/digest.h>
+#include <cryb/hmac.h>
+
+CRYB_BEGIN
+
+#define hkdf_ctx			cryb_hkdf_ctx
+#define hkdf_extract			cryb_hkdf_extract
+#define hkdf_setprk			cryb_hkdf_setprk
+#define hkdf_expand			cryb_hkdf_expand
+#define hkdf_clear			cryb_hkdf_clear
+#define hkdf_complete			cryb_hkdf_complete
+
+typedef struct {
+	hmac_key	 prk;		/* precomputed PRK key state */
+} hkdf_ctx;
+
+int hkdf_extract(hkdf_ctx *, const digest_algorithm *,
+    const void *, size_t, const void *, size_t);
+int hkdf_setprk(hkdf_ctx *, const digest_algorithm *, const void *, size_t);
+int hkdf_expand(const hkdf_ctx *, const void *, size_t, uint8_t *, size_t);
+void hkdf_clear(hkdf_ctx *);
+int hkdf_complete(const digest_algorithm *, const void *, size_t,
+    const void *, size_t, const void *, size_t, uint8_t *, size_t);
+
+CRYB_END
+
+#endif
@@ -0,0 +1,67 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CRYB_HLL_H_INCLUDED
+#define CRYB_HLL_H_INCLUDED
+
+#ifndef CRYB_TO
+#include <cryb/to.h>
+#endif
+
+#include <cryb/hash.h>
+
+CRYB_BEGIN
+
+#define hll_new				cryb_hll_new
+#define hll_delete			cryb_hll_delete
+#define hll_add				cryb_hll_add
+#define hll_add_many			cryb_hll_add_many
+#define hll_merge			cryb_hll_merge
+#define hll_estimate			cryb_hll_estimate
+#define hll_export			cryb_hll_export
+#define hll_import			cryb_hll_import
+
+typedef struct cryb_hll hll;
+
+/* range of supported precisions */
+#define HLL_MIN_PRECISION		4
+#define HLL_MAX_PRECISION		18
+
+hll	*hll_new(unsigned int, uint64_t);
+void	 hll_delete(hll *);
+int	 hll_add(hll *, const void *, size_t);
+int	 hll_add_many(hll *, const hash_key *, size_t);
+int	 hll_merge(hll *, const hll *);
+uint64_t hll_estimate(const hll *);
+size_t	 hll_export(const hll *, void *, size_t);
+hll	*hll_import(const void *, size_t);
+
+CRYB_END
+
+#endif
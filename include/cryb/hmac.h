@@ -34,10 +34,50 @@
 #include <cryb/to.h>
 #endif
 
+#include <cryb/digest.h>
+
 #include <cryb/hmac_sha1.h>
 #include <cryb/hmac_sha224.h>
 #include <cryb/hmac_sha256.h>
 #include <cryb/hmac_sha384.h>
 #include <cryb/hmac_sha512.h>
 
+CRYB_BEGIN
+
+#define HMAC_MAX_MAC_LEN		DIGEST_MAX_DIGEST_LEN
+
+#define hmac_ctx			cryb_hmac_ctx
+#define hmac_key			cryb_hmac_key
+#define hmac_init			cryb_hmac_init
+#define hmac_setkey			cryb_hmac_setkey
+#define hmac_reset			cryb_hmac_reset
+#define hmac_update			cryb_hmac_update
+#define hmac_final			cryb_hmac_final
+#define hmac_complete			cryb_hmac_complete
+
+/*
+ * HMAC over an arbitrary digest algorithm
+ */
+typedef struct {
+	const digest_algorithm	*alg;
+	uint64_t		 ictx[DIGEST_MAX_CONTEXT_LEN / sizeof(uint64_t)];
+	uint64_t		 octx[DIGEST_MAX_CONTEXT_LEN / sizeof(uint64_t)];
+} hmac_ctx;
+
+typedef struct {
+	const digest_algorithm	*alg;
+	uint64_t		 ictx[DIGEST_MAX_CONTEXT_LEN / sizeof(uint64_t)];
+	uint64_t		 octx[DIGEST_MAX_CONTEXT_LEN / sizeof(uint64_t)];
+} hmac_key;
+
+int hmac_init(hmac_ctx *, const digest_algorithm *, const void *, size_t);
+int hmac_setkey(hmac_key *, const digest_algorithm *, const void *, size_t);
+void hmac_reset(hmac_ctx *, const hmac_key *);
+void hmac_update(hmac_ctx *, const void *, size_t);
+void hmac_final(hmac_ctx *, uint8_t *);
+int hmac_complete(const digest_algorithm *, const void *, size_t,
+    const void *, size_t, uint8_t *);
+
+CRYB_END
+
 #endif
@@ -35,23 +35,37 @@
 #endif
 
 #include <cryb/sha1.h>
+#include <cryb/mac.h>
 
 CRYB_BEGIN
 
 #define HMAC_SHA1_MAC_LEN		20
 
+#define hmac_sha1_mac			cryb_hmac_sha1_mac
 #define hmac_sha1_ctx			cryb_hmac_sha1_ctx
+#define hmac_sha1_key			cryb_hmac_sha1_key
 #define hmac_sha1_init			cryb_hmac_sha1_init
+#define hmac_sha1_setkey		cryb_hmac_sha1_setkey
+#define hmac_sha1_reset			cryb_hmac_sha1_reset
 #define hmac_sha1_update		cryb_hmac_sha1_update
 #define hmac_sha1_final			cryb_hmac_sha1_final
 #define hmac_sha1_complete		cryb_hmac_sha1_complete
 
+extern mac_algorithm hmac_sha1_mac;
+
 typedef struct {
 	sha1_ctx ictx;
 	sha1_ctx octx;
 } hmac_sha1_ctx;
 
+typedef struct {
+	sha1_ctx ictx;
+	sha1_ctx octx;
+} hmac_sha1_key;
+
 void hmac_sha1_init(hmac_sha1_ctx *, const void *, size_t);
+void hmac_sha1_setkey(hmac_sha1_key *, const void *, size_t);
+void hmac_sha1_reset(hmac_sha1_ctx *, const hmac_sha1_key *);
 void hmac_sha1_update(hmac_sha1_ctx *, const void *, size_t);
 void hmac_sha1_final(hmac_sha1_ctx *, uint8_t *);
 void hmac_sha1_complete(const void *, size_t, const void *, size_t, uint8_t *);
@@ -35,23 +35,37 @@
 #endif
 
 #include <cryb/sha224.h>
+#include <cryb/mac.h>
 
 CRYB_BEGIN
 
 #define HMAC_SHA224_MAC_LEN		28
 
+#define hmac_sha224_mac			cryb_hmac_sha224_mac
 #define hmac_sha224_ctx			cryb_hmac_sha224_ctx
+#define hmac_sha224_key			cryb_hmac_sha224_key
 #define hmac_sha224_init		cryb_hmac_sha224_init
+#define hmac_sha224_setkey		cryb_hmac_sha224_setkey
+#define hmac_sha224_reset		cryb_hmac_sha224_reset
 #define hmac_sha224_update		cryb_hmac_sha224_update
 #define hmac_sha224_final		cryb_hmac_sha224_final
 #define hmac_sha224_complete		cryb_hmac_sha224_complete
 
+extern mac_algorithm hmac_sha224_mac;
+
 typedef struct {
 	sha224_ctx ictx;
 	sha224_ctx octx;
 } hmac_sha224_ctx;
 
+typedef struct {
+	sha224_ctx ictx;
+	sha224_ctx octx;
+} hmac_sha224_key;
+
 void hmac_sha224_init(hmac_sha224_ctx *, const void *, size_t);
+void hmac_sha224_setkey(hmac_sha224_key *, const void *, size_t);
+void hmac_sha224_reset(hmac_sha224_ctx *, const hmac_sha224_key *);
 void hmac_sha224_update(hmac_sha224_ctx *, const void *, size_t);
 void hmac_sha224_final(hmac_sha224_ctx *, uint8_t *);
 void hmac_sha224_complete(const void *, size_t, const void *, size_t, uint8_t *);
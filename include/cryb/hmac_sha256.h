@@ -35,23 +35,37 @@
 #endif
 
 #include <cryb/sha256.h>
+#include <cryb/mac.h>
 
 CRYB_BEGIN
 
 #define HMAC_SHA256_MAC_LEN		32
 
+#define hmac_sha256_mac			cryb_hmac_sha256_mac
 #define hmac_sha256_ctx			cryb_hmac_sha256_ctx
+#define hmac_sha256_key			cryb_hmac_sha256_key
 #define hmac_sha256_init		cryb_hmac_sha256_init
+#define hmac_sha256_setkey		cryb_hmac_sha256_setkey
+#define hmac_sha256_reset		cryb_hmac_sha256_reset
 #define hmac_sha256_update		cryb_hmac_sha256_update
 #define hmac_sha256_final		cryb_hmac_sha256_final
 #define hmac_sha256_complete		cryb_hmac_sha256_complete
 
+extern mac_algorithm hmac_sha256_mac;
+
 typedef struct {
 	sha256_ctx ictx;
 	sha256_ctx octx;
 } hmac_sha256_ctx;
 
+typedef struct {
+	sha256_ctx ictx;
+	sha256_ctx octx;
+} hmac_sha256_key;
+
 void hmac_sha256_init(hmac_sha256_ctx *, const void *, size_t);
+void hmac_sha256_setkey(hmac_sha256_key *, const void *, size_t);
+void hmac_sha256_reset(hmac_sha256_ctx *, const hmac_sha256_key *);
 void hmac_sha256_update(hmac_sha256_ctx *, const void *, size_t);
 void hmac_sha256_final(hmac_sha256_ctx *, uint8_t *);
 void hmac_sha256_complete(const void *, size_t, const void *, size_t, uint8_t *);
@@ -35,23 +35,37 @@
 #endif
 
 #include <cryb/sha384.h>
+#include <cryb/mac.h>
 
 CRYB_BEGIN
 
 #define HMAC_SHA384_MAC_LEN		48
 
+#define hmac_sha384_mac			cryb_hmac_sha384_mac
 #define hmac_sha384_ctx			cryb_hmac_sha384_ctx
+#define hmac_sha384_key			cryb_hmac_sha384_key
 #define hmac_sha384_init		cryb_hmac_sha384_init
+#define hmac_sha384_setkey		cryb_hmac_sha384_setkey
+#define hmac_sha384_reset		cryb_hmac_sha384_reset
 #define hmac_sha384_update		cryb_hmac_sha384_update
 #define hmac_sha384_final		cryb_hmac_sha384_final
 #define hmac_sha384_complete		cryb_hmac_sha384_complete
 
+extern mac_algorithm hmac_sha384_mac;
+
 typedef struct {
 	sha384_ctx ictx;
 	sha384_ctx octx;
 } hmac_sha384_ctx;
 
+typedef struct {
+	sha384_ctx ictx;
+	sha384_ctx octx;
+} hmac_sha384_key;
+
 void hmac_sha384_init(hmac_sha384_ctx *, const void *, size_t);
+void hmac_sha384_setkey(hmac_sha384_key *, const void *, size_t);
+void hmac_sha384_reset(hmac_sha384_ctx *, const hmac_sha384_key *);
 void hmac_sha384_update(hmac_sha384_ctx *, const void *, size_t);
 void hmac_sha384_final(hmac_sha384_ctx *, uint8_t *);
 void hmac_sha384_complete(const void *, size_t, const void *, size_t, uint8_t *);
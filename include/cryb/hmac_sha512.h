@@ -35,23 +35,37 @@
 #endif
 
 #include <cryb/sha512.h>
+#include <cryb/mac.h>
 
 CRYB_BEGIN
 
 #define HMAC_SHA512_MAC_LEN		64
 
+#define hmac_sha512_mac			cryb_hmac_sha512_mac
 #define hmac_sha512_ctx			cryb_hmac_sha512_ctx
+#define hmac_sha512_key			cryb_hmac_sha512_key
 #define hmac_sha512_init		cryb_hmac_sha512_init
+#define hmac_sha512_setkey		cryb_hmac_sha512_setkey
+#define hmac_sha512_reset		cryb_hmac_sha512_reset
 #define hmac_sha512_update		cryb_hmac_sha512_update
 #define hmac_sha512_final		cryb_hmac_sha512_final
 #define hmac_sha512_complete		cryb_hmac_sha512_complete
 
+extern mac_algorithm hmac_sha512_mac;
+
 typedef struct {
 	sha512_ctx ictx;
 	sha512_ctx octx;
 } hmac_sha512_ctx;
 
+typedef struct {
+	sha512_ctx ictx;
+	sha512_ctx octx;
+} hmac_sha512_key;
+
 void hmac_sha512_init(hmac_sha512_ctx *, const void *, size_t);
+void hmac_sha512_setkey(hmac_sha512_key *, const void *, size_t);
+void hmac_sha512_reset(hmac_sha512_ctx *, const hmac_sha512_key *);
 void hmac_sha512_update(hmac_sha512_ctx *, const void *, size_t);
 void hmac_sha512_final(hmac_sha512_ctx *, uint8_t *);
 void hmac_sha512_complete(const void *, size_t, const void *, size_t, uint8_t *);
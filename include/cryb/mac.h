@@ -34,12 +34,88 @@
 #include <cryb/to.h>
 #endif
 
-#include <cryb/hmac.h>
-
 CRYB_BEGIN
 
 const char *cryb_mac_version(void);
 
+#define mac_ctx				cryb_mac_ctx
+#define mac_key				cryb_mac_key
+#define mac_init_func			cryb_mac_init_func
+#define mac_update_func			cryb_mac_update_func
+#define mac_final_func			cryb_mac_final_func
+#define mac_complete_func		cryb_mac_complete_func
+#define mac_setkey_func			cryb_mac_setkey_func
+#define mac_reset_func			cryb_mac_reset_func
+#define mac_algorithm			cryb_mac_algorithm
+
+typedef void mac_ctx;
+typedef void mac_key;
+typedef void (*mac_init_func)(mac_ctx *, const void *, size_t);
+typedef void (*mac_update_func)(mac_ctx *, const void *, size_t);
+typedef void (*mac_final_func)(mac_ctx *, uint8_t *);
+typedef void (*mac_complete_func)(const void *, size_t, const void *, size_t,
+    uint8_t *);
+typedef void (*mac_setkey_func)(mac_key *, const void *, size_t);
+typedef void (*mac_reset_func)(mac_ctx *, const mac_key *);
+
+/* upper bounds for all MAC algorithms provided by this library */
+#define MAC_MAX_MAC_LEN			64
+#define MAC_MAX_CONTEXT_LEN		1024
+
+/* shortest truncated MAC accepted by mac_verify() (RFC 2104 section 5) */
+#define MAC_MIN_TAG_LEN			10
+
+typedef struct {
+	const char		*name;		/* algorithm name */
+	size_t			 contextlen;	/* size of context structure */
+	size_t			 keystatelen;	/* size of precomputed key */
+	size_t			 maclen;	/* length of the MAC */
+	mac_init_func		 init;		/* initialization method */
+	mac_update_func		 update;	/* update method */
+	mac_final_func		 final;		/* finalization method */
+	mac_complete_func	 complete;	/* one-shot method */
+	mac_setkey_func		 setkey;	/* key precomputation method */
+	mac_reset_func		 reset;		/* reinitialization method */
+} mac_algorithm;
+
+#define get_mac_algorithm		cryb_get_mac_algorithm
+
+const mac_algorithm *get_mac_algorithm(const char *);
+
+#define mac_init(alg, ctx, key, keylen)					\
+	(alg)->init((ctx), (key), (keylen))
+#define mac_update(alg, ctx, buf, len)					\
+	(alg)->update((ctx), (buf), (len))
+#define mac_final(alg, ctx, mac)					\
+	(alg)->final((ctx), (mac))
+#define mac_complete(alg, key, keylen, buf, len, mac)			\
+	(alg)->complete((key), (keylen), (buf), (len), (mac))
+#define mac_setkey(alg, hk, key, keylen)				\
+	(alg)->setkey((hk), (key), (keylen))
+#define mac_reset(alg, ctx, hk)						\
+	(alg)->reset((ctx), (hk))
+
+#define mac_verify			cryb_mac_verify
+#define mac_verify_item			cryb_mac_verify_item
+#define mac_verify_many			cryb_mac_verify_many
+
+typedef struct {
+	const void		*key;		/* key */
+	size_t			 keylen;	/* length of key */
+	const void		*msg;		/* message */
+	size_t			 msglen;	/* length of message */
+	const uint8_t		*tag;		/* expected MAC */
+	size_t			 taglen;	/* length of expected MAC */
+} mac_verify_item;
+
+int mac_verify(const mac_algorithm *, const void *, size_t,
+    const void *, size_t, const uint8_t *, size_t);
+size_t mac_verify_many(const mac_algorithm *, const mac_verify_item *,
+    size_t, int *);
+
 CRYB_END
 
+/* for backward compatibility */
+#include <cryb/hmac.h>
+
 #endif
@@ -0,0 +1,80 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CRYB_MERKLE_H_INCLUDED
+#define CRYB_MERKLE_H_INCLUDED
+
+#ifndef CRYB_TO
+#include <cryb/to.h>
+#endif
+
+#include <cryb/digest.h>
+
+CRYB_BEGIN
+
+#define MERKLE_LEAF_PREFIX		0x00
+#define MERKLE_NODE_PREFIX		0x01
+#define MERKLE_MAX_DEPTH		64
+
+#define merkle_ctx			cryb_merkle_ctx
+#define merkle_init			cryb_merkle_init
+#define merkle_update			cryb_merkle_update
+#define merkle_update_leaf		cryb_merkle_update_leaf
+#define merkle_final			cryb_merkle_final
+#define merkle_complete			cryb_merkle_complete
+#define merkle_leaf			cryb_merkle_leaf
+#define merkle_proof			cryb_merkle_proof
+#define merkle_verify			cryb_merkle_verify
+
+typedef struct {
+	const digest_algorithm	*alg;		/* underlying digest */
+	size_t			 leaflen;	/* leaf length */
+	unsigned int		 fanout;	/* children per node */
+	uint64_t		 nleaves;	/* leaves hashed so far */
+	size_t			 leafpos;	/* bytes in current leaf */
+	unsigned int		 depth;		/* levels allocated */
+	unsigned int		 count[MERKLE_MAX_DEPTH];
+	uint8_t			*state;		/* per-level state */
+} merkle_ctx;
+
+int merkle_init(merkle_ctx *, const digest_algorithm *, size_t, unsigned int);
+void merkle_update(merkle_ctx *, const void *, size_t);
+void merkle_update_leaf(merkle_ctx *, const uint8_t *);
+void merkle_final(merkle_ctx *, uint8_t *);
+int merkle_complete(const digest_algorithm *, size_t, unsigned int,
+    const void *, size_t, uint8_t *);
+void merkle_leaf(const digest_algorithm *, const void *, size_t, uint8_t *);
+int merkle_proof(const digest_algorithm *, size_t, unsigned int,
+    const void *, size_t, uint64_t, uint8_t *, size_t *);
+int merkle_verify(const digest_algorithm *, unsigned int, const uint8_t *,
+    uint64_t, uint64_t, const uint8_t *, size_t, const uint8_t *);
+
+CRYB_END
+
+#endif
@@ -0,0 +1,68 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CRYB_MPH_H_INCLUDED
+#define CRYB_MPH_H_INCLUDED
+
+#ifndef CRYB_TO
+#include <cryb/to.h>
+#endif
+
+#include <cryb/hash.h>
+
+CRYB_BEGIN
+
+/*
+ * Minimal perfect hash functions
+ */
+
+#define mph_build			cryb_mph_build
+#define mph_load			cryb_mph_load
+#define mph_delete			cryb_mph_delete
+#define mph_image			cryb_mph_image
+#define mph_count			cryb_mph_count
+#define mph_lookup			cryb_mph_lookup
+#define mph_lookup_many			cryb_mph_lookup_many
+
+typedef struct cryb_mph mph;
+
+/* upper bound on the number of keys */
+#define MPH_MAX_KEYS			0xf0000000UL
+
+mph	*mph_build(const hash_key *, size_t, uint64_t);
+mph	*mph_load(const void *, size_t);
+void	 mph_delete(mph *);
+const void *mph_image(const mph *, size_t *);
+size_t	 mph_count(const mph *);
+size_t	 mph_lookup(const mph *, const void *, size_t);
+void	 mph_lookup_many(const mph *, const hash_key *, size_t, size_t *);
+
+CRYB_END
+
+#endif
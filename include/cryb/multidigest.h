@@ -0,0 +1,65 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CRYB_MULTIDIGEST_H_INCLUDED
+#define CRYB_MULTIDIGEST_H_INCLUDED
+
+#ifndef CRYB_TO
+#include <cryb/to.h>
+#endif
+
+#include <cryb/digest.h>
+
+CRYB_BEGIN
+
+#define MULTIDIGEST_MAX_ALGS		8
+
+#define multidigest_ctx			cryb_multidigest_ctx
+#define multidigest_init		cryb_multidigest_init
+#define multidigest_update		cryb_multidigest_update
+#define multidigest_final		cryb_multidigest_final
+#define multidigest_complete		cryb_multidigest_complete
+
+typedef struct {
+	unsigned int		 nalgs;
+	const digest_algorithm	*alg[MULTIDIGEST_MAX_ALGS];
+	uint64_t		 ctx[MULTIDIGEST_MAX_ALGS]
+	    [DIGEST_MAX_CONTEXT_LEN / sizeof(uint64_t)];
+} multidigest_ctx;
+
+int multidigest_init(multidigest_ctx *, const digest_algorithm * const *,
+    unsigned int);
+void multidigest_update(multidigest_ctx *, const void *, size_t);
+void multidigest_final(multidigest_ctx *, uint8_t * const *);
+int multidigest_complete(const digest_algorithm * const *, unsigned int,
+    const void *, size_t, uint8_t * const *);
+
+CRYB_END
+
+#endif
@@ -0,0 +1,193 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <cryb/endian.h>
+#include <cryb/memset_s.h>
+
+#include <cryb/ghash.h>
+
+/*
+ * GHASH, the universal hash used by GCM and GMAC (NIST SP 800-38D),
+ * using Shoup's method: a table of the sixteen multiples of H by 4-bit
+ * polynomials, so a multiplication by H costs 32 table lookups instead
+ * of 128 conditional shift-and-add steps.
+ */
+
+/*
+ * Reduction of the four bits shifted out of the low end of a product.
+ */
+static const uint64_t ghash_last4[16] = {
+	0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+	0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0,
+};
+
+/*
+ * Initialize a GHASH context with the given hash subkey H.
+ */
+void
+ghash_init(ghash_ctx *ctx, const uint8_t *h)
+{
+	uint64_t vh, vl, carry;
+	unsigned int i, j;
+
+	memset(ctx, 0, sizeof *ctx);
+	vh = be64dec(h);
+	vl = be64dec(h + 8);
+	ctx->hh[8] = vh;
+	ctx->hl[8] = vl;
+	for (i = 4; i > 0; i >>= 1) {
+		/* multiply by x */
+		carry = vl & 1;
+		vl = (vh << 63) | (vl >> 1);
+		vh = (vh >> 1) ^ (carry * 0xe100000000000000ULL);
+		ctx->hh[i] = vh;
+		ctx->hl[i] = vl;
+	}
+	for (i = 2; i <= 8; i *= 2) {
+		for (j = 1; j < i; ++j) {
+			ctx->hh[i + j] = ctx->hh[i] ^ ctx->hh[j];
+			ctx->hl[i + j] = ctx->hl[i] ^ ctx->hl[j];
+		}
+	}
+}
+
+/*
+ * Multiply the running hash by H.
+ */
+static void
+ghash_mult(ghash_ctx *ctx)
+{
+	uint64_t zh, zl;
+	unsigned int lo, hi, rem;
+	int i;
+
+	lo = ctx->y[15] & 0x0f;
+	zh = ctx->hh[lo];
+	zl = ctx->hl[lo];
+	for (i = 15; i >= 0; --i) {
+		lo = ctx->y[i] & 0x0f;
+		hi = ctx->y[i] >> 4;
+		if (i != 15) {
+			rem = zl & 0x0f;
+			zl = (zh << 60) | (zl >> 4);
+			zh = (zh >> 4) ^ (ghash_last4[rem] << 48);
+			zh ^= ctx->hh[lo];
+			zl ^= ctx->hl[lo];
+		}
+		rem = zl & 0x0f;
+		zl = (zh << 60) | (zl >> 4);
+		zh = (zh >> 4) ^ (ghash_last4[rem] << 48);
+		zh ^= ctx->hh[hi];
+		zl ^= ctx->hl[hi];
+	}
+	be64enc(ctx->y, zh);
+	be64enc(ctx->y + 8, zl);
+}
+
+/*
+ * Absorb one block.
+ */
+static void
+ghash_block(ghash_ctx *ctx, const uint8_t *block)
+{
+	unsigned int i;
+
+	for (i = 0; i < GHASH_BLOCK_LEN; ++i)
+		ctx->y[i] ^= block[i];
+	ghash_mult(ctx);
+}
+
+/*
+ * Hash data.  Complete blocks are hashed directly from the caller's
+ * buffer; a trailing partial block is held until more data arrives or
+ * the context is padded.
+ */
+void
+ghash_update(ghash_ctx *ctx, const void *buf, size_t len)
+{
+	const uint8_t *p = buf;
+	size_t n;
+
+	if (ctx->buflen > 0) {
+		n = GHASH_BLOCK_LEN - ctx->buflen;
+		if (n > len)
+			n = len;
+		memcpy(ctx->buf + ctx->buflen, p, n);
+		ctx->buflen += n;
+		p += n;
+		len -= n;
+		if (ctx->buflen < GHASH_BLOCK_LEN)
+			return;
+		ghash_block(ctx, ctx->buf);
+		ctx->buflen = 0;
+	}
+	while (len >= GHASH_BLOCK_LEN) {
+		ghash_block(ctx, p);
+		p += GHASH_BLOCK_LEN;
+		len -= GHASH_BLOCK_LEN;
+	}
+	if (len > 0) {
+		memcpy(ctx->buf, p, len);
+		ctx->buflen = len;
+	}
+}
+
+/*
+ * Pad any partial block with zeroes and hash it, so that subsequent
+ * data starts on a block boundary.  GCM uses this to separate the
+ * additional data from the ciphertext.
+ */
+void
+ghash_pad(ghash_ctx *ctx)
+{
+
+	if (ctx->buflen > 0) {
+		memset(ctx->buf + ctx->buflen, 0,
+		    GHASH_BLOCK_LEN - ctx->buflen);
+		ghash_block(ctx, ctx->buf);
+		ctx->buflen = 0;
+	}
+}
+
+/*
+ * Pad any partial block, store the result and wipe the context.
+ */
+void
+ghash_final(ghash_ctx *ctx, uint8_t *out)
+{
+
+	ghash_pad(ctx);
+	memcpy(out, ctx->y, GHASH_BLOCK_LEN);
+	memset_s(ctx, sizeof *ctx, 0, sizeof *ctx);
+}
@@ -0,0 +1,62 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <cryb/timingsafe_bcmp.h>
+
+/*
+ * Like bcmp(3), but the time taken depends only on the length of the
+ * buffers, not on their contents.  The buffers are compared a word at a
+ * time; the words are loaded with memcpy() so that neither buffer needs
+ * to be aligned.
+ *
+ * Returns 0 if the buffers are identical and 1 if they are not.
+ */
+int
+cryb_timingsafe_bcmp(const void *b1, const void *b2, size_t len)
+{
+	const uint8_t *p1 = b1, *p2 = b2;
+	uint64_t w1, w2, acc;
+
+	for (acc = 0; len >= sizeof acc; len -= sizeof acc) {
+		memcpy(&w1, p1, sizeof w1);
+		memcpy(&w2, p2, sizeof w2);
+		acc |= w1 ^ w2;
+		p1 += sizeof w1;
+		p2 += sizeof w2;
+	}
+	while (len-- > 0)
+		acc |= *p1++ ^ *p2++;
+	return ((int)((acc | (0 - acc)) >> 63));
+}
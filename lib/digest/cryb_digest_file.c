@@ -0,0 +1,210 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#if HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <cryb/memset_s.h>
+
+#include <cryb/digest.h>
+
+/*
+ * Size of the window we map at a time.  Windows start at multiples of
+ * this size, so it must be a multiple of the page size.  Only the last
+ * window of a file can be shorter.
+ */
+#define DIGEST_FILE_WINDOW	(8 * 1024 * 1024)
+
+/*
+ * Size of the buffer we read into when we can't map the file.
+ */
+#define DIGEST_FILE_BUFLEN	(64 * 1024)
+
+#if HAVE_MMAP
+/*
+ * Hash a regular file from the given offset to the end, given its size,
+ * by mapping it one window at a time.  The first window starts at the
+ * window boundary at or below the offset, and the part of it that lies
+ * before the offset is skipped.  Before hashing each window, we map the
+ * next one and, where madvise() is available, ask the kernel to start
+ * reading it in, so that I/O overlaps with computation.
+ *
+ * Returns 0 on success, 1 if the file could not be mapped at all (in
+ * which case nothing has been hashed and the caller should fall back to
+ * reading), and -1 on failure.
+ */
+static int
+digest_fd_mmap(const digest_algorithm *alg, digest_ctx *ctx, int fd,
+    off_t off, off_t size)
+{
+	void *cur, *next;
+	size_t curlen, nextlen, skip;
+	off_t curoff, nextoff;
+
+	/* mmap() wants a page-aligned offset; use the window boundary */
+	skip = off % DIGEST_FILE_WINDOW;
+	curoff = off - skip;
+	curlen = size - curoff < DIGEST_FILE_WINDOW ?
+	    (size_t)(size - curoff) : DIGEST_FILE_WINDOW;
+	cur = mmap(NULL, curlen, PROT_READ, MAP_SHARED, fd, curoff);
+	if (cur == MAP_FAILED)
+		return (1);
+#if HAVE_MADVISE
+	(void)madvise(cur, curlen, MADV_SEQUENTIAL);
+#endif
+	for (;;) {
+		/* map the next window and start reading it in */
+		next = MAP_FAILED;
+		nextlen = 0;
+		nextoff = curoff + curlen;
+		if (nextoff < size) {
+			nextlen = size - nextoff < DIGEST_FILE_WINDOW ?
+			    (size_t)(size - nextoff) : DIGEST_FILE_WINDOW;
+			next = mmap(NULL, nextlen, PROT_READ, MAP_SHARED,
+			    fd, nextoff);
+			if (next == MAP_FAILED) {
+				(void)munmap(cur, curlen);
+				return (-1);
+			}
+#if HAVE_MADVISE
+			(void)madvise(next, nextlen, MADV_SEQUENTIAL);
+			(void)madvise(next, nextlen, MADV_WILLNEED);
+#endif
+		}
+
+		/* hash the current window */
+		digest_update(alg, ctx, (const uint8_t *)cur + skip,
+		    curlen - skip);
+		(void)munmap(cur, curlen);
+		if (next == MAP_FAILED)
+			break;
+		cur = next;
+		curlen = nextlen;
+		curoff = nextoff;
+		skip = 0;
+	}
+	return (0);
+}
+#endif
+
+/*
+ * Hash whatever can be read from the given file descriptor.
+ */
+static int
+digest_fd_read(const digest_algorithm *alg, digest_ctx *ctx, int fd)
+{
+	uint8_t *buf;
+	ssize_t rlen;
+
+	if ((buf = malloc(DIGEST_FILE_BUFLEN)) == NULL)
+		return (-1);
+	for (;;) {
+		rlen = read(fd, buf, DIGEST_FILE_BUFLEN);
+		if (rlen < 0 && errno == EINTR)
+			continue;
+		if (rlen <= 0)
+			break;
+		digest_update(alg, ctx, buf, rlen);
+	}
+	free(buf);
+	return (rlen < 0 ? -1 : 0);
+}
+
+/*
+ * Compute the digest of everything from the current position of the
+ * given file descriptor to the end of the file.  Regular files are
+ * mapped into memory rather than read, and the file position is left at
+ * the end of the file, as it would have been if we had read it.
+ */
+int
+digest_fd(const digest_algorithm *alg, int fd, uint8_t *md)
+{
+	uint64_t ctx[DIGEST_MAX_CONTEXT_LEN / sizeof(uint64_t)];
+	int ret, serrno;
+#if HAVE_MMAP
+	struct stat st;
+	off_t off;
+#endif
+
+	if (alg->contextlen > sizeof ctx) {
+		errno = EINVAL;
+		return (-1);
+	}
+	digest_init(alg, ctx);
+	ret = 1;
+#if HAVE_MMAP
+	if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) &&
+	    (off = lseek(fd, 0, SEEK_CUR)) >= 0) {
+		if (off >= st.st_size)
+			ret = 0;
+		else
+			ret = digest_fd_mmap(alg, ctx, fd, off, st.st_size);
+		if (ret == 0 && lseek(fd, st.st_size, SEEK_SET) < 0)
+			ret = -1;
+	}
+#endif
+	if (ret > 0)
+		ret = digest_fd_read(alg, ctx, fd);
+	if (ret != 0) {
+		serrno = errno;
+		memset_s(ctx, sizeof ctx, 0, sizeof ctx);
+		errno = serrno;
+		return (-1);
+	}
+	digest_final(alg, ctx, md);
+	return (0);
+}
+
+/*
+ * Compute the digest of the named file.
+ */
+int
+digest_file(const digest_algorithm *alg, const char *path, uint8_t *md)
+{
+	int fd, ret, serrno;
+
+	if ((fd = open(path, O_RDONLY)) < 0)
+		return (-1);
+	ret = digest_fd(alg, fd, md);
+	serrno = errno;
+	(void)close(fd);
+	errno = serrno;
+	return (ret);
+}
@@ -0,0 +1,411 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cryb/memset_s.h>
+
+#include <cryb/digest.h>
+#include <cryb/merkle.h>
+
+/*
+ * Merkle tree hash with RFC 6962 domain separation, generalized to an
+ * arbitrary fan-out.  Leaves are hashed as H(0x00 || leaf) and interior
+ * nodes as H(0x01 || child_0 || ... || child_k-1).  A tree of n > 1
+ * leaves is split into subtrees of f^m leaves, where f^m is the largest
+ * power of the fan-out f strictly less than n, with the last subtree
+ * taking whatever is left.  With a fan-out of 2, this is exactly the
+ * Merkle Tree Hash described in RFC 6962 section 2.1.
+ *
+ * The streaming implementation builds the tree bottom-up.  Each level
+ * holds a partially hashed parent node: the first child is held back
+ * until the second arrives, since a trailing node with no siblings is
+ * promoted unchanged rather than hashed again.
+ */
+
+/* n rounded up to nearest multiple of 8 */
+#define RUP8(n) (((n) + 7) & ~(size_t)7)
+
+/* size of the state for one level */
+#define MERKLE_SLOT_LEN(alg)						\
+	(RUP8((alg)->contextlen) + RUP8((alg)->digestlen))
+
+/* digest context for a level; level 0 is the leaf being hashed */
+#define MERKLE_CTX(ctx, i)						\
+	((digest_ctx *)((ctx)->state + (i) * MERKLE_SLOT_LEN((ctx)->alg)))
+
+/* first child held back at a level */
+#define MERKLE_FIRST(ctx, i)						\
+	((ctx)->state + (i) * MERKLE_SLOT_LEN((ctx)->alg) +		\
+	    RUP8((ctx)->alg->contextlen))
+
+static const uint8_t merkle_leaf_prefix = MERKLE_LEAF_PREFIX;
+static const uint8_t merkle_node_prefix = MERKLE_NODE_PREFIX;
+
+/*
+ * Initialize a Merkle tree context with the given digest algorithm,
+ * leaf length and fan-out.
+ */
+int
+merkle_init(merkle_ctx *ctx, const digest_algorithm *alg, size_t leaflen,
+    unsigned int fanout)
+{
+
+	if (alg->contextlen > DIGEST_MAX_CONTEXT_LEN ||
+	    alg->digestlen > DIGEST_MAX_DIGEST_LEN ||
+	    leaflen == 0 || fanout < 2) {
+		errno = EINVAL;
+		return (-1);
+	}
+	memset(ctx, 0, sizeof *ctx);
+	ctx->state = calloc(MERKLE_MAX_DEPTH + 1, MERKLE_SLOT_LEN(alg));
+	if (ctx->state == NULL)
+		return (-1);
+	ctx->alg = alg;
+	ctx->leaflen = leaflen;
+	ctx->fanout = fanout;
+	return (0);
+}
+
+/*
+ * Add a node to the given level, propagating upwards as parents fill up.
+ */
+static void
+merkle_add_node(merkle_ctx *ctx, unsigned int level, const uint8_t *md)
+{
+	const digest_algorithm *alg = ctx->alg;
+	uint8_t node[DIGEST_MAX_DIGEST_LEN];
+	digest_ctx *dctx;
+
+	while (level < MERKLE_MAX_DEPTH) {
+		if (level >= ctx->depth)
+			ctx->depth = level + 1;
+		dctx = MERKLE_CTX(ctx, level + 1);
+		if (ctx->count[level] == 0) {
+			memcpy(MERKLE_FIRST(ctx, level + 1), md, alg->digestlen);
+			ctx->count[level] = 1;
+			return;
+		}
+		if (ctx->count[level] == 1) {
+			digest_init(alg, dctx);
+			digest_update(alg, dctx, &merkle_node_prefix, 1);
+			digest_update(alg, dctx, MERKLE_FIRST(ctx, level + 1),
+			    alg->digestlen);
+		}
+		digest_update(alg, dctx, md, alg->digestlen);
+		if (++ctx->count[level] < ctx->fanout)
+			return;
+		digest_final(alg, dctx, node);
+		ctx->count[level] = 0;
+		md = node;
+		level++;
+	}
+}
+
+/*
+ * Hash the next len bytes of data into the tree.
+ */
+void
+merkle_update(merkle_ctx *ctx, const void *buf, size_t len)
+{
+	const digest_algorithm *alg = ctx->alg;
+	uint8_t md[DIGEST_MAX_DIGEST_LEN];
+	const uint8_t *data = buf;
+	size_t copylen;
+
+	while (len > 0) {
+		if (ctx->leafpos == 0) {
+			digest_init(alg, MERKLE_CTX(ctx, 0));
+			digest_update(alg, MERKLE_CTX(ctx, 0),
+			    &merkle_leaf_prefix, 1);
+		}
+		copylen = ctx->leaflen - ctx->leafpos;
+		if (copylen > len)
+			copylen = len;
+		digest_update(alg, MERKLE_CTX(ctx, 0), data, copylen);
+		ctx->leafpos += copylen;
+		data += copylen;
+		len -= copylen;
+		if (ctx->leafpos == ctx->leaflen) {
+			digest_final(alg, MERKLE_CTX(ctx, 0), md);
+			merkle_add_node(ctx, 0, md);
+			ctx->nleaves++;
+			ctx->leafpos = 0;
+		}
+	}
+}
+
+/*
+ * Add a precomputed leaf hash (see merkle_leaf()) to the tree.  This
+ * allows the caller to hash leaves concurrently and feed the results to
+ * the tree in order.  Must not be interleaved with a partial leaf.
+ */
+void
+merkle_update_leaf(merkle_ctx *ctx, const uint8_t *md)
+{
+
+	merkle_add_node(ctx, 0, md);
+	ctx->nleaves++;
+}
+
+/*
+ * Finalize the tree and write the root hash to md.
+ */
+void
+merkle_final(merkle_ctx *ctx, uint8_t *md)
+{
+	const digest_algorithm *alg = ctx->alg;
+	uint8_t carry[DIGEST_MAX_DIGEST_LEN];
+	unsigned int level, n;
+	digest_ctx *dctx;
+	int carried;
+
+	/* finish the last leaf */
+	if (ctx->leafpos > 0) {
+		digest_final(alg, MERKLE_CTX(ctx, 0), carry);
+		merkle_add_node(ctx, 0, carry);
+		ctx->nleaves++;
+		ctx->leafpos = 0;
+	}
+
+	/* fold incomplete nodes from the bottom up */
+	for (carried = 0, level = 0; level < ctx->depth; ++level) {
+		dctx = MERKLE_CTX(ctx, level + 1);
+		n = ctx->count[level] + carried;
+		if (n == 0)
+			continue;
+		if (n == 1) {
+			/* single node, promote it */
+			if (ctx->count[level] == 1)
+				memcpy(carry, MERKLE_FIRST(ctx, level + 1),
+				    alg->digestlen);
+			carried = 1;
+			continue;
+		}
+		if (ctx->count[level] == 1) {
+			digest_init(alg, dctx);
+			digest_update(alg, dctx, &merkle_node_prefix, 1);
+			digest_update(alg, dctx, MERKLE_FIRST(ctx, level + 1),
+			    alg->digestlen);
+		}
+		if (carried)
+			digest_update(alg, dctx, carry, alg->digestlen);
+		digest_final(alg, dctx, carry);
+		carried = 1;
+	}
+
+	/* the root of an empty tree is the hash of the empty string */
+	if (carried)
+		memcpy(md, carry, alg->digestlen);
+	else
+		digest_complete(alg, NULL, 0, md);
+
+	memset_s(ctx->state, (MERKLE_MAX_DEPTH + 1) * MERKLE_SLOT_LEN(alg), 0,
+	    (MERKLE_MAX_DEPTH + 1) * MERKLE_SLOT_LEN(alg));
+	free(ctx->state);
+	memset_s(ctx, sizeof *ctx, 0, sizeof *ctx);
+}
+
+/*
+ * Compute the root hash of a tree over a single contiguous buffer.
+ */
+int
+merkle_complete(const digest_algorithm *alg, size_t leaflen,
+    unsigned int fanout, const void *buf, size_t len, uint8_t *md)
+{
+	merkle_ctx ctx;
+
+	if (merkle_init(&ctx, alg, leaflen, fanout) != 0)
+		return (-1);
+	merkle_update(&ctx, buf, len);
+	merkle_final(&ctx, md);
+	return (0);
+}
+
+/*
+ * Compute the hash of a single leaf.
+ */
+void
+merkle_leaf(const digest_algorithm *alg, const void *buf, size_t len,
+    uint8_t *md)
+{
+	uint64_t dctx[DIGEST_MAX_CONTEXT_LEN / sizeof(uint64_t)];
+
+	digest_init(alg, dctx);
+	digest_update(alg, dctx, &merkle_leaf_prefix, 1);
+	digest_update(alg, dctx, buf, len);
+	digest_final(alg, dctx, md);
+}
+
+/*
+ * One step on the path from the root to a leaf: the parent node spans
+ * leaves [start, start + span), its children span up to step leaves
+ * each, and the path continues through child number pos out of nchild.
+ */
+struct merkle_step {
+	uint64_t	 start;
+	uint64_t	 span;
+	uint64_t	 step;
+	unsigned int	 nchild;
+	unsigned int	 pos;
+};
+
+/*
+ * Trace the path from the root of a tree of nleaves leaves to the leaf
+ * with the given index.  Returns the number of steps, root first.
+ */
+static unsigned int
+merkle_path(unsigned int fanout, uint64_t index, uint64_t nleaves,
+    struct merkle_step *path)
+{
+	uint64_t start, span, step;
+	unsigned int depth;
+
+	for (depth = 0, start = 0, span = nleaves; span > 1; ++depth) {
+		/* largest power of the fan-out strictly less than span */
+		for (step = 1; step <= (span - 1) / fanout; step *= fanout)
+			/* nothing */ ;
+		path[depth].start = start;
+		path[depth].span = span;
+		path[depth].step = step;
+		path[depth].nchild = (span + step - 1) / step;
+		path[depth].pos = (index - start) / step;
+		start += path[depth].pos * step;
+		if (span - (start - path[depth].start) < step)
+			span = span - (start - path[depth].start);
+		else
+			span = step;
+	}
+	return (depth);
+}
+
+/*
+ * Generate an inclusion proof for the leaf with the given index in the
+ * tree over a contiguous buffer.  The proof consists of the hashes of
+ * the leaf's siblings at each level, from the bottom up and from left
+ * to right within each level.  On input, *prooflen is the size of the
+ * proof buffer; on output, it is the length of the proof.
+ */
+int
+merkle_proof(const digest_algorithm *alg, size_t leaflen,
+    unsigned int fanout, const void *buf, size_t len, uint64_t index,
+    uint8_t *proof, size_t *prooflen)
+{
+	struct merkle_step path[MERKLE_MAX_DEPTH];
+	const uint8_t *data = buf;
+	uint64_t nleaves, first, last;
+	size_t off, end, plen;
+	unsigned int depth, i, j;
+
+	if (leaflen == 0 || fanout < 2) {
+		errno = EINVAL;
+		return (-1);
+	}
+	nleaves = len / leaflen + (len % leaflen != 0);
+	if (index >= nleaves) {
+		errno = EINVAL;
+		return (-1);
+	}
+	depth = merkle_path(fanout, index, nleaves, path);
+	for (plen = 0, i = 0; i < depth; ++i)
+		plen += (path[i].nchild - 1) * alg->digestlen;
+	if (plen > *prooflen) {
+		errno = ENOSPC;
+		return (-1);
+	}
+	for (plen = 0, i = depth; i > 0; --i) {
+		for (j = 0; j < path[i - 1].nchild; ++j) {
+			if (j == path[i - 1].pos)
+				continue;
+			first = path[i - 1].start + j * path[i - 1].step;
+			last = first + path[i - 1].step;
+			if (last > path[i - 1].start + path[i - 1].span)
+				last = path[i - 1].start + path[i - 1].span;
+			off = first * leaflen;
+			end = last * leaflen;
+			if (end > len)
+				end = len;
+			if (merkle_complete(alg, leaflen, fanout,
+			    data + off, end - off, proof + plen) != 0)
+				return (-1);
+			plen += alg->digestlen;
+		}
+	}
+	*prooflen = plen;
+	return (0);
+}
+
+/*
+ * Verify an inclusion proof for a leaf, given the leaf hash, its index,
+ * the number of leaves in the tree and the expected root hash.  Returns
+ * 1 if the proof is valid, 0 if it is not, and -1 on error.
+ */
+int
+merkle_verify(const digest_algorithm *alg, unsigned int fanout,
+    const uint8_t *leafmd, uint64_t index, uint64_t nleaves,
+    const uint8_t *proof, size_t prooflen, const uint8_t *root)
+{
+	uint64_t dctx[DIGEST_MAX_CONTEXT_LEN / sizeof(uint64_t)];
+	uint8_t md[DIGEST_MAX_DIGEST_LEN];
+	struct merkle_step path[MERKLE_MAX_DEPTH];
+	unsigned int depth, i, j;
+	size_t plen;
+
+	if (alg->contextlen > DIGEST_MAX_CONTEXT_LEN ||
+	    alg->digestlen > DIGEST_MAX_DIGEST_LEN ||
+	    fanout < 2 || index >= nleaves) {
+		errno = EINVAL;
+		return (-1);
+	}
+	depth = merkle_path(fanout, index, nleaves, path);
+	for (plen = 0, i = 0; i < depth; ++i)
+		plen += (path[i].nchild - 1) * alg->digestlen;
+	if (plen != prooflen)
+		return (0);
+	memcpy(md, leafmd, alg->digestlen);
+	for (i = depth; i > 0; --i) {
+		digest_init(alg, dctx);
+		digest_update(alg, dctx, &merkle_node_prefix, 1);
+		for (j = 0; j < path[i - 1].nchild; ++j) {
+			if (j == path[i - 1].pos) {
+				digest_update(alg, dctx, md, alg->digestlen);
+			} else {
+				digest_update(alg, dctx, proof, alg->digestlen);
+				proof += alg->digestlen;
+			}
+		}
+		digest_final(alg, dctx, md);
+	}
+	return (memcmp(md, root, alg->digestlen) == 0);
+}
@@ -0,0 +1,125 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <cryb/memset_s.h>
+
+#include <cryb/digest.h>
+#include <cryb/multidigest.h>
+
+/*
+ * Compute several digests of the same message in a single pass.  The
+ * input is split into chunks, and each chunk is passed to every
+ * algorithm in turn before moving on to the next, so that it only has
+ * to be brought into cache once.  Each algorithm handles partial blocks
+ * at either end of a chunk in its own context, as it would for any
+ * other update.
+ */
+#define MULTIDIGEST_CHUNK_LEN	(16 * 1024)
+
+/*
+ * Initialize a multi-digest context with the given list of algorithms.
+ */
+int
+multidigest_init(multidigest_ctx *ctx, const digest_algorithm * const *algs,
+    unsigned int nalgs)
+{
+	unsigned int i;
+
+	if (nalgs == 0 || nalgs > MULTIDIGEST_MAX_ALGS) {
+		errno = EINVAL;
+		return (-1);
+	}
+	for (i = 0; i < nalgs; ++i) {
+		if (algs[i]->contextlen > DIGEST_MAX_CONTEXT_LEN) {
+			errno = EINVAL;
+			return (-1);
+		}
+	}
+	ctx->nalgs = nalgs;
+	for (i = 0; i < nalgs; ++i) {
+		ctx->alg[i] = algs[i];
+		digest_init(algs[i], ctx->ctx[i]);
+	}
+	return (0);
+}
+
+/*
+ * Feed data to every algorithm.
+ */
+void
+multidigest_update(multidigest_ctx *ctx, const void *buf, size_t len)
+{
+	const uint8_t *p = buf;
+	unsigned int i;
+	size_t n;
+
+	while (len > 0) {
+		n = len < MULTIDIGEST_CHUNK_LEN ? len : MULTIDIGEST_CHUNK_LEN;
+		for (i = 0; i < ctx->nalgs; ++i)
+			digest_update(ctx->alg[i], ctx->ctx[i], p, n);
+		p += n;
+		len -= n;
+	}
+}
+
+/*
+ * Finalize every algorithm, storing each digest in the corresponding
+ * output buffer.
+ */
+void
+multidigest_final(multidigest_ctx *ctx, uint8_t * const *md)
+{
+	unsigned int i;
+
+	for (i = 0; i < ctx->nalgs; ++i)
+		digest_final(ctx->alg[i], ctx->ctx[i], md[i]);
+	memset_s(ctx, sizeof *ctx, 0, sizeof *ctx);
+}
+
+/*
+ * Compute several digests of a message in a single pass.
+ */
+int
+multidigest_complete(const digest_algorithm * const *algs, unsigned int nalgs,
+    const void *buf, size_t len, uint8_t * const *md)
+{
+	multidigest_ctx ctx;
+
+	if (multidigest_init(&ctx, algs, nalgs) != 0)
+		return (-1);
+	multidigest_update(&ctx, buf, len);
+	multidigest_final(&ctx, md);
+	return (0);
+}
@@ -234,11 +234,13 @@ sha256_update(sha256_ctx * ctx, const void *in, size_t len)
 		return;
 	}
 
-	/* Finish the current block. */
-	memcpy(&ctx->buf[r], src, 64 - r);
-	sha256_Transform(ctx->state, ctx->buf);
-	src += 64 - r;
-	len -= 64 - r;
+	/* Finish the current block, if any. */
+	if (r > 0) {
+		memcpy(&ctx->buf[r], src, 64 - r);
+		sha256_Transform(ctx->state, ctx->buf);
+		src += 64 - r;
+		len -= 64 - r;
+	}
 
 	/* Perform complete blocks. */
 	while (len >= 64) {
@@ -32,22 +32,257 @@
 #include <stdint.h>
 #include <string.h>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define ADLER32_AVX2 1
+#define ADLER32_VECLEN 32
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#define ADLER32_SSSE3 1
+#define ADLER32_VECLEN 16
+#endif
+
 #include <cryb/bitwise.h>
 #include <cryb/endian.h>
 #include <cryb/hash.h>
 
+#include "cryb_hash_impl.h"
+
 /*
- * Simple implementation of the Adler-32 checksum described in RFC 1950.
+ * Implementation of the Adler-32 checksum described in RFC 1950.
+ *
+ * Rather than reduce both sums modulo 65521 after every byte, we let
+ * them grow and reduce them every ADLER32_NMAX bytes.  ADLER32_NMAX is
+ * the largest n such that 255 n (n + 1) / 2 + (n + 1) (65521 - 1) fits
+ * in 32 bits, i.e. the longest run of 0xff bytes which cannot overflow
+ * the second sum if both sums were fully reduced beforehand.  The inner
+ * loop is unrolled sixteen ways, which is enough for the compiler to
+ * schedule it well.
+ *
+ * Where SSSE3 or AVX2 is available at compile time, the bulk of each
+ * run is handled by a vector kernel instead; see below.
  */
-uint32_t
-adler32_hash(const void *data, size_t len)
+#define ADLER32_BASE	65521U
+#define ADLER32_NMAX	5552
+
+#define ADLER32_DO1(i)	do { c0 += bytes[i]; c1 += c0; } while (0)
+#define ADLER32_DO4(i)							\
+	do {								\
+		ADLER32_DO1(i);						\
+		ADLER32_DO1(i + 1);					\
+		ADLER32_DO1(i + 2);					\
+		ADLER32_DO1(i + 3);					\
+	} while (0)
+#define ADLER32_DO16()							\
+	do {								\
+		ADLER32_DO4(0);						\
+		ADLER32_DO4(4);						\
+		ADLER32_DO4(8);						\
+		ADLER32_DO4(12);					\
+	} while (0)
+
+#if ADLER32_VECLEN
+/*
+ * Vector kernel for a run of len bytes, where len is a multiple of the
+ * vector length and no greater than ADLER32_NMAX.  For each block of
+ * ADLER32_VECLEN bytes, the first sum grows by the sum of the bytes,
+ * and the second by the sum of the bytes weighted by their distance
+ * from the end of the block, plus the block length times the first sum
+ * as it stood before the block.  We accumulate the byte sums, their
+ * running total and the weighted sums in separate vectors and combine
+ * them at the end.  The lanes may wrap around, but since the final
+ * sums are known to fit in 32 bits, arithmetic modulo 2^32 gives the
+ * right answer.
+ */
+#if ADLER32_AVX2
+static void
+adler32_vec(uint32_t *pc0, uint32_t *pc1, const uint8_t *bytes, size_t len)
+{
+	const __m256i weights = _mm256_setr_epi8(
+	    32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+	    16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+	const __m256i ones = _mm256_set1_epi16(1);
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i vs1, vps, vs2, v;
+	__m128i t1, tps, t2;
+	uint32_t c0, c1;
+	size_t i;
+
+	vs1 = vps = vs2 = zero;
+	for (i = 0; i < len; i += 32) {
+		v = _mm256_loadu_si256((const __m256i *)(bytes + i));
+		vps = _mm256_add_epi32(vps, vs1);
+		vs1 = _mm256_add_epi32(vs1, _mm256_sad_epu8(v, zero));
+		vs2 = _mm256_add_epi32(vs2,
+		    _mm256_madd_epi16(_mm256_maddubs_epi16(v, weights), ones));
+	}
+	t1 = _mm_add_epi32(_mm256_castsi256_si128(vs1),
+	    _mm256_extracti128_si256(vs1, 1));
+	tps = _mm_add_epi32(_mm256_castsi256_si128(vps),
+	    _mm256_extracti128_si256(vps, 1));
+	t2 = _mm_add_epi32(_mm256_castsi256_si128(vs2),
+	    _mm256_extracti128_si256(vs2, 1));
+#else
+static void
+adler32_vec(uint32_t *pc0, uint32_t *pc1, const uint8_t *bytes, size_t len)
+{
+	const __m128i weights = _mm_setr_epi8(
+	    16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+	const __m128i ones = _mm_set1_epi16(1);
+	const __m128i zero = _mm_setzero_si128();
+	__m128i t1, tps, t2, v;
+	uint32_t c0, c1;
+	size_t i;
+
+	t1 = tps = t2 = zero;
+	for (i = 0; i < len; i += 16) {
+		v = _mm_loadu_si128((const __m128i *)(bytes + i));
+		tps = _mm_add_epi32(tps, t1);
+		t1 = _mm_add_epi32(t1, _mm_sad_epu8(v, zero));
+		t2 = _mm_add_epi32(t2,
+		    _mm_madd_epi16(_mm_maddubs_epi16(v, weights), ones));
+	}
+#endif
+	/* horizontal sums */
+	t1 = _mm_add_epi32(t1, _mm_shuffle_epi32(t1, 0x4e));
+	t1 = _mm_add_epi32(t1, _mm_shuffle_epi32(t1, 0xb1));
+	tps = _mm_add_epi32(tps, _mm_shuffle_epi32(tps, 0x4e));
+	tps = _mm_add_epi32(tps, _mm_shuffle_epi32(tps, 0xb1));
+	t2 = _mm_add_epi32(t2, _mm_shuffle_epi32(t2, 0x4e));
+	t2 = _mm_add_epi32(t2, _mm_shuffle_epi32(t2, 0xb1));
+	c0 = *pc0;
+	c1 = *pc1;
+	c1 += c0 * (uint32_t)len;
+	c1 += ADLER32_VECLEN * (uint32_t)_mm_cvtsi128_si32(tps);
+	c1 += (uint32_t)_mm_cvtsi128_si32(t2);
+	c0 += (uint32_t)_mm_cvtsi128_si32(t1);
+	*pc0 = c0;
+	*pc1 = c1;
+}
+#endif
+
+void
+adler32_init(adler32_ctx *ctx)
+{
+
+	ctx->c0 = 1;
+	ctx->c1 = 0;
+}
+
+void
+adler32_update(adler32_ctx *ctx, const void *data, size_t len)
 {
 	const uint8_t *bytes;
 	uint32_t c0, c1;
+	size_t n;
+#if ADLER32_VECLEN
+	size_t m;
+#endif
 
-	for (bytes = data, c0 = 1, c1 = 0; len > 0; len--, bytes++) {
-		c0 = (c0 + *bytes) % 65521;
-		c1 = (c1 + c0) % 65521;
+	bytes = data;
+	c0 = ctx->c0;
+	c1 = ctx->c1;
+	while (len > 0) {
+		n = len < ADLER32_NMAX ? len : ADLER32_NMAX;
+		len -= n;
+#if ADLER32_VECLEN
+		m = n - n % ADLER32_VECLEN;
+		adler32_vec(&c0, &c1, bytes, m);
+		bytes += m;
+		n -= m;
+#endif
+		for (; n >= 16; n -= 16, bytes += 16)
+			ADLER32_DO16();
+		for (; n > 0; n--, bytes++)
+			ADLER32_DO1(0);
+		c0 %= ADLER32_BASE;
+		c1 %= ADLER32_BASE;
 	}
-	return (c1 << 16 | c0);
+	ctx->c0 = c0;
+	ctx->c1 = c1;
 }
+
+uint32_t
+adler32_final(adler32_ctx *ctx)
+{
+
+	return (ctx->c1 << 16 | ctx->c0);
+}
+
+/*
+ * Given the checksums of two adjacent pieces of data and the length of
+ * the second, compute the checksum of their concatenation.  This allows
+ * the pieces to be checksummed independently, e.g. in parallel.
+ *
+ * If the pieces are A and B, the first sum of AB is a0 + b0 - 1, since
+ * both started at 1, and each of the len2 terms added to the second sum
+ * while processing B is a0 - 1 greater than it would have been.
+ */
+uint32_t
+adler32_combine(uint32_t sum1, uint32_t sum2, uint64_t len2)
+{
+	uint32_t a0, a1, b0, b1, rem;
+
+	rem = len2 % ADLER32_BASE;
+	a0 = sum1 & 0xffff;
+	a1 = sum1 >> 16;
+	b0 = sum2 & 0xffff;
+	b1 = sum2 >> 16;
+	/* a0 + b0 - 1, kept non-negative */
+	b0 = (a0 + b0 + ADLER32_BASE - 1) % ADLER32_BASE;
+	/* a1 + b1 + rem * (a0 - 1), likewise */
+	b1 = (a1 + b1 + ADLER32_BASE - rem +
+	    (uint32_t)((uint64_t)rem * a0 % ADLER32_BASE)) % ADLER32_BASE;
+	return (b1 << 16 | b0);
+}
+
+/*
+ * Rolling interface, as used by rsync: append one byte to the data, or
+ * remove one from the front of data which is currently len bytes long.
+ * Removing x from the front takes x off the first sum and len x + 1 off
+ * the second, since x and the initial 1 were both counted in each of the
+ * len partial sums which make it up.  Both sums are kept fully reduced,
+ * so a conditional subtraction is all we need on the fast path.
+ */
+void
+adler32_roll_in(adler32_ctx *ctx, uint8_t in)
+{
+	uint32_t c0, c1;
+
+	c0 = ctx->c0 + in;
+	if (c0 >= ADLER32_BASE)
+		c0 -= ADLER32_BASE;
+	c1 = ctx->c1 + c0;
+	if (c1 >= ADLER32_BASE)
+		c1 -= ADLER32_BASE;
+	ctx->c0 = c0;
+	ctx->c1 = c1;
+}
+
+void
+adler32_roll_out(adler32_ctx *ctx, uint8_t out, uint64_t len)
+{
+	uint32_t c0, c1, t;
+
+	c0 = ctx->c0 + ADLER32_BASE - out;
+	if (c0 >= ADLER32_BASE)
+		c0 -= ADLER32_BASE;
+	t = ((uint32_t)(len % ADLER32_BASE) * out + 1) % ADLER32_BASE;
+	c1 = ctx->c1 + ADLER32_BASE - t;
+	if (c1 >= ADLER32_BASE)
+		c1 -= ADLER32_BASE;
+	ctx->c0 = c0;
+	ctx->c1 = c1;
+}
+
+uint32_t
+adler32_hash(const void *data, size_t len)
+{
+	adler32_ctx ctx;
+
+	adler32_init(&ctx);
+	adler32_update(&ctx, data, len);
+	return (adler32_final(&ctx));
+}
+
+CRYB_HASH_ALGORITHM_UNKEYED(adler32, "adler32", adler32_ctx, uint32_t);
@@ -0,0 +1,287 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cryb/endian.h>
+#include <cryb/hash.h>
+#include <cryb/filter.h>
+
+#include "cryb_filter_impl.h"
+
+/*
+ * Classic and blocked Bloom filters.
+ *
+ * The bit positions for a key are derived from the two halves of its
+ * 128-bit MurmurHash3 using double hashing, as described by Kirsch and
+ * Mitzenmacher: the i-th position is h1 + i * h2.
+ *
+ * In a blocked filter, h1 selects a 512-bit block, which is aligned on
+ * a cache line, and all the positions are taken from that block using
+ * the two halves of h2.  This costs a little accuracy in exchange for a
+ * single cache miss per lookup.
+ */
+
+#define BLOCK_BITS	(FILTER_ALIGN * 8)
+
+struct cryb_bloom {
+	void		*base;		/* allocation, NULL if loaded */
+	uint8_t		*image;		/* header and data */
+	uint8_t		*bits;		/* data */
+	uint64_t	 nbits;		/* number of bits */
+	uint64_t	 nblocks;	/* number of blocks, if blocked */
+	unsigned int	 nhashes;	/* number of hash functions */
+	uint32_t	 seed;		/* MurmurHash3 seed */
+};
+
+/*
+ * Allocate a new filter of at least the given number of bits, using
+ * the given number of hash functions.
+ */
+bloom *
+bloom_new(size_t nbits, unsigned int nhashes, uint32_t seed,
+    unsigned int flags)
+{
+	bloom *bf;
+	uint32_t type;
+
+	if (nbits == 0 || nhashes == 0 || nhashes > BLOOM_MAX_HASHES ||
+	    (flags & ~BLOOM_BLOCKED) != 0 || nbits > SIZE_MAX - BLOCK_BITS) {
+		errno = EINVAL;
+		return (NULL);
+	}
+	if ((bf = calloc(1, sizeof *bf)) == NULL)
+		return (NULL);
+	if (flags & BLOOM_BLOCKED) {
+		type = FILTER_TYPE_BLOCKED;
+		bf->nblocks = (nbits + BLOCK_BITS - 1) / BLOCK_BITS;
+		bf->nbits = bf->nblocks * BLOCK_BITS;
+	} else {
+		type = FILTER_TYPE_BLOOM;
+		bf->nbits = (nbits + 7) / 8 * 8;
+	}
+	bf->nhashes = nhashes;
+	bf->seed = seed;
+	bf->image = filter_image_new(bf->nbits / 8, type, bf->nbits, seed,
+	    &bf->base);
+	if (bf->image == NULL) {
+		free(bf);
+		return (NULL);
+	}
+	le32enc(bf->image + FILTER_OFF_NHASHES, nhashes);
+	bf->bits = bf->image + FILTER_HEADER_LEN;
+	return (bf);
+}
+
+/*
+ * Create a filter from an image previously obtained from bloom_image().
+ * The image is used in place and must remain valid for the lifetime of
+ * the filter.
+ */
+bloom *
+bloom_load(void *buf, size_t len)
+{
+	uint8_t *image = buf;
+	bloom *bf;
+	uint64_t nbits;
+	unsigned int nhashes;
+	int type;
+
+	if ((type = filter_image_type(image, len)) < 0)
+		return (NULL);
+	nhashes = le32dec(image + FILTER_OFF_NHASHES);
+	nbits = le64dec(image + FILTER_OFF_SIZE);
+	if ((type != FILTER_TYPE_BLOOM && type != FILTER_TYPE_BLOCKED) ||
+	    nhashes == 0 || nhashes > BLOOM_MAX_HASHES || nbits == 0 ||
+	    nbits % (type == FILTER_TYPE_BLOCKED ? BLOCK_BITS : 8) != 0 ||
+	    nbits / 8 != len - FILTER_HEADER_LEN) {
+		errno = EINVAL;
+		return (NULL);
+	}
+	if ((bf = calloc(1, sizeof *bf)) == NULL)
+		return (NULL);
+	bf->image = image;
+	bf->bits = image + FILTER_HEADER_LEN;
+	bf->nbits = nbits;
+	if (type == FILTER_TYPE_BLOCKED)
+		bf->nblocks = nbits / BLOCK_BITS;
+	bf->nhashes = nhashes;
+	bf->seed = le32dec(image + FILTER_OFF_SEED);
+	return (bf);
+}
+
+/*
+ * Delete a filter
+ */
+void
+bloom_delete(bloom *bf)
+{
+
+	if (bf != NULL) {
+		free(bf->base);
+		free(bf);
+	}
+}
+
+/*
+ * Return the image of a filter and its length
+ */
+const void *
+bloom_image(const bloom *bf, size_t *len)
+{
+
+	*len = FILTER_HEADER_LEN + bf->nbits / 8;
+	return (bf->image);
+}
+
+/*
+ * Return a pointer to the first byte of the filter which will be
+ * accessed for a key with the given hash.
+ */
+static inline const uint8_t *
+bloom_first(const bloom *bf, const struct filter_hash *fh)
+{
+
+	if (bf->nblocks > 0)
+		return (bf->bits + (fh->h1 % bf->nblocks) * FILTER_ALIGN);
+	return (bf->bits + (fh->h1 % bf->nbits) / 8);
+}
+
+/*
+ * Set or test the bits for a key with the given hash.
+ */
+static inline void
+bloom_set(bloom *bf, const struct filter_hash *fh)
+{
+	uint8_t *block;
+	uint64_t h, pos;
+	uint32_t a, b;
+	unsigned int i;
+
+	if (bf->nblocks > 0) {
+		block = bf->bits + (fh->h1 % bf->nblocks) * FILTER_ALIGN;
+		a = (uint32_t)fh->h2;
+		b = (uint32_t)(fh->h2 >> 32) | 1;
+		for (i = 0; i < bf->nhashes; ++i, a += b)
+			block[(a % BLOCK_BITS) / 8] |= 1U << (a % 8);
+	} else {
+		for (i = 0, h = fh->h1; i < bf->nhashes; ++i, h += fh->h2) {
+			pos = h % bf->nbits;
+			bf->bits[pos / 8] |= 1U << (pos % 8);
+		}
+	}
+}
+
+static inline int
+bloom_test(const bloom *bf, const struct filter_hash *fh)
+{
+	const uint8_t *block;
+	uint64_t h, pos;
+	uint32_t a, b;
+	unsigned int i;
+
+	if (bf->nblocks > 0) {
+		block = bf->bits + (fh->h1 % bf->nblocks) * FILTER_ALIGN;
+		a = (uint32_t)fh->h2;
+		b = (uint32_t)(fh->h2 >> 32) | 1;
+		for (i = 0; i < bf->nhashes; ++i, a += b)
+			if ((block[(a % BLOCK_BITS) / 8] & (1U << (a % 8))) == 0)
+				return (0);
+	} else {
+		for (i = 0, h = fh->h1; i < bf->nhashes; ++i, h += fh->h2) {
+			pos = h % bf->nbits;
+			if ((bf->bits[pos / 8] & (1U << (pos % 8))) == 0)
+				return (0);
+		}
+	}
+	return (1);
+}
+
+/*
+ * Add a key to a filter
+ */
+void
+bloom_add(bloom *bf, const void *key, size_t len)
+{
+	struct filter_hash fh;
+
+	filter_hash(key, len, bf->seed, &fh);
+	bloom_set(bf, &fh);
+}
+
+/*
+ * Return 1 if a key may be present in a filter and 0 if it definitely
+ * is not.
+ */
+int
+bloom_query(const bloom *bf, const void *key, size_t len)
+{
+	struct filter_hash fh;
+
+	filter_hash(key, len, bf->seed, &fh);
+	return (bloom_test(bf, &fh));
+}
+
+/*
+ * Query multiple keys, storing the results in the corresponding
+ * elements of an array if it is not NULL, and return the number of
+ * keys which may be present.  The keys are hashed a few at a time and
+ * the first cache line each of them needs is prefetched before any of
+ * them is looked up.
+ */
+size_t
+bloom_query_many(const bloom *bf, const hash_key *keys, size_t n,
+    int *results)
+{
+	struct filter_hash fh[FILTER_PREFETCH];
+	size_t i, j, m, count;
+	int r;
+
+	for (i = count = 0; i < n; i += m) {
+		m = n - i < FILTER_PREFETCH ? n - i : FILTER_PREFETCH;
+		for (j = 0; j < m; ++j) {
+			filter_hash(keys[i + j].data, keys[i + j].len,
+			    bf->seed, &fh[j]);
+			filter_prefetch(bloom_first(bf, &fh[j]));
+		}
+		for (j = 0; j < m; ++j) {
+			r = bloom_test(bf, &fh[j]);
+			if (results != NULL)
+				results[i + j] = r;
+			count += r;
+		}
+	}
+	return (count);
+}
@@ -0,0 +1,102 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <cryb/bitwise.h>
+#include <cryb/hash.h>
+
+#include "cryb_hash_impl.h"
+#include "cryb_rolling_table.h"
+
+/*
+ * Buzhash (cyclic polynomial hashing), as described by Uzgalis and by
+ * Lemire and Kaser.  Each byte is replaced by an entry from a table of
+ * random words and the hash of a string is the exclusive or of those
+ * entries, each rotated by its distance from the end of the string.
+ * Appending a byte rotates the hash by one position, and removing the
+ * first byte of a string of length len cancels its entry, which has
+ * by then been rotated len - 1 times.
+ */
+
+void
+buzhash_init(buzhash_ctx *ctx)
+{
+
+	ctx->h = 0;
+}
+
+void
+buzhash_update(buzhash_ctx *ctx, const void *data, size_t len)
+{
+	const uint8_t *bytes;
+	uint64_t h;
+
+	bytes = data;
+	h = ctx->h;
+	while (len--)
+		h = rol64(h, 1) ^ rolling_table[*bytes++];
+	ctx->h = h;
+}
+
+uint64_t
+buzhash_final(buzhash_ctx *ctx)
+{
+
+	return (ctx->h);
+}
+
+void
+buzhash_roll_in(buzhash_ctx *ctx, uint8_t in)
+{
+
+	ctx->h = rol64(ctx->h, 1) ^ rolling_table[in];
+}
+
+void
+buzhash_roll_out(buzhash_ctx *ctx, uint8_t out, uint64_t len)
+{
+
+	ctx->h ^= rol64(rolling_table[out], (len - 1) % 64);
+}
+
+uint64_t
+buzhash_hash(const void *data, size_t len)
+{
+	buzhash_ctx ctx;
+
+	buzhash_init(&ctx);
+	buzhash_update(&ctx, data, len);
+	return (buzhash_final(&ctx));
+}
+
+CRYB_HASH_ALGORITHM_UNKEYED(buzhash, "buzhash", buzhash_ctx, uint64_t);
@@ -0,0 +1,165 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cryb/cdc.h>
+
+#include "cryb_rolling_table.h"
+
+/*
+ * FastCDC, as described by Xia et al.  A Gear hash is rolled over the
+ * data, shifting the fingerprint left by one bit per byte so that each
+ * byte falls out of it 64 bytes later, and a chunk ends wherever the
+ * top bits of the fingerprint are all zero.
+ *
+ * The first min - 1 bytes of each chunk are skipped without hashing,
+ * since no boundary can fall there.  Chunk sizes are normalized by
+ * requiring two more zero bits than the average size calls for until
+ * the chunk reaches the average size, and two fewer after that, which
+ * makes chunks much less likely to be very short or to hit the maximum.
+ *
+ * All state is kept in the context, so the boundaries found do not
+ * depend on how the input is split across calls.
+ */
+#define CDC_NORMALIZATION	2
+
+int
+cdc_init(cdc_ctx *ctx, size_t min, size_t avg, size_t max)
+{
+	unsigned int bits;
+
+	if (avg < CDC_MIN_AVG_SIZE || avg > CDC_MAX_AVG_SIZE ||
+	    (avg & (avg - 1)) != 0 || min > avg || max < avg) {
+		errno = EINVAL;
+		return (-1);
+	}
+	for (bits = 0; (1UL << bits) < avg; ++bits)
+		/* nothing */ ;
+	ctx->min = min;
+	ctx->avg = avg;
+	ctx->max = max;
+	ctx->mask_s = ~0ULL << (64 - bits - CDC_NORMALIZATION);
+	ctx->mask_l = ~0ULL << (64 - bits + CDC_NORMALIZATION);
+	cdc_reset(ctx);
+	return (0);
+}
+
+void
+cdc_reset(cdc_ctx *ctx)
+{
+
+	ctx->fp = 0;
+	ctx->pos = 0;
+}
+
+/*
+ * Scan for the end of the current chunk.  Return the number of bytes up
+ * to and including the last byte of the chunk, or 0 if the chunk does
+ * not end within the buffer, in which case the whole buffer has been
+ * consumed.
+ */
+size_t
+cdc_next(cdc_ctx *ctx, const void *data, size_t len)
+{
+	const uint8_t *start, *p, *q;
+	uint64_t fp;
+	size_t n, pos;
+
+	start = p = data;
+	pos = ctx->pos;
+	fp = ctx->fp;
+	/* skip ahead to the shortest permissible chunk */
+	if (pos + 1 < ctx->min) {
+		n = ctx->min - pos - 1;
+		if (n >= len) {
+			ctx->pos = pos + len;
+			return (0);
+		}
+		p += n;
+		len -= n;
+		pos += n;
+	}
+	/* strict mask up to the average size */
+	n = pos < ctx->avg ? ctx->avg - pos : 0;
+	if (n > len)
+		n = len;
+	for (q = p + n; p < q; ++p) {
+		fp = (fp << 1) + rolling_table[*p];
+		if ((fp & ctx->mask_s) == 0)
+			goto boundary;
+	}
+	len -= n;
+	pos += n;
+	/* lenient mask up to the maximum size */
+	n = ctx->max - pos;
+	if (n > len)
+		n = len;
+	for (q = p + n; p < q; ++p) {
+		fp = (fp << 1) + rolling_table[*p];
+		if ((fp & ctx->mask_l) == 0)
+			goto boundary;
+	}
+	pos += n;
+	if (pos < ctx->max) {
+		ctx->fp = fp;
+		ctx->pos = pos;
+		return (0);
+	}
+	--p;
+boundary:
+	cdc_reset(ctx);
+	return (p - start + 1);
+}
+
+/*
+ * Scan a buffer for the ends of up to n chunks and store their offsets
+ * from the start of the buffer in the array pointed to by ends.  Return
+ * the number of chunk ends found.  If that is less than n, the entire
+ * buffer was consumed; otherwise, scanning stopped at ends[n - 1].
+ */
+size_t
+cdc_scan(cdc_ctx *ctx, const void *data, size_t len, size_t *ends, size_t n)
+{
+	const uint8_t *bytes;
+	size_t i, off, m;
+
+	bytes = data;
+	for (i = 0, off = 0; i < n && off < len; ++i) {
+		if ((m = cdc_next(ctx, bytes + off, len - off)) == 0)
+			break;
+		off += m;
+		ends[i] = off;
+	}
+	return (i);
+}
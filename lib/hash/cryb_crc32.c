@@ -0,0 +1,249 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE4_2__) && defined(__x86_64__)
+#include <nmmintrin.h>
+#define CRC32C_HW 1
+#endif
+
+#include <cryb/endian.h>
+#include <cryb/hash.h>
+
+#include "cryb_crc32_tables.h"
+#include "cryb_hash_impl.h"
+
+/*
+ * Implementation of CRC-32 (as used by Ethernet, zlib and many others)
+ * and CRC-32C (as used by iSCSI, SCTP and ext4).  Both are reflected,
+ * with an initial value and final XOR of 0xffffffff.
+ *
+ * The portable implementation uses the slicing-by-8 technique, which
+ * processes eight bytes per iteration with eight table lookups.  When
+ * compiled for a target that supports SSE4.2, CRC-32C uses the crc32
+ * instruction instead.
+ */
+
+#define CRC32_POLY	0xedb88320U
+#define CRC32C_POLY	0x82f63b78U
+
+static inline uint32_t
+crc32_slice8(const uint32_t (*table)[256], uint32_t crc,
+    const uint8_t *p, size_t len)
+{
+	uint32_t w0, w1;
+
+	while (len > 0 && ((uintptr_t)p & 7) != 0) {
+		crc = table[0][(crc ^ *p++) & 0xff] ^ crc >> 8;
+		len--;
+	}
+	for (; len >= 8; p += 8, len -= 8) {
+		w0 = le32dec(p) ^ crc;
+		w1 = le32dec(p + 4);
+		crc = table[7][w0 & 0xff] ^
+		    table[6][(w0 >> 8) & 0xff] ^
+		    table[5][(w0 >> 16) & 0xff] ^
+		    table[4][w0 >> 24] ^
+		    table[3][w1 & 0xff] ^
+		    table[2][(w1 >> 8) & 0xff] ^
+		    table[1][(w1 >> 16) & 0xff] ^
+		    table[0][w1 >> 24];
+	}
+	while (len-- > 0)
+		crc = table[0][(crc ^ *p++) & 0xff] ^ crc >> 8;
+	return (crc);
+}
+
+#if CRC32C_HW
+static inline uint32_t
+crc32c_hw(uint32_t crc, const uint8_t *p, size_t len)
+{
+	uint64_t crc64, w;
+
+	while (len > 0 && ((uintptr_t)p & 7) != 0) {
+		crc = _mm_crc32_u8(crc, *p++);
+		len--;
+	}
+	for (crc64 = crc; len >= 8; p += 8, len -= 8) {
+		memcpy(&w, p, sizeof w);
+		crc64 = _mm_crc32_u64(crc64, w);
+	}
+	for (crc = (uint32_t)crc64; len > 0; len--)
+		crc = _mm_crc32_u8(crc, *p++);
+	return (crc);
+}
+#endif
+
+/*
+ * Multiply two polynomials modulo the CRC polynomial.  Both are in
+ * reflected form, i.e. the coefficient of x^0 is in the high bit.
+ */
+static uint32_t
+crc32_multmodp(uint32_t a, uint32_t b, uint32_t poly)
+{
+	uint32_t m, p;
+
+	for (m = 1U << 31, p = 0; m != 0; m >>= 1) {
+		if (a & m)
+			p ^= b;
+		b = b & 1 ? b >> 1 ^ poly : b >> 1;
+	}
+	return (p);
+}
+
+/*
+ * Compute x^(8 len) modulo the CRC polynomial, i.e. the operator which
+ * appends len zero bytes to a message, by repeated squaring.
+ */
+static uint32_t
+crc32_x8nmodp(uint64_t len, uint32_t poly)
+{
+	uint32_t p, x2n;
+
+	/* x^8, since len counts bytes */
+	x2n = 1U << 23;
+	for (p = 1U << 31; len > 0; len >>= 1) {
+		if (len & 1)
+			p = crc32_multmodp(x2n, p, poly);
+		x2n = crc32_multmodp(x2n, x2n, poly);
+	}
+	return (p);
+}
+
+/*
+ * Given the CRCs of two adjacent pieces of data and the length of the
+ * second, compute the CRC of their concatenation.  The CRC of the first
+ * piece is advanced past len2 zero bytes, which cancels out the initial
+ * value of the second; the two are then simply XORed together.
+ */
+static inline uint32_t
+crc32_combine_poly(uint32_t crc1, uint32_t crc2, uint64_t len2,
+    uint32_t poly)
+{
+
+	return (crc32_multmodp(crc32_x8nmodp(len2, poly), crc1, poly) ^ crc2);
+}
+
+/***************************************************************************
+ * CRC-32
+ */
+
+void
+crc32_init(crc32_ctx *ctx)
+{
+
+	ctx->crc = 0xffffffffU;
+}
+
+void
+crc32_update(crc32_ctx *ctx, const void *data, size_t len)
+{
+
+	ctx->crc = crc32_slice8(crc32_table, ctx->crc, data, len);
+}
+
+uint32_t
+crc32_final(crc32_ctx *ctx)
+{
+
+	return (ctx->crc ^ 0xffffffffU);
+}
+
+uint32_t
+crc32_combine(uint32_t crc1, uint32_t crc2, uint64_t len2)
+{
+
+	return (crc32_combine_poly(crc1, crc2, len2, CRC32_POLY));
+}
+
+uint32_t
+crc32_hash(const void *data, size_t len)
+{
+
+	return (crc32_slice8(crc32_table, 0xffffffffU, data, len) ^
+	    0xffffffffU);
+}
+
+CRYB_HASH_ALGORITHM_UNKEYED(crc32, "crc32", crc32_ctx, uint32_t);
+
+/***************************************************************************
+ * CRC-32C
+ */
+
+static inline uint32_t
+crc32c_update_raw(uint32_t crc, const void *data, size_t len)
+{
+
+#if CRC32C_HW
+	return (crc32c_hw(crc, data, len));
+#else
+	return (crc32_slice8(crc32c_table, crc, data, len));
+#endif
+}
+
+void
+crc32c_init(crc32_ctx *ctx)
+{
+
+	ctx->crc = 0xffffffffU;
+}
+
+void
+crc32c_update(crc32_ctx *ctx, const void *data, size_t len)
+{
+
+	ctx->crc = crc32c_update_raw(ctx->crc, data, len);
+}
+
+uint32_t
+crc32c_final(crc32_ctx *ctx)
+{
+
+	return (ctx->crc ^ 0xffffffffU);
+}
+
+uint32_t
+crc32c_combine(uint32_t crc1, uint32_t crc2, uint64_t len2)
+{
+
+	return (crc32_combine_poly(crc1, crc2, len2, CRC32C_POLY));
+}
+
+uint32_t
+crc32c_hash(const void *data, size_t len)
+{
+
+	return (crc32c_update_raw(0xffffffffU, data, len) ^ 0xffffffffU);
+}
+
+CRYB_HASH_ALGORITHM_UNKEYED(crc32c, "crc32c", crc32_ctx, uint32_t);
@@ -0,0 +1,421 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cryb/endian.h>
+#include <cryb/hash.h>
+#include <cryb/filter.h>
+
+#include "cryb_filter_impl.h"
+
+/*
+ * Cuckoo filter as described by Fan, Andersen, Kaminsky and
+ * Mitzenmacher, with four 16-bit fingerprints per bucket.
+ *
+ * The first bucket for a key is selected by h1 and its fingerprint is
+ * taken from h2.  The alternate bucket is obtained by xoring the index
+ * with a hash of the fingerprint, so it can be computed from either
+ * bucket without knowing the key.  A fingerprint of zero denotes an
+ * empty slot.
+ *
+ * When both buckets are full, a random entry is evicted and moved to
+ * its alternate bucket, and so on until an empty slot is found or
+ * MAX_KICKS entries have been moved.  In the latter case, the last
+ * evicted entry is kept aside as the victim, and the filter accepts no
+ * more keys until a removal makes room for it.
+ */
+
+#define BUCKET_SLOTS	4
+#define BUCKET_LEN	(BUCKET_SLOTS * 2)
+#define MAX_KICKS	500
+
+/* maximum load, in percent, before doubling the number of buckets */
+#define MAX_LOAD	96
+
+struct cryb_cuckoo {
+	void		*base;		/* allocation, NULL if loaded */
+	uint8_t		*image;		/* header and data */
+	uint8_t		*buckets;	/* data */
+	uint64_t	 mask;		/* number of buckets - 1 */
+	uint32_t	 seed;		/* MurmurHash3 seed */
+	uint32_t	 rnd;		/* eviction PRNG state */
+};
+
+static inline uint16_t
+cuckoo_fingerprint(const struct filter_hash *fh)
+{
+	uint16_t fp;
+
+	fp = (uint16_t)(fh->h2 >> 48);
+	return (fp != 0 ? fp : 1);
+}
+
+static inline uint64_t
+cuckoo_alt(const cuckoo *cf, uint64_t i, uint16_t fp)
+{
+
+	return ((i ^ (fp * 0x5bd1e995U)) & cf->mask);
+}
+
+static inline uint8_t *
+cuckoo_bucket(const cuckoo *cf, uint64_t i)
+{
+
+	return (cf->buckets + i * BUCKET_LEN);
+}
+
+/*
+ * Store a fingerprint in the first empty slot in a bucket.
+ */
+static int
+cuckoo_bucket_put(uint8_t *b, uint16_t fp)
+{
+	unsigned int j;
+
+	for (j = 0; j < BUCKET_SLOTS; ++j) {
+		if (le16dec(b + j * 2) == 0) {
+			le16enc(b + j * 2, fp);
+			return (1);
+		}
+	}
+	return (0);
+}
+
+/*
+ * Remove one instance of a fingerprint from a bucket.
+ */
+static int
+cuckoo_bucket_del(uint8_t *b, uint16_t fp)
+{
+	unsigned int j;
+
+	for (j = 0; j < BUCKET_SLOTS; ++j) {
+		if (le16dec(b + j * 2) == fp) {
+			le16enc(b + j * 2, 0);
+			return (1);
+		}
+	}
+	return (0);
+}
+
+static inline int
+cuckoo_bucket_has(const uint8_t *b, uint16_t fp)
+{
+
+	return (le16dec(b) == fp || le16dec(b + 2) == fp ||
+	    le16dec(b + 4) == fp || le16dec(b + 6) == fp);
+}
+
+/*
+ * Victim and count, which live in the header
+ */
+static inline uint16_t
+cuckoo_victim(const cuckoo *cf, uint64_t *i)
+{
+
+	*i = le64dec(cf->image + FILTER_OFF_VICTIM_IDX);
+	return ((uint16_t)le32dec(cf->image + FILTER_OFF_VICTIM));
+}
+
+static inline void
+cuckoo_set_victim(cuckoo *cf, uint64_t i, uint16_t fp)
+{
+
+	le32enc(cf->image + FILTER_OFF_VICTIM, fp);
+	le64enc(cf->image + FILTER_OFF_VICTIM_IDX, i);
+}
+
+static inline void
+cuckoo_adjust_count(cuckoo *cf, int delta)
+{
+	uint8_t *p = cf->image + FILTER_OFF_COUNT;
+
+	le64enc(p, le64dec(p) + (uint64_t)(int64_t)delta);
+}
+
+static void
+cuckoo_init(cuckoo *cf, uint8_t *image, uint64_t nbuckets)
+{
+
+	cf->image = image;
+	cf->buckets = image + FILTER_HEADER_LEN;
+	cf->mask = nbuckets - 1;
+	cf->seed = le32dec(image + FILTER_OFF_SEED);
+	cf->rnd = cf->seed | 1;
+}
+
+/*
+ * Allocate a new filter with room for at least the given number of
+ * keys.
+ */
+cuckoo *
+cuckoo_new(size_t capacity, uint32_t seed)
+{
+	cuckoo *cf;
+	uint8_t *image;
+	uint64_t nbuckets;
+
+	if (capacity == 0 || capacity > SIZE_MAX / 4 / BUCKET_LEN) {
+		errno = EINVAL;
+		return (NULL);
+	}
+	for (nbuckets = 1; nbuckets * BUCKET_SLOTS < capacity; nbuckets *= 2)
+		/* nothing */ ;
+	if (capacity * 100 > nbuckets * BUCKET_SLOTS * MAX_LOAD)
+		nbuckets *= 2;
+	if ((cf = calloc(1, sizeof *cf)) == NULL)
+		return (NULL);
+	image = filter_image_new(nbuckets * BUCKET_LEN, FILTER_TYPE_CUCKOO,
+	    nbuckets, seed, &cf->base);
+	if (image == NULL) {
+		free(cf);
+		return (NULL);
+	}
+	cuckoo_init(cf, image, nbuckets);
+	return (cf);
+}
+
+/*
+ * Create a filter from an image previously obtained from cuckoo_image().
+ * The image is used in place and must remain valid for the lifetime of
+ * the filter.
+ */
+cuckoo *
+cuckoo_load(void *buf, size_t len)
+{
+	uint8_t *image = buf;
+	cuckoo *cf;
+	uint64_t nbuckets;
+
+	if (filter_image_type(image, len) != FILTER_TYPE_CUCKOO) {
+		errno = EINVAL;
+		return (NULL);
+	}
+	nbuckets = le64dec(image + FILTER_OFF_SIZE);
+	if (nbuckets == 0 || (nbuckets & (nbuckets - 1)) != 0 ||
+	    nbuckets > (len - FILTER_HEADER_LEN) / BUCKET_LEN ||
+	    nbuckets * BUCKET_LEN != len - FILTER_HEADER_LEN ||
+	    le64dec(image + FILTER_OFF_VICTIM_IDX) >= nbuckets) {
+		errno = EINVAL;
+		return (NULL);
+	}
+	if ((cf = calloc(1, sizeof *cf)) == NULL)
+		return (NULL);
+	cuckoo_init(cf, image, nbuckets);
+	return (cf);
+}
+
+/*
+ * Delete a filter
+ */
+void
+cuckoo_delete(cuckoo *cf)
+{
+
+	if (cf != NULL) {
+		free(cf->base);
+		free(cf);
+	}
+}
+
+/*
+ * Return the image of a filter and its length
+ */
+const void *
+cuckoo_image(const cuckoo *cf, size_t *len)
+{
+
+	*len = FILTER_HEADER_LEN + (cf->mask + 1) * BUCKET_LEN;
+	return (cf->image);
+}
+
+/*
+ * Return the number of keys in a filter
+ */
+size_t
+cuckoo_count(const cuckoo *cf)
+{
+
+	return (le64dec(cf->image + FILTER_OFF_COUNT));
+}
+
+/*
+ * Insert a fingerprint into either of its buckets, evicting other
+ * entries if necessary.
+ */
+static void
+cuckoo_insert(cuckoo *cf, uint64_t i, uint16_t fp)
+{
+	uint8_t *b;
+	uint16_t evicted;
+	unsigned int j, n;
+
+	if (cuckoo_bucket_put(cuckoo_bucket(cf, i), fp))
+		return;
+	i = cuckoo_alt(cf, i, fp);
+	if (cuckoo_bucket_put(cuckoo_bucket(cf, i), fp))
+		return;
+	for (n = 0; n < MAX_KICKS; ++n) {
+		/* xorshift32 */
+		cf->rnd ^= cf->rnd << 13;
+		cf->rnd ^= cf->rnd >> 17;
+		cf->rnd ^= cf->rnd << 5;
+		j = cf->rnd % BUCKET_SLOTS;
+		b = cuckoo_bucket(cf, i);
+		evicted = le16dec(b + j * 2);
+		le16enc(b + j * 2, fp);
+		fp = evicted;
+		i = cuckoo_alt(cf, i, fp);
+		if (cuckoo_bucket_put(cuckoo_bucket(cf, i), fp))
+			return;
+	}
+	cuckoo_set_victim(cf, i, fp);
+}
+
+/*
+ * Add a key to a filter.  Returns -1 if the filter is full.
+ */
+int
+cuckoo_add(cuckoo *cf, const void *key, size_t len)
+{
+	struct filter_hash fh;
+	uint64_t vi;
+
+	if (cuckoo_victim(cf, &vi) != 0) {
+		errno = ENOSPC;
+		return (-1);
+	}
+	filter_hash(key, len, cf->seed, &fh);
+	cuckoo_insert(cf, fh.h1 & cf->mask, cuckoo_fingerprint(&fh));
+	cuckoo_adjust_count(cf, 1);
+	return (0);
+}
+
+/*
+ * Remove a key from a filter.  Returns -1 if it was not found.  Note
+ * that removing a key which was never added may remove another key
+ * with the same fingerprint.
+ */
+int
+cuckoo_remove(cuckoo *cf, const void *key, size_t len)
+{
+	struct filter_hash fh;
+	uint64_t i1, i2, vi;
+	uint16_t fp, vfp;
+
+	filter_hash(key, len, cf->seed, &fh);
+	fp = cuckoo_fingerprint(&fh);
+	i1 = fh.h1 & cf->mask;
+	i2 = cuckoo_alt(cf, i1, fp);
+	vfp = cuckoo_victim(cf, &vi);
+	if (vfp == fp && (vi == i1 || vi == i2)) {
+		cuckoo_set_victim(cf, 0, 0);
+	} else if (cuckoo_bucket_del(cuckoo_bucket(cf, i1), fp) ||
+	    cuckoo_bucket_del(cuckoo_bucket(cf, i2), fp)) {
+		/* there is room for the victim now */
+		if (vfp != 0) {
+			cuckoo_set_victim(cf, 0, 0);
+			cuckoo_insert(cf, vi, vfp);
+		}
+	} else {
+		errno = ENOENT;
+		return (-1);
+	}
+	cuckoo_adjust_count(cf, -1);
+	return (0);
+}
+
+static inline int
+cuckoo_test(const cuckoo *cf, const struct filter_hash *fh)
+{
+	uint64_t i1, i2, vi;
+	uint16_t fp, vfp;
+
+	fp = cuckoo_fingerprint(fh);
+	i1 = fh->h1 & cf->mask;
+	i2 = cuckoo_alt(cf, i1, fp);
+	if (cuckoo_bucket_has(cuckoo_bucket(cf, i1), fp) ||
+	    cuckoo_bucket_has(cuckoo_bucket(cf, i2), fp))
+		return (1);
+	vfp = cuckoo_victim(cf, &vi);
+	return (vfp == fp && (vi == i1 || vi == i2));
+}
+
+/*
+ * Return 1 if a key may be present in a filter and 0 if it definitely
+ * is not.
+ */
+int
+cuckoo_query(const cuckoo *cf, const void *key, size_t len)
+{
+	struct filter_hash fh;
+
+	filter_hash(key, len, cf->seed, &fh);
+	return (cuckoo_test(cf, &fh));
+}
+
+/*
+ * Query multiple keys; see bloom_query_many().  Both candidate buckets
+ * of each key are prefetched.
+ */
+size_t
+cuckoo_query_many(const cuckoo *cf, const hash_key *keys, size_t n,
+    int *results)
+{
+	struct filter_hash fh[FILTER_PREFETCH];
+	size_t i, j, m, count;
+	uint64_t i1;
+	int r;
+
+	for (i = count = 0; i < n; i += m) {
+		m = n - i < FILTER_PREFETCH ? n - i : FILTER_PREFETCH;
+		for (j = 0; j < m; ++j) {
+			filter_hash(keys[i + j].data, keys[i + j].len,
+			    cf->seed, &fh[j]);
+			i1 = fh[j].h1 & cf->mask;
+			filter_prefetch(cuckoo_bucket(cf, i1));
+			filter_prefetch(cuckoo_bucket(cf, cuckoo_alt(cf, i1,
+			    cuckoo_fingerprint(&fh[j]))));
+		}
+		for (j = 0; j < m; ++j) {
+			r = cuckoo_test(cf, &fh[j]);
+			if (results != NULL)
+				results[i + j] = r;
+			count += r;
+		}
+	}
+	return (count);
+}
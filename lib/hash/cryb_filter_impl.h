@@ -0,0 +1,131 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CRYB_FILTER_IMPL_H_INCLUDED
+#define CRYB_FILTER_IMPL_H_INCLUDED
+
+/*
+ * Layout of the filter header.  All fields are little-endian.
+ *
+ *  0  magic		"CRYBFLTR"
+ *  8  type		FILTER_TYPE_*
+ * 12  nhashes		number of hash functions (Bloom only)
+ * 16  size		number of bits or buckets
+ * 24  seed		MurmurHash3 seed
+ * 28  victim		fingerprint of the evicted entry (cuckoo only)
+ * 32  victim index	bucket of the evicted entry (cuckoo only)
+ * 40  count		number of entries (cuckoo only)
+ * 48  reserved		zero
+ */
+#define FILTER_MAGIC		"CRYBFLTR"
+#define FILTER_MAGIC_LEN	8
+#define FILTER_OFF_TYPE		8
+#define FILTER_OFF_NHASHES	12
+#define FILTER_OFF_SIZE		16
+#define FILTER_OFF_SEED		24
+#define FILTER_OFF_VICTIM	28
+#define FILTER_OFF_VICTIM_IDX	32
+#define FILTER_OFF_COUNT	40
+
+#define FILTER_TYPE_BLOOM	1
+#define FILTER_TYPE_BLOCKED	2
+#define FILTER_TYPE_CUCKOO	3
+
+/* alignment of the image, and size of a blocked Bloom filter block */
+#define FILTER_ALIGN		64
+
+/* number of keys hashed ahead of the one being looked up */
+#define FILTER_PREFETCH		8
+
+#if HAVE___BUILTIN_PREFETCH
+#define filter_prefetch(p)	__builtin_prefetch(p)
+#else
+#define filter_prefetch(p)	((void)(p))
+#endif
+
+/*
+ * Both halves of the 128-bit MurmurHash3 of a key
+ */
+struct filter_hash {
+	uint64_t	h1, h2;
+};
+
+static inline void
+filter_hash(const void *key, size_t len, uint32_t seed, struct filter_hash *fh)
+{
+	uint8_t out[MURMUR3_128_HASH_LEN];
+
+	murmur3_x64_128_hash(key, len, seed, out);
+	fh->h1 = le64dec(out);
+	fh->h2 = le64dec(out + 8);
+}
+
+/*
+ * Allocate a zeroed image of the given data length, aligned to
+ * FILTER_ALIGN, and fill in the common parts of its header.  The
+ * pointer which must eventually be freed is returned in *base.
+ */
+static inline uint8_t *
+filter_image_new(size_t datalen, uint32_t type, uint64_t size, uint32_t seed,
+    void **base)
+{
+	uint8_t *image;
+
+	if (datalen > SIZE_MAX - FILTER_HEADER_LEN - FILTER_ALIGN) {
+		errno = ENOMEM;
+		return (NULL);
+	}
+	if ((*base = calloc(1, FILTER_HEADER_LEN + datalen + FILTER_ALIGN)) ==
+	    NULL)
+		return (NULL);
+	image = (uint8_t *)*base + FILTER_ALIGN -
+	    (uintptr_t)*base % FILTER_ALIGN;
+	memcpy(image, FILTER_MAGIC, FILTER_MAGIC_LEN);
+	le32enc(image + FILTER_OFF_TYPE, type);
+	le64enc(image + FILTER_OFF_SIZE, size);
+	le32enc(image + FILTER_OFF_SEED, seed);
+	return (image);
+}
+
+/*
+ * Check that an image has a valid header and return its type.
+ */
+static inline int
+filter_image_type(const uint8_t *image, size_t len)
+{
+
+	if (len < FILTER_HEADER_LEN ||
+	    memcmp(image, FILTER_MAGIC, FILTER_MAGIC_LEN) != 0) {
+		errno = EINVAL;
+		return (-1);
+	}
+	return ((int)le32dec(image + FILTER_OFF_TYPE));
+}
+
+#endif
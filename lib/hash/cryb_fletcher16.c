@@ -36,21 +36,68 @@
 #include <cryb/endian.h>
 #include <cryb/hash.h>
 
+#include "cryb_hash_impl.h"
+
 /*
  * Simple implementation of the 16-bit variant of Fletcher's checksum,
  * described in Fletcher, J. G. (January 1982), "An Arithmetic Checksum
  * for Serial Transmissions", IEEE Transactions on Communications. COM-30
  * (1): 247–252, doi:10.1109/tcom.1982.1095369
  */
-uint16_t
-fletcher16_hash(const void *data, size_t len)
+void
+fletcher16_init(fletcher16_ctx *ctx)
+{
+
+	ctx->c0 = ctx->c1 = 0;
+}
+
+void
+fletcher16_update(fletcher16_ctx *ctx, const void *data, size_t len)
 {
 	const uint8_t *bytes;
 	uint16_t c0, c1;
 
-	for (bytes = data, c0 = c1 = 0; len > 0; len--, bytes++) {
+	c0 = ctx->c0;
+	c1 = ctx->c1;
+	for (bytes = data; len > 0; len--, bytes++) {
 		c0 = (c0 + *bytes) % 0xffU;
 		c1 = (c1 + c0) % 0xffU;
 	}
-	return (c1 << 8 | c0);
+	ctx->c0 = c0;
+	ctx->c1 = c1;
+}
+
+uint16_t
+fletcher16_final(fletcher16_ctx *ctx)
+{
+
+	return (ctx->c1 << 8 | ctx->c0);
+}
+
+/*
+ * Given the checksums of two adjacent pieces of data and the length of
+ * the second, compute the checksum of their concatenation.
+ */
+uint16_t
+fletcher16_combine(uint16_t sum1, uint16_t sum2, uint64_t len2)
+{
+	uint64_t c0, c1, n;
+
+	n = (len2) % 0xffU;
+	c0 = ((sum1 & 0xff) + (sum2 & 0xff)) % 0xffU;
+	c1 = ((sum1 >> 8) + (sum2 >> 8) +
+	    n * (sum1 & 0xff) % 0xffU) % 0xffU;
+	return ((uint16_t)(c1 << 8 | c0));
 }
+
+uint16_t
+fletcher16_hash(const void *data, size_t len)
+{
+	fletcher16_ctx ctx;
+
+	fletcher16_init(&ctx);
+	fletcher16_update(&ctx, data, len);
+	return (fletcher16_final(&ctx));
+}
+
+CRYB_HASH_ALGORITHM_UNKEYED(fletcher16, "fletcher16", fletcher16_ctx, uint16_t);
@@ -36,6 +36,8 @@
 #include <cryb/endian.h>
 #include <cryb/hash.h>
 
+#include "cryb_hash_impl.h"
+
 /*
  * Simple implementation of the 32-bit variant of Fletcher's checksum,
  * described in Fletcher, J. G. (January 1982), "An Arithmetic Checksum
@@ -45,24 +47,95 @@
  * The paper assumes that the input length is a multiple of the checksum
  * algorithm's word size (half the checksum size).  This implementation
  * will zero-pad the input up to the nearest multiple of the word size.
+ *
+ * The streaming interface holds back a trailing odd byte until either
+ * more data or the end of the input is reached.
  */
-uint32_t
-fletcher32_hash(const void *data, size_t len)
+void
+fletcher32_init(fletcher32_ctx *ctx)
+{
+
+	ctx->c0 = ctx->c1 = 0;
+	ctx->buflen = 0;
+}
+
+void
+fletcher32_update(fletcher32_ctx *ctx, const void *data, size_t len)
 {
 	const uint8_t *bytes;
 	uint32_t c0, c1;
 	uint16_t w;
 
-	for (bytes = data, c0 = c1 = 0; len > 1; len -= 2, bytes += 2) {
+	if (len == 0)
+		return;
+	bytes = data;
+	c0 = ctx->c0;
+	c1 = ctx->c1;
+	if (ctx->buflen > 0) {
+		w = ctx->buf[0] << 8 | bytes[0];
+		c0 = (c0 + w) % 0xffffU;
+		c1 = (c1 + c0) % 0xffffU;
+		ctx->buflen = 0;
+		bytes++;
+		len--;
+	}
+	for (; len > 1; len -= 2, bytes += 2) {
 		/* replace with be16toh() if input is aligned */
 		w = be16dec(bytes);
 		c0 = (c0 + w) % 0xffffU;
 		c1 = (c1 + c0) % 0xffffU;
 	}
 	if (len > 0) {
-		w = bytes[0] << 8;
-		c0 = (c0 + w) % 0xffffffffU;
-		c1 = (c1 + c0) % 0xffffffffU;
+		ctx->buf[0] = bytes[0];
+		ctx->buflen = 1;
+	}
+	ctx->c0 = c0;
+	ctx->c1 = c1;
+}
+
+uint32_t
+fletcher32_final(fletcher32_ctx *ctx)
+{
+	uint32_t c0, c1;
+	uint16_t w;
+
+	c0 = ctx->c0;
+	c1 = ctx->c1;
+	if (ctx->buflen > 0) {
+		w = ctx->buf[0] << 8;
+		c0 = (c0 + w) % 0xffffU;
+		c1 = (c1 + c0) % 0xffffU;
 	}
 	return (c1 << 16 | c0);
 }
+
+/*
+ * Given the checksums of two adjacent pieces of data and the length of
+ * the second, compute the checksum of their concatenation.  The length
+ * of the first piece must be a multiple of the word size (2 bytes),
+ * since a partial word at the end of the first piece would be padded
+ * rather than continued by the second.
+ */
+uint32_t
+fletcher32_combine(uint32_t sum1, uint32_t sum2, uint64_t len2)
+{
+	uint64_t c0, c1, n;
+
+	n = ((len2 + 1) / 2) % 0xffffU;
+	c0 = ((sum1 & 0xffff) + (sum2 & 0xffff)) % 0xffffU;
+	c1 = ((sum1 >> 16) + (sum2 >> 16) +
+	    n * (sum1 & 0xffff) % 0xffffU) % 0xffffU;
+	return ((uint32_t)(c1 << 16 | c0));
+}
+
+uint32_t
+fletcher32_hash(const void *data, size_t len)
+{
+	fletcher32_ctx ctx;
+
+	fletcher32_init(&ctx);
+	fletcher32_update(&ctx, data, len);
+	return (fletcher32_final(&ctx));
+}
+
+CRYB_HASH_ALGORITHM_UNKEYED(fletcher32, "fletcher32", fletcher32_ctx, uint32_t);
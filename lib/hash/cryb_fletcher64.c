@@ -36,6 +36,8 @@
 #include <cryb/endian.h>
 #include <cryb/hash.h>
 
+#include "cryb_hash_impl.h"
+
 /*
  * Simple implementation of the 64-bit variant of Fletcher's checksum,
  * described in Fletcher, J. G. (January 1982), "An Arithmetic Checksum
@@ -45,28 +47,99 @@
  * The paper assumes that the input length is a multiple of the checksum
  * algorithm's word size (half the checksum size).  This implementation
  * will zero-pad the input up to the nearest multiple of the word size.
+ *
+ * The streaming interface holds back up to three trailing bytes until
+ * either more data or the end of the input is reached.
  */
-uint64_t
-fletcher64_hash(const void *data, size_t len)
+void
+fletcher64_init(fletcher64_ctx *ctx)
+{
+
+	ctx->c0 = ctx->c1 = 0;
+	ctx->buflen = 0;
+}
+
+void
+fletcher64_update(fletcher64_ctx *ctx, const void *data, size_t len)
 {
 	const uint8_t *bytes;
 	uint64_t c0, c1;
 	uint32_t w;
 
-	for (bytes = data, c0 = c1 = 0; len > 3; len -= 4, bytes += 4) {
+	bytes = data;
+	c0 = ctx->c0;
+	c1 = ctx->c1;
+	if (ctx->buflen > 0) {
+		while (ctx->buflen < 4 && len > 0) {
+			ctx->buf[ctx->buflen++] = *bytes++;
+			len--;
+		}
+		if (ctx->buflen < 4)
+			return;
+		w = be32dec(ctx->buf);
+		c0 = (c0 + w) % 0xffffffffU;
+		c1 = (c1 + c0) % 0xffffffffU;
+		ctx->buflen = 0;
+	}
+	for (; len > 3; len -= 4, bytes += 4) {
 		/* replace with be32toh() if input is aligned */
 		w = be32dec(bytes);
 		c0 = (c0 + w) % 0xffffffffU;
 		c1 = (c1 + c0) % 0xffffffffU;
 	}
-	if (len > 0) {
-		w = bytes[0] << 24;
-		if (len > 1)
-			w |= bytes[1] << 16;
-		if (len > 2)
-			w |= bytes[2] << 8;
+	while (len-- > 0)
+		ctx->buf[ctx->buflen++] = *bytes++;
+	ctx->c0 = c0;
+	ctx->c1 = c1;
+}
+
+uint64_t
+fletcher64_final(fletcher64_ctx *ctx)
+{
+	uint64_t c0, c1;
+	uint32_t w;
+
+	c0 = ctx->c0;
+	c1 = ctx->c1;
+	if (ctx->buflen > 0) {
+		w = (uint32_t)ctx->buf[0] << 24;
+		if (ctx->buflen > 1)
+			w |= (uint32_t)ctx->buf[1] << 16;
+		if (ctx->buflen > 2)
+			w |= ctx->buf[2] << 8;
 		c0 = (c0 + w) % 0xffffffffU;
 		c1 = (c1 + c0) % 0xffffffffU;
 	}
 	return (c1 << 32 | c0);
 }
+
+/*
+ * Given the checksums of two adjacent pieces of data and the length of
+ * the second, compute the checksum of their concatenation.  The length
+ * of the first piece must be a multiple of the word size (4 bytes),
+ * since a partial word at the end of the first piece would be padded
+ * rather than continued by the second.
+ */
+uint64_t
+fletcher64_combine(uint64_t sum1, uint64_t sum2, uint64_t len2)
+{
+	uint64_t c0, c1, n;
+
+	n = ((len2 + 3) / 4) % 0xffffffffU;
+	c0 = ((sum1 & 0xffffffff) + (sum2 & 0xffffffff)) % 0xffffffffU;
+	c1 = ((sum1 >> 32) + (sum2 >> 32) +
+	    n * (sum1 & 0xffffffff) % 0xffffffffU) % 0xffffffffU;
+	return ((uint64_t)(c1 << 32 | c0));
+}
+
+uint64_t
+fletcher64_hash(const void *data, size_t len)
+{
+	fletcher64_ctx ctx;
+
+	fletcher64_init(&ctx);
+	fletcher64_update(&ctx, data, len);
+	return (fletcher64_final(&ctx));
+}
+
+CRYB_HASH_ALGORITHM_UNKEYED(fletcher64, "fletcher64", fletcher64_ctx, uint64_t);
@@ -35,79 +35,311 @@
 #include <cryb/hash.h>
 
 #include "cryb_fnv_impl.h"
+#include "cryb_hash_impl.h"
 
 /*
  * Implementations of the 32- and 64-bit Fowler-Noll-Vo (FNV) 0, 1, and 1a hashes.
  */
 
-uint32_t fnv0_32_hash(const void *data, size_t len)
+void
+fnv0_32_init(fnv32_ctx *ctx)
+{
+
+	ctx->h = 0;
+}
+
+void
+fnv0_32_update(fnv32_ctx *ctx, const void *data, size_t len)
 {
 	const uint8_t *p;
 	uint32_t h;
 
-	for (p = data, h = 0; len > 0; ++p, --len) {
+	for (p = data, h = ctx->h; len > 0; ++p, --len) {
 		h *= FNV_32_PRIME;
 		h ^= *p;
 	}
-	return (h);
+	ctx->h = h;
 }
 
-uint64_t fnv0_64_hash(const void *data, size_t len)
+uint32_t
+fnv0_32_final(fnv32_ctx *ctx)
+{
+
+	return (ctx->h);
+}
+
+uint32_t
+fnv0_32_hash(const void *data, size_t len)
+{
+	fnv32_ctx ctx;
+
+	fnv0_32_init(&ctx);
+	fnv0_32_update(&ctx, data, len);
+	return (fnv0_32_final(&ctx));
+}
+
+CRYB_HASH_ALGORITHM_UNKEYED(fnv0_32, "fnv0-32", fnv32_ctx, uint32_t);
+
+void
+fnv0_64_init(fnv64_ctx *ctx)
+{
+
+	ctx->h = 0;
+}
+
+void
+fnv0_64_update(fnv64_ctx *ctx, const void *data, size_t len)
 {
 	const uint8_t *p;
 	uint64_t h;
 
-	for (p = data, h = 0; len > 0; ++p, --len) {
+	for (p = data, h = ctx->h; len > 0; ++p, --len) {
 		h *= FNV_64_PRIME;
 		h ^= *p;
 	}
-	return (h);
+	ctx->h = h;
+}
+
+uint64_t
+fnv0_64_final(fnv64_ctx *ctx)
+{
+
+	return (ctx->h);
 }
 
-uint32_t fnv1_32_hash(const void *data, size_t len)
+uint64_t
+fnv0_64_hash(const void *data, size_t len)
+{
+	fnv64_ctx ctx;
+
+	fnv0_64_init(&ctx);
+	fnv0_64_update(&ctx, data, len);
+	return (fnv0_64_final(&ctx));
+}
+
+CRYB_HASH_ALGORITHM_UNKEYED(fnv0_64, "fnv0-64", fnv64_ctx, uint64_t);
+
+void
+fnv1_32_init(fnv32_ctx *ctx)
+{
+
+	ctx->h = FNV_32_OFFSET_BASIS;
+}
+
+void
+fnv1_32_update(fnv32_ctx *ctx, const void *data, size_t len)
 {
 	const uint8_t *p;
 	uint32_t h;
 
-	for (p = data, h = FNV_32_OFFSET_BASIS; len > 0; ++p, --len) {
+	for (p = data, h = ctx->h; len > 0; ++p, --len) {
 		h *= FNV_32_PRIME;
 		h ^= *p;
 	}
-	return (h);
+	ctx->h = h;
 }
 
-uint64_t fnv1_64_hash(const void *data, size_t len)
+uint32_t
+fnv1_32_final(fnv32_ctx *ctx)
+{
+
+	return (ctx->h);
+}
+
+uint32_t
+fnv1_32_hash(const void *data, size_t len)
+{
+	fnv32_ctx ctx;
+
+	fnv1_32_init(&ctx);
+	fnv1_32_update(&ctx, data, len);
+	return (fnv1_32_final(&ctx));
+}
+
+CRYB_HASH_ALGORITHM_UNKEYED(fnv1_32, "fnv1-32", fnv32_ctx, uint32_t);
+
+void
+fnv1_64_init(fnv64_ctx *ctx)
+{
+
+	ctx->h = FNV_64_OFFSET_BASIS;
+}
+
+void
+fnv1_64_update(fnv64_ctx *ctx, const void *data, size_t len)
 {
 	const uint8_t *p;
 	uint64_t h;
 
-	for (p = data, h = FNV_64_OFFSET_BASIS; len > 0; ++p, --len) {
+	for (p = data, h = ctx->h; len > 0; ++p, --len) {
 		h *= FNV_64_PRIME;
 		h ^= *p;
 	}
-	return (h);
+	ctx->h = h;
+}
+
+uint64_t
+fnv1_64_final(fnv64_ctx *ctx)
+{
+
+	return (ctx->h);
 }
 
-uint32_t fnv1a_32_hash(const void *data, size_t len)
+uint64_t
+fnv1_64_hash(const void *data, size_t len)
+{
+	fnv64_ctx ctx;
+
+	fnv1_64_init(&ctx);
+	fnv1_64_update(&ctx, data, len);
+	return (fnv1_64_final(&ctx));
+}
+
+CRYB_HASH_ALGORITHM_UNKEYED(fnv1_64, "fnv1-64", fnv64_ctx, uint64_t);
+
+void
+fnv1a_32_init(fnv32_ctx *ctx)
+{
+
+	ctx->h = FNV_32_OFFSET_BASIS;
+}
+
+void
+fnv1a_32_update(fnv32_ctx *ctx, const void *data, size_t len)
 {
 	const uint8_t *p;
 	uint32_t h;
 
-	for (p = data, h = FNV_32_OFFSET_BASIS; len > 0; ++p, --len) {
+	for (p = data, h = ctx->h; len > 0; ++p, --len) {
 		h ^= *p;
 		h *= FNV_32_PRIME;
 	}
-	return (h);
+	ctx->h = h;
+}
+
+uint32_t
+fnv1a_32_final(fnv32_ctx *ctx)
+{
+
+	return (ctx->h);
 }
 
-uint64_t fnv1a_64_hash(const void *data, size_t len)
+uint32_t
+fnv1a_32_hash(const void *data, size_t len)
+{
+	fnv32_ctx ctx;
+
+	fnv1a_32_init(&ctx);
+	fnv1a_32_update(&ctx, data, len);
+	return (fnv1a_32_final(&ctx));
+}
+
+CRYB_HASH_ALGORITHM_UNKEYED(fnv1a_32, "fnv1a-32", fnv32_ctx, uint32_t);
+
+void
+fnv1a_64_init(fnv64_ctx *ctx)
+{
+
+	ctx->h = FNV_64_OFFSET_BASIS;
+}
+
+void
+fnv1a_64_update(fnv64_ctx *ctx, const void *data, size_t len)
 {
 	const uint8_t *p;
 	uint64_t h;
 
-	for (p = data, h = FNV_64_OFFSET_BASIS; len > 0; ++p, --len) {
+	for (p = data, h = ctx->h; len > 0; ++p, --len) {
 		h ^= *p;
 		h *= FNV_64_PRIME;
 	}
-	return (h);
+	ctx->h = h;
+}
+
+uint64_t
+fnv1a_64_final(fnv64_ctx *ctx)
+{
+
+	return (ctx->h);
 }
+
+uint64_t
+fnv1a_64_hash(const void *data, size_t len)
+{
+	fnv64_ctx ctx;
+
+	fnv1a_64_init(&ctx);
+	fnv1a_64_update(&ctx, data, len);
+	return (fnv1a_64_final(&ctx));
+}
+
+CRYB_HASH_ALGORITHM_UNKEYED(fnv1a_64, "fnv1a-64", fnv64_ctx, uint64_t);
+
+/*
+ * Batch interface for FNV-1a.  Each byte of a key depends on the
+ * previous one through a multiplication, so a single hash cannot go
+ * faster than one byte per multiplication latency.  Instead, we hash
+ * HASH_MANY_LANES keys in lockstep, which keeps the multiplier busy.
+ * Whenever a key is exhausted, its lane is refilled with the next one;
+ * once there are not enough keys left to fill every lane, the remaining
+ * ones are finished one at a time.
+ */
+#define FNV1A_HASH_MANY(bits)						\
+	void								\
+	fnv1a_##bits##_hash_many(const hash_key *keys, size_t n,	\
+	    uint##bits##_t *out)					\
+	{								\
+		const uint8_t *p[HASH_MANY_LANES];			\
+		size_t left[HASH_MANY_LANES], idx[HASH_MANY_LANES];	\
+		uint##bits##_t h[HASH_MANY_LANES], h0, h1, h2, h3;	\
+		fnv##bits##_ctx ctx;					\
+		size_t i, m, next;					\
+		unsigned int l;						\
+		int full;						\
+									\
+		for (l = 0; l < HASH_MANY_LANES; ++l)			\
+			idx[l] = SIZE_MAX;				\
+		for (next = 0, full = 1; full; ) {			\
+			for (l = 0; l < HASH_MANY_LANES; ++l) {		\
+				if (idx[l] != SIZE_MAX && left[l] == 0) { \
+					out[idx[l]] = h[l];		\
+					idx[l] = SIZE_MAX;		\
+				}					\
+				if (idx[l] == SIZE_MAX && next < n) {	\
+					p[l] = keys[next].data;		\
+					left[l] = keys[next].len;	\
+					h[l] = FNV_##bits##_OFFSET_BASIS; \
+					idx[l] = next++;		\
+				}					\
+				if (idx[l] == SIZE_MAX)			\
+					full = 0;			\
+			}						\
+			if (!full)					\
+				break;					\
+			for (m = left[0], l = 1; l < HASH_MANY_LANES; ++l) \
+				if (left[l] < m)			\
+					m = left[l];			\
+			h0 = h[0], h1 = h[1], h2 = h[2], h3 = h[3];	\
+			for (i = 0; i < m; ++i) {			\
+				h0 = (h0 ^ p[0][i]) * FNV_##bits##_PRIME; \
+				h1 = (h1 ^ p[1][i]) * FNV_##bits##_PRIME; \
+				h2 = (h2 ^ p[2][i]) * FNV_##bits##_PRIME; \
+				h3 = (h3 ^ p[3][i]) * FNV_##bits##_PRIME; \
+			}						\
+			h[0] = h0, h[1] = h1, h[2] = h2, h[3] = h3;	\
+			for (l = 0; l < HASH_MANY_LANES; ++l) {		\
+				p[l] += m;				\
+				left[l] -= m;				\
+			}						\
+		}							\
+		for (l = 0; l < HASH_MANY_LANES; ++l) {			\
+			if (idx[l] == SIZE_MAX)				\
+				continue;				\
+			ctx.h = h[l];					\
+			fnv1a_##bits##_update(&ctx, p[l], left[l]);	\
+			out[idx[l]] = ctx.h;				\
+		}							\
+	}
+
+FNV1A_HASH_MANY(32)
+FNV1A_HASH_MANY(64)
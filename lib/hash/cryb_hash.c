@@ -30,6 +30,7 @@
 #include "cryb/impl.h"
 
 #include <stdint.h>
+#include <string.h>
 #include <unistd.h>
 
 #include <cryb/hash.h>
@@ -42,3 +43,48 @@ cryb_hash_version(void)
 
 	return (cryb_hash_version_string);
 }
+
+static const hash_algorithm **cryb_hash_algorithms;
+
+static void
+init_hash_algorithms(void)
+{
+	static const hash_algorithm *algorithms[] = {
+		&adler32_hash_algorithm,
+		&buzhash_hash_algorithm,
+		&crc32_hash_algorithm,
+		&crc32c_hash_algorithm,
+		&fletcher16_hash_algorithm,
+		&fletcher32_hash_algorithm,
+		&fletcher64_hash_algorithm,
+		&fnv0_32_hash_algorithm,
+		&fnv0_64_hash_algorithm,
+		&fnv1_32_hash_algorithm,
+		&fnv1_64_hash_algorithm,
+		&fnv1a_32_hash_algorithm,
+		&fnv1a_64_hash_algorithm,
+		&halfsiphash24_hash_algorithm,
+		&halfsiphash24_64_hash_algorithm,
+		&murmur3_32_hash_algorithm,
+		&pearson_hash_algorithm,
+		&siphash13_hash_algorithm,
+		&siphash24_hash_algorithm,
+		&xxh3_64_hash_algorithm,
+		&xxh64_hash_algorithm,
+		NULL
+	};
+	cryb_hash_algorithms = algorithms;
+}
+
+const hash_algorithm *
+get_hash_algorithm(const char *name)
+{
+	const hash_algorithm **algp;
+
+	if (cryb_hash_algorithms == NULL)
+		init_hash_algorithms();
+	for (algp = cryb_hash_algorithms; *algp != NULL; ++algp)
+		if (strcasecmp((*algp)->name, name) == 0)
+			return (*algp);
+	return (NULL);
+}
@@ -0,0 +1,81 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CRYB_HASH_IMPL_H_INCLUDED
+#define CRYB_HASH_IMPL_H_INCLUDED
+
+/*
+ * Number of keys hashed in lockstep by the batch interfaces.  Their
+ * inner loops are unrolled by hand, so this cannot simply be changed.
+ */
+#define HASH_MANY_LANES		4
+
+/*
+ * Define the hash_algorithm descriptor for an unkeyed hash function
+ * which provides the usual pfx_init(), pfx_update(), pfx_final() and
+ * pfx_hash() functions and whose context type is ctxtype.  The init,
+ * final and complete methods need wrappers since their signatures
+ * differ from the generic ones.
+ */
+#define CRYB_HASH_ALGORITHM_UNKEYED(pfx, algname, ctxtype, type)	\
+	static void							\
+	pfx##_hash_init(hash_ctx *ctx, const void *key CRYB_UNUSED)	\
+	{								\
+									\
+		pfx##_init(ctx);					\
+	}								\
+									\
+	static uint64_t							\
+	pfx##_hash_final(hash_ctx *ctx)					\
+	{								\
+									\
+		return (pfx##_final(ctx));				\
+	}								\
+									\
+	static uint64_t							\
+	pfx##_hash_complete(const void *data, size_t len,		\
+	    const void *key CRYB_UNUSED)				\
+	{								\
+									\
+		return (pfx##_hash(data, len));				\
+	}								\
+									\
+	const hash_algorithm pfx##_hash_algorithm = {			\
+		.name			 = algname,			\
+		.contextlen		 = sizeof(ctxtype),		\
+		.keylen			 = 0,				\
+		.hashlen		 = sizeof(type),		\
+		.init			 = pfx##_hash_init,		\
+		.update			 =				\
+		    (hash_update_func)(void *)pfx##_update,		\
+		.final			 = pfx##_hash_final,		\
+		.complete		 = pfx##_hash_complete,		\
+	}
+
+#endif
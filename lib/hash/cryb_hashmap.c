@@ -0,0 +1,528 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cryb/bitwise.h>
+#include <cryb/hash.h>
+#include <cryb/hashmap.h>
+
+/*
+ * Open-addressing hash map in the style of the Swiss table.
+ *
+ * Slots are organized in groups of GROUP_LEN, and each slot has a
+ * control byte which is either EMPTY, DELETED or the low seven bits of
+ * the hash of the key stored in that slot.  The remaining bits of the
+ * hash select the first group to probe, and subsequent groups are
+ * chosen by triangular probing, which visits every group when the
+ * number of groups is a power of two.  A lookup compares the tag
+ * against all the control bytes of a group at once, and stops at the
+ * first group which contains an EMPTY slot.
+ *
+ * A group which has no EMPTY slot never regains one except by
+ * rehashing, so a slot can be marked EMPTY on removal if its group
+ * already has one; otherwise it becomes DELETED.
+ *
+ * Rehashing is incremental: when the table is full, a new one is
+ * allocated and the old one is kept around and consulted by lookups
+ * while each subsequent insertion or removal moves MIGRATE_GROUPS
+ * groups over.  The new table is large enough that the migration is
+ * always complete before it fills up in turn.
+ */
+
+#define GROUP_LEN	16
+#define MIGRATE_GROUPS	2
+
+#define CTRL_EMPTY	0x80
+#define CTRL_DELETED	0xfe
+#define CTRL_TAG(h)	((uint8_t)((h) & 0x7f))
+
+/* maximum load factor, counting DELETED slots */
+#define MAX_LOAD(cap)	((cap) - (cap) / 8)
+
+/* minimum size of an arena chunk */
+#define ARENA_CHUNK_LEN	4096
+
+struct hashmap_slot {
+	const void	*key;
+	size_t		 keylen;
+	void		*value;
+	uint64_t	 hash;
+};
+
+struct hashmap_table {
+	uint8_t			*ctrl;		/* control bytes */
+	struct hashmap_slot	*slots;		/* slots */
+	size_t			 ngroups;	/* number of groups */
+	size_t			 count;		/* number of full slots */
+	size_t			 used;		/* full + deleted slots */
+};
+
+struct hashmap_chunk {
+	struct hashmap_chunk	*next;
+	size_t			 size;
+	size_t			 used;
+	uint8_t			 buf[];
+};
+
+struct cryb_hashmap {
+	const hash_algorithm	*alg;
+	uint8_t			 hkey[HASH_MAX_KEY_LEN];
+	unsigned int		 flags;
+	struct hashmap_table	 cur;		/* current table */
+	struct hashmap_table	 old;		/* table being migrated */
+	size_t			 migrated;	/* groups migrated so far */
+	struct hashmap_chunk	*arena;		/* storage for copied keys */
+};
+
+/*
+ * Return a bitmask of the slots in a group whose control byte equals c.
+ */
+static inline unsigned int
+hashmap_group_match(const uint8_t *ctrl, uint8_t c)
+{
+#if defined(__SSE2__)
+	__m128i g;
+
+	g = _mm_loadu_si128((const __m128i *)(const void *)ctrl);
+	return ((unsigned int)_mm_movemask_epi8(
+	    _mm_cmpeq_epi8(g, _mm_set1_epi8((char)c))));
+#else
+	unsigned int i, mask;
+
+	for (i = mask = 0; i < GROUP_LEN; ++i)
+		if (ctrl[i] == c)
+			mask |= 1U << i;
+	return (mask);
+#endif
+}
+
+/*
+ * Return a bitmask of the slots in a group which are either EMPTY or
+ * DELETED, i.e. whose control byte has the high bit set.
+ */
+static inline unsigned int
+hashmap_group_free(const uint8_t *ctrl)
+{
+#if defined(__SSE2__)
+	__m128i g;
+
+	g = _mm_loadu_si128((const __m128i *)(const void *)ctrl);
+	return ((unsigned int)_mm_movemask_epi8(g));
+#else
+	unsigned int i, mask;
+
+	for (i = mask = 0; i < GROUP_LEN; ++i)
+		if (ctrl[i] & 0x80)
+			mask |= 1U << i;
+	return (mask);
+#endif
+}
+
+/*
+ * Hash a key
+ */
+static inline uint64_t
+hashmap_hash(const hashmap *map, const void *key, size_t keylen)
+{
+
+	return (map->alg->complete(key, keylen, map->hkey));
+}
+
+/*
+ * Look up a key in a table and return the index of its slot, or -1 if
+ * it was not found.
+ */
+static size_t
+hashmap_find(const struct hashmap_table *t, uint64_t h,
+    const void *key, size_t keylen)
+{
+	const struct hashmap_slot *slot;
+	size_t g, i, mask, step;
+	unsigned int m;
+
+	if (t->ngroups == 0)
+		return ((size_t)-1);
+	mask = t->ngroups - 1;
+	for (g = (h >> 7) & mask, step = 1; step <= t->ngroups; ++step) {
+		m = hashmap_group_match(t->ctrl + g * GROUP_LEN, CTRL_TAG(h));
+		while (m != 0) {
+			i = g * GROUP_LEN + ffs((int)m) - 1;
+			slot = &t->slots[i];
+			if (slot->hash == h && slot->keylen == keylen &&
+			    (keylen == 0 || memcmp(slot->key, key, keylen) == 0))
+				return (i);
+			m &= m - 1;
+		}
+		if (hashmap_group_match(t->ctrl + g * GROUP_LEN, CTRL_EMPTY))
+			break;
+		g = (g + step) & mask;
+	}
+	return ((size_t)-1);
+}
+
+/*
+ * Insert a key which is known not to be present into a table which is
+ * known to have room for it.
+ */
+static void
+hashmap_insert(struct hashmap_table *t, const struct hashmap_slot *slot)
+{
+	size_t g, i, mask, step;
+	unsigned int m;
+
+	mask = t->ngroups - 1;
+	for (g = (slot->hash >> 7) & mask, step = 1; ; ++step) {
+		if ((m = hashmap_group_free(t->ctrl + g * GROUP_LEN)) != 0)
+			break;
+		g = (g + step) & mask;
+	}
+	i = g * GROUP_LEN + ffs((int)m) - 1;
+	if (t->ctrl[i] == CTRL_EMPTY)
+		t->used++;
+	t->ctrl[i] = CTRL_TAG(slot->hash);
+	t->slots[i] = *slot;
+	t->count++;
+}
+
+/*
+ * Remove the entry in the specified slot from a table.
+ */
+static void
+hashmap_erase(struct hashmap_table *t, size_t i)
+{
+	size_t g;
+
+	g = i / GROUP_LEN;
+	if (hashmap_group_match(t->ctrl + g * GROUP_LEN, CTRL_EMPTY)) {
+		t->ctrl[i] = CTRL_EMPTY;
+		t->used--;
+	} else {
+		t->ctrl[i] = CTRL_DELETED;
+	}
+	t->count--;
+}
+
+/*
+ * Free a table
+ */
+static void
+hashmap_table_free(struct hashmap_table *t)
+{
+
+	free(t->ctrl);
+	free(t->slots);
+	memset(t, 0, sizeof *t);
+}
+
+/*
+ * Move up to n groups from the old table to the current one, and free
+ * the old table once it is empty.
+ */
+static void
+hashmap_migrate(hashmap *map, size_t n)
+{
+	struct hashmap_table *old = &map->old;
+	size_t i, end;
+
+	while (n-- > 0 && map->migrated < old->ngroups) {
+		i = map->migrated * GROUP_LEN;
+		for (end = i + GROUP_LEN; i < end; ++i) {
+			if (old->ctrl[i] & 0x80)
+				continue;
+			hashmap_insert(&map->cur, &old->slots[i]);
+			/* not EMPTY, lookups in the old table must go on */
+			old->ctrl[i] = CTRL_DELETED;
+			old->count--;
+		}
+		map->migrated++;
+	}
+	if (old->ngroups > 0 &&
+	    (old->count == 0 || map->migrated == old->ngroups))
+		hashmap_table_free(old);
+}
+
+/*
+ * Ensure that there is room for one more entry in the current table,
+ * starting a new migration if necessary.
+ */
+static int
+hashmap_reserve(hashmap *map)
+{
+	struct hashmap_table t;
+	size_t count, ngroups;
+
+	if (map->cur.used < MAX_LOAD(map->cur.ngroups * GROUP_LEN))
+		return (0);
+	/* complete any migration which is still in progress */
+	hashmap_migrate(map, map->old.ngroups);
+	/* grow unless more than half the slots are tombstones */
+	count = map->cur.count + 1;
+	ngroups = map->cur.ngroups > 0 ? map->cur.ngroups : 1;
+	while (count > MAX_LOAD(ngroups * GROUP_LEN) / 2)
+		ngroups *= 2;
+	if (ngroups > SIZE_MAX / GROUP_LEN / sizeof *t.slots) {
+		errno = ENOMEM;
+		return (-1);
+	}
+	t.ngroups = ngroups;
+	t.count = t.used = 0;
+	if ((t.ctrl = malloc(ngroups * GROUP_LEN)) == NULL)
+		return (-1);
+	if ((t.slots = malloc(ngroups * GROUP_LEN * sizeof *t.slots)) == NULL) {
+		free(t.ctrl);
+		return (-1);
+	}
+	memset(t.ctrl, CTRL_EMPTY, ngroups * GROUP_LEN);
+	map->old = map->cur;
+	map->cur = t;
+	map->migrated = 0;
+	if (map->old.count == 0)
+		hashmap_table_free(&map->old);
+	return (0);
+}
+
+/*
+ * Copy a key into the arena
+ */
+static const void *
+hashmap_copy_key(hashmap *map, const void *key, size_t keylen)
+{
+	struct hashmap_chunk *chunk;
+	size_t size;
+	void *p;
+
+	if ((chunk = map->arena) == NULL || chunk->size - chunk->used < keylen) {
+		size = keylen > ARENA_CHUNK_LEN ? keylen : ARENA_CHUNK_LEN;
+		if ((chunk = malloc(sizeof *chunk + size)) == NULL)
+			return (NULL);
+		chunk->size = size;
+		chunk->used = 0;
+		/* keep the chunk with the most room at the head */
+		if (map->arena != NULL && size == keylen) {
+			chunk->next = map->arena->next;
+			map->arena->next = chunk;
+		} else {
+			chunk->next = map->arena;
+			map->arena = chunk;
+		}
+	}
+	p = chunk->buf + chunk->used;
+	memcpy(p, key, keylen);
+	chunk->used += keylen;
+	return (p);
+}
+
+/*
+ * Allocate a new hash map which uses the specified hash algorithm and
+ * key.  If the algorithm is NULL, SipHash-1-3 is used.  The key may
+ * only be NULL if the algorithm is unkeyed.
+ */
+hashmap *
+hashmap_new(const hash_algorithm *alg, const void *hkey, unsigned int flags)
+{
+	hashmap *map;
+
+	if (alg == NULL)
+		alg = &siphash13_hash_algorithm;
+	if (alg->keylen > HASH_MAX_KEY_LEN ||
+	    (hkey == NULL && alg->keylen > 0)) {
+		errno = EINVAL;
+		return (NULL);
+	}
+	if ((map = calloc(1, sizeof *map)) == NULL)
+		return (NULL);
+	map->alg = alg;
+	if (alg->keylen > 0)
+		memcpy(map->hkey, hkey, alg->keylen);
+	map->flags = flags;
+	return (map);
+}
+
+/*
+ * Delete a hash map.  Values and uncopied keys are not freed.
+ */
+void
+hashmap_delete(hashmap *map)
+{
+	struct hashmap_chunk *chunk;
+
+	if (map != NULL) {
+		hashmap_table_free(&map->cur);
+		hashmap_table_free(&map->old);
+		while ((chunk = map->arena) != NULL) {
+			map->arena = chunk->next;
+			free(chunk);
+		}
+		free(map);
+	}
+}
+
+/*
+ * Return the number of entries in a hash map
+ */
+size_t
+hashmap_count(const hashmap *map)
+{
+
+	return (map->cur.count + map->old.count);
+}
+
+/*
+ * Look up a key in both tables and return a pointer to its slot.
+ */
+static struct hashmap_slot *
+hashmap_lookup(hashmap *map, uint64_t h, const void *key, size_t keylen)
+{
+	size_t i;
+
+	if ((i = hashmap_find(&map->cur, h, key, keylen)) != (size_t)-1)
+		return (&map->cur.slots[i]);
+	if ((i = hashmap_find(&map->old, h, key, keylen)) != (size_t)-1)
+		return (&map->old.slots[i]);
+	return (NULL);
+}
+
+/*
+ * Look up a key and return a pointer to the associated value, or NULL
+ * if the key was not found.  The pointer is valid only until the next
+ * insertion or removal.
+ */
+void **
+hashmap_get(hashmap *map, const void *key, size_t keylen)
+{
+	struct hashmap_slot *slot;
+
+	slot = hashmap_lookup(map, hashmap_hash(map, key, keylen), key, keylen);
+	return (slot != NULL ? &slot->value : NULL);
+}
+
+/*
+ * Associate a value with a key, replacing any previous value
+ */
+int
+hashmap_put(hashmap *map, const void *key, size_t keylen, void *value)
+{
+	struct hashmap_slot slot, *sp;
+
+	hashmap_migrate(map, MIGRATE_GROUPS);
+	slot.hash = hashmap_hash(map, key, keylen);
+	if ((sp = hashmap_lookup(map, slot.hash, key, keylen)) != NULL) {
+		sp->value = value;
+		return (0);
+	}
+	if (hashmap_reserve(map) != 0)
+		return (-1);
+	slot.keylen = keylen;
+	slot.value = value;
+	slot.key = key;
+	if ((map->flags & HASHMAP_COPY_KEYS) && keylen > 0 &&
+	    (slot.key = hashmap_copy_key(map, key, keylen)) == NULL)
+		return (-1);
+	hashmap_insert(&map->cur, &slot);
+	return (0);
+}
+
+/*
+ * Remove a key, optionally returning the associated value
+ */
+int
+hashmap_remove(hashmap *map, const void *key, size_t keylen, void **value)
+{
+	struct hashmap_table *t;
+	uint64_t h;
+	size_t i;
+
+	hashmap_migrate(map, MIGRATE_GROUPS);
+	h = hashmap_hash(map, key, keylen);
+	t = &map->cur;
+	if ((i = hashmap_find(t, h, key, keylen)) == (size_t)-1) {
+		t = &map->old;
+		if ((i = hashmap_find(t, h, key, keylen)) == (size_t)-1) {
+			errno = ENOENT;
+			return (-1);
+		}
+	}
+	if (value != NULL)
+		*value = t->slots[i].value;
+	if (t == &map->old) {
+		t->ctrl[i] = CTRL_DELETED;
+		if (--t->count == 0)
+			hashmap_table_free(t);
+	} else {
+		hashmap_erase(t, i);
+	}
+	return (0);
+}
+
+/*
+ * Iterate over the entries in a hash map.  The iterator must initially
+ * be zero.  Returns 1 and the next entry, or 0 if there are no more
+ * entries.  Inserting or removing entries invalidates the iterator.
+ */
+int
+hashmap_next(hashmap *map, size_t *iter, const void **key, size_t *keylen,
+    void **value)
+{
+	const struct hashmap_table *t;
+	size_t curlen, i;
+
+	curlen = map->cur.ngroups * GROUP_LEN;
+	for (;;) {
+		if (*iter < curlen) {
+			t = &map->cur;
+			i = *iter;
+		} else if (*iter - curlen < map->old.ngroups * GROUP_LEN) {
+			t = &map->old;
+			i = *iter - curlen;
+		} else {
+			return (0);
+		}
+		++*iter;
+		if (t->ctrl[i] & 0x80)
+			continue;
+		if (key != NULL)
+			*key = t->slots[i].key;
+		if (keylen != NULL)
+			*keylen = t->slots[i].keylen;
+		if (value != NULL)
+			*value = t->slots[i].value;
+		return (1);
+	}
+}
@@ -0,0 +1,614 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <errno.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cryb/bitwise.h>
+#include <cryb/endian.h>
+#include <cryb/hash.h>
+#include <cryb/hll.h>
+
+/*
+ * HyperLogLog cardinality estimator with the sparse representation
+ * described by Heule, Nunkesser and Hall ("HyperLogLog in Practice")
+ * and the improved raw estimator of Ertl ("New cardinality estimation
+ * algorithms for HyperLogLog sketches"), which needs neither the
+ * empirical bias correction of HLL++ nor a separate small-range
+ * estimator.
+ *
+ * Keys are hashed with XXH64.  The top p bits of the hash select one
+ * of m = 2^p registers, which records the largest number of leading
+ * zeroes plus one (rho) seen in the remaining bits.  Registers are six
+ * bits wide and packed four to three bytes, least significant first.
+ *
+ * Small sketches instead keep a set of 32-bit entries, each of which
+ * records the index and rho of a hash at the higher precision
+ * SPARSE_P.  If the bits between p and SPARSE_P are not all zero, they
+ * determine rho, and the entry is the SPARSE_P-bit index shifted left
+ * by one; otherwise, the entry is the index shifted left by seven,
+ * followed by the rho of the remaining bits and a 1 bit.  The set is
+ * an open-addressing hash table, and is converted to registers once it
+ * would take up more memory than they do.
+ */
+
+#define SPARSE_P	25
+#define SPARSE_MIN_LEN	16
+
+#define DENSE_LEN(p)	((size_t)3 << ((p) - 2))
+
+/* number of keys hashed at a time by hll_add_many() */
+#define ADD_BATCH	8
+
+/* export format */
+#define HLL_MAGIC	"CRYBHLL1"
+#define HLL_MAGIC_LEN	8
+#define HLL_HEADER_LEN	24
+#define HLL_ENC_SPARSE	1
+#define HLL_ENC_DENSE	2
+
+struct cryb_hll {
+	unsigned int	 p;		/* precision */
+	uint64_t	 seed;		/* XXH64 seed */
+	uint8_t		*dense;		/* packed registers, or NULL */
+	uint32_t	*sparse;	/* sparse entries, or NULL */
+	size_t		 sparselen;	/* size of sparse table */
+	size_t		 nsparse;	/* number of sparse entries */
+};
+
+static inline unsigned int
+hll_clz64(uint64_t x)
+{
+#if HAVE___BUILTIN_CLZLL
+	return ((unsigned int)__builtin_clzll(x));
+#else
+	unsigned int n;
+
+	for (n = 0; (x & 0x8000000000000000ULL) == 0; x <<= 1)
+		++n;
+	return (n);
+#endif
+}
+
+/*
+ * Number of leading zeroes plus one in the bits of h which remain after
+ * removing the first p
+ */
+static inline unsigned int
+hll_rho(uint64_t h, unsigned int p)
+{
+
+	h <<= p;
+	return (h == 0 ? 64 - p + 1 : hll_clz64(h) + 1);
+}
+
+/*
+ * Dense registers
+ */
+static inline void
+hll_dense_update(uint8_t *d, size_t j, unsigned int rho)
+{
+	size_t bit = j * 6;
+	unsigned int w;
+
+	w = d[bit / 8] | d[bit / 8 + 1] << 8;
+	if (rho > ((w >> (bit % 8)) & 0x3f)) {
+		w &= ~(0x3fU << (bit % 8));
+		w |= rho << (bit % 8);
+		d[bit / 8] = (uint8_t)w;
+		d[bit / 8 + 1] = (uint8_t)(w >> 8);
+	}
+}
+
+/*
+ * Eight registers at a time, as a 48-bit word
+ */
+static inline uint64_t
+hll_load48(const uint8_t *d)
+{
+
+	return (le32dec(d) | (uint64_t)le16dec(d + 4) << 32);
+}
+
+static inline void
+hll_store48(uint8_t *d, uint64_t w)
+{
+
+	le32enc(d, (uint32_t)w);
+	le16enc(d + 4, (uint16_t)(w >> 32));
+}
+
+/*
+ * Sparse entries
+ */
+static inline uint32_t
+hll_sparse_encode(uint64_t h, unsigned int p)
+{
+	uint32_t idx;
+
+	idx = (uint32_t)(h >> (64 - SPARSE_P));
+	if ((idx & ((1U << (SPARSE_P - p)) - 1)) != 0)
+		return (idx << 1);
+	return (idx << 7 | hll_rho(h, SPARSE_P) << 1 | 1);
+}
+
+static inline uint32_t
+hll_sparse_index(uint32_t e)
+{
+
+	return ((e & 1) ? e >> 7 : e >> 1);
+}
+
+static inline void
+hll_sparse_decode(uint32_t e, unsigned int p, size_t *j, unsigned int *rho)
+{
+	uint32_t idx;
+
+	idx = hll_sparse_index(e);
+	*j = idx >> (SPARSE_P - p);
+	if (e & 1)
+		*rho = ((e >> 1) & 0x3f) + (SPARSE_P - p);
+	else
+		*rho = SPARSE_P - p -
+		    fls((int)(idx & ((1U << (SPARSE_P - p)) - 1))) + 1;
+}
+
+/*
+ * Check that a sparse entry could have been produced by
+ * hll_sparse_encode().
+ */
+static int
+hll_sparse_valid(uint32_t e, unsigned int p)
+{
+	unsigned int rho;
+
+	if (e & 1) {
+		rho = (e >> 1) & 0x3f;
+		return (rho >= 1 && rho <= 64 - SPARSE_P + 1 &&
+		    ((e >> 7) & ((1U << (SPARSE_P - p)) - 1)) == 0);
+	}
+	return (e >> (SPARSE_P + 1) == 0 &&
+	    ((e >> 1) & ((1U << (SPARSE_P - p)) - 1)) != 0);
+}
+
+/*
+ * Insert an entry into a sparse table which has room for it.
+ */
+static void
+hll_sparse_insert(uint32_t *table, size_t len, size_t *n, uint32_t e)
+{
+	uint32_t idx;
+	size_t i;
+
+	idx = hll_sparse_index(e);
+	for (i = (idx * 0x9e3779b1U) & (len - 1); table[i] != 0;
+	     i = (i + 1) & (len - 1)) {
+		if (hll_sparse_index(table[i]) == idx) {
+			/* both have the same flag, so this selects the max rho */
+			if (e > table[i])
+				table[i] = e;
+			return;
+		}
+	}
+	table[i] = e;
+	++*n;
+}
+
+/*
+ * Switch from the sparse to the dense representation
+ */
+static int
+hll_densify(hll *h)
+{
+	unsigned int rho;
+	size_t i, j;
+
+	if ((h->dense = calloc(1, DENSE_LEN(h->p) + 1)) == NULL)
+		return (-1);
+	for (i = 0; i < h->sparselen; ++i) {
+		if (h->sparse[i] != 0) {
+			hll_sparse_decode(h->sparse[i], h->p, &j, &rho);
+			hll_dense_update(h->dense, j, rho);
+		}
+	}
+	free(h->sparse);
+	h->sparse = NULL;
+	h->sparselen = h->nsparse = 0;
+	return (0);
+}
+
+/*
+ * Add a sparse entry to a sketch in either representation, growing or
+ * converting it as needed.
+ */
+static int
+hll_add_entry(hll *h, uint32_t e)
+{
+	uint32_t *table;
+	unsigned int rho;
+	size_t i, j, len, n;
+
+	if (h->sparse != NULL && (h->nsparse + 1) * 2 > h->sparselen) {
+		len = h->sparselen * 2;
+		if (len * sizeof *table > DENSE_LEN(h->p)) {
+			if (hll_densify(h) != 0)
+				return (-1);
+		} else {
+			if ((table = calloc(len, sizeof *table)) == NULL)
+				return (-1);
+			for (i = n = 0; i < h->sparselen; ++i)
+				if (h->sparse[i] != 0)
+					hll_sparse_insert(table, len, &n,
+					    h->sparse[i]);
+			free(h->sparse);
+			h->sparse = table;
+			h->sparselen = len;
+		}
+	}
+	if (h->sparse != NULL) {
+		hll_sparse_insert(h->sparse, h->sparselen, &h->nsparse, e);
+	} else {
+		hll_sparse_decode(e, h->p, &j, &rho);
+		hll_dense_update(h->dense, j, rho);
+	}
+	return (0);
+}
+
+static inline int
+hll_add_hash(hll *h, uint64_t hash)
+{
+
+	if (h->dense != NULL) {
+		hll_dense_update(h->dense, hash >> (64 - h->p),
+		    hll_rho(hash, h->p));
+		return (0);
+	}
+	return (hll_add_entry(h, hll_sparse_encode(hash, h->p)));
+}
+
+/*
+ * Allocate a new, empty sketch with 2^p registers.  The relative
+ * standard error of the estimate is approximately 1.04 / sqrt(2^p).
+ */
+hll *
+hll_new(unsigned int p, uint64_t seed)
+{
+	hll *h;
+
+	if (p < HLL_MIN_PRECISION || p > HLL_MAX_PRECISION) {
+		errno = EINVAL;
+		return (NULL);
+	}
+	if ((h = calloc(1, sizeof *h)) == NULL)
+		return (NULL);
+	h->p = p;
+	h->seed = seed;
+	if (SPARSE_MIN_LEN * sizeof *h->sparse < DENSE_LEN(p)) {
+		h->sparselen = SPARSE_MIN_LEN;
+		h->sparse = calloc(h->sparselen, sizeof *h->sparse);
+	} else {
+		h->dense = calloc(1, DENSE_LEN(p) + 1);
+	}
+	if (h->sparse == NULL && h->dense == NULL) {
+		free(h);
+		return (NULL);
+	}
+	return (h);
+}
+
+/*
+ * Delete a sketch
+ */
+void
+hll_delete(hll *h)
+{
+
+	if (h != NULL) {
+		free(h->sparse);
+		free(h->dense);
+		free(h);
+	}
+}
+
+/*
+ * Add a key to a sketch
+ */
+int
+hll_add(hll *h, const void *key, size_t len)
+{
+
+	return (hll_add_hash(h, xxh64_hash(key, len, h->seed)));
+}
+
+/*
+ * Add multiple keys to a sketch, hashing several at a time
+ */
+int
+hll_add_many(hll *h, const hash_key *keys, size_t n)
+{
+	uint64_t hash[ADD_BATCH];
+	size_t i, j, m;
+
+	for (i = 0; i < n; i += m) {
+		m = n - i < ADD_BATCH ? n - i : ADD_BATCH;
+		for (j = 0; j < m; ++j)
+			hash[j] = xxh64_hash(keys[i + j].data, keys[i + j].len,
+			    h->seed);
+		for (j = 0; j < m; ++j)
+			if (hll_add_hash(h, hash[j]) != 0)
+				return (-1);
+	}
+	return (0);
+}
+
+/*
+ * Merge the registers of one dense sketch into another, eight at a
+ * time: split each 48-bit word into even and odd registers, so that
+ * every register has six spare bits above it, and use the top one to
+ * find out which of each pair is larger.
+ */
+#define EVEN	0x03f03f03f03fULL
+#define GUARD	0x040040040040ULL
+
+static inline uint64_t
+hll_max6(uint64_t a, uint64_t b)
+{
+	uint64_t sel;
+
+	sel = ((((a | GUARD) - b) & GUARD) >> 6) * 0x3f;
+	return ((a & sel) | (b & ~sel));
+}
+
+static void
+hll_dense_merge(uint8_t *dst, const uint8_t *src, unsigned int p)
+{
+	uint64_t a, b;
+	size_t i;
+
+	for (i = 0; i < DENSE_LEN(p); i += 6) {
+		a = hll_load48(dst + i);
+		b = hll_load48(src + i);
+		hll_store48(dst + i, hll_max6(a & EVEN, b & EVEN) |
+		    hll_max6(a >> 6 & EVEN, b >> 6 & EVEN) << 6);
+	}
+}
+
+/*
+ * Merge one sketch into another.  Both must have the same precision
+ * and seed.  The result is the same as if all the keys which were
+ * added to either had been added to the first.
+ */
+int
+hll_merge(hll *dst, const hll *src)
+{
+	size_t i;
+
+	if (dst->p != src->p || dst->seed != src->seed) {
+		errno = EINVAL;
+		return (-1);
+	}
+	if (dst == src)
+		return (0);
+	if (src->dense != NULL) {
+		if (dst->dense == NULL && hll_densify(dst) != 0)
+			return (-1);
+		hll_dense_merge(dst->dense, src->dense, dst->p);
+		return (0);
+	}
+	for (i = 0; i < src->sparselen; ++i)
+		if (src->sparse[i] != 0 && hll_add_entry(dst, src->sparse[i]) != 0)
+			return (-1);
+	return (0);
+}
+
+/*
+ * Ertl's sigma and tau functions
+ */
+static double
+hll_sigma(double x)
+{
+	double y, z, zp;
+
+	y = 1.0;
+	z = x;
+	do {
+		x *= x;
+		zp = z;
+		z += x * y;
+		y += y;
+	} while (z != zp);
+	return (z);
+}
+
+static double
+hll_tau(double x)
+{
+	double y, z, zp;
+
+	if (x == 0.0 || x == 1.0)
+		return (0.0);
+	y = 1.0;
+	z = 1.0 - x;
+	do {
+		x = sqrt(x);
+		zp = z;
+		y *= 0.5;
+		z -= (1.0 - x) * (1.0 - x) * y;
+	} while (z != zp);
+	return (z / 3.0);
+}
+
+/*
+ * Estimate the number of distinct keys which have been added to a
+ * sketch.
+ */
+uint64_t
+hll_estimate(const hll *h)
+{
+	unsigned int c[64 + 2] = { 0 };
+	double m, z;
+	uint64_t w;
+	size_t i;
+	unsigned int k, q;
+
+	if (h->dense == NULL) {
+		/* linear counting at the sparse precision */
+		m = (double)(1UL << SPARSE_P);
+		return ((uint64_t)(m * log(m / (m - h->nsparse)) + 0.5));
+	}
+	for (i = 0; i < DENSE_LEN(h->p); i += 6)
+		for (w = hll_load48(h->dense + i), k = 0; k < 8; ++k, w >>= 6)
+			c[w & 0x3f]++;
+	m = (double)(1UL << h->p);
+	q = 64 - h->p;
+	if (c[0] == 1UL << h->p)
+		return (0);
+	z = m * hll_tau((m - c[q + 1]) / m);
+	for (k = q; k >= 1; --k)
+		z = 0.5 * (z + c[k]);
+	z += m * hll_sigma(c[0] / m);
+	return ((uint64_t)(m * m / (2.0 * log(2.0) * z) + 0.5));
+}
+
+/*
+ * Serialize a sketch.  The format is a 24-byte header containing the
+ * magic string, precision, representation, number of sparse entries
+ * and seed, followed either by the sparse entries in ascending order
+ * or by the packed registers, all little-endian.  Returns the length
+ * of the serialized sketch, which is only written if it fits.
+ */
+static int
+hll_entry_cmp(const void *a, const void *b)
+{
+	uint32_t ea, eb;
+
+	memcpy(&ea, a, sizeof ea);
+	memcpy(&eb, b, sizeof eb);
+	return (ea < eb ? -1 : ea > eb);
+}
+
+size_t
+hll_export(const hll *h, void *buf, size_t len)
+{
+	uint8_t *p = buf;
+	uint32_t e;
+	size_t i, n, need;
+
+	if (h->dense != NULL)
+		need = HLL_HEADER_LEN + DENSE_LEN(h->p);
+	else
+		need = HLL_HEADER_LEN + h->nsparse * sizeof e;
+	if (len < need)
+		return (need);
+	memcpy(p, HLL_MAGIC, HLL_MAGIC_LEN);
+	p[8] = (uint8_t)h->p;
+	p[9] = h->dense != NULL ? HLL_ENC_DENSE : HLL_ENC_SPARSE;
+	le16enc(p + 10, 0);
+	le32enc(p + 12, (uint32_t)h->nsparse);
+	le64enc(p + 16, h->seed);
+	p += HLL_HEADER_LEN;
+	if (h->dense != NULL) {
+		memcpy(p, h->dense, DENSE_LEN(h->p));
+	} else {
+		/* sort in host order, then convert */
+		for (i = n = 0; i < h->sparselen; ++i)
+			if (h->sparse[i] != 0)
+				memcpy(p + n++ * sizeof e, &h->sparse[i],
+				    sizeof e);
+		qsort(p, n, sizeof e, hll_entry_cmp);
+		for (i = 0; i < n; ++i) {
+			memcpy(&e, p + i * sizeof e, sizeof e);
+			le32enc(p + i * sizeof e, e);
+		}
+	}
+	return (need);
+}
+
+/*
+ * Create a sketch from its serialized form
+ */
+hll *
+hll_import(const void *buf, size_t len)
+{
+	const uint8_t *p = buf;
+	unsigned int enc, prec;
+	uint32_t e;
+	size_t i, n;
+	hll *h;
+
+	if (len < HLL_HEADER_LEN || memcmp(p, HLL_MAGIC, HLL_MAGIC_LEN) != 0)
+		goto einval;
+	prec = p[8];
+	enc = p[9];
+	n = le32dec(p + 12);
+	if (prec < HLL_MIN_PRECISION || prec > HLL_MAX_PRECISION)
+		goto einval;
+	if (enc == HLL_ENC_DENSE) {
+		if (len != HLL_HEADER_LEN + DENSE_LEN(prec))
+			goto einval;
+	} else if (enc == HLL_ENC_SPARSE) {
+		if ((len - HLL_HEADER_LEN) % sizeof e != 0 ||
+		    (len - HLL_HEADER_LEN) / sizeof e != n)
+			goto einval;
+	} else {
+		goto einval;
+	}
+	if ((h = hll_new(prec, le64dec(p + 16))) == NULL)
+		return (NULL);
+	p += HLL_HEADER_LEN;
+	if (enc == HLL_ENC_DENSE) {
+		if (h->dense == NULL && hll_densify(h) != 0) {
+			hll_delete(h);
+			return (NULL);
+		}
+		memcpy(h->dense, p, DENSE_LEN(prec));
+		return (h);
+	}
+	for (i = 0; i < n; ++i) {
+		e = le32dec(p + i * sizeof e);
+		if (!hll_sparse_valid(e, prec)) {
+			hll_delete(h);
+			goto einval;
+		}
+		if (hll_add_entry(h, e) != 0) {
+			hll_delete(h);
+			return (NULL);
+		}
+	}
+	return (h);
+einval:
+	errno = EINVAL;
+	return (NULL);
+}
@@ -0,0 +1,510 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cryb/endian.h>
+#include <cryb/hash.h>
+#include <cryb/mph.h>
+
+/*
+ * Minimal perfect hash functions, built using the pilot search method
+ * of PTHash (Pibiri and Trani), which refines CHD (Belazzougui, Botelho
+ * and Dietzfelbinger).
+ *
+ * The keys are hashed with XXH3-128.  The first half of the hash picks
+ * one of n / 4 buckets.  Buckets are processed from largest to
+ * smallest, and for each one we search for a 16-bit pilot which, mixed
+ * with the second half of the hash of each key in the bucket, places
+ * them all in free slots of a table slightly larger than n.  Slots
+ * beyond n are finally remapped to the free slots below n.
+ *
+ * A lookup therefore costs one hash, one read from the pilot array,
+ * and in about 1.5% of cases one read from the remap array.  The pilots
+ * take up 4 bits per key and the remap array another 0.5.
+ */
+
+/*
+ * Layout of the image.  All fields are little-endian.
+ *
+ *  0  magic		"CRYBMPH1"
+ *  8  count		number of keys
+ * 12  nbuckets		number of buckets
+ * 16  size		number of slots
+ * 20  reserved		zero
+ * 24  seed		XXH3 seed
+ * 32  pilots		16 bits per bucket, padded to a multiple of 4 bytes
+ *     remap		32 bits per slot beyond count
+ */
+#define MPH_MAGIC		"CRYBMPH1"
+#define MPH_MAGIC_LEN		8
+#define MPH_OFF_COUNT		8
+#define MPH_OFF_NBUCKETS	12
+#define MPH_OFF_SIZE		16
+#define MPH_OFF_SEED		24
+#define MPH_HEADER_LEN		32
+
+/* average number of keys per bucket */
+#define MPH_BUCKET_KEYS		4
+
+/* largest pilot and number of seeds to try before giving up */
+#define MPH_MAX_PILOT		0xffff
+#define MPH_MAX_TRIES		8
+
+/* number of keys hashed ahead of the one being looked up */
+#define MPH_PREFETCH		8
+
+#if HAVE___BUILTIN_PREFETCH
+#define mph_prefetch(p)		__builtin_prefetch(p)
+#else
+#define mph_prefetch(p)		((void)(p))
+#endif
+
+struct cryb_mph {
+	void		*base;		/* allocation, NULL if loaded */
+	const uint8_t	*image;		/* header and data */
+	const uint8_t	*pilots;	/* pilot array */
+	const uint8_t	*remap;		/* remap array */
+	uint32_t	 count;		/* number of keys */
+	uint32_t	 nbuckets;	/* number of buckets */
+	uint32_t	 size;		/* number of slots */
+	uint64_t	 seed;		/* XXH3 seed */
+};
+
+#define MPH_NBUCKETS(n)		((n) / MPH_BUCKET_KEYS + 1)
+#define MPH_SIZE(n)		((n) + (n) / 64 + 1)
+#define MPH_PILOTS_LEN(nb)	(((nb) * 2 + 3) / 4 * 4)
+#define MPH_IMAGE_LEN(n, nb, m)						\
+	(MPH_HEADER_LEN + MPH_PILOTS_LEN(nb) + ((m) - (n)) * 4)
+
+struct mph_hash {
+	uint64_t	 h1, h2;
+};
+
+static inline void
+mph_hash(const void *key, size_t len, uint64_t seed, struct mph_hash *mh)
+{
+	uint8_t out[XXH3_128_HASH_LEN];
+
+	xxh3_128_hash(key, len, seed, out);
+	mh->h1 = le64dec(out);
+	mh->h2 = le64dec(out + 8);
+}
+
+/*
+ * Map a 32-bit value onto [0, n) with a multiplication rather than a
+ * division, as described by Lemire.
+ */
+static inline uint32_t
+mph_reduce(uint32_t x, uint32_t n)
+{
+
+	return ((uint32_t)(((uint64_t)x * n) >> 32));
+}
+
+/*
+ * Pick a bucket.  As in PTHash, the distribution is skewed so that 60%
+ * of the keys land in the first 30% of the buckets.  Those fill up
+ * while the table is still mostly empty, and the smaller buckets that
+ * remain are easier to place once it is nearly full, which cuts the
+ * number of pilots we need to try by about a third.
+ */
+static inline uint32_t
+mph_bucket(uint64_t h1, uint32_t nbuckets)
+{
+	uint32_t dense;
+
+	dense = nbuckets * 3 / 10;
+	if ((uint32_t)(h1 >> 32) < 0x9999999aU)
+		return (mph_reduce(h1, dense));
+	return (dense + mph_reduce(h1, nbuckets - dense));
+}
+
+/*
+ * The SplitMix64 finalizer, used to spread the pilot across all the
+ * bits of the second half of the hash before mixing them.
+ */
+static inline uint64_t
+mph_pilot_hash(uint64_t pilot, uint64_t seed)
+{
+	uint64_t x;
+
+	x = seed ^ (pilot + 1) * 0x9e3779b97f4a7c15ULL;
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+	return (x ^ (x >> 31));
+}
+
+static inline uint32_t
+mph_position(uint64_t h2, uint64_t ph, uint32_t size)
+{
+
+	return (mph_reduce(((h2 ^ ph) * 0xbf58476d1ce4e5b9ULL) >> 32, size));
+}
+
+static inline size_t
+mph_index(const mph *f, const struct mph_hash *mh)
+{
+	uint32_t b, pos;
+
+	b = mph_bucket(mh->h1, f->nbuckets);
+	pos = mph_position(mh->h2,
+	    mph_pilot_hash(le16dec(f->pilots + b * 2), f->seed), f->size);
+	if (pos >= f->count)
+		pos = le32dec(f->remap + (pos - f->count) * 4);
+	return (pos);
+}
+
+/*
+ * Scratch space for the construction
+ */
+struct mph_work {
+	struct mph_hash	*hashes;	/* hash of each key */
+	uint32_t	*order;		/* keys sorted by bucket */
+	uint32_t	*start;		/* first key of each bucket */
+	uint32_t	*buckets;	/* buckets sorted by size */
+	uint32_t	*sizes;		/* histogram of bucket sizes */
+	uint32_t	*pos;		/* positions of the current bucket */
+	uint64_t	*taken;		/* bitmap of slots in use */
+};
+
+#define MPH_TAKEN(w, p)		((w)->taken[(p) / 64] >> ((p) % 64) & 1)
+#define MPH_TAKE(w, p)		((w)->taken[(p) / 64] |= 1ULL << ((p) % 64))
+#define MPH_FREE(w, p)		((w)->taken[(p) / 64] &= ~(1ULL << ((p) % 64)))
+
+/*
+ * Check a bucket for keys with identical hashes.  Return -1 if any of
+ * them are actually identical, 1 if they merely collide, and 0 if
+ * there are none.
+ */
+static int
+mph_check_bucket(const hash_key *keys, const struct mph_work *w,
+    uint32_t first, uint32_t n)
+{
+	const struct mph_hash *ha, *hb;
+	const hash_key *ka, *kb;
+	uint32_t i, j;
+
+	for (i = 0; i < n; ++i) {
+		ha = &w->hashes[w->order[first + i]];
+		for (j = i + 1; j < n; ++j) {
+			hb = &w->hashes[w->order[first + j]];
+			if (ha->h1 != hb->h1 || ha->h2 != hb->h2)
+				continue;
+			ka = &keys[w->order[first + i]];
+			kb = &keys[w->order[first + j]];
+			if (ka->len == kb->len &&
+			    memcmp(ka->data, kb->data, ka->len) == 0)
+				return (-1);
+			return (1);
+		}
+	}
+	return (0);
+}
+
+/*
+ * Attempt to build the function with the seed stored in f, writing the
+ * pilots and the remap array into the image.  Return 0 if successful,
+ * -1 if there are duplicate keys, and 1 if another seed should be
+ * tried.
+ */
+static int
+mph_try(mph *f, uint8_t *pilots, uint8_t *remap, const hash_key *keys,
+    struct mph_work *w)
+{
+	uint32_t i, j, b, n, first, maxsize, pilot, pos, slot;
+	uint64_t ph;
+	int ret;
+
+	/* hash the keys and sort them by bucket */
+	memset(w->start, 0, (f->nbuckets + 1) * sizeof *w->start);
+	for (i = 0; i < f->count; ++i) {
+		mph_hash(keys[i].data, keys[i].len, f->seed, &w->hashes[i]);
+		w->start[mph_bucket(w->hashes[i].h1, f->nbuckets)]++;
+	}
+	for (b = 0; b < f->nbuckets; ++b)
+		w->start[b + 1] += w->start[b];
+	for (i = f->count; i > 0; --i)
+		w->order[--w->start[mph_bucket(w->hashes[i - 1].h1,
+		    f->nbuckets)]] = i - 1;
+	for (b = 0, maxsize = 0; b < f->nbuckets; ++b)
+		if (w->start[b + 1] - w->start[b] > maxsize)
+			maxsize = w->start[b + 1] - w->start[b];
+	/* sort the buckets by size, largest first */
+	memset(w->sizes, 0, (maxsize + 2) * sizeof *w->sizes);
+	for (b = 0; b < f->nbuckets; ++b)
+		w->sizes[maxsize - (w->start[b + 1] - w->start[b]) + 1]++;
+	for (n = 1; n <= maxsize + 1; ++n)
+		w->sizes[n] += w->sizes[n - 1];
+	for (b = 0; b < f->nbuckets; ++b)
+		w->buckets[w->sizes[maxsize -
+		    (w->start[b + 1] - w->start[b])]++] = b;
+	/* find a pilot for each bucket */
+	memset(w->taken, 0, (f->size + 63) / 64 * sizeof *w->taken);
+	for (i = 0; i < f->nbuckets; ++i) {
+		b = w->buckets[i];
+		first = w->start[b];
+		if ((n = w->start[b + 1] - first) == 0)
+			break;
+		if ((ret = mph_check_bucket(keys, w, first, n)) != 0)
+			return (ret);
+		for (pilot = 0; pilot <= MPH_MAX_PILOT; ++pilot) {
+			ph = mph_pilot_hash(pilot, f->seed);
+			for (j = 0; j < n; ++j) {
+				pos = mph_position(w->hashes[w->order[first +
+				    j]].h2, ph, f->size);
+				if (MPH_TAKEN(w, pos))
+					break;
+				MPH_TAKE(w, pos);
+				w->pos[j] = pos;
+			}
+			if (j == n)
+				break;
+			while (j-- > 0)
+				MPH_FREE(w, w->pos[j]);
+		}
+		if (pilot > MPH_MAX_PILOT)
+			return (1);
+		le16enc(pilots + b * 2, pilot);
+	}
+	/* remap the slots beyond count to the free slots below it */
+	for (pos = f->count, slot = 0; pos < f->size; ++pos) {
+		if (MPH_TAKEN(w, pos)) {
+			while (MPH_TAKEN(w, slot))
+				++slot;
+			le32enc(remap + (pos - f->count) * 4, slot++);
+		} else {
+			le32enc(remap + (pos - f->count) * 4, 0);
+		}
+	}
+	return (0);
+}
+
+/*
+ * Build a minimal perfect hash function for the given keys, which must
+ * be distinct.  If no function can be found using the given seed,
+ * which is exceedingly unlikely, the next few seeds are tried.
+ */
+mph *
+mph_build(const hash_key *keys, size_t n, uint64_t seed)
+{
+	struct mph_work w;
+	uint8_t *image;
+	mph *f;
+	size_t len;
+	unsigned int tries;
+	int ret;
+
+	if (n > MPH_MAX_KEYS) {
+		errno = EINVAL;
+		return (NULL);
+	}
+	if ((f = calloc(1, sizeof *f)) == NULL)
+		return (NULL);
+	f->count = n;
+	f->nbuckets = MPH_NBUCKETS(f->count);
+	f->size = MPH_SIZE(f->count);
+	len = MPH_IMAGE_LEN((size_t)f->count, (size_t)f->nbuckets,
+	    (size_t)f->size);
+	memset(&w, 0, sizeof w);
+	if ((f->base = calloc(1, len)) == NULL ||
+	    (w.hashes = calloc(n + 1, sizeof *w.hashes)) == NULL ||
+	    (w.order = calloc(n + 1, sizeof *w.order)) == NULL ||
+	    (w.start = calloc(f->nbuckets + 1, sizeof *w.start)) == NULL ||
+	    (w.buckets = calloc(f->nbuckets, sizeof *w.buckets)) == NULL ||
+	    (w.sizes = calloc(n + 2, sizeof *w.sizes)) == NULL ||
+	    (w.pos = calloc(n + 1, sizeof *w.pos)) == NULL ||
+	    (w.taken = calloc((f->size + 63) / 64, sizeof *w.taken)) == NULL) {
+		ret = -1;
+		goto done;
+	}
+	image = f->base;
+	for (tries = 0; tries < MPH_MAX_TRIES; ++tries, ++seed) {
+		f->seed = seed;
+		memset(image, 0, len);
+		ret = mph_try(f, image + MPH_HEADER_LEN,
+		    image + MPH_HEADER_LEN + MPH_PILOTS_LEN(f->nbuckets),
+		    keys, &w);
+		if (ret <= 0)
+			break;
+	}
+	if (ret < 0)
+		errno = EINVAL;
+	else if (ret > 0)
+		errno = EAGAIN;
+	else {
+		memcpy(image, MPH_MAGIC, MPH_MAGIC_LEN);
+		le32enc(image + MPH_OFF_COUNT, f->count);
+		le32enc(image + MPH_OFF_NBUCKETS, f->nbuckets);
+		le32enc(image + MPH_OFF_SIZE, f->size);
+		le64enc(image + MPH_OFF_SEED, f->seed);
+		f->image = image;
+		f->pilots = image + MPH_HEADER_LEN;
+		f->remap = f->pilots + MPH_PILOTS_LEN(f->nbuckets);
+	}
+done:
+	free(w.taken);
+	free(w.pos);
+	free(w.sizes);
+	free(w.buckets);
+	free(w.start);
+	free(w.order);
+	free(w.hashes);
+	if (ret != 0) {
+		mph_delete(f);
+		return (NULL);
+	}
+	return (f);
+}
+
+/*
+ * Create a function from an image previously obtained from
+ * mph_image().  The image is used in place and must remain valid for
+ * the lifetime of the function.
+ */
+mph *
+mph_load(const void *buf, size_t len)
+{
+	const uint8_t *image = buf;
+	uint32_t count, nbuckets, size, pos;
+	mph *f;
+
+	if (len < MPH_HEADER_LEN ||
+	    memcmp(image, MPH_MAGIC, MPH_MAGIC_LEN) != 0) {
+		errno = EINVAL;
+		return (NULL);
+	}
+	count = le32dec(image + MPH_OFF_COUNT);
+	nbuckets = le32dec(image + MPH_OFF_NBUCKETS);
+	size = le32dec(image + MPH_OFF_SIZE);
+	if (count > MPH_MAX_KEYS || nbuckets != MPH_NBUCKETS(count) ||
+	    size != MPH_SIZE(count) || len != MPH_IMAGE_LEN((size_t)count,
+	    (size_t)nbuckets, (size_t)size)) {
+		errno = EINVAL;
+		return (NULL);
+	}
+	if ((f = calloc(1, sizeof *f)) == NULL)
+		return (NULL);
+	f->image = image;
+	f->pilots = image + MPH_HEADER_LEN;
+	f->remap = f->pilots + MPH_PILOTS_LEN(nbuckets);
+	f->count = count;
+	f->nbuckets = nbuckets;
+	f->size = size;
+	f->seed = le64dec(image + MPH_OFF_SEED);
+	/* make sure lookups cannot stray outside [0, count) */
+	for (pos = 0; pos < size - count; ++pos) {
+		if (le32dec(f->remap + pos * 4) >= count &&
+		    le32dec(f->remap + pos * 4) != 0) {
+			free(f);
+			errno = EINVAL;
+			return (NULL);
+		}
+	}
+	return (f);
+}
+
+/*
+ * Delete a function
+ */
+void
+mph_delete(mph *f)
+{
+
+	if (f != NULL) {
+		free(f->base);
+		free(f);
+	}
+}
+
+/*
+ * Return the image of a function and its length
+ */
+const void *
+mph_image(const mph *f, size_t *len)
+{
+
+	*len = MPH_IMAGE_LEN((size_t)f->count, (size_t)f->nbuckets,
+	    (size_t)f->size);
+	return (f->image);
+}
+
+/*
+ * Return the number of keys
+ */
+size_t
+mph_count(const mph *f)
+{
+
+	return (f->count);
+}
+
+/*
+ * Look up a key.  The result is only meaningful for keys which were
+ * part of the set the function was built for.
+ */
+size_t
+mph_lookup(const mph *f, const void *key, size_t len)
+{
+	struct mph_hash mh;
+
+	mph_hash(key, len, f->seed, &mh);
+	return (mph_index(f, &mh));
+}
+
+/*
+ * Look up multiple keys, storing the results in the corresponding
+ * elements of an array.  The keys are hashed a few at a time and their
+ * pilots prefetched before any of them is looked up.
+ */
+void
+mph_lookup_many(const mph *f, const hash_key *keys, size_t n,
+    size_t *results)
+{
+	struct mph_hash mh[MPH_PREFETCH];
+	size_t i, j, m;
+
+	for (i = 0; i < n; i += m) {
+		m = n - i < MPH_PREFETCH ? n - i : MPH_PREFETCH;
+		for (j = 0; j < m; ++j) {
+			mph_hash(keys[i + j].data, keys[i + j].len, f->seed,
+			    &mh[j]);
+			mph_prefetch(f->pilots +
+			    mph_bucket(mh[j].h1, f->nbuckets) * 2);
+		}
+		for (j = 0; j < m; ++j)
+			results[i + j] = mph_index(f, &mh[j]);
+	}
+}
@@ -0,0 +1,329 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <cryb/bitwise.h>
+#include <cryb/endian.h>
+#include <cryb/hash.h>
+
+/*
+ * Load little-endian words.  As in the 32-bit variant, the fixed-size
+ * memcpy() compiles to a single unaligned load.
+ */
+static inline uint32_t
+murmur3_load32(const uint8_t *p)
+{
+	uint32_t k;
+
+	memcpy(&k, p, sizeof k);
+	return (le32toh(k));
+}
+
+static inline uint64_t
+murmur3_load64(const uint8_t *p)
+{
+	uint64_t k;
+
+	memcpy(&k, p, sizeof k);
+	return (le64toh(k));
+}
+
+static inline uint32_t
+murmur3_fmix32(uint32_t h)
+{
+
+	h ^= h >> 16;
+	h *= 0x85ebca6b;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35;
+	h ^= h >> 16;
+	return (h);
+}
+
+static inline uint64_t
+murmur3_fmix64(uint64_t k)
+{
+
+	k ^= k >> 33;
+	k *= 0xff51afd7ed558ccdLLU;
+	k ^= k >> 33;
+	k *= 0xc4ceb9fe1a85ec53LLU;
+	k ^= k >> 33;
+	return (k);
+}
+
+#define MURMUR3_X86_C1	0x239b961bU
+#define MURMUR3_X86_C2	0xab0e9789U
+#define MURMUR3_X86_C3	0x38b34ae5U
+#define MURMUR3_X86_C4	0xa1e38b93U
+
+/*
+ * 128-bit MurmurHash3 optimized for 32-bit platforms.  The output is
+ * the four 32-bit state words, each in little-endian order.
+ */
+void
+murmur3_x86_128_hash(const void *data, size_t len, uint32_t seed,
+    uint8_t *out)
+{
+	const uint8_t *bytes;
+	uint32_t h1, h2, h3, h4, k1, k2, k3, k4;
+	size_t rem;
+
+	h1 = h2 = h3 = h4 = seed;
+	for (bytes = data, rem = len; rem >= 16; bytes += 16, rem -= 16) {
+		k1 = murmur3_load32(bytes);
+		k2 = murmur3_load32(bytes + 4);
+		k3 = murmur3_load32(bytes + 8);
+		k4 = murmur3_load32(bytes + 12);
+		k1 *= MURMUR3_X86_C1;
+		k1 = rol32(k1, 15);
+		k1 *= MURMUR3_X86_C2;
+		h1 ^= k1;
+		h1 = rol32(h1, 19);
+		h1 += h2;
+		h1 = h1 * 5 + 0x561ccd1b;
+		k2 *= MURMUR3_X86_C2;
+		k2 = rol32(k2, 16);
+		k2 *= MURMUR3_X86_C3;
+		h2 ^= k2;
+		h2 = rol32(h2, 17);
+		h2 += h3;
+		h2 = h2 * 5 + 0x0bcaa747;
+		k3 *= MURMUR3_X86_C3;
+		k3 = rol32(k3, 17);
+		k3 *= MURMUR3_X86_C4;
+		h3 ^= k3;
+		h3 = rol32(h3, 15);
+		h3 += h4;
+		h3 = h3 * 5 + 0x96cd1c35;
+		k4 *= MURMUR3_X86_C4;
+		k4 = rol32(k4, 18);
+		k4 *= MURMUR3_X86_C1;
+		h4 ^= k4;
+		h4 = rol32(h4, 13);
+		h4 += h1;
+		h4 = h4 * 5 + 0x32ac3b17;
+	}
+	k1 = k2 = k3 = k4 = 0;
+	switch (rem) {
+	case 15:
+		k4 ^= (uint32_t)bytes[14] << 16;
+		/* fall through */
+	case 14:
+		k4 ^= (uint32_t)bytes[13] << 8;
+		/* fall through */
+	case 13:
+		k4 ^= (uint32_t)bytes[12];
+		k4 *= MURMUR3_X86_C4;
+		k4 = rol32(k4, 18);
+		k4 *= MURMUR3_X86_C1;
+		h4 ^= k4;
+		/* fall through */
+	case 12:
+		k3 ^= (uint32_t)bytes[11] << 24;
+		/* fall through */
+	case 11:
+		k3 ^= (uint32_t)bytes[10] << 16;
+		/* fall through */
+	case 10:
+		k3 ^= (uint32_t)bytes[9] << 8;
+		/* fall through */
+	case 9:
+		k3 ^= (uint32_t)bytes[8];
+		k3 *= MURMUR3_X86_C3;
+		k3 = rol32(k3, 17);
+		k3 *= MURMUR3_X86_C4;
+		h3 ^= k3;
+		/* fall through */
+	case 8:
+		k2 ^= (uint32_t)bytes[7] << 24;
+		/* fall through */
+	case 7:
+		k2 ^= (uint32_t)bytes[6] << 16;
+		/* fall through */
+	case 6:
+		k2 ^= (uint32_t)bytes[5] << 8;
+		/* fall through */
+	case 5:
+		k2 ^= (uint32_t)bytes[4];
+		k2 *= MURMUR3_X86_C2;
+		k2 = rol32(k2, 16);
+		k2 *= MURMUR3_X86_C3;
+		h2 ^= k2;
+		/* fall through */
+	case 4:
+		k1 ^= (uint32_t)bytes[3] << 24;
+		/* fall through */
+	case 3:
+		k1 ^= (uint32_t)bytes[2] << 16;
+		/* fall through */
+	case 2:
+		k1 ^= (uint32_t)bytes[1] << 8;
+		/* fall through */
+	case 1:
+		k1 ^= (uint32_t)bytes[0];
+		k1 *= MURMUR3_X86_C1;
+		k1 = rol32(k1, 15);
+		k1 *= MURMUR3_X86_C2;
+		h1 ^= k1;
+		break;
+	case 0:
+		break;
+	CRYB_NO_DEFAULT_CASE;
+	}
+	h1 ^= (uint32_t)len;
+	h2 ^= (uint32_t)len;
+	h3 ^= (uint32_t)len;
+	h4 ^= (uint32_t)len;
+	h1 += h2 + h3 + h4;
+	h2 += h1;
+	h3 += h1;
+	h4 += h1;
+	h1 = murmur3_fmix32(h1);
+	h2 = murmur3_fmix32(h2);
+	h3 = murmur3_fmix32(h3);
+	h4 = murmur3_fmix32(h4);
+	h1 += h2 + h3 + h4;
+	h2 += h1;
+	h3 += h1;
+	h4 += h1;
+	le32enc(out, h1);
+	le32enc(out + 4, h2);
+	le32enc(out + 8, h3);
+	le32enc(out + 12, h4);
+}
+
+#define MURMUR3_X64_C1	0x87c37b91114253d5LLU
+#define MURMUR3_X64_C2	0x4cf5ad432745937fLLU
+
+/*
+ * 128-bit MurmurHash3 optimized for 64-bit platforms.  The output is
+ * the two 64-bit state words, each in little-endian order.
+ */
+void
+murmur3_x64_128_hash(const void *data, size_t len, uint32_t seed,
+    uint8_t *out)
+{
+	const uint8_t *bytes;
+	uint64_t h1, h2, k1, k2;
+	size_t rem;
+
+	h1 = h2 = seed;
+	for (bytes = data, rem = len; rem >= 16; bytes += 16, rem -= 16) {
+		k1 = murmur3_load64(bytes);
+		k2 = murmur3_load64(bytes + 8);
+		k1 *= MURMUR3_X64_C1;
+		k1 = rol64(k1, 31);
+		k1 *= MURMUR3_X64_C2;
+		h1 ^= k1;
+		h1 = rol64(h1, 27);
+		h1 += h2;
+		h1 = h1 * 5 + 0x52dce729;
+		k2 *= MURMUR3_X64_C2;
+		k2 = rol64(k2, 33);
+		k2 *= MURMUR3_X64_C1;
+		h2 ^= k2;
+		h2 = rol64(h2, 31);
+		h2 += h1;
+		h2 = h2 * 5 + 0x38495ab5;
+	}
+	k1 = k2 = 0;
+	switch (rem) {
+	case 15:
+		k2 ^= (uint64_t)bytes[14] << 48;
+		/* fall through */
+	case 14:
+		k2 ^= (uint64_t)bytes[13] << 40;
+		/* fall through */
+	case 13:
+		k2 ^= (uint64_t)bytes[12] << 32;
+		/* fall through */
+	case 12:
+		k2 ^= (uint64_t)bytes[11] << 24;
+		/* fall through */
+	case 11:
+		k2 ^= (uint64_t)bytes[10] << 16;
+		/* fall through */
+	case 10:
+		k2 ^= (uint64_t)bytes[9] << 8;
+		/* fall through */
+	case 9:
+		k2 ^= (uint64_t)bytes[8];
+		k2 *= MURMUR3_X64_C2;
+		k2 = rol64(k2, 33);
+		k2 *= MURMUR3_X64_C1;
+		h2 ^= k2;
+		/* fall through */
+	case 8:
+		k1 ^= (uint64_t)bytes[7] << 56;
+		/* fall through */
+	case 7:
+		k1 ^= (uint64_t)bytes[6] << 48;
+		/* fall through */
+	case 6:
+		k1 ^= (uint64_t)bytes[5] << 40;
+		/* fall through */
+	case 5:
+		k1 ^= (uint64_t)bytes[4] << 32;
+		/* fall through */
+	case 4:
+		k1 ^= (uint64_t)bytes[3] << 24;
+		/* fall through */
+	case 3:
+		k1 ^= (uint64_t)bytes[2] << 16;
+		/* fall through */
+	case 2:
+		k1 ^= (uint64_t)bytes[1] << 8;
+		/* fall through */
+	case 1:
+		k1 ^= (uint64_t)bytes[0];
+		k1 *= MURMUR3_X64_C1;
+		k1 = rol64(k1, 31);
+		k1 *= MURMUR3_X64_C2;
+		h1 ^= k1;
+		break;
+	case 0:
+		break;
+	CRYB_NO_DEFAULT_CASE;
+	}
+	h1 ^= (uint64_t)len;
+	h2 ^= (uint64_t)len;
+	h1 += h2;
+	h2 += h1;
+	h1 = murmur3_fmix64(h1);
+	h2 = murmur3_fmix64(h2);
+	h1 += h2;
+	h2 += h1;
+	le64enc(out, h1);
+	le64enc(out + 8, h2);
+}
@@ -36,43 +36,48 @@
 #include <cryb/endian.h>
 #include <cryb/hash.h>
 
+#include "cryb_hash_impl.h"
+
 /*
- * Simple implementation of the Murmur3-32 hash function.
- *
- * This implementation is slow but safe.  It can be made significantly
- * faster if the caller guarantees that the input is correctly aligned for
- * 32-bit reads, and slightly faster yet if the caller guarantees that the
- * length of the input is always a multiple of 4 bytes.
+ * Load a little-endian 32-bit word.  The compiler turns the fixed-size
+ * memcpy() into a single load, which is safe regardless of alignment,
+ * and le32toh() is a no-op on little-endian hosts.
  */
-uint32_t
-murmur3_32_hash(const void *data, size_t len, uint32_t seed)
+static inline uint32_t
+murmur3_load32(const uint8_t *p)
 {
-	const uint8_t *bytes;
-	uint32_t hash, k;
-	size_t res;
+	uint32_t k;
 
-	/* initialization */
-	bytes = data;
-	res = len;
-	hash = seed;
+	memcpy(&k, p, sizeof k);
+	return (le32toh(k));
+}
 
-	/* main loop */
-	while (res >= 4) {
-		/* replace with le32toh() if input is aligned */
-		k = le32dec(bytes);
-		bytes += 4;
-		res -= 4;
-		k *= 0xcc9e2d51;
-		k = rol32(k, 15);
-		k *= 0x1b873593;
-		hash ^= k;
-		hash = rol32(hash, 13);
-		hash *= 5;
-		hash += 0xe6546b64;
-	}
+static inline uint32_t
+murmur3_32_scramble(uint32_t k)
+{
+
+	k *= 0xcc9e2d51;
+	k = rol32(k, 15);
+	k *= 0x1b873593;
+	return (k);
+}
+
+static inline uint32_t
+murmur3_32_block(uint32_t hash, uint32_t k)
+{
+
+	hash ^= murmur3_32_scramble(k);
+	hash = rol32(hash, 13);
+	hash *= 5;
+	hash += 0xe6546b64;
+	return (hash);
+}
+
+static inline uint32_t
+murmur3_32_tail(uint32_t hash, const uint8_t *bytes, size_t res)
+{
+	uint32_t k;
 
-	/* remainder */
-	/* remove if input length is a multiple of 4 */
 	if (res > 0) {
 		k = 0;
 		switch (res) {
@@ -84,16 +89,18 @@ murmur3_32_hash(const void *data, size_t len, uint32_t seed)
 			/* fall through */
 		case 1:
 			k |= bytes[0];
-			k *= 0xcc9e2d51;
-			k = rol32(k, 15);
-			k *= 0x1b873593;
-			hash ^= k;
+			hash ^= murmur3_32_scramble(k);
 			break;
 		CRYB_NO_DEFAULT_CASE;
 		}
 	}
+	return (hash);
+}
+
+static inline uint32_t
+murmur3_32_finalize(uint32_t hash, size_t len)
+{
 
-	/* finalize */
 	hash ^= (uint32_t)len;
 	hash ^= hash >> 16;
 	hash *= 0x85ebca6b;
@@ -102,3 +109,177 @@ murmur3_32_hash(const void *data, size_t len, uint32_t seed)
 	hash ^= hash >> 16;
 	return (hash);
 }
+
+/*
+ * Implementation of the Murmur3-32 hash function.
+ *
+ * The input is read a word at a time regardless of its alignment.  It
+ * can be made slightly faster if the caller guarantees that the length
+ * of the input is always a multiple of 4 bytes.
+ */
+uint32_t
+murmur3_32_hash(const void *data, size_t len, uint32_t seed)
+{
+	const uint8_t *bytes;
+	uint32_t hash;
+	size_t res;
+
+	/* initialization */
+	bytes = data;
+	res = len;
+	hash = seed;
+
+	/* main loop */
+	while (res >= 4) {
+		hash = murmur3_32_block(hash, murmur3_load32(bytes));
+		bytes += 4;
+		res -= 4;
+	}
+
+	/* remainder */
+	/* remove if input length is a multiple of 4 */
+	hash = murmur3_32_tail(hash, bytes, res);
+
+	/* finalize */
+	return (murmur3_32_finalize(hash, len));
+}
+
+/*
+ * Batch interface.  We hash HASH_MANY_LANES keys at a time, running the
+ * blocks they have in common in lockstep so that the dependency chains
+ * of different keys overlap, then finish each key separately.
+ */
+static inline uint32_t
+murmur3_32_finish(uint32_t hash, const uint8_t *bytes, size_t res,
+    size_t len)
+{
+
+	for (; res >= 4; bytes += 4, res -= 4)
+		hash = murmur3_32_block(hash, murmur3_load32(bytes));
+	hash = murmur3_32_tail(hash, bytes, res);
+	return (murmur3_32_finalize(hash, len));
+}
+
+void
+murmur3_32_hash_many(const hash_key *keys, size_t n, uint32_t seed,
+    uint32_t *out)
+{
+	const uint8_t *p0, *p1, *p2, *p3;
+	uint32_t h0, h1, h2, h3;
+	size_t i, j, m;
+
+	for (; n >= HASH_MANY_LANES; keys += HASH_MANY_LANES,
+	    out += HASH_MANY_LANES, n -= HASH_MANY_LANES) {
+		p0 = keys[0].data;
+		p1 = keys[1].data;
+		p2 = keys[2].data;
+		p3 = keys[3].data;
+		m = keys[0].len;
+		for (i = 1; i < HASH_MANY_LANES; ++i)
+			if (keys[i].len < m)
+				m = keys[i].len;
+		m &= ~(size_t)3;
+		h0 = h1 = h2 = h3 = seed;
+		for (j = 0; j < m; j += 4) {
+			h0 = murmur3_32_block(h0, murmur3_load32(p0 + j));
+			h1 = murmur3_32_block(h1, murmur3_load32(p1 + j));
+			h2 = murmur3_32_block(h2, murmur3_load32(p2 + j));
+			h3 = murmur3_32_block(h3, murmur3_load32(p3 + j));
+		}
+		out[0] = murmur3_32_finish(h0, p0 + m, keys[0].len - m,
+		    keys[0].len);
+		out[1] = murmur3_32_finish(h1, p1 + m, keys[1].len - m,
+		    keys[1].len);
+		out[2] = murmur3_32_finish(h2, p2 + m, keys[2].len - m,
+		    keys[2].len);
+		out[3] = murmur3_32_finish(h3, p3 + m, keys[3].len - m,
+		    keys[3].len);
+	}
+	for (i = 0; i < n; ++i)
+		out[i] = murmur3_32_hash(keys[i].data, keys[i].len, seed);
+}
+
+/*
+ * Streaming interface.  Input which does not fill a whole 4-byte block
+ * is held back in the context until either more data arrives or the
+ * hash is finalized.
+ */
+void
+murmur3_32_init(murmur3_32_ctx *ctx, uint32_t seed)
+{
+
+	ctx->h = seed;
+	ctx->buflen = 0;
+	ctx->len = 0;
+}
+
+void
+murmur3_32_update(murmur3_32_ctx *ctx, const void *data, size_t len)
+{
+	const uint8_t *bytes;
+	uint32_t hash;
+
+	bytes = data;
+	hash = ctx->h;
+	ctx->len += len;
+	if (ctx->buflen > 0) {
+		while (ctx->buflen < 4 && len > 0) {
+			ctx->buf[ctx->buflen++] = *bytes++;
+			len--;
+		}
+		if (ctx->buflen < 4)
+			return;
+		hash = murmur3_32_block(hash, le32dec(ctx->buf));
+		ctx->buflen = 0;
+	}
+	for (; len >= 4; bytes += 4, len -= 4)
+		hash = murmur3_32_block(hash, murmur3_load32(bytes));
+	while (len-- > 0)
+		ctx->buf[ctx->buflen++] = *bytes++;
+	ctx->h = hash;
+}
+
+uint32_t
+murmur3_32_final(murmur3_32_ctx *ctx)
+{
+	uint32_t hash;
+
+	hash = murmur3_32_tail(ctx->h, ctx->buf, ctx->buflen);
+	return (murmur3_32_finalize(hash, ctx->len));
+}
+
+/*
+ * The seed is passed to the generic interface as four bytes in
+ * little-endian order.
+ */
+static void
+murmur3_32_hash_init(hash_ctx *ctx, const void *key)
+{
+
+	murmur3_32_init(ctx, key == NULL ? 0 : le32dec(key));
+}
+
+static uint64_t
+murmur3_32_hash_final(hash_ctx *ctx)
+{
+
+	return (murmur3_32_final(ctx));
+}
+
+static uint64_t
+murmur3_32_hash_complete(const void *data, size_t len, const void *key)
+{
+
+	return (murmur3_32_hash(data, len, key == NULL ? 0 : le32dec(key)));
+}
+
+const hash_algorithm murmur3_32_hash_algorithm = {
+	.name			 = "murmur3-32",
+	.contextlen		 = sizeof(murmur3_32_ctx),
+	.keylen			 = sizeof(uint32_t),
+	.hashlen		 = sizeof(uint32_t),
+	.init			 = murmur3_32_hash_init,
+	.update			 = (hash_update_func)(void *)murmur3_32_update,
+	.final			 = murmur3_32_hash_final,
+	.complete		 = murmur3_32_hash_complete,
+};
@@ -34,6 +34,8 @@
 
 #include <cryb/hash.h>
 
+#include "cryb_hash_impl.h"
+
 /*
  * Implementation of the hash function described in Pearson, Peter
  * K. (June 1990), "Fast Hashing of Variable-Length Text Strings",
@@ -75,15 +77,39 @@ static const uint8_t T[256] = {
 	0xc2,	0x8b,	0x70,	0x2b,	0x47,	0x6d,	0xb8,	0xd1,
 };
 
-uint8_t
-pearson_hash(const void *data, size_t len)
+void
+pearson_init(pearson_ctx *ctx)
+{
+
+	ctx->h = 0;
+}
+
+void
+pearson_update(pearson_ctx *ctx, const void *data, size_t len)
 {
 	const uint8_t *p;
 	uint8_t h;
 
-	for (p = data, h = 0; len > 0; ++p, --len)
+	for (p = data, h = ctx->h; len > 0; ++p, --len)
 		h = T[h ^ *p];
-	return (h);
+	ctx->h = h;
+}
+
+uint8_t
+pearson_final(pearson_ctx *ctx)
+{
+
+	return (ctx->h);
+}
+
+uint8_t
+pearson_hash(const void *data, size_t len)
+{
+	pearson_ctx ctx;
+
+	pearson_init(&ctx);
+	pearson_update(&ctx, data, len);
+	return (pearson_final(&ctx));
 }
 
 uint8_t
@@ -95,3 +121,5 @@ pearson_hash_str(const char *str)
 		h = T[h ^ (uint8_t)*str];
 	return (h);
 }
+
+CRYB_HASH_ALGORITHM_UNKEYED(pearson, "pearson", pearson_ctx, uint8_t);
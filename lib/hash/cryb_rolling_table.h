@@ -0,0 +1,170 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CRYB_ROLLING_TABLE_H_INCLUDED
+#define CRYB_ROLLING_TABLE_H_INCLUDED
+
+/*
+ * Byte substitution table shared by Buzhash and the Gear hash used by
+ * the content-defined chunker.  Both only need the entries to be
+ * independent and uniformly distributed; these are the first 256
+ * outputs of SplitMix64 seeded with 0x62757a6861736821 ("buzhash!").
+ */
+static const uint64_t rolling_table[256] = {
+	0x2e617cab89709ae1ULL, 0xd6daeacdc27313acULL,
+	0x51c35f9398348425ULL, 0x649c2c560d6f389eULL,
+	0x657c6cb6dcfc4468ULL, 0x9ce88da671ffc0c2ULL,
+	0x20b202128f7e131aULL, 0x8b2503d6498a9c7cULL,
+	0xc06677899e072e65ULL, 0xd9794e2f9db0eb1eULL,
+	0x90bb6bf80a47ef74ULL, 0x6c91577a0a4e34c9ULL,
+	0x8085a1d4dfd9bed2ULL, 0x2c15dd95e4f4610dULL,
+	0xf39924ef60604764ULL, 0x873a1ef7a3d7b9efULL,
+	0xd79a2cb8efa8839aULL, 0xe872ffd78fe4bdf9ULL,
+	0x2f0339f2fc34e0abULL, 0x185d3c82483c5e9dULL,
+	0xb71d9d2156696dd1ULL, 0xa3930092d1234e25ULL,
+	0x37204b913e09565bULL, 0x72784f8b1eb5e20eULL,
+	0x267b4818888c6fd7ULL, 0x3601ec742cb21d0dULL,
+	0x4c98232e2e32c538ULL, 0x5261dc5468e835f1ULL,
+	0xe727c9e6e3e2a6c1ULL, 0xc70e77d58b414685ULL,
+	0xadcc2cbbd8f76fb0ULL, 0x551b82de460b1829ULL,
+	0x69616481c74cbc58ULL, 0x771d856d7c400bdbULL,
+	0x9e329b90502ce4c2ULL, 0x2fb3d5443b7fcfe6ULL,
+	0x8cf556eee96ee34aULL, 0x993fecd7d71de0feULL,
+	0x11a9d06f740eff85ULL, 0xed86e14f2e408361ULL,
+	0xf540153b1722b6d7ULL, 0x698cf398abf08830ULL,
+	0x8345add10609ab5fULL, 0x544f64107e042f8dULL,
+	0x4605b8a30fae9accULL, 0xfb0c5722f086ab05ULL,
+	0x6c5e4b75a9f01ecdULL, 0xbb1675ffadc17d8aULL,
+	0xaf23c81082d22667ULL, 0xb8bf6217ea873841ULL,
+	0xb28d795123aebf29ULL, 0x317b5220ad991e28ULL,
+	0x34b98ed8431f899bULL, 0x24b82e9618dfea8cULL,
+	0xd22ee71b9eec54a6ULL, 0xc0da9f92ed100272ULL,
+	0xadf9cfb4c5fef8d3ULL, 0x247d680722002204ULL,
+	0x0aee76ed4465061dULL, 0xf32cd3ec63524e2dULL,
+	0x5776f12b195b4c14ULL, 0x1b5b0cf547b40846ULL,
+	0xd0b45d36461c2768ULL, 0x68853b2eda525c14ULL,
+	0x4bc1aafb7a148961ULL, 0xde9999bfd98f7b2cULL,
+	0x91c497229758ee02ULL, 0x898f8a0814a37d61ULL,
+	0x2c2ce0e43a2dacf9ULL, 0x1c1a0375ccd6d12bULL,
+	0xc14b94d0f2cc6121ULL, 0x39158604907b53e1ULL,
+	0x7a4e9e114347a2beULL, 0xc3476367a3e45212ULL,
+	0xe8e1de8a784c11e9ULL, 0x462e5cbada3a7609ULL,
+	0x28f1acf680d41044ULL, 0x23bb5cb144b34370ULL,
+	0xd4c01f8be4ceed1aULL, 0x9d93854dc1b4d857ULL,
+	0xa0ace402bc576b25ULL, 0x3de9a4187577dd2fULL,
+	0x2f6ad483fb8a3937ULL, 0x62a85c3a867c2d67ULL,
+	0x3ffb594cfddab298ULL, 0x77c08644510c0093ULL,
+	0x991bce45a7d3722eULL, 0x8304f619aabb5a46ULL,
+	0x1fb44a598c204409ULL, 0xb713c16601913850ULL,
+	0x6f3011881bbf7064ULL, 0xf315d2539bd6f991ULL,
+	0x67cb68fdc974b0d2ULL, 0x223948da6e9b16e0ULL,
+	0x5295ede1296edc3aULL, 0x5d59cb9cf47972f9ULL,
+	0x0d29cb84d074cf1cULL, 0x4bf9c8b156d049f4ULL,
+	0xd9f61cc15567d627ULL, 0x19a05b18ecbd4216ULL,
+	0x79f47b1d8ff1c468ULL, 0x6677e6cb917cef5eULL,
+	0xe9f9fc7744fbbf45ULL, 0xf315df8c50920a0bULL,
+	0xdf2130e659f6b700ULL, 0x986111e98952bf85ULL,
+	0x281644382e30cf06ULL, 0x182f0a2fbbcdf576ULL,
+	0x002c9163f8bf2763ULL, 0xdb7ad4ae8e148dacULL,
+	0xc63c5ae2fe6bab52ULL, 0xcc68f2024db2b4acULL,
+	0x7e6045a089ed56eeULL, 0xc3aa77395ede58e0ULL,
+	0x250a42e8a249149aULL, 0x345843ad94434597ULL,
+	0xc2cea51d726bd8b6ULL, 0x92541314d589dc64ULL,
+	0xd954edad6bae25f7ULL, 0xf0bac6d83c712094ULL,
+	0x86d11eef4cb7e5ebULL, 0x6ca5669b2ab956c7ULL,
+	0x53d8ea73a15be32fULL, 0x5c9641e67e06658cULL,
+	0x32f8e99125951e8aULL, 0x319dd1f8495e0a3aULL,
+	0x900cc366b560625cULL, 0xdeedcf60e7511fd0ULL,
+	0x30c990e1741d16c7ULL, 0x46d1697fc07bad43ULL,
+	0x5c349d17e4730f9bULL, 0xacd9c08ce056c096ULL,
+	0xc27a1670fe4b8b87ULL, 0x0acc61c3d60dcc7aULL,
+	0xaf2f3e41f084177aULL, 0x1e1534cd42426b54ULL,
+	0x3fc7c309a5993b79ULL, 0xd6f4e916e0536471ULL,
+	0xbf8051935f6d5c7bULL, 0x765fd63d523259aaULL,
+	0x01d78abca61d276cULL, 0xbd42e25a2111e555ULL,
+	0x48d4366d891bdce2ULL, 0xb7116dbfa727de46ULL,
+	0xfe535d8875e00667ULL, 0x749ed1fe6e7f0f1aULL,
+	0xfc4fca333152fbc1ULL, 0xe7cdb7fc4cf4d8d7ULL,
+	0x79b9d519995ec968ULL, 0xb191844996c418f1ULL,
+	0xc7bd350eea06f7f4ULL, 0xd9d0b18c5cf5cad0ULL,
+	0x09744b1afa02b091ULL, 0xa0ca8d40ff136be6ULL,
+	0xb4f9da717039b593ULL, 0x3364bf6eaf3969e8ULL,
+	0x66b05981828d1251ULL, 0x0d2319b170cf258bULL,
+	0x77ad81f17307f51fULL, 0x664c0f6a9450d6e9ULL,
+	0x7f191fd7fe1cd29dULL, 0x734197385574fdfaULL,
+	0xb77161a649a06b32ULL, 0x4b2dd96e21b0edfdULL,
+	0xec90314172138199ULL, 0xeca39c57b08632fcULL,
+	0xcc2fdefec9505280ULL, 0x4b135b00b003257cULL,
+	0x2ffbca0bb9a2c130ULL, 0x3bf349dfef5510b4ULL,
+	0x78e9b9da019c064dULL, 0x2abc518bf3ad5d31ULL,
+	0xe3c571a4e80c0481ULL, 0xfbe71f459fc0d00cULL,
+	0x64bdf9126cd5fa8eULL, 0x6645009e112aebc8ULL,
+	0x937568e28bdefbbbULL, 0x8afcdcafb804c995ULL,
+	0xda7a2b800108784bULL, 0x90218b63d5c9e5f8ULL,
+	0xe47b4c00842fb60eULL, 0xacad540fc3334b8dULL,
+	0x185f690f51254af3ULL, 0xaeea641f974ec9edULL,
+	0xa09f9472aa5b7efcULL, 0x9ac86fa3180cd17fULL,
+	0x443c120baac38cfbULL, 0xda97abba664d21ffULL,
+	0x79f70382007c691dULL, 0x9d881253d48eef39ULL,
+	0xe372f68f4801dcb7ULL, 0x3c32b67bcc5d99ebULL,
+	0x59b9e2082c967fd8ULL, 0x92159a9868049b2fULL,
+	0xe2fc546daac0f6afULL, 0xf30bd5afcc2c156fULL,
+	0x1cbdca348807bf0cULL, 0x68cd7134760e048fULL,
+	0x86e60615cf06c86bULL, 0xbb1420ebe8ec575eULL,
+	0x096ffff04719f7fbULL, 0xbc6cf9a9158739c1ULL,
+	0xb071c1c77412c789ULL, 0x39621f881e81e006ULL,
+	0xcb8a84f22096abadULL, 0xe243bf0a18cc67a1ULL,
+	0xe3c07275ac161f1bULL, 0xa46b8ded0bb5a836ULL,
+	0xa20dc1b0dfc4fa31ULL, 0x8898d9ca95ba32fbULL,
+	0x1b36e21c85f4dee7ULL, 0x467a18ec5226c8acULL,
+	0xe5fba71480fee0bcULL, 0xe6854716a54a8ee7ULL,
+	0x279eda74fb53a1b3ULL, 0x1f63ece11129110dULL,
+	0x8ca4b9c54fc6f6eaULL, 0x279cc78d5c9473c0ULL,
+	0xadc212283e4d4625ULL, 0x65f159e5cc252ae2ULL,
+	0xcfff76a3dd1f5bf4ULL, 0x0594f69e797ad3e1ULL,
+	0x983d6aa8c3ca9d84ULL, 0xc93da51ddb03c789ULL,
+	0x0c23fa615d939744ULL, 0x8883c2a39a081cc9ULL,
+	0xbeb13e05992e238aULL, 0x16062fdac5652915ULL,
+	0x27a89beb8356d604ULL, 0xc955110d32326fa1ULL,
+	0x931dfe669948c18aULL, 0xac48c3adde807e04ULL,
+	0x683f2c52144476bdULL, 0x5d59430d2e2fefb6ULL,
+	0xa1f63a2653cfedf0ULL, 0x0cf4dc3a1a5dcef2ULL,
+	0xef038b0af3495578ULL, 0x41465276e25233c6ULL,
+	0xb148b1f3d5d4d8b8ULL, 0xcff1cb653f876b7fULL,
+	0x01b7c620e0a8354eULL, 0x88cab3982776bcdaULL,
+	0x3bdf2106819ffe75ULL, 0x9e2c0ab4d444ba6aULL,
+	0x09eaa4ec56ceb754ULL, 0x000e909a1a40528aULL,
+	0x79d74137564fcf69ULL, 0x8b6e1d52b710283eULL,
+	0xd2e31fab74805cf8ULL, 0x2b54d4d3ac3d2815ULL,
+	0x890bce057d8036daULL, 0x287357fd1e102377ULL,
+	0xd2f1a5eb9da65ef5ULL, 0xd3a5f694ecff3a55ULL,
+	0xf6dbe60b6b105553ULL, 0x5c517ad8c1d9b3acULL,
+};
+
+#endif
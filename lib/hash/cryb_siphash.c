@@ -0,0 +1,691 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <cryb/bitwise.h>
+#include <cryb/endian.h>
+#include <cryb/hash.h>
+
+#include "cryb_hash_impl.h"
+
+/*
+ * Implementation of the SipHash and HalfSipHash keyed hash functions, as
+ * described in J.-P. Aumasson and D. J. Bernstein, "SipHash: a fast
+ * short-input PRF" (2012).
+ *
+ * The common code is written as inline functions taking the number of
+ * compression and finalization rounds and the output length as
+ * arguments, so that each public function is compiled with these as
+ * constants.  The final partial block is read with at most three loads
+ * rather than one byte at a time, since short inputs are where SipHash
+ * spends most of its time.
+ *
+ * The streaming interface buffers a partial block in the context.  The
+ * output length is fixed when the context is initialized, so a context
+ * initialized with a _128_init() or _64_init() function must be
+ * finalized with the corresponding _final() function.
+ */
+
+/***************************************************************************
+ * SipHash
+ */
+
+#define SIPROUND(v0, v1, v2, v3)					\
+	do {								\
+		v0 += v1; v1 = rol64(v1, 13); v1 ^= v0; v0 = rol64(v0, 32); \
+		v2 += v3; v3 = rol64(v3, 16); v3 ^= v2;			\
+		v0 += v3; v3 = rol64(v3, 21); v3 ^= v0;			\
+		v2 += v1; v1 = rol64(v1, 17); v1 ^= v2; v2 = rol64(v2, 32); \
+	} while (0)
+
+/*
+ * Read the final 0 to 7 bytes of the input, pointed to by p, and combine
+ * them with the low byte of the total length.  If the input is at least
+ * one word long, read the last whole word and shift out the bytes that
+ * were already consumed.
+ */
+static inline uint64_t
+siphash_tail(const uint8_t *p, size_t res, size_t len)
+{
+	uint64_t b;
+
+	if (res == 0)
+		b = 0;
+	else if (len >= 8)
+		b = le64dec(p + res - 8) >> (64 - 8 * res);
+	else if (res >= 4)
+		b = le32dec(p) |
+		    (uint64_t)le32dec(p + res - 4) << (8 * (res - 4));
+	else
+		b = p[0] | (uint64_t)p[res / 2] << (8 * (res / 2)) |
+		    (uint64_t)p[res - 1] << (8 * (res - 1));
+	return (b | (uint64_t)len << 56);
+}
+
+static inline void
+siphash(const void *data, size_t len, const uint8_t *key,
+    unsigned int crounds, unsigned int drounds, uint8_t *out, size_t outlen)
+{
+	const uint8_t *p;
+	uint64_t k0, k1, v0, v1, v2, v3, b;
+	unsigned int i;
+	size_t res;
+
+	k0 = le64dec(key);
+	k1 = le64dec(key + 8);
+	v0 = k0 ^ 0x736f6d6570736575ULL;
+	v1 = k1 ^ 0x646f72616e646f6dULL;
+	v2 = k0 ^ 0x6c7967656e657261ULL;
+	v3 = k1 ^ 0x7465646279746573ULL;
+	if (outlen == 16)
+		v1 ^= 0xee;
+	for (p = data, res = len; res >= 8; p += 8, res -= 8) {
+		b = le64dec(p);
+		v3 ^= b;
+		for (i = 0; i < crounds; ++i)
+			SIPROUND(v0, v1, v2, v3);
+		v0 ^= b;
+	}
+	b = siphash_tail(p, res, len);
+	v3 ^= b;
+	for (i = 0; i < crounds; ++i)
+		SIPROUND(v0, v1, v2, v3);
+	v0 ^= b;
+	v2 ^= outlen == 16 ? 0xee : 0xff;
+	for (i = 0; i < drounds; ++i)
+		SIPROUND(v0, v1, v2, v3);
+	le64enc(out, v0 ^ v1 ^ v2 ^ v3);
+	if (outlen == 16) {
+		v1 ^= 0xdd;
+		for (i = 0; i < drounds; ++i)
+			SIPROUND(v0, v1, v2, v3);
+		le64enc(out + 8, v0 ^ v1 ^ v2 ^ v3);
+	}
+}
+
+uint64_t
+siphash24_hash(const void *data, size_t len, const uint8_t *key)
+{
+	uint8_t out[8];
+
+	siphash(data, len, key, 2, 4, out, sizeof out);
+	return (le64dec(out));
+}
+
+void
+siphash24_128_hash(const void *data, size_t len, const uint8_t *key,
+    uint8_t *out)
+{
+
+	siphash(data, len, key, 2, 4, out, 16);
+}
+
+uint64_t
+siphash13_hash(const void *data, size_t len, const uint8_t *key)
+{
+	uint8_t out[8];
+
+	siphash(data, len, key, 1, 3, out, sizeof out);
+	return (le64dec(out));
+}
+
+void
+siphash13_128_hash(const void *data, size_t len, const uint8_t *key,
+    uint8_t *out)
+{
+
+	siphash(data, len, key, 1, 3, out, 16);
+}
+
+static inline void
+siphash_init(siphash_ctx *ctx, const uint8_t *key, size_t outlen)
+{
+	uint64_t k0, k1;
+
+	k0 = le64dec(key);
+	k1 = le64dec(key + 8);
+	ctx->v0 = k0 ^ 0x736f6d6570736575ULL;
+	ctx->v1 = k1 ^ 0x646f72616e646f6dULL;
+	ctx->v2 = k0 ^ 0x6c7967656e657261ULL;
+	ctx->v3 = k1 ^ 0x7465646279746573ULL;
+	if (outlen == 16)
+		ctx->v1 ^= 0xee;
+	ctx->buflen = 0;
+	ctx->len = 0;
+}
+
+static inline void
+siphash_update(siphash_ctx *ctx, const void *data, size_t len,
+    unsigned int crounds)
+{
+	const uint8_t *p;
+	uint64_t v0, v1, v2, v3, b;
+	unsigned int i;
+
+	p = data;
+	ctx->len += len;
+	if (ctx->buflen > 0) {
+		while (ctx->buflen < 8 && len > 0) {
+			ctx->buf[ctx->buflen++] = *p++;
+			len--;
+		}
+		if (ctx->buflen < 8)
+			return;
+	}
+	v0 = ctx->v0;
+	v1 = ctx->v1;
+	v2 = ctx->v2;
+	v3 = ctx->v3;
+	if (ctx->buflen > 0) {
+		b = le64dec(ctx->buf);
+		v3 ^= b;
+		for (i = 0; i < crounds; ++i)
+			SIPROUND(v0, v1, v2, v3);
+		v0 ^= b;
+		ctx->buflen = 0;
+	}
+	for (; len >= 8; p += 8, len -= 8) {
+		b = le64dec(p);
+		v3 ^= b;
+		for (i = 0; i < crounds; ++i)
+			SIPROUND(v0, v1, v2, v3);
+		v0 ^= b;
+	}
+	while (len-- > 0)
+		ctx->buf[ctx->buflen++] = *p++;
+	ctx->v0 = v0;
+	ctx->v1 = v1;
+	ctx->v2 = v2;
+	ctx->v3 = v3;
+}
+
+static inline void
+siphash_final(siphash_ctx *ctx, unsigned int crounds, unsigned int drounds,
+    uint8_t *out, size_t outlen)
+{
+	uint64_t v0, v1, v2, v3, b;
+	unsigned int i;
+
+	v0 = ctx->v0;
+	v1 = ctx->v1;
+	v2 = ctx->v2;
+	v3 = ctx->v3;
+	for (b = 0, i = 0; i < ctx->buflen; ++i)
+		b |= (uint64_t)ctx->buf[i] << (8 * i);
+	b |= (uint64_t)ctx->len << 56;
+	v3 ^= b;
+	for (i = 0; i < crounds; ++i)
+		SIPROUND(v0, v1, v2, v3);
+	v0 ^= b;
+	v2 ^= outlen == 16 ? 0xee : 0xff;
+	for (i = 0; i < drounds; ++i)
+		SIPROUND(v0, v1, v2, v3);
+	le64enc(out, v0 ^ v1 ^ v2 ^ v3);
+	if (outlen == 16) {
+		v1 ^= 0xdd;
+		for (i = 0; i < drounds; ++i)
+			SIPROUND(v0, v1, v2, v3);
+		le64enc(out + 8, v0 ^ v1 ^ v2 ^ v3);
+	}
+}
+
+void
+siphash24_init(siphash_ctx *ctx, const uint8_t *key)
+{
+
+	siphash_init(ctx, key, 8);
+}
+
+void
+siphash24_128_init(siphash_ctx *ctx, const uint8_t *key)
+{
+
+	siphash_init(ctx, key, 16);
+}
+
+void
+siphash24_update(siphash_ctx *ctx, const void *data, size_t len)
+{
+
+	siphash_update(ctx, data, len, 2);
+}
+
+uint64_t
+siphash24_final(siphash_ctx *ctx)
+{
+	uint8_t out[8];
+
+	siphash_final(ctx, 2, 4, out, sizeof out);
+	return (le64dec(out));
+}
+
+void
+siphash24_128_final(siphash_ctx *ctx, uint8_t *out)
+{
+
+	siphash_final(ctx, 2, 4, out, 16);
+}
+
+void
+siphash13_init(siphash_ctx *ctx, const uint8_t *key)
+{
+
+	siphash_init(ctx, key, 8);
+}
+
+void
+siphash13_128_init(siphash_ctx *ctx, const uint8_t *key)
+{
+
+	siphash_init(ctx, key, 16);
+}
+
+void
+siphash13_update(siphash_ctx *ctx, const void *data, size_t len)
+{
+
+	siphash_update(ctx, data, len, 1);
+}
+
+uint64_t
+siphash13_final(siphash_ctx *ctx)
+{
+	uint8_t out[8];
+
+	siphash_final(ctx, 1, 3, out, sizeof out);
+	return (le64dec(out));
+}
+
+void
+siphash13_128_final(siphash_ctx *ctx, uint8_t *out)
+{
+
+	siphash_final(ctx, 1, 3, out, 16);
+}
+
+/***************************************************************************
+ * HalfSipHash
+ */
+
+#define HALFSIPROUND(v0, v1, v2, v3)					\
+	do {								\
+		v0 += v1; v1 = rol32(v1, 5); v1 ^= v0; v0 = rol32(v0, 16); \
+		v2 += v3; v3 = rol32(v3, 8); v3 ^= v2;			\
+		v0 += v3; v3 = rol32(v3, 7); v3 ^= v0;			\
+		v2 += v1; v1 = rol32(v1, 13); v1 ^= v2; v2 = rol32(v2, 16); \
+	} while (0)
+
+static inline uint32_t
+halfsiphash_tail(const uint8_t *p, size_t res, size_t len)
+{
+	uint32_t b;
+
+	if (res == 0)
+		b = 0;
+	else if (len >= 4)
+		b = le32dec(p + res - 4) >> (32 - 8 * res);
+	else
+		b = p[0] | (uint32_t)p[res / 2] << (8 * (res / 2)) |
+		    (uint32_t)p[res - 1] << (8 * (res - 1));
+	return (b | (uint32_t)len << 24);
+}
+
+static inline void
+halfsiphash(const void *data, size_t len, const uint8_t *key,
+    unsigned int crounds, unsigned int drounds, uint8_t *out, size_t outlen)
+{
+	const uint8_t *p;
+	uint32_t k0, k1, v0, v1, v2, v3, b;
+	unsigned int i;
+	size_t res;
+
+	k0 = le32dec(key);
+	k1 = le32dec(key + 4);
+	v0 = k0;
+	v1 = k1;
+	v2 = k0 ^ 0x6c796765U;
+	v3 = k1 ^ 0x74656462U;
+	if (outlen == 8)
+		v1 ^= 0xee;
+	for (p = data, res = len; res >= 4; p += 4, res -= 4) {
+		b = le32dec(p);
+		v3 ^= b;
+		for (i = 0; i < crounds; ++i)
+			HALFSIPROUND(v0, v1, v2, v3);
+		v0 ^= b;
+	}
+	b = halfsiphash_tail(p, res, len);
+	v3 ^= b;
+	for (i = 0; i < crounds; ++i)
+		HALFSIPROUND(v0, v1, v2, v3);
+	v0 ^= b;
+	v2 ^= outlen == 8 ? 0xee : 0xff;
+	for (i = 0; i < drounds; ++i)
+		HALFSIPROUND(v0, v1, v2, v3);
+	le32enc(out, v1 ^ v3);
+	if (outlen == 8) {
+		v1 ^= 0xdd;
+		for (i = 0; i < drounds; ++i)
+			HALFSIPROUND(v0, v1, v2, v3);
+		le32enc(out + 4, v1 ^ v3);
+	}
+}
+
+uint32_t
+halfsiphash24_hash(const void *data, size_t len, const uint8_t *key)
+{
+	uint8_t out[4];
+
+	halfsiphash(data, len, key, 2, 4, out, sizeof out);
+	return (le32dec(out));
+}
+
+uint64_t
+halfsiphash24_64_hash(const void *data, size_t len, const uint8_t *key)
+{
+	uint8_t out[8];
+
+	halfsiphash(data, len, key, 2, 4, out, sizeof out);
+	return (le64dec(out));
+}
+
+static inline void
+halfsiphash_init(halfsiphash_ctx *ctx, const uint8_t *key, size_t outlen)
+{
+	uint32_t k0, k1;
+
+	k0 = le32dec(key);
+	k1 = le32dec(key + 4);
+	ctx->v0 = k0;
+	ctx->v1 = k1;
+	ctx->v2 = k0 ^ 0x6c796765U;
+	ctx->v3 = k1 ^ 0x74656462U;
+	if (outlen == 8)
+		ctx->v1 ^= 0xee;
+	ctx->buflen = 0;
+	ctx->len = 0;
+}
+
+static inline void
+halfsiphash_update(halfsiphash_ctx *ctx, const void *data, size_t len,
+    unsigned int crounds)
+{
+	const uint8_t *p;
+	uint32_t v0, v1, v2, v3, b;
+	unsigned int i;
+
+	p = data;
+	ctx->len += len;
+	if (ctx->buflen > 0) {
+		while (ctx->buflen < 4 && len > 0) {
+			ctx->buf[ctx->buflen++] = *p++;
+			len--;
+		}
+		if (ctx->buflen < 4)
+			return;
+	}
+	v0 = ctx->v0;
+	v1 = ctx->v1;
+	v2 = ctx->v2;
+	v3 = ctx->v3;
+	if (ctx->buflen > 0) {
+		b = le32dec(ctx->buf);
+		v3 ^= b;
+		for (i = 0; i < crounds; ++i)
+			HALFSIPROUND(v0, v1, v2, v3);
+		v0 ^= b;
+		ctx->buflen = 0;
+	}
+	for (; len >= 4; p += 4, len -= 4) {
+		b = le32dec(p);
+		v3 ^= b;
+		for (i = 0; i < crounds; ++i)
+			HALFSIPROUND(v0, v1, v2, v3);
+		v0 ^= b;
+	}
+	while (len-- > 0)
+		ctx->buf[ctx->buflen++] = *p++;
+	ctx->v0 = v0;
+	ctx->v1 = v1;
+	ctx->v2 = v2;
+	ctx->v3 = v3;
+}
+
+static inline void
+halfsiphash_final(halfsiphash_ctx *ctx, unsigned int crounds,
+    unsigned int drounds, uint8_t *out, size_t outlen)
+{
+	uint32_t v0, v1, v2, v3, b;
+	unsigned int i;
+
+	v0 = ctx->v0;
+	v1 = ctx->v1;
+	v2 = ctx->v2;
+	v3 = ctx->v3;
+	for (b = 0, i = 0; i < ctx->buflen; ++i)
+		b |= (uint32_t)ctx->buf[i] << (8 * i);
+	b |= (uint32_t)ctx->len << 24;
+	v3 ^= b;
+	for (i = 0; i < crounds; ++i)
+		HALFSIPROUND(v0, v1, v2, v3);
+	v0 ^= b;
+	v2 ^= outlen == 8 ? 0xee : 0xff;
+	for (i = 0; i < drounds; ++i)
+		HALFSIPROUND(v0, v1, v2, v3);
+	le32enc(out, v1 ^ v3);
+	if (outlen == 8) {
+		v1 ^= 0xdd;
+		for (i = 0; i < drounds; ++i)
+			HALFSIPROUND(v0, v1, v2, v3);
+		le32enc(out + 4, v1 ^ v3);
+	}
+}
+
+void
+halfsiphash24_init(halfsiphash_ctx *ctx, const uint8_t *key)
+{
+
+	halfsiphash_init(ctx, key, 4);
+}
+
+void
+halfsiphash24_64_init(halfsiphash_ctx *ctx, const uint8_t *key)
+{
+
+	halfsiphash_init(ctx, key, 8);
+}
+
+void
+halfsiphash24_update(halfsiphash_ctx *ctx, const void *data, size_t len)
+{
+
+	halfsiphash_update(ctx, data, len, 2);
+}
+
+uint32_t
+halfsiphash24_final(halfsiphash_ctx *ctx)
+{
+	uint8_t out[4];
+
+	halfsiphash_final(ctx, 2, 4, out, sizeof out);
+	return (le32dec(out));
+}
+
+uint64_t
+halfsiphash24_64_final(halfsiphash_ctx *ctx)
+{
+	uint8_t out[8];
+
+	halfsiphash_final(ctx, 2, 4, out, sizeof out);
+	return (le64dec(out));
+}
+
+/***************************************************************************
+ * Generic interface
+ */
+
+/*
+ * A null key is treated as all zeroes.
+ */
+static const uint8_t siphash_zero_key[SIPHASH_KEY_LEN];
+
+#define SIPHASH_KEY(key)						\
+	((key) == NULL ? siphash_zero_key : (const uint8_t *)(key))
+
+static void
+siphash24_hash_init(hash_ctx *ctx, const void *key)
+{
+
+	siphash24_init(ctx, SIPHASH_KEY(key));
+}
+
+static uint64_t
+siphash24_hash_final(hash_ctx *ctx)
+{
+
+	return (siphash24_final(ctx));
+}
+
+static uint64_t
+siphash24_hash_complete(const void *data, size_t len, const void *key)
+{
+
+	return (siphash24_hash(data, len, SIPHASH_KEY(key)));
+}
+
+const hash_algorithm siphash24_hash_algorithm = {
+	.name			 = "siphash24",
+	.contextlen		 = sizeof(siphash_ctx),
+	.keylen			 = SIPHASH_KEY_LEN,
+	.hashlen		 = sizeof(uint64_t),
+	.init			 = siphash24_hash_init,
+	.update			 = (hash_update_func)(void *)siphash24_update,
+	.final			 = siphash24_hash_final,
+	.complete		 = siphash24_hash_complete,
+};
+
+static void
+siphash13_hash_init(hash_ctx *ctx, const void *key)
+{
+
+	siphash13_init(ctx, SIPHASH_KEY(key));
+}
+
+static uint64_t
+siphash13_hash_final(hash_ctx *ctx)
+{
+
+	return (siphash13_final(ctx));
+}
+
+static uint64_t
+siphash13_hash_complete(const void *data, size_t len, const void *key)
+{
+
+	return (siphash13_hash(data, len, SIPHASH_KEY(key)));
+}
+
+const hash_algorithm siphash13_hash_algorithm = {
+	.name			 = "siphash13",
+	.contextlen		 = sizeof(siphash_ctx),
+	.keylen			 = SIPHASH_KEY_LEN,
+	.hashlen		 = sizeof(uint64_t),
+	.init			 = siphash13_hash_init,
+	.update			 = (hash_update_func)(void *)siphash13_update,
+	.final			 = siphash13_hash_final,
+	.complete		 = siphash13_hash_complete,
+};
+
+static void
+halfsiphash24_hash_init(hash_ctx *ctx, const void *key)
+{
+
+	halfsiphash24_init(ctx, SIPHASH_KEY(key));
+}
+
+static uint64_t
+halfsiphash24_hash_final(hash_ctx *ctx)
+{
+
+	return (halfsiphash24_final(ctx));
+}
+
+static uint64_t
+halfsiphash24_hash_complete(const void *data, size_t len, const void *key)
+{
+
+	return (halfsiphash24_hash(data, len, SIPHASH_KEY(key)));
+}
+
+const hash_algorithm halfsiphash24_hash_algorithm = {
+	.name			 = "halfsiphash24",
+	.contextlen		 = sizeof(halfsiphash_ctx),
+	.keylen			 = HALFSIPHASH_KEY_LEN,
+	.hashlen		 = sizeof(uint32_t),
+	.init			 = halfsiphash24_hash_init,
+	.update			 = (hash_update_func)(void *)halfsiphash24_update,
+	.final			 = halfsiphash24_hash_final,
+	.complete		 = halfsiphash24_hash_complete,
+};
+
+static void
+halfsiphash24_64_hash_init(hash_ctx *ctx, const void *key)
+{
+
+	halfsiphash24_64_init(ctx, SIPHASH_KEY(key));
+}
+
+static uint64_t
+halfsiphash24_64_hash_final(hash_ctx *ctx)
+{
+
+	return (halfsiphash24_64_final(ctx));
+}
+
+static uint64_t
+halfsiphash24_64_hash_complete(const void *data, size_t len, const void *key)
+{
+
+	return (halfsiphash24_64_hash(data, len, SIPHASH_KEY(key)));
+}
+
+const hash_algorithm halfsiphash24_64_hash_algorithm = {
+	.name			 = "halfsiphash24-64",
+	.contextlen		 = sizeof(halfsiphash_ctx),
+	.keylen			 = HALFSIPHASH_KEY_LEN,
+	.hashlen		 = sizeof(uint64_t),
+	.init			 = halfsiphash24_64_hash_init,
+	.update			 = (hash_update_func)(void *)halfsiphash24_update,
+	.final			 = halfsiphash24_64_hash_final,
+	.complete		 = halfsiphash24_64_hash_complete,
+};
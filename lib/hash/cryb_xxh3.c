@@ -0,0 +1,925 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define XXH3_AVX2 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define XXH3_SSE2 1
+#endif
+
+#include <cryb/assert.h>
+#include <cryb/bitwise.h>
+#include <cryb/endian.h>
+#include <cryb/hash.h>
+
+#include "cryb_xxhash_impl.h"
+
+/*
+ * Implementation of the 64-bit and 128-bit XXH3 hash functions.
+ *
+ * Inputs of up to 240 bytes are handled by dedicated code paths which
+ * mix the input with parts of the secret.  Longer inputs are processed
+ * in 64-byte stripes spread over eight 64-bit accumulators; after each
+ * block of stripes, the accumulators are scrambled.  The accumulator
+ * loop is written with SSE2 or AVX2 intrinsics when the compiler
+ * targets a processor which supports them.
+ *
+ * A seed is applied either directly (for short inputs) or by deriving
+ * a custom secret from the default one (for long inputs).
+ * Alternatively, the caller can supply a secret of their own.
+ */
+
+#define XXH3_STRIPE_LEN		64
+#define XXH3_SECRET_CONSUME_RATE	8
+#define XXH3_ACC_NB		8
+#define XXH3_MIDSIZE_MAX	240
+#define XXH3_MIDSIZE_STARTOFFSET	3
+#define XXH3_MIDSIZE_LASTOFFSET	17
+#define XXH3_SECRET_MERGEACCS_START	11
+#define XXH3_SECRET_LASTACC_START	7
+
+#define XXH_PRIME_MX1	0x165667919e3779f9ULL
+#define XXH_PRIME_MX2	0x9fb21c651e98df25ULL
+
+static const uint8_t xxh3_default_secret[XXH3_SECRET_LEN] = {
+	0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe,
+	0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+	0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb,
+	0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+	0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78,
+	0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+	0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e,
+	0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+	0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb,
+	0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+	0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e,
+	0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+	0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f,
+	0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+	0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31,
+	0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+	0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3,
+	0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+	0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49,
+	0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+	0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc,
+	0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+	0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28,
+	0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+typedef struct {
+	uint64_t lo, hi;
+} xxh128;
+
+static inline xxh128
+xxh_mult64to128(uint64_t a, uint64_t b)
+{
+	xxh128 r;
+#if defined(__SIZEOF_INT128__)
+	__extension__ unsigned __int128 p;
+
+	p = (unsigned __int128)a * b;
+	r.lo = (uint64_t)p;
+	r.hi = (uint64_t)(p >> 64);
+#else
+	uint64_t lolo, hilo, lohi, hihi, cross;
+
+	lolo = (a & 0xffffffff) * (b & 0xffffffff);
+	hilo = (a >> 32) * (b & 0xffffffff);
+	lohi = (a & 0xffffffff) * (b >> 32);
+	hihi = (a >> 32) * (b >> 32);
+	cross = (lolo >> 32) + (hilo & 0xffffffff) + lohi;
+	r.hi = (hilo >> 32) + (cross >> 32) + hihi;
+	r.lo = (cross << 32) | (lolo & 0xffffffff);
+#endif
+	return (r);
+}
+
+static inline uint64_t
+xxh_mul128_fold64(uint64_t a, uint64_t b)
+{
+	xxh128 p;
+
+	p = xxh_mult64to128(a, b);
+	return (p.lo ^ p.hi);
+}
+
+static inline uint64_t
+xxh3_avalanche(uint64_t h)
+{
+
+	h ^= h >> 37;
+	h *= XXH_PRIME_MX1;
+	h ^= h >> 32;
+	return (h);
+}
+
+static inline uint64_t
+xxh3_rrmxmx(uint64_t h, uint64_t len)
+{
+
+	h ^= rol64(h, 49) ^ rol64(h, 24);
+	h *= XXH_PRIME_MX2;
+	h ^= (h >> 35) + len;
+	h *= XXH_PRIME_MX2;
+	h ^= h >> 28;
+	return (h);
+}
+
+static inline uint64_t
+xxh3_mix16(const uint8_t *p, const uint8_t *secret, uint64_t seed)
+{
+
+	return (xxh_mul128_fold64(xxh_read64(p) ^ (xxh_read64(secret) + seed),
+	    xxh_read64(p + 8) ^ (xxh_read64(secret + 8) - seed)));
+}
+
+static inline xxh128
+xxh3_mix32(xxh128 acc, const uint8_t *p1, const uint8_t *p2,
+    const uint8_t *secret, uint64_t seed)
+{
+
+	acc.lo += xxh3_mix16(p1, secret, seed);
+	acc.lo ^= xxh_read64(p2) + xxh_read64(p2 + 8);
+	acc.hi += xxh3_mix16(p2, secret + 16, seed);
+	acc.hi ^= xxh_read64(p1) + xxh_read64(p1 + 8);
+	return (acc);
+}
+
+/*
+ * Derive a custom secret from the default secret and a seed.
+ */
+static void
+xxh3_derive_secret(uint8_t *secret, uint64_t seed)
+{
+	unsigned int i;
+
+	for (i = 0; i < XXH3_SECRET_LEN; i += 16) {
+		le64enc(secret + i,
+		    xxh_read64(xxh3_default_secret + i) + seed);
+		le64enc(secret + i + 8,
+		    xxh_read64(xxh3_default_secret + i + 8) - seed);
+	}
+}
+
+/***************************************************************************
+ * Long inputs
+ */
+
+static const uint64_t xxh3_init_acc[XXH3_ACC_NB] = {
+	XXH_PRIME32_3, XXH_PRIME64_1, XXH_PRIME64_2, XXH_PRIME64_3,
+	XXH_PRIME64_4, XXH_PRIME32_2, XXH_PRIME64_5, XXH_PRIME32_1,
+};
+
+#if XXH3_AVX2
+/*
+ * Process nstripes consecutive stripes, advancing through the secret
+ * by 8 bytes for each stripe.
+ */
+static inline void
+xxh3_accumulate(uint64_t *acc, const uint8_t *p, const uint8_t *secret,
+    size_t nstripes)
+{
+	__m256i xacc[2], d, dk, dklo;
+	unsigned int i;
+
+	xacc[0] = _mm256_loadu_si256((__m256i *)acc);
+	xacc[1] = _mm256_loadu_si256((__m256i *)acc + 1);
+	for (; nstripes > 0; --nstripes) {
+		for (i = 0; i < 2; ++i) {
+			d = _mm256_loadu_si256((const __m256i *)p + i);
+			dk = _mm256_xor_si256(d,
+			    _mm256_loadu_si256((const __m256i *)secret + i));
+			dklo = _mm256_shuffle_epi32(dk, _MM_SHUFFLE(0, 3, 0, 1));
+			xacc[i] = _mm256_add_epi64(xacc[i],
+			    _mm256_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2)));
+			xacc[i] = _mm256_add_epi64(xacc[i],
+			    _mm256_mul_epu32(dk, dklo));
+		}
+		p += XXH3_STRIPE_LEN;
+		secret += XXH3_SECRET_CONSUME_RATE;
+	}
+	_mm256_storeu_si256((__m256i *)acc, xacc[0]);
+	_mm256_storeu_si256((__m256i *)acc + 1, xacc[1]);
+}
+
+static inline void
+xxh3_scramble(uint64_t *acc, const uint8_t *secret)
+{
+	__m256i a, dk, prime;
+	unsigned int i;
+
+	prime = _mm256_set1_epi32((int)XXH_PRIME32_1);
+	for (i = 0; i < 2; ++i) {
+		a = _mm256_loadu_si256((__m256i *)acc + i);
+		a = _mm256_xor_si256(a, _mm256_srli_epi64(a, 47));
+		dk = _mm256_xor_si256(a,
+		    _mm256_loadu_si256((const __m256i *)secret + i));
+		a = _mm256_add_epi64(_mm256_mul_epu32(dk, prime),
+		    _mm256_slli_epi64(_mm256_mul_epu32(
+		    _mm256_shuffle_epi32(dk, _MM_SHUFFLE(0, 3, 0, 1)),
+		    prime), 32));
+		_mm256_storeu_si256((__m256i *)acc + i, a);
+	}
+}
+#elif XXH3_SSE2
+static inline void
+xxh3_accumulate(uint64_t *acc, const uint8_t *p, const uint8_t *secret,
+    size_t nstripes)
+{
+	__m128i xacc[4], d, dk, dklo;
+	unsigned int i;
+
+	for (i = 0; i < 4; ++i)
+		xacc[i] = _mm_loadu_si128((__m128i *)acc + i);
+	for (; nstripes > 0; --nstripes) {
+		for (i = 0; i < 4; ++i) {
+			d = _mm_loadu_si128((const __m128i *)p + i);
+			dk = _mm_xor_si128(d,
+			    _mm_loadu_si128((const __m128i *)secret + i));
+			dklo = _mm_shuffle_epi32(dk, _MM_SHUFFLE(0, 3, 0, 1));
+			xacc[i] = _mm_add_epi64(xacc[i],
+			    _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2)));
+			xacc[i] = _mm_add_epi64(xacc[i],
+			    _mm_mul_epu32(dk, dklo));
+		}
+		p += XXH3_STRIPE_LEN;
+		secret += XXH3_SECRET_CONSUME_RATE;
+	}
+	for (i = 0; i < 4; ++i)
+		_mm_storeu_si128((__m128i *)acc + i, xacc[i]);
+}
+
+static inline void
+xxh3_scramble(uint64_t *acc, const uint8_t *secret)
+{
+	__m128i a, dk, prime;
+	unsigned int i;
+
+	prime = _mm_set1_epi32((int)XXH_PRIME32_1);
+	for (i = 0; i < 4; ++i) {
+		a = _mm_loadu_si128((__m128i *)acc + i);
+		a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+		dk = _mm_xor_si128(a,
+		    _mm_loadu_si128((const __m128i *)secret + i));
+		a = _mm_add_epi64(_mm_mul_epu32(dk, prime),
+		    _mm_slli_epi64(_mm_mul_epu32(
+		    _mm_shuffle_epi32(dk, _MM_SHUFFLE(0, 3, 0, 1)),
+		    prime), 32));
+		_mm_storeu_si128((__m128i *)acc + i, a);
+	}
+}
+#else
+static inline void
+xxh3_accumulate(uint64_t *acc, const uint8_t *p, const uint8_t *secret,
+    size_t nstripes)
+{
+	uint64_t d, dk;
+	unsigned int i;
+
+	for (; nstripes > 0; --nstripes) {
+		for (i = 0; i < XXH3_ACC_NB; ++i) {
+			d = xxh_read64(p + 8 * i);
+			dk = d ^ xxh_read64(secret + 8 * i);
+			acc[i ^ 1] += d;
+			acc[i] += (dk & 0xffffffff) * (dk >> 32);
+		}
+		p += XXH3_STRIPE_LEN;
+		secret += XXH3_SECRET_CONSUME_RATE;
+	}
+}
+
+static inline void
+xxh3_scramble(uint64_t *acc, const uint8_t *secret)
+{
+	unsigned int i;
+
+	for (i = 0; i < XXH3_ACC_NB; ++i) {
+		acc[i] ^= acc[i] >> 47;
+		acc[i] ^= xxh_read64(secret + 8 * i);
+		acc[i] *= XXH_PRIME32_1;
+	}
+}
+#endif
+
+static inline uint64_t
+xxh3_merge_accs(const uint64_t *acc, const uint8_t *secret, uint64_t h)
+{
+	unsigned int i;
+
+	for (i = 0; i < XXH3_ACC_NB; i += 2)
+		h += xxh_mul128_fold64(acc[i] ^ xxh_read64(secret + 8 * i),
+		    acc[i + 1] ^ xxh_read64(secret + 8 * i + 8));
+	return (xxh3_avalanche(h));
+}
+
+/*
+ * Feed nstripes stripes to the accumulators, given that *done stripes
+ * of the current block have already been processed, and scramble the
+ * accumulators if the end of the block is reached.
+ */
+static inline void
+xxh3_consume(uint64_t *acc, size_t *done, const uint8_t *p, size_t nstripes,
+    const uint8_t *secret, size_t secretlen)
+{
+	size_t perblock, n;
+
+	perblock = (secretlen - XXH3_STRIPE_LEN) / XXH3_SECRET_CONSUME_RATE;
+	while (nstripes > 0) {
+		n = perblock - *done;
+		if (n > nstripes)
+			n = nstripes;
+		xxh3_accumulate(acc, p, secret +
+		    *done * XXH3_SECRET_CONSUME_RATE, n);
+		p += n * XXH3_STRIPE_LEN;
+		nstripes -= n;
+		*done += n;
+		if (*done == perblock) {
+			xxh3_scramble(acc,
+			    secret + secretlen - XXH3_STRIPE_LEN);
+			*done = 0;
+		}
+	}
+}
+
+/*
+ * Process an input longer than XXH3_MIDSIZE_MAX, leaving the
+ * accumulators ready to be merged.
+ */
+static void
+xxh3_hash_long(uint64_t *acc, const uint8_t *p, size_t len,
+    const uint8_t *secret, size_t secretlen)
+{
+	size_t done;
+
+	memcpy(acc, xxh3_init_acc, sizeof xxh3_init_acc);
+	done = 0;
+	/* all stripes but the last, which may be partial */
+	xxh3_consume(acc, &done, p, (len - 1) / XXH3_STRIPE_LEN,
+	    secret, secretlen);
+	/* the last stripe always ends at the end of the input */
+	xxh3_accumulate(acc, p + len - XXH3_STRIPE_LEN, secret + secretlen -
+	    XXH3_STRIPE_LEN - XXH3_SECRET_LASTACC_START, 1);
+}
+
+/***************************************************************************
+ * 64-bit variant
+ */
+
+static inline uint64_t
+xxh3_64_0to16(const uint8_t *p, size_t len, const uint8_t *secret,
+    uint64_t seed)
+{
+	uint64_t lo, hi, acc;
+	uint32_t combined;
+
+	if (len > 8) {
+		lo = xxh_read64(p) ^
+		    ((xxh_read64(secret + 24) ^ xxh_read64(secret + 32)) + seed);
+		hi = xxh_read64(p + len - 8) ^
+		    ((xxh_read64(secret + 40) ^ xxh_read64(secret + 48)) - seed);
+		acc = len + bswap64(lo) + hi + xxh_mul128_fold64(lo, hi);
+		return (xxh3_avalanche(acc));
+	}
+	if (len >= 4) {
+		seed ^= (uint64_t)bswap32((uint32_t)seed) << 32;
+		acc = xxh_read32(p + len - 4) + ((uint64_t)xxh_read32(p) << 32);
+		acc ^= (xxh_read64(secret + 8) ^ xxh_read64(secret + 16)) - seed;
+		return (xxh3_rrmxmx(acc, len));
+	}
+	if (len > 0) {
+		combined = ((uint32_t)p[0] << 16) |
+		    ((uint32_t)p[len >> 1] << 24) |
+		    (uint32_t)p[len - 1] | ((uint32_t)len << 8);
+		acc = combined ^
+		    ((xxh_read32(secret) ^ xxh_read32(secret + 4)) + seed);
+		return (xxh64_avalanche(acc));
+	}
+	return (xxh64_avalanche(seed ^
+	    xxh_read64(secret + 56) ^ xxh_read64(secret + 64)));
+}
+
+static inline uint64_t
+xxh3_64_17to128(const uint8_t *p, size_t len, const uint8_t *secret,
+    uint64_t seed)
+{
+	uint64_t acc;
+
+	acc = len * XXH_PRIME64_1;
+	if (len > 32) {
+		if (len > 64) {
+			if (len > 96) {
+				acc += xxh3_mix16(p + 48, secret + 96, seed);
+				acc += xxh3_mix16(p + len - 64, secret + 112,
+				    seed);
+			}
+			acc += xxh3_mix16(p + 32, secret + 64, seed);
+			acc += xxh3_mix16(p + len - 48, secret + 80, seed);
+		}
+		acc += xxh3_mix16(p + 16, secret + 32, seed);
+		acc += xxh3_mix16(p + len - 32, secret + 48, seed);
+	}
+	acc += xxh3_mix16(p, secret, seed);
+	acc += xxh3_mix16(p + len - 16, secret + 16, seed);
+	return (xxh3_avalanche(acc));
+}
+
+static inline uint64_t
+xxh3_64_129to240(const uint8_t *p, size_t len, const uint8_t *secret,
+    uint64_t seed)
+{
+	uint64_t acc;
+	size_t i;
+
+	acc = len * XXH_PRIME64_1;
+	for (i = 0; i < 8; ++i)
+		acc += xxh3_mix16(p + 16 * i, secret + 16 * i, seed);
+	acc = xxh3_avalanche(acc);
+	for (i = 8; i < len / 16; ++i)
+		acc += xxh3_mix16(p + 16 * i,
+		    secret + 16 * (i - 8) + XXH3_MIDSIZE_STARTOFFSET, seed);
+	acc += xxh3_mix16(p + len - 16,
+	    secret + XXH3_SECRET_MIN_LEN - XXH3_MIDSIZE_LASTOFFSET, seed);
+	return (xxh3_avalanche(acc));
+}
+
+static inline uint64_t
+xxh3_64_short(const uint8_t *p, size_t len, const uint8_t *secret,
+    uint64_t seed)
+{
+
+	if (len <= 16)
+		return (xxh3_64_0to16(p, len, secret, seed));
+	if (len <= 128)
+		return (xxh3_64_17to128(p, len, secret, seed));
+	return (xxh3_64_129to240(p, len, secret, seed));
+}
+
+static inline uint64_t
+xxh3_64_merge(const uint64_t *acc, const uint8_t *secret, uint64_t len)
+{
+
+	return (xxh3_merge_accs(acc, secret + XXH3_SECRET_MERGEACCS_START,
+	    len * XXH_PRIME64_1));
+}
+
+uint64_t
+xxh3_64_hash(const void *data, size_t len, uint64_t seed)
+{
+	uint64_t acc[XXH3_ACC_NB];
+	uint8_t secret[XXH3_SECRET_LEN];
+
+	if (len <= XXH3_MIDSIZE_MAX)
+		return (xxh3_64_short(data, len, xxh3_default_secret, seed));
+	if (seed == 0) {
+		xxh3_hash_long(acc, data, len, xxh3_default_secret,
+		    XXH3_SECRET_LEN);
+		return (xxh3_64_merge(acc, xxh3_default_secret, len));
+	}
+	xxh3_derive_secret(secret, seed);
+	xxh3_hash_long(acc, data, len, secret, sizeof secret);
+	return (xxh3_64_merge(acc, secret, len));
+}
+
+/*
+ * A secret shorter than XXH3_SECRET_MIN_LEN would have us read past its
+ * end.  There is no way to report an error from the one-shot functions,
+ * so as in the reference implementation, it is a precondition.
+ */
+uint64_t
+xxh3_64_hash_secret(const void *data, size_t len, const uint8_t *secret,
+    size_t secretlen)
+{
+	uint64_t acc[XXH3_ACC_NB];
+
+	assert(secretlen >= XXH3_SECRET_MIN_LEN);
+	if (len <= XXH3_MIDSIZE_MAX)
+		return (xxh3_64_short(data, len, secret, 0));
+	xxh3_hash_long(acc, data, len, secret, secretlen);
+	return (xxh3_64_merge(acc, secret, len));
+}
+
+/***************************************************************************
+ * 128-bit variant
+ */
+
+static inline xxh128
+xxh3_128_0to16(const uint8_t *p, size_t len, const uint8_t *secret,
+    uint64_t seed)
+{
+	xxh128 m, h;
+	uint64_t lo, hi, bitflip;
+	uint32_t combined;
+
+	if (len > 8) {
+		lo = xxh_read64(p);
+		hi = xxh_read64(p + len - 8);
+		m = xxh_mult64to128(lo ^ hi ^
+		    ((xxh_read64(secret + 32) ^ xxh_read64(secret + 40)) - seed),
+		    XXH_PRIME64_1);
+		m.lo += (uint64_t)(len - 1) << 54;
+		hi ^= (xxh_read64(secret + 48) ^ xxh_read64(secret + 56)) + seed;
+		m.hi += hi + (hi & 0xffffffff) * (XXH_PRIME32_2 - 1);
+		m.lo ^= bswap64(m.hi);
+		h = xxh_mult64to128(m.lo, XXH_PRIME64_2);
+		h.hi += m.hi * XXH_PRIME64_2;
+		h.lo = xxh3_avalanche(h.lo);
+		h.hi = xxh3_avalanche(h.hi);
+		return (h);
+	}
+	if (len >= 4) {
+		seed ^= (uint64_t)bswap32((uint32_t)seed) << 32;
+		lo = xxh_read32(p) + ((uint64_t)xxh_read32(p + len - 4) << 32);
+		lo ^= (xxh_read64(secret + 16) ^ xxh_read64(secret + 24)) + seed;
+		m = xxh_mult64to128(lo, XXH_PRIME64_1 + (len << 2));
+		m.hi += m.lo << 1;
+		m.lo ^= m.hi >> 3;
+		m.lo ^= m.lo >> 35;
+		m.lo *= XXH_PRIME_MX2;
+		m.lo ^= m.lo >> 28;
+		m.hi = xxh3_avalanche(m.hi);
+		return (m);
+	}
+	if (len > 0) {
+		combined = ((uint32_t)p[0] << 16) |
+		    ((uint32_t)p[len >> 1] << 24) |
+		    (uint32_t)p[len - 1] | ((uint32_t)len << 8);
+		bitflip = (xxh_read32(secret) ^ xxh_read32(secret + 4)) + seed;
+		h.lo = xxh64_avalanche(combined ^ bitflip);
+		bitflip = (xxh_read32(secret + 8) ^ xxh_read32(secret + 12)) -
+		    seed;
+		h.hi = xxh64_avalanche(rol32(bswap32(combined), 13) ^ bitflip);
+		return (h);
+	}
+	h.lo = xxh64_avalanche(seed ^
+	    xxh_read64(secret + 64) ^ xxh_read64(secret + 72));
+	h.hi = xxh64_avalanche(seed ^
+	    xxh_read64(secret + 80) ^ xxh_read64(secret + 88));
+	return (h);
+}
+
+static inline xxh128
+xxh3_128_finish(xxh128 acc, size_t len, uint64_t seed)
+{
+	xxh128 h;
+
+	h.lo = xxh3_avalanche(acc.lo + acc.hi);
+	h.hi = 0 - xxh3_avalanche(acc.lo * XXH_PRIME64_1 +
+	    acc.hi * XXH_PRIME64_4 + (len - seed) * XXH_PRIME64_2);
+	return (h);
+}
+
+static inline xxh128
+xxh3_128_17to128(const uint8_t *p, size_t len, const uint8_t *secret,
+    uint64_t seed)
+{
+	xxh128 acc;
+
+	acc.lo = len * XXH_PRIME64_1;
+	acc.hi = 0;
+	if (len > 32) {
+		if (len > 64) {
+			if (len > 96)
+				acc = xxh3_mix32(acc, p + 48, p + len - 64,
+				    secret + 96, seed);
+			acc = xxh3_mix32(acc, p + 32, p + len - 48,
+			    secret + 64, seed);
+		}
+		acc = xxh3_mix32(acc, p + 16, p + len - 32, secret + 32, seed);
+	}
+	acc = xxh3_mix32(acc, p, p + len - 16, secret, seed);
+	return (xxh3_128_finish(acc, len, seed));
+}
+
+static inline xxh128
+xxh3_128_129to240(const uint8_t *p, size_t len, const uint8_t *secret,
+    uint64_t seed)
+{
+	xxh128 acc;
+	size_t i;
+
+	acc.lo = len * XXH_PRIME64_1;
+	acc.hi = 0;
+	for (i = 0; i < 4; ++i)
+		acc = xxh3_mix32(acc, p + 32 * i, p + 32 * i + 16,
+		    secret + 32 * i, seed);
+	acc.lo = xxh3_avalanche(acc.lo);
+	acc.hi = xxh3_avalanche(acc.hi);
+	for (i = 4; i < len / 32; ++i)
+		acc = xxh3_mix32(acc, p + 32 * i, p + 32 * i + 16,
+		    secret + XXH3_MIDSIZE_STARTOFFSET + 32 * (i - 4), seed);
+	acc = xxh3_mix32(acc, p + len - 16, p + len - 32,
+	    secret + XXH3_SECRET_MIN_LEN - XXH3_MIDSIZE_LASTOFFSET - 16,
+	    0 - seed);
+	return (xxh3_128_finish(acc, len, seed));
+}
+
+static inline xxh128
+xxh3_128_short(const uint8_t *p, size_t len, const uint8_t *secret,
+    uint64_t seed)
+{
+
+	if (len <= 16)
+		return (xxh3_128_0to16(p, len, secret, seed));
+	if (len <= 128)
+		return (xxh3_128_17to128(p, len, secret, seed));
+	return (xxh3_128_129to240(p, len, secret, seed));
+}
+
+static inline xxh128
+xxh3_128_merge(const uint64_t *acc, const uint8_t *secret, size_t secretlen,
+    uint64_t len)
+{
+	xxh128 h;
+
+	h.lo = xxh3_merge_accs(acc, secret + XXH3_SECRET_MERGEACCS_START,
+	    len * XXH_PRIME64_1);
+	h.hi = xxh3_merge_accs(acc, secret + secretlen - XXH3_STRIPE_LEN -
+	    XXH3_SECRET_MERGEACCS_START, ~(len * XXH_PRIME64_2));
+	return (h);
+}
+
+/*
+ * Store a 128-bit hash in canonical form, i.e. as a big-endian number.
+ */
+static inline void
+xxh3_128_store(xxh128 h, uint8_t *out)
+{
+
+	be64enc(out, h.hi);
+	be64enc(out + 8, h.lo);
+}
+
+void
+xxh3_128_hash(const void *data, size_t len, uint64_t seed, uint8_t *out)
+{
+	uint64_t acc[XXH3_ACC_NB];
+	uint8_t secret[XXH3_SECRET_LEN];
+
+	if (len <= XXH3_MIDSIZE_MAX) {
+		xxh3_128_store(xxh3_128_short(data, len, xxh3_default_secret,
+		    seed), out);
+	} else if (seed == 0) {
+		xxh3_hash_long(acc, data, len, xxh3_default_secret,
+		    XXH3_SECRET_LEN);
+		xxh3_128_store(xxh3_128_merge(acc, xxh3_default_secret,
+		    XXH3_SECRET_LEN, len), out);
+	} else {
+		xxh3_derive_secret(secret, seed);
+		xxh3_hash_long(acc, data, len, secret, sizeof secret);
+		xxh3_128_store(xxh3_128_merge(acc, secret, sizeof secret, len),
+		    out);
+	}
+}
+
+void
+xxh3_128_hash_secret(const void *data, size_t len, const uint8_t *secret,
+    size_t secretlen, uint8_t *out)
+{
+	uint64_t acc[XXH3_ACC_NB];
+
+	assert(secretlen >= XXH3_SECRET_MIN_LEN);
+	if (len <= XXH3_MIDSIZE_MAX) {
+		xxh3_128_store(xxh3_128_short(data, len, secret, 0), out);
+	} else {
+		xxh3_hash_long(acc, data, len, secret, secretlen);
+		xxh3_128_store(xxh3_128_merge(acc, secret, secretlen, len),
+		    out);
+	}
+}
+
+/***************************************************************************
+ * Streaming interface
+ */
+
+/*
+ * The secret used for long inputs: either the caller's, or the one
+ * derived from the seed (which is the default secret if the seed is
+ * zero).  The derived secret is stored in the context rather than
+ * pointed to so the context can be copied.
+ */
+static inline const uint8_t *
+xxh3_ctx_secret(const xxh3_ctx *ctx)
+{
+
+	return (ctx->secret != NULL ? ctx->secret : ctx->secretbuf);
+}
+
+static inline size_t
+xxh3_ctx_secretlen(const xxh3_ctx *ctx)
+{
+
+	return (ctx->secret != NULL ? ctx->secretlen : XXH3_SECRET_LEN);
+}
+
+static void
+xxh3_reset(xxh3_ctx *ctx)
+{
+
+	memcpy(ctx->acc, xxh3_init_acc, sizeof xxh3_init_acc);
+	ctx->buflen = 0;
+	ctx->nstripes = 0;
+	ctx->len = 0;
+}
+
+void
+xxh3_init(xxh3_ctx *ctx, uint64_t seed)
+{
+
+	xxh3_reset(ctx);
+	xxh3_derive_secret(ctx->secretbuf, seed);
+	ctx->secret = NULL;
+	ctx->secretlen = 0;
+	ctx->seed = seed;
+}
+
+int
+xxh3_init_secret(xxh3_ctx *ctx, const uint8_t *secret, size_t secretlen)
+{
+
+	if (secretlen < XXH3_SECRET_MIN_LEN) {
+		errno = EINVAL;
+		return (-1);
+	}
+	xxh3_reset(ctx);
+	ctx->secret = secret;
+	ctx->secretlen = secretlen;
+	ctx->seed = 0;
+	return (0);
+}
+
+/*
+ * Input is buffered until more than a full buffer is available, so that
+ * there is always something left in the buffer at the end and we know
+ * where the last stripe is.  Whenever the buffer is refilled from the
+ * start, the last stripe consumed is saved at its end.
+ */
+void
+xxh3_update(xxh3_ctx *ctx, const void *data, size_t len)
+{
+	const uint8_t *p, *secret;
+	size_t n, secretlen;
+
+	p = data;
+	ctx->len += len;
+	if (len <= sizeof ctx->buf - ctx->buflen) {
+		memcpy(ctx->buf + ctx->buflen, p, len);
+		ctx->buflen += len;
+		return;
+	}
+	secret = xxh3_ctx_secret(ctx);
+	secretlen = xxh3_ctx_secretlen(ctx);
+	n = sizeof ctx->buf / XXH3_STRIPE_LEN;
+	if (ctx->buflen > 0) {
+		memcpy(ctx->buf + ctx->buflen, p, sizeof ctx->buf - ctx->buflen);
+		p += sizeof ctx->buf - ctx->buflen;
+		len -= sizeof ctx->buf - ctx->buflen;
+		xxh3_consume(ctx->acc, &ctx->nstripes, ctx->buf, n,
+		    secret, secretlen);
+		ctx->buflen = 0;
+	}
+	if (len > sizeof ctx->buf) {
+		while (len > sizeof ctx->buf) {
+			xxh3_consume(ctx->acc, &ctx->nstripes, p, n,
+			    secret, secretlen);
+			p += sizeof ctx->buf;
+			len -= sizeof ctx->buf;
+		}
+		memcpy(ctx->buf + sizeof ctx->buf - XXH3_STRIPE_LEN,
+		    p - XXH3_STRIPE_LEN, XXH3_STRIPE_LEN);
+	}
+	memcpy(ctx->buf, p, len);
+	ctx->buflen = len;
+}
+
+/*
+ * Process what remains in the buffer of a long input into a copy of the
+ * accumulators, so that the context can still be updated afterwards.
+ */
+static void
+xxh3_digest_long(const xxh3_ctx *ctx, uint64_t *acc)
+{
+	uint8_t last[XXH3_STRIPE_LEN];
+	const uint8_t *secret, *p;
+	size_t secretlen, done, n;
+
+	secret = xxh3_ctx_secret(ctx);
+	secretlen = xxh3_ctx_secretlen(ctx);
+	memcpy(acc, ctx->acc, sizeof ctx->acc);
+	done = ctx->nstripes;
+	if (ctx->buflen >= XXH3_STRIPE_LEN) {
+		xxh3_consume(acc, &done, ctx->buf,
+		    (ctx->buflen - 1) / XXH3_STRIPE_LEN, secret, secretlen);
+		p = ctx->buf + ctx->buflen - XXH3_STRIPE_LEN;
+	} else {
+		/* the last stripe straddles the end of the previous buffer */
+		n = XXH3_STRIPE_LEN - ctx->buflen;
+		memcpy(last, ctx->buf + sizeof ctx->buf - n, n);
+		memcpy(last + n, ctx->buf, ctx->buflen);
+		p = last;
+	}
+	xxh3_accumulate(acc, p, secret + secretlen - XXH3_STRIPE_LEN -
+	    XXH3_SECRET_LASTACC_START, 1);
+}
+
+uint64_t
+xxh3_64_final(xxh3_ctx *ctx)
+{
+	uint64_t acc[XXH3_ACC_NB];
+
+	if (ctx->len <= XXH3_MIDSIZE_MAX) {
+		if (ctx->secret != NULL)
+			return (xxh3_64_short(ctx->buf, ctx->len,
+			    ctx->secret, 0));
+		return (xxh3_64_short(ctx->buf, ctx->len,
+		    xxh3_default_secret, ctx->seed));
+	}
+	xxh3_digest_long(ctx, acc);
+	return (xxh3_64_merge(acc, xxh3_ctx_secret(ctx), ctx->len));
+}
+
+void
+xxh3_128_final(xxh3_ctx *ctx, uint8_t *out)
+{
+	uint64_t acc[XXH3_ACC_NB];
+
+	if (ctx->len <= XXH3_MIDSIZE_MAX) {
+		if (ctx->secret != NULL)
+			xxh3_128_store(xxh3_128_short(ctx->buf, ctx->len,
+			    ctx->secret, 0), out);
+		else
+			xxh3_128_store(xxh3_128_short(ctx->buf, ctx->len,
+			    xxh3_default_secret, ctx->seed), out);
+		return;
+	}
+	xxh3_digest_long(ctx, acc);
+	xxh3_128_store(xxh3_128_merge(acc, xxh3_ctx_secret(ctx),
+	    xxh3_ctx_secretlen(ctx), ctx->len), out);
+}
+
+static void
+xxh3_64_hash_init(hash_ctx *ctx, const void *key)
+{
+
+	xxh3_init(ctx, key == NULL ? 0 : le64dec(key));
+}
+
+static uint64_t
+xxh3_64_hash_final(hash_ctx *ctx)
+{
+
+	return (xxh3_64_final(ctx));
+}
+
+static uint64_t
+xxh3_64_hash_complete(const void *data, size_t len, const void *key)
+{
+
+	return (xxh3_64_hash(data, len, key == NULL ? 0 : le64dec(key)));
+}
+
+const hash_algorithm xxh3_64_hash_algorithm = {
+	.name			 = "xxh3-64",
+	.contextlen		 = sizeof(xxh3_ctx),
+	.keylen			 = XXH_SEED_LEN,
+	.hashlen		 = sizeof(uint64_t),
+	.init			 = xxh3_64_hash_init,
+	.update			 = (hash_update_func)(void *)xxh3_update,
+	.final			 = xxh3_64_hash_final,
+	.complete		 = xxh3_64_hash_complete,
+};
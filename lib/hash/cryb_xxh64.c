@@ -0,0 +1,223 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <cryb/bitwise.h>
+#include <cryb/endian.h>
+#include <cryb/hash.h>
+
+#include "cryb_xxhash_impl.h"
+
+/*
+ * Implementation of the XXH64 hash function.  Input is processed in
+ * 32-byte stripes spread over four independent accumulators.
+ */
+
+static inline uint64_t
+xxh64_round(uint64_t acc, uint64_t input)
+{
+
+	acc += input * XXH_PRIME64_2;
+	acc = rol64(acc, 31);
+	acc *= XXH_PRIME64_1;
+	return (acc);
+}
+
+static inline uint64_t
+xxh64_merge_round(uint64_t acc, uint64_t val)
+{
+
+	acc ^= xxh64_round(0, val);
+	acc = acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+	return (acc);
+}
+
+static inline const uint8_t *
+xxh64_stripes(uint64_t *v, const uint8_t *p, size_t nstripes)
+{
+
+	for (; nstripes > 0; --nstripes, p += 32) {
+		v[0] = xxh64_round(v[0], xxh_read64(p));
+		v[1] = xxh64_round(v[1], xxh_read64(p + 8));
+		v[2] = xxh64_round(v[2], xxh_read64(p + 16));
+		v[3] = xxh64_round(v[3], xxh_read64(p + 24));
+	}
+	return (p);
+}
+
+static inline uint64_t
+xxh64_converge(const uint64_t *v)
+{
+	uint64_t h;
+
+	h = rol64(v[0], 1) + rol64(v[1], 7) + rol64(v[2], 12) +
+	    rol64(v[3], 18);
+	h = xxh64_merge_round(h, v[0]);
+	h = xxh64_merge_round(h, v[1]);
+	h = xxh64_merge_round(h, v[2]);
+	h = xxh64_merge_round(h, v[3]);
+	return (h);
+}
+
+/*
+ * Process the final 0 to 31 bytes and mix the result.
+ */
+static inline uint64_t
+xxh64_finalize(uint64_t h, const uint8_t *p, size_t len)
+{
+
+	for (; len >= 8; p += 8, len -= 8) {
+		h ^= xxh64_round(0, xxh_read64(p));
+		h = rol64(h, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+	}
+	if (len >= 4) {
+		h ^= (uint64_t)xxh_read32(p) * XXH_PRIME64_1;
+		h = rol64(h, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+		p += 4;
+		len -= 4;
+	}
+	for (; len > 0; ++p, --len) {
+		h ^= *p * XXH_PRIME64_5;
+		h = rol64(h, 11) * XXH_PRIME64_1;
+	}
+	return (xxh64_avalanche(h));
+}
+
+static inline void
+xxh64_reset(uint64_t *v, uint64_t seed)
+{
+
+	v[0] = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+	v[1] = seed + XXH_PRIME64_2;
+	v[2] = seed;
+	v[3] = seed - XXH_PRIME64_1;
+}
+
+uint64_t
+xxh64_hash(const void *data, size_t len, uint64_t seed)
+{
+	const uint8_t *p;
+	uint64_t v[4], h;
+
+	p = data;
+	if (len >= 32) {
+		xxh64_reset(v, seed);
+		p = xxh64_stripes(v, p, len / 32);
+		h = xxh64_converge(v);
+	} else {
+		h = seed + XXH_PRIME64_5;
+	}
+	h += len;
+	return (xxh64_finalize(h, p, len % 32));
+}
+
+void
+xxh64_init(xxh64_ctx *ctx, uint64_t seed)
+{
+
+	xxh64_reset(ctx->v, seed);
+	ctx->seed = seed;
+	ctx->buflen = 0;
+	ctx->len = 0;
+}
+
+void
+xxh64_update(xxh64_ctx *ctx, const void *data, size_t len)
+{
+	const uint8_t *p;
+	size_t n;
+
+	p = data;
+	ctx->len += len;
+	if (ctx->buflen > 0) {
+		n = sizeof ctx->buf - ctx->buflen;
+		if (n > len)
+			n = len;
+		memcpy(ctx->buf + ctx->buflen, p, n);
+		ctx->buflen += n;
+		p += n;
+		len -= n;
+		if (ctx->buflen < sizeof ctx->buf)
+			return;
+		xxh64_stripes(ctx->v, ctx->buf, 1);
+		ctx->buflen = 0;
+	}
+	p = xxh64_stripes(ctx->v, p, len / 32);
+	memcpy(ctx->buf, p, len % 32);
+	ctx->buflen = len % 32;
+}
+
+uint64_t
+xxh64_final(xxh64_ctx *ctx)
+{
+	uint64_t h;
+
+	if (ctx->len >= 32)
+		h = xxh64_converge(ctx->v);
+	else
+		h = ctx->seed + XXH_PRIME64_5;
+	h += ctx->len;
+	return (xxh64_finalize(h, ctx->buf, ctx->buflen));
+}
+
+static void
+xxh64_hash_init(hash_ctx *ctx, const void *key)
+{
+
+	xxh64_init(ctx, key == NULL ? 0 : le64dec(key));
+}
+
+static uint64_t
+xxh64_hash_final(hash_ctx *ctx)
+{
+
+	return (xxh64_final(ctx));
+}
+
+static uint64_t
+xxh64_hash_complete(const void *data, size_t len, const void *key)
+{
+
+	return (xxh64_hash(data, len, key == NULL ? 0 : le64dec(key)));
+}
+
+const hash_algorithm xxh64_hash_algorithm = {
+	.name			 = "xxh64",
+	.contextlen		 = sizeof(xxh64_ctx),
+	.keylen			 = XXH_SEED_LEN,
+	.hashlen		 = sizeof(uint64_t),
+	.init			 = xxh64_hash_init,
+	.update			 = (hash_update_func)(void *)xxh64_update,
+	.final			 = xxh64_hash_final,
+	.complete		 = xxh64_hash_complete,
+};
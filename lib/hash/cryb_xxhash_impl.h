@@ -0,0 +1,80 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CRYB_XXHASH_IMPL_H_INCLUDED
+#define CRYB_XXHASH_IMPL_H_INCLUDED
+
+#define XXH_PRIME32_1	0x9e3779b1U
+#define XXH_PRIME32_2	0x85ebca77U
+#define XXH_PRIME32_3	0xc2b2ae3dU
+
+#define XXH_PRIME64_1	0x9e3779b185ebca87ULL
+#define XXH_PRIME64_2	0xc2b2ae3d27d4eb4fULL
+#define XXH_PRIME64_3	0x165667b19e3779f9ULL
+#define XXH_PRIME64_4	0x85ebca77c2b2ae63ULL
+#define XXH_PRIME64_5	0x27d4eb2f165667c5ULL
+
+/*
+ * Load little-endian words.  The fixed-size memcpy() compiles to a
+ * single unaligned load.
+ */
+static inline uint32_t
+xxh_read32(const uint8_t *p)
+{
+	uint32_t w;
+
+	memcpy(&w, p, sizeof w);
+	return (le32toh(w));
+}
+
+static inline uint64_t
+xxh_read64(const uint8_t *p)
+{
+	uint64_t w;
+
+	memcpy(&w, p, sizeof w);
+	return (le64toh(w));
+}
+
+/*
+ * Final mix, shared by XXH64 and XXH3.
+ */
+static inline uint64_t
+xxh64_avalanche(uint64_t h)
+{
+
+	h ^= h >> 33;
+	h *= XXH_PRIME64_2;
+	h ^= h >> 29;
+	h *= XXH_PRIME64_3;
+	h ^= h >> 32;
+	return (h);
+}
+
+#endif
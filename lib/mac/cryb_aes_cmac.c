@@ -0,0 +1,186 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <cryb/memset_s.h>
+
+#include <cryb/aes.h>
+#include <cryb/aes_cmac.h>
+
+/*
+ * AES-CMAC as described in RFC 4493.  The subkeys are derived once per
+ * key, and complete blocks are chained directly from the caller's buffer;
+ * only the last block of the message, which needs to be masked with a
+ * subkey, is held back in the context.
+ */
+
+/*
+ * Multiply a block by x in GF(2^128).
+ */
+static void
+aes_cmac_dbl(uint8_t *out, const uint8_t *in)
+{
+	uint8_t carry;
+	int i;
+
+	carry = in[0] >> 7;
+	for (i = 0; i < AES_BLOCK_LEN - 1; ++i)
+		out[i] = (uint8_t)(in[i] << 1 | in[i + 1] >> 7);
+	out[AES_BLOCK_LEN - 1] = (uint8_t)(in[AES_BLOCK_LEN - 1] << 1) ^
+	    (carry * 0x87);
+}
+
+/*
+ * Chain a block into the running value.
+ */
+static void
+aes_cmac_block(aes_cmac_ctx *ctx, const uint8_t *block)
+{
+	unsigned int i;
+
+	for (i = 0; i < AES_BLOCK_LEN; ++i)
+		ctx->x[i] ^= block[i];
+	aes_encrypt(&ctx->key.aes, ctx->x, ctx->x, AES_BLOCK_LEN);
+}
+
+/*
+ * Expand the key and derive the subkeys.
+ */
+void
+aes_cmac_setkey(aes_cmac_key *hk, const void *key, size_t keylen)
+{
+	uint8_t l[AES_BLOCK_LEN];
+
+	aes_init(&hk->aes, CIPHER_MODE_ENCRYPT, key, keylen);
+	memset(l, 0, sizeof l);
+	aes_encrypt(&hk->aes, l, l, sizeof l);
+	aes_cmac_dbl(hk->k1, l);
+	aes_cmac_dbl(hk->k2, hk->k1);
+	memset_s(l, sizeof l, 0, sizeof l);
+}
+
+/*
+ * Prepare a context for a new message using a precomputed key.
+ */
+void
+aes_cmac_reset(aes_cmac_ctx *ctx, const aes_cmac_key *hk)
+{
+
+	ctx->key = *hk;
+	memset(ctx->x, 0, sizeof ctx->x);
+	ctx->buflen = 0;
+}
+
+void
+aes_cmac_init(aes_cmac_ctx *ctx, const void *key, size_t keylen)
+{
+
+	aes_cmac_setkey(&ctx->key, key, keylen);
+	memset(ctx->x, 0, sizeof ctx->x);
+	ctx->buflen = 0;
+}
+
+void
+aes_cmac_update(aes_cmac_ctx *ctx, const void *buf, size_t len)
+{
+	const uint8_t *p = buf;
+	size_t n;
+
+	if (len == 0)
+		return;
+	if (ctx->buflen > 0) {
+		/* fill the held-back block; flush it only if more follows */
+		n = AES_BLOCK_LEN - ctx->buflen;
+		if (n > len)
+			n = len;
+		memcpy(ctx->buf + ctx->buflen, p, n);
+		ctx->buflen += n;
+		p += n;
+		len -= n;
+		if (len == 0)
+			return;
+		aes_cmac_block(ctx, ctx->buf);
+		ctx->buflen = 0;
+	}
+	while (len > AES_BLOCK_LEN) {
+		aes_cmac_block(ctx, p);
+		p += AES_BLOCK_LEN;
+		len -= AES_BLOCK_LEN;
+	}
+	memcpy(ctx->buf, p, len);
+	ctx->buflen = len;
+}
+
+void
+aes_cmac_final(aes_cmac_ctx *ctx, uint8_t *mac)
+{
+	unsigned int i;
+
+	if (ctx->buflen == AES_BLOCK_LEN) {
+		for (i = 0; i < AES_BLOCK_LEN; ++i)
+			ctx->buf[i] ^= ctx->key.k1[i];
+	} else {
+		ctx->buf[ctx->buflen] = 0x80;
+		for (i = ctx->buflen + 1; i < AES_BLOCK_LEN; ++i)
+			ctx->buf[i] = 0;
+		for (i = 0; i < AES_BLOCK_LEN; ++i)
+			ctx->buf[i] ^= ctx->key.k2[i];
+	}
+	aes_cmac_block(ctx, ctx->buf);
+	memcpy(mac, ctx->x, AES_CMAC_MAC_LEN);
+	memset_s(ctx, sizeof *ctx, 0, sizeof *ctx);
+}
+
+void
+aes_cmac_complete(const void *key, size_t keylen,
+    const void *buf, size_t len, uint8_t *mac)
+{
+	aes_cmac_ctx ctx;
+
+	aes_cmac_init(&ctx, key, keylen);
+	aes_cmac_update(&ctx, buf, len);
+	aes_cmac_final(&ctx, mac);
+}
+
+mac_algorithm aes_cmac_mac = {
+	.name			 = "aes-cmac",
+	.contextlen		 = sizeof(aes_cmac_ctx),
+	.keystatelen		 = sizeof(aes_cmac_key),
+	.maclen			 = AES_CMAC_MAC_LEN,
+	.init			 = (mac_init_func)(void *)aes_cmac_init,
+	.update			 = (mac_update_func)(void *)aes_cmac_update,
+	.final			 = (mac_final_func)(void *)aes_cmac_final,
+	.complete		 = (mac_complete_func)(void *)aes_cmac_complete,
+	.setkey			 = (mac_setkey_func)(void *)aes_cmac_setkey,
+	.reset			 = (mac_reset_func)(void *)aes_cmac_reset,
+};
@@ -0,0 +1,115 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <cryb/endian.h>
+#include <cryb/memset_s.h>
+
+#include <cryb/aes.h>
+#include <cryb/ghash.h>
+#include <cryb/aes_gmac.h>
+
+/*
+ * AES-GMAC, i.e. GCM authentication of additional data with no
+ * plaintext (NIST SP 800-38D).  The AES key is only needed to derive
+ * the hash subkey and to encrypt the pre-counter block, so it is
+ * discarded once the context has been initialized.
+ */
+void
+aes_gmac_init(aes_gmac_ctx *ctx, const void *key, size_t keylen,
+    const void *iv, size_t ivlen)
+{
+	uint8_t h[AES_BLOCK_LEN], j0[AES_BLOCK_LEN];
+	ghash_ctx ivctx;
+	aes_ctx aes;
+
+	aes_init(&aes, CIPHER_MODE_ENCRYPT, key, keylen);
+	memset(h, 0, sizeof h);
+	aes_encrypt(&aes, h, h, sizeof h);
+	if (ivlen == 12) {
+		/* J0 = IV || 0^31 || 1 */
+		memcpy(j0, iv, 12);
+		be32enc(j0 + 12, 1);
+	} else {
+		/* J0 = GHASH(IV || 0^s+64 || [len(IV)]_64) */
+		ghash_init(&ivctx, h);
+		ghash_update(&ivctx, iv, ivlen);
+		ghash_pad(&ivctx);
+		memset(j0, 0, sizeof j0);
+		be64enc(j0 + 8, (uint64_t)ivlen * 8);
+		ghash_update(&ivctx, j0, sizeof j0);
+		ghash_final(&ivctx, j0);
+	}
+	aes_encrypt(&aes, j0, ctx->ekj0, sizeof j0);
+	ghash_init(&ctx->ghash, h);
+	ctx->len = 0;
+	aes_finish(&aes);
+	memset_s(h, sizeof h, 0, sizeof h);
+	memset_s(j0, sizeof j0, 0, sizeof j0);
+}
+
+void
+aes_gmac_update(aes_gmac_ctx *ctx, const void *buf, size_t len)
+{
+
+	ghash_update(&ctx->ghash, buf, len);
+	ctx->len += len;
+}
+
+void
+aes_gmac_final(aes_gmac_ctx *ctx, uint8_t *mac)
+{
+	uint8_t lenblock[GHASH_BLOCK_LEN];
+	unsigned int i;
+
+	/* [len(A)]_64 || [len(C)]_64, with no ciphertext */
+	ghash_pad(&ctx->ghash);
+	be64enc(lenblock, ctx->len * 8);
+	memset(lenblock + 8, 0, 8);
+	ghash_update(&ctx->ghash, lenblock, sizeof lenblock);
+	ghash_final(&ctx->ghash, mac);
+	for (i = 0; i < AES_GMAC_MAC_LEN; ++i)
+		mac[i] ^= ctx->ekj0[i];
+	memset_s(ctx, sizeof *ctx, 0, sizeof *ctx);
+}
+
+void
+aes_gmac_complete(const void *key, size_t keylen, const void *iv,
+    size_t ivlen, const void *buf, size_t len, uint8_t *mac)
+{
+	aes_gmac_ctx ctx;
+
+	aes_gmac_init(&ctx, key, keylen, iv, ivlen);
+	aes_gmac_update(&ctx, buf, len);
+	aes_gmac_final(&ctx, mac);
+}
@@ -0,0 +1,140 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <cryb/memset_s.h>
+
+#include <cryb/digest.h>
+#include <cryb/hmac.h>
+#include <cryb/hkdf.h>
+
+/*
+ * HKDF (RFC 5869) with HMAC over the given digest algorithm.  The
+ * context holds the HMAC key state for the pseudorandom key rather than
+ * the key itself, so any number of subkeys can be expanded from it
+ * without hashing the pads again.
+ */
+
+/*
+ * Extract a pseudorandom key from the input keying material and prepare
+ * the context for expansion.  An absent salt is equivalent to a string
+ * of zeroes the length of the digest, as HMAC pads the key with zeroes
+ * anyway.
+ */
+int
+hkdf_extract(hkdf_ctx *ctx, const digest_algorithm *alg,
+    const void *salt, size_t saltlen, const void *ikm, size_t ikmlen)
+{
+	uint8_t prk[DIGEST_MAX_DIGEST_LEN];
+	int ret;
+
+	if (hmac_complete(alg, salt, saltlen, ikm, ikmlen, prk) != 0)
+		return (-1);
+	ret = hkdf_setprk(ctx, alg, prk, alg->digestlen);
+	memset_s(prk, sizeof prk, 0, sizeof prk);
+	return (ret);
+}
+
+/*
+ * Prepare the context for expansion from an existing pseudorandom key.
+ */
+int
+hkdf_setprk(hkdf_ctx *ctx, const digest_algorithm *alg,
+    const void *prk, size_t prklen)
+{
+
+	return (hmac_setkey(&ctx->prk, alg, prk, prklen));
+}
+
+/*
+ * Expand the pseudorandom key into output keying material.
+ */
+int
+hkdf_expand(const hkdf_ctx *ctx, const void *info, size_t infolen,
+    uint8_t *okm, size_t okmlen)
+{
+	uint8_t t[DIGEST_MAX_DIGEST_LEN];
+	hmac_ctx hctx;
+	size_t hlen, len, tlen;
+	uint8_t i;
+
+	hlen = ctx->prk.alg->digestlen;
+	if (okmlen > 255 * hlen) {
+		errno = EINVAL;
+		return (-1);
+	}
+	for (i = 1, tlen = 0; okmlen > 0; ++i) {
+		/* T(i) = HMAC-Hash(PRK, T(i-1) | info | i) */
+		hmac_reset(&hctx, &ctx->prk);
+		hmac_update(&hctx, t, tlen);
+		hmac_update(&hctx, info, infolen);
+		hmac_update(&hctx, &i, 1);
+		hmac_final(&hctx, t);
+		tlen = hlen;
+		len = okmlen < hlen ? okmlen : hlen;
+		memcpy(okm, t, len);
+		okm += len;
+		okmlen -= len;
+	}
+	memset_s(t, sizeof t, 0, sizeof t);
+	return (0);
+}
+
+/*
+ * Wipe a context.
+ */
+void
+hkdf_clear(hkdf_ctx *ctx)
+{
+
+	memset_s(ctx, sizeof *ctx, 0, sizeof *ctx);
+}
+
+/*
+ * Extract and expand in a single call.
+ */
+int
+hkdf_complete(const digest_algorithm *alg, const void *salt, size_t saltlen,
+    const void *ikm, size_t ikmlen, const void *info, size_t infolen,
+    uint8_t *okm, size_t okmlen)
+{
+	hkdf_ctx ctx;
+	int ret;
+
+	if (hkdf_extract(&ctx, alg, salt, saltlen, ikm, ikmlen) != 0)
+		return (-1);
+	ret = hkdf_expand(&ctx, info, infolen, okm, okmlen);
+	hkdf_clear(&ctx);
+	return (ret);
+}
@@ -0,0 +1,183 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <cryb/memset_s.h>
+
+#include <cryb/digest.h>
+#include <cryb/hmac.h>
+
+#include "cryb_hmac_impl.h"
+
+/*
+ * HMAC (RFC 2104) over an arbitrary digest algorithm.  The functions for
+ * specific digest algorithms are thin wrappers around hmac_pads() and
+ * hmac_finish(), so the construction itself only exists here.
+ */
+
+/*
+ * Hash the inner and outer pads into a pair of digest contexts.
+ */
+void
+hmac_pads(const digest_algorithm *alg, digest_ctx *ictx, digest_ctx *octx,
+    const void *key, size_t keylen)
+{
+	uint8_t keybuf[DIGEST_MAX_BLOCK_LEN], pad[DIGEST_MAX_BLOCK_LEN];
+	unsigned int i;
+
+	/* prepare key */
+	memset(keybuf, 0, sizeof keybuf);
+	if (keylen > alg->blocklen)
+		digest_complete(alg, key, keylen, keybuf);
+	else if (keylen > 0)
+		memcpy(keybuf, key, keylen);
+
+	/* input pad */
+	for (i = 0; i < alg->blocklen; ++i)
+		pad[i] = 0x36 ^ keybuf[i];
+	digest_init(alg, ictx);
+	digest_update(alg, ictx, pad, alg->blocklen);
+
+	/* output pad */
+	for (i = 0; i < alg->blocklen; ++i)
+		pad[i] = 0x5c ^ keybuf[i];
+	digest_init(alg, octx);
+	digest_update(alg, octx, pad, alg->blocklen);
+
+	/* hide the evidence */
+	memset_s(keybuf, sizeof keybuf, 0, sizeof keybuf);
+	memset_s(pad, sizeof pad, 0, sizeof pad);
+}
+
+/*
+ * Finish the inner hash and feed it to the outer hash.
+ */
+void
+hmac_finish(const digest_algorithm *alg, digest_ctx *ictx, digest_ctx *octx,
+    uint8_t *mac)
+{
+	uint8_t digest[DIGEST_MAX_DIGEST_LEN];
+
+	digest_final(alg, ictx, digest);
+	digest_update(alg, octx, digest, alg->digestlen);
+	digest_final(alg, octx, mac);
+	memset_s(digest, sizeof digest, 0, sizeof digest);
+}
+
+/*
+ * Check that a digest algorithm fits in our contexts.
+ */
+static int
+hmac_supported(const digest_algorithm *alg)
+{
+
+	return (alg->contextlen <= DIGEST_MAX_CONTEXT_LEN &&
+	    alg->blocklen <= DIGEST_MAX_BLOCK_LEN &&
+	    alg->digestlen <= DIGEST_MAX_DIGEST_LEN);
+}
+
+/*
+ * Initialize an HMAC context with the given digest algorithm and key.
+ */
+int
+hmac_init(hmac_ctx *ctx, const digest_algorithm *alg,
+    const void *key, size_t keylen)
+{
+
+	if (!hmac_supported(alg)) {
+		errno = EINVAL;
+		return (-1);
+	}
+	ctx->alg = alg;
+	hmac_pads(alg, ctx->ictx, ctx->octx, key, keylen);
+	return (0);
+}
+
+/*
+ * Precompute the pad midstates for a key, so that they can be reused
+ * for any number of messages without hashing the pads again.
+ */
+int
+hmac_setkey(hmac_key *hk, const digest_algorithm *alg,
+    const void *key, size_t keylen)
+{
+
+	if (!hmac_supported(alg)) {
+		errno = EINVAL;
+		return (-1);
+	}
+	hk->alg = alg;
+	hmac_pads(alg, hk->ictx, hk->octx, key, keylen);
+	return (0);
+}
+
+/*
+ * Prepare a context for a new message using precomputed midstates.
+ */
+void
+hmac_reset(hmac_ctx *ctx, const hmac_key *hk)
+{
+
+	ctx->alg = hk->alg;
+	memcpy(ctx->ictx, hk->ictx, hk->alg->contextlen);
+	memcpy(ctx->octx, hk->octx, hk->alg->contextlen);
+}
+
+void
+hmac_update(hmac_ctx *ctx, const void *buf, size_t len)
+{
+
+	digest_update(ctx->alg, ctx->ictx, buf, len);
+}
+
+void
+hmac_final(hmac_ctx *ctx, uint8_t *mac)
+{
+
+	hmac_finish(ctx->alg, ctx->ictx, ctx->octx, mac);
+	memset_s(ctx, sizeof *ctx, 0, sizeof *ctx);
+}
+
+int
+hmac_complete(const digest_algorithm *alg, const void *key, size_t keylen,
+    const void *buf, size_t len, uint8_t *mac)
+{
+	hmac_ctx ctx;
+
+	if (hmac_init(&ctx, alg, key, keylen) != 0)
+		return (-1);
+	hmac_update(&ctx, buf, len);
+	hmac_final(&ctx, mac);
+	return (0);
+}
@@ -30,46 +30,35 @@
 
 #include "cryb/impl.h"
 
-#if HAVE_SYS_ENDIAN_H
-#include <sys/endian.h>
-#endif
-
-#if HAVE_ENDIAN_H
-#include <endian.h>
-#endif
-
 #include <stdint.h>
 #include <string.h>
 
+#include <cryb/memset_s.h>
+
 #include <cryb/hmac_sha224.h>
 
+#include "cryb_hmac_impl.h"
+
 void
 hmac_sha224_init(hmac_sha224_ctx *ctx, const void *key, size_t keylen)
 {
-	uint8_t keybuf[SHA224_BLOCK_LEN], pad[SHA224_BLOCK_LEN];
-
-	/* prepare key */
-	memset(keybuf, 0, sizeof keybuf);
-	if (keylen > sizeof keybuf)
-		sha224_complete(key, keylen, keybuf);
-	else
-		memcpy(keybuf, key, keylen);
-
-	/* input pad */
-	for (unsigned int i = 0; i < sizeof pad; ++i)
-		pad[i] = 0x36 ^ keybuf[i];
-	sha224_init(&ctx->ictx);
-	sha224_update(&ctx->ictx, pad, sizeof pad);
-
-	/* output pad */
-	for (unsigned int i = 0; i < sizeof pad; ++i)
-		pad[i] = 0x5c ^ keybuf[i];
-	sha224_init(&ctx->octx);
-	sha224_update(&ctx->octx, pad, sizeof pad);
-
-	/* hide the evidence */
-	memset(keybuf, 0, sizeof keybuf);
-	memset(pad, 0, sizeof pad);
+
+	hmac_pads(&sha224_digest, &ctx->ictx, &ctx->octx, key, keylen);
+}
+
+void
+hmac_sha224_setkey(hmac_sha224_key *hk, const void *key, size_t keylen)
+{
+
+	hmac_pads(&sha224_digest, &hk->ictx, &hk->octx, key, keylen);
+}
+
+void
+hmac_sha224_reset(hmac_sha224_ctx *ctx, const hmac_sha224_key *hk)
+{
+
+	ctx->ictx = hk->ictx;
+	ctx->octx = hk->octx;
 }
 
 void
@@ -82,12 +71,9 @@ hmac_sha224_update(hmac_sha224_ctx *ctx, const void *buf, size_t len)
 void
 hmac_sha224_final(hmac_sha224_ctx *ctx, uint8_t *mac)
 {
-	uint8_t digest[SHA224_DIGEST_LEN];
 
-	sha224_final(&ctx->ictx, digest);
-	sha224_update(&ctx->octx, digest, sizeof digest);
-	sha224_final(&ctx->octx, mac);
-	memset(ctx, 0, sizeof *ctx);
+	hmac_finish(&sha224_digest, &ctx->ictx, &ctx->octx, mac);
+	memset_s(ctx, sizeof *ctx, 0, sizeof *ctx);
 }
 
 void
@@ -100,3 +86,16 @@ hmac_sha224_complete(const void *key, size_t keylen,
 	hmac_sha224_update(&ctx, buf, len);
 	hmac_sha224_final(&ctx, mac);
 }
+
+mac_algorithm hmac_sha224_mac = {
+	.name			 = "hmac-sha224",
+	.contextlen		 = sizeof(hmac_sha224_ctx),
+	.keystatelen		 = sizeof(hmac_sha224_key),
+	.maclen			 = HMAC_SHA224_MAC_LEN,
+	.init			 = (mac_init_func)(void *)hmac_sha224_init,
+	.update			 = (mac_update_func)(void *)hmac_sha224_update,
+	.final			 = (mac_final_func)(void *)hmac_sha224_final,
+	.complete		 = (mac_complete_func)(void *)hmac_sha224_complete,
+	.setkey			 = (mac_setkey_func)(void *)hmac_sha224_setkey,
+	.reset			 = (mac_reset_func)(void *)hmac_sha224_reset,
+};
@@ -30,9 +30,16 @@
 #include "cryb/impl.h"
 
 #include <stdint.h>
+#include <string.h>
 #include <unistd.h>
 
 #include <cryb/mac.h>
+#include <cryb/aes_cmac.h>
+#include <cryb/hmac_sha1.h>
+#include <cryb/hmac_sha224.h>
+#include <cryb/hmac_sha256.h>
+#include <cryb/hmac_sha384.h>
+#include <cryb/hmac_sha512.h>
 
 static const char *cryb_mac_version_string = PACKAGE_VERSION;
 
@@ -42,3 +49,33 @@ cryb_mac_version(void)
 
 	return (cryb_mac_version_string);
 }
+
+static const mac_algorithm **cryb_mac_algorithms;
+
+static void
+init_mac_algorithms(void)
+{
+	static const mac_algorithm *algorithms[] = {
+		&aes_cmac_mac,
+		&hmac_sha1_mac,
+		&hmac_sha224_mac,
+		&hmac_sha256_mac,
+		&hmac_sha384_mac,
+		&hmac_sha512_mac,
+		NULL
+	};
+	cryb_mac_algorithms = algorithms;
+}
+
+const mac_algorithm *
+get_mac_algorithm(const char *name)
+{
+	const mac_algorithm **algp;
+
+	if (cryb_mac_algorithms == NULL)
+		init_mac_algorithms();
+	for (algp = cryb_mac_algorithms; *algp != NULL; ++algp)
+		if (strcasecmp((*algp)->name, name) == 0)
+			return (*algp);
+	return (NULL);
+}
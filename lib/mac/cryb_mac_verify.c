@@ -0,0 +1,145 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <cryb/memset_s.h>
+#include <cryb/timingsafe_bcmp.h>
+
+#include <cryb/mac.h>
+
+/*
+ * Check that the algorithm's state fits in our buffers.
+ */
+static int
+mac_verify_check(const mac_algorithm *alg)
+{
+
+	if (alg->contextlen > MAC_MAX_CONTEXT_LEN ||
+	    alg->keystatelen > MAC_MAX_CONTEXT_LEN ||
+	    alg->maclen > MAC_MAX_MAC_LEN) {
+		errno = EINVAL;
+		return (-1);
+	}
+	return (0);
+}
+
+/*
+ * Compare a computed MAC with an expected one, which may be truncated,
+ * but to no less than half its length or MAC_MIN_TAG_LEN bytes,
+ * whichever is longer.  The comparison takes the same time regardless
+ * of where, or whether, the two differ.
+ */
+static int
+mac_compare(const mac_algorithm *alg, const uint8_t *mac,
+    const uint8_t *tag, size_t taglen)
+{
+	size_t minlen;
+
+	minlen = alg->maclen / 2;
+	if (minlen < MAC_MIN_TAG_LEN)
+		minlen = MAC_MIN_TAG_LEN;
+	if (minlen > alg->maclen)
+		minlen = alg->maclen;
+	if (taglen < minlen || taglen > alg->maclen)
+		return (0);
+	return (timingsafe_bcmp(mac, tag, taglen) == 0);
+}
+
+/*
+ * Compute the MAC of a message and compare it with the expected value.
+ * Returns 1 if they match, 0 if they don't, and -1 if the algorithm is
+ * not supported.
+ */
+int
+mac_verify(const mac_algorithm *alg, const void *key, size_t keylen,
+    const void *msg, size_t msglen, const uint8_t *tag, size_t taglen)
+{
+	uint8_t mac[MAC_MAX_MAC_LEN];
+	int ret;
+
+	if (mac_verify_check(alg) != 0)
+		return (-1);
+	mac_complete(alg, key, keylen, msg, msglen, mac);
+	ret = mac_compare(alg, mac, tag, taglen);
+	memset_s(mac, sizeof mac, 0, sizeof mac);
+	return (ret);
+}
+
+/*
+ * Verify a batch of messages.  The result for each item (1 if the MAC
+ * matches, 0 otherwise) is stored in the corresponding element of
+ * results, and the number of valid items is returned.  Every item is
+ * checked even if an earlier one fails.  If the algorithm is not
+ * supported, every result is 0 and (size_t)-1 is returned.
+ *
+ * The key state is computed once for each run of consecutive items that
+ * share the same key buffer, so callers verifying many messages under a
+ * single key should pass the same pointer for each of them.
+ */
+size_t
+mac_verify_many(const mac_algorithm *alg, const mac_verify_item *items,
+    size_t n, int *results)
+{
+	uint64_t ctx[MAC_MAX_CONTEXT_LEN / sizeof(uint64_t)];
+	uint64_t hk[MAC_MAX_CONTEXT_LEN / sizeof(uint64_t)];
+	uint8_t mac[MAC_MAX_MAC_LEN];
+	const void *key;
+	size_t i, keylen, valid;
+
+	if (mac_verify_check(alg) != 0) {
+		for (i = 0; i < n; ++i)
+			results[i] = 0;
+		return ((size_t)-1);
+	}
+	key = NULL;
+	keylen = 0;
+	for (i = valid = 0; i < n; ++i) {
+		if (i == 0 || items[i].key != key || items[i].keylen != keylen) {
+			key = items[i].key;
+			keylen = items[i].keylen;
+			mac_setkey(alg, hk, key, keylen);
+		}
+		mac_reset(alg, ctx, hk);
+		mac_update(alg, ctx, items[i].msg, items[i].msglen);
+		mac_final(alg, ctx, mac);
+		results[i] = mac_compare(alg, mac, items[i].tag,
+		    items[i].taglen);
+		valid += results[i];
+	}
+	memset_s(hk, sizeof hk, 0, sizeof hk);
+	memset_s(ctx, sizeof ctx, 0, sizeof ctx);
+	memset_s(mac, sizeof mac, 0, sizeof mac);
+	return (valid);
+}
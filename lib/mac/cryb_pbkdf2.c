@@ -0,0 +1,110 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <cryb/endian.h>
+#include <cryb/memset_s.h>
+
+#include <cryb/digest.h>
+#include <cryb/hmac.h>
+#include <cryb/pbkdf2.h>
+
+#include "cryb_hmac_impl.h"
+
+#define PBKDF2_WORDS	(DIGEST_MAX_DIGEST_LEN / sizeof(uint64_t))
+
+/*
+ * PBKDF2 (RFC 8018 section 5.2) with HMAC over the given digest
+ * algorithm as the pseudorandom function.
+ *
+ * The inner and outer pad midstates are computed once from the password
+ * and copied into place at the start of each iteration, so every
+ * iteration costs exactly two compression function calls for the
+ * common case of a digest no longer than the block length.
+ */
+int
+pbkdf2_hmac(const digest_algorithm *alg, const void *password, size_t pwlen,
+    const void *salt, size_t saltlen, unsigned int iterations,
+    uint8_t *dk, size_t dklen)
+{
+	uint64_t ictx[DIGEST_MAX_CONTEXT_LEN / sizeof(uint64_t)];
+	uint64_t octx[DIGEST_MAX_CONTEXT_LEN / sizeof(uint64_t)];
+	uint64_t U[PBKDF2_WORDS], T[PBKDF2_WORDS];
+	uint8_t ibuf[4];
+	hmac_key hk;
+	size_t hlen, len;
+	uint32_t i;
+	unsigned int j, k;
+
+	hlen = alg->digestlen;
+	if (iterations == 0 ||
+	    (dklen > 0 && (dklen - 1) / hlen >= UINT32_MAX)) {
+		errno = EINVAL;
+		return (-1);
+	}
+	if (hmac_setkey(&hk, alg, password, pwlen) != 0)
+		return (-1);
+	memset(U, 0, sizeof U);
+	for (i = 1; dklen > 0; ++i) {
+		/* U_1 = PRF(P, S || INT(i)) */
+		be32enc(ibuf, i);
+		memcpy(ictx, hk.ictx, alg->contextlen);
+		memcpy(octx, hk.octx, alg->contextlen);
+		digest_update(alg, ictx, salt, saltlen);
+		digest_update(alg, ictx, ibuf, sizeof ibuf);
+		hmac_finish(alg, ictx, octx, (uint8_t *)U);
+		memcpy(T, U, sizeof T);
+
+		/* U_j = PRF(P, U_{j-1}), T_i = U_1 ^ ... ^ U_c */
+		for (j = 1; j < iterations; ++j) {
+			memcpy(ictx, hk.ictx, alg->contextlen);
+			memcpy(octx, hk.octx, alg->contextlen);
+			digest_update(alg, ictx, U, hlen);
+			hmac_finish(alg, ictx, octx, (uint8_t *)U);
+			for (k = 0; k < PBKDF2_WORDS; ++k)
+				T[k] ^= U[k];
+		}
+
+		len = dklen < hlen ? dklen : hlen;
+		memcpy(dk, T, len);
+		dk += len;
+		dklen -= len;
+	}
+	memset_s(&hk, sizeof hk, 0, sizeof hk);
+	memset_s(ictx, sizeof ictx, 0, sizeof ictx);
+	memset_s(octx, sizeof octx, 0, sizeof octx);
+	memset_s(U, sizeof U, 0, sizeof U);
+	memset_s(T, sizeof T, 0, sizeof T);
+	return (0);
+}
@@ -104,6 +104,9 @@ mpi_add_abs(cryb_mpi *X, const cryb_mpi *A, const cryb_mpi *B)
 		c = (X->words[i] < c);
 		++i;
 	}
+	/* B may have been shorter than A, which X->msb still reflects */
+	if (i < MPI_MSW(X) - 1)
+		i = MPI_MSW(X) - 1;
 	if (X->words[i] == 0)
 		--i;
 	X->msb = i * 32 + flsl(X->words[i]);
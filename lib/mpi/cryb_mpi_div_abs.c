@@ -39,16 +39,44 @@
 
 #include "cryb_mpi_impl.h"
 
+/*
+ * Recompute the msb of X, given that its value fits in n words.
+ */
+static void
+mpi_div_fix_msb(cryb_mpi *X, unsigned int n)
+{
+
+	while (n > 0 && X->words[n - 1] == 0)
+		--n;
+	X->msb = n > 0 ? (n - 1) * 32 + flsl(X->words[n - 1]) : 0;
+}
+
 /*
  * Store the quotient and remainder of A divided by B in Q and R.
  *
  * Assumes Q != R, but any combination of {Q,R} == {A,B} is fine.  Either
  * Q or R or both may be NULL, althought the latter is pointless.
+ *
+ * This is the classical long division algorithm, Knuth's Algorithm D
+ * (TAOCP vol. 2, 4.3.1), also described as Algorithm 14.20 in HAC.  A
+ * and B have m and n words respectively.  We first shift both left so
+ * that the most significant bit of B is set, which guarantees that the
+ * trial quotient computed from the top two words of the remainder and
+ * the top word of B, which is a 64-bit by 32-bit division, is at most
+ * two too large.  A second test using the next word of B catches almost
+ * all of those cases, and in the rare remaining case the remainder goes
+ * negative and we add B back.  This takes O(n (m - n)) time, rather
+ * than time proportional to the quotient.
+ *
+ * Single-word divisors are handled separately and much more simply.
  */
 int
 mpi_div_abs(cryb_mpi *Q, cryb_mpi *R, const cryb_mpi *A, const cryb_mpi *B)
 {
-	cryb_mpi AA = CRYB_MPI_ZERO, QQ = CRYB_MPI_ZERO;
+	cryb_mpi UU = CRYB_MPI_ZERO, VV = CRYB_MPI_ZERO, QQ = CRYB_MPI_ZERO;
+	uint32_t *q, *u, *v, d, r;
+	uint64_t num, qhat, rhat, p, t, carry, borrow;
+	unsigned int i, j, m, n, s;
 	int cmp;
 
 	/* trivial cases */
@@ -86,30 +114,104 @@ mpi_div_abs(cryb_mpi *Q, cryb_mpi *R, const cryb_mpi *A, const cryb_mpi *B)
 		return (0);
 	}
 
-	/* division is destructive, so we work on copies */
-	if (mpi_copy(&AA, A) != 0)
-		return (-1);
-	mpi_zero(&QQ);
-
 	/*
-	 * Repeatedly subtract B from A until they are the same length,
-	 * then one last time if A is still greater than B.
+	 * Division is destructive, so we work on copies.  The remainder
+	 * needs an extra word to hold the bits shifted out at the top.
 	 */
-	while (AA.msb > B->msb) {
-		mpi_sub_abs(&AA, &AA, B);
-		mpi_inc_abs(&QQ);
-	}
-	if (mpi_cmp_abs(&AA, B) >= 0) {
-		mpi_sub_abs(&AA, &AA, B);
-		mpi_inc_abs(&QQ);
+	m = MPI_MSW(A);
+	n = MPI_MSW(B);
+	if (mpi_grow(&QQ, (m - n + 1) * 32) != 0 ||
+	    mpi_grow(&UU, (m + 1) * 32) != 0 ||
+	    mpi_grow(&VV, n * 32) != 0)
+		goto fail;
+	q = QQ.words;
+	u = UU.words;
+	v = VV.words;
+
+	if (n == 1) {
+		/*
+		 * Single-word divisor: divide one word at a time, carrying
+		 * the remainder into the next.
+		 */
+		d = B->words[0];
+		for (r = 0, j = m; j > 0; --j) {
+			num = (uint64_t)r << 32 | A->words[j - 1];
+			q[j - 1] = num / d;
+			r = num % d;
+		}
+		u[0] = r;
+	} else {
+		/* normalize */
+		s = 32 - flsl(B->words[n - 1]);
+		for (i = n - 1; i > 0; --i)
+			v[i] = B->words[i] << s |
+			    (s ? B->words[i - 1] >> (32 - s) : 0);
+		v[0] = B->words[0] << s;
+		u[m] = s ? A->words[m - 1] >> (32 - s) : 0;
+		for (i = m - 1; i > 0; --i)
+			u[i] = A->words[i] << s |
+			    (s ? A->words[i - 1] >> (32 - s) : 0);
+		u[0] = A->words[0] << s;
+
+		for (j = m - n + 1; j > 0; --j) {
+			/* estimate the next quotient word */
+			num = (uint64_t)u[j - 1 + n] << 32 | u[j - 2 + n];
+			qhat = num / v[n - 1];
+			rhat = num % v[n - 1];
+			while (qhat > 0xffffffffU ||
+			    qhat * v[n - 2] > (rhat << 32 | u[j - 3 + n])) {
+				--qhat;
+				rhat += v[n - 1];
+				if (rhat > 0xffffffffU)
+					break;
+			}
+
+			/* multiply and subtract */
+			for (carry = borrow = 0, i = 0; i < n; ++i) {
+				p = qhat * v[i] + carry;
+				carry = p >> 32;
+				t = (uint64_t)u[i + j - 1] - (uint32_t)p - borrow;
+				u[i + j - 1] = (uint32_t)t;
+				borrow = t >> 63;
+			}
+			t = (uint64_t)u[j - 1 + n] - carry - borrow;
+			u[j - 1 + n] = (uint32_t)t;
+
+			/* if we went too far, add back */
+			if (t >> 63) {
+				--qhat;
+				for (carry = 0, i = 0; i < n; ++i) {
+					t = (uint64_t)u[i + j - 1] + v[i] + carry;
+					u[i + j - 1] = (uint32_t)t;
+					carry = t >> 32;
+				}
+				u[j - 1 + n] += carry;
+			}
+			q[j - 1] = qhat;
+		}
+
+		/* denormalize the remainder */
+		for (i = 0; i < n - 1; ++i)
+			u[i] = u[i] >> s | (s ? u[i + 1] << (32 - s) : 0);
+		u[n - 1] >>= s;
+		for (i = n; i <= m; ++i)
+			u[i] = 0;
 	}
+	mpi_div_fix_msb(&QQ, m - n + 1);
+	mpi_div_fix_msb(&UU, n);
 
 	/* store result where requested and clean up */
 	if (Q != NULL)
 		mpi_swap(Q, &QQ);
 	if (R != NULL)
-		mpi_swap(R, &AA);
-	mpi_destroy(&AA);
+		mpi_swap(R, &UU);
+	mpi_destroy(&UU);
+	mpi_destroy(&VV);
 	mpi_destroy(&QQ);
 	return (0);
+fail:
+	mpi_destroy(&UU);
+	mpi_destroy(&VV);
+	mpi_destroy(&QQ);
+	return (-1);
 }
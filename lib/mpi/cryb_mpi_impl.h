@@ -41,3 +41,24 @@
 		(X)->words = (X)->swords;				\
 		(X)->size = CRYB_MPI_SWORDS;				\
 	} while (0)
+
+/*
+ * Operand sizes, in words, at or above which mpi_mul_abs() switches
+ * from schoolbook multiplication to Karatsuba and from Karatsuba to
+ * Toom-3.  Machines without a native 32x32->64 multiply benefit from
+ * switching earlier.  Either can be overridden at build time.
+ */
+#ifndef CRYB_MPI_KARATSUBA_THRESHOLD
+#if defined(__LP64__) || defined(_WIN64)
+#define CRYB_MPI_KARATSUBA_THRESHOLD	32
+#else
+#define CRYB_MPI_KARATSUBA_THRESHOLD	24
+#endif
+#endif
+#ifndef CRYB_MPI_TOOM3_THRESHOLD
+#if defined(__LP64__) || defined(_WIN64)
+#define CRYB_MPI_TOOM3_THRESHOLD	128
+#else
+#define CRYB_MPI_TOOM3_THRESHOLD	96
+#endif
+#endif
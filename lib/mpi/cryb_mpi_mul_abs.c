@@ -31,15 +31,177 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 #include <strings.h>
 
 #include <cryb/bitwise.h>
+#include <cryb/memset_s.h>
 #include <cryb/mpi.h>
 
 #include "cryb_mpi_impl.h"
 
+#if CRYB_MPI_KARATSUBA_THRESHOLD < 2
+#error CRYB_MPI_KARATSUBA_THRESHOLD must be at least 2
+#endif
+#if CRYB_MPI_TOOM3_THRESHOLD < 5
+#error CRYB_MPI_TOOM3_THRESHOLD must be at least 5
+#endif
+
 /*
- * Store the product of the absolutes values of A and B in X.
+ * The functions below operate directly on arrays of words rather than
+ * on mpis, so that the recursive algorithms can work on slices of
+ * their operands and on preallocated scratch space.
+ */
+
+/*
+ * Store a + b in r, where all three have n words, and return the carry.
+ */
+static uint32_t
+mpi_w_add(uint32_t *r, const uint32_t *a, const uint32_t *b, unsigned int n)
+{
+	uint64_t t;
+	unsigned int i;
+	uint32_t c;
+
+	for (c = i = 0; i < n; ++i) {
+		t = (uint64_t)a[i] + b[i] + c;
+		r[i] = t & 0xffffffffUL;
+		c = t >> 32;
+	}
+	return (c);
+}
+
+/*
+ * Store a - b in r, where all three have n words, and return the borrow.
+ */
+static uint32_t
+mpi_w_sub(uint32_t *r, const uint32_t *a, const uint32_t *b, unsigned int n)
+{
+	uint64_t t;
+	unsigned int i;
+	uint32_t c;
+
+	for (c = i = 0; i < n; ++i) {
+		t = (uint64_t)a[i] - b[i] - c;
+		r[i] = t & 0xffffffffUL;
+		c = (t >> 32) & 1;
+	}
+	return (c);
+}
+
+/*
+ * Add the an-word a to the rn-word r modulo the size of r.
+ */
+static void
+mpi_w_addto(uint32_t *r, unsigned int rn, const uint32_t *a, unsigned int an)
+{
+	unsigned int i;
+	uint32_t c;
+
+	if (an > rn)
+		an = rn;
+	c = mpi_w_add(r, r, a, an);
+	for (i = an; c && i < rn; ++i)
+		c = (++r[i] == 0);
+}
+
+/*
+ * Subtract the an-word a from the rn-word r modulo the size of r.
+ */
+static void
+mpi_w_subfrom(uint32_t *r, unsigned int rn, const uint32_t *a,
+    unsigned int an)
+{
+	unsigned int i;
+	uint32_t c;
+
+	if (an > rn)
+		an = rn;
+	c = mpi_w_sub(r, r, a, an);
+	for (i = an; c && i < rn; ++i)
+		c = (r[i]-- == 0);
+}
+
+/*
+ * Store the absolute difference between the n-word a and the bn-word b
+ * in the n-word r, where bn <= n.  Return 1 if a < b and 0 otherwise.
+ */
+static int
+mpi_w_absdiff(uint32_t *r, const uint32_t *a, unsigned int n,
+    const uint32_t *b, unsigned int bn)
+{
+	unsigned int i;
+
+	for (i = n; i > bn; --i)
+		if (a[i - 1] != 0)
+			break;
+	if (i == bn) {
+		while (i > 0 && a[i - 1] == b[i - 1])
+			--i;
+		if (i > 0 && a[i - 1] < b[i - 1]) {
+			mpi_w_sub(r, b, a, bn);
+			memset(r + bn, 0, (n - bn) * sizeof *r);
+			return (1);
+		}
+	}
+	memcpy(r, a, n * sizeof *r);
+	mpi_w_subfrom(r, n, b, bn);
+	return (0);
+}
+
+/*
+ * Negate the n-word two's complement number x.
+ */
+static void
+mpi_w_negate(uint32_t *x, unsigned int n)
+{
+	unsigned int i;
+	uint32_t c;
+
+	for (c = 1, i = 0; i < n; ++i) {
+		x[i] = ~x[i] + c;
+		c = c && x[i] == 0;
+	}
+}
+
+/*
+ * Divide the n-word two's complement number x by two.
+ */
+static void
+mpi_w_half(uint32_t *x, unsigned int n)
+{
+	unsigned int i;
+
+	for (i = 0; i < n - 1; ++i)
+		x[i] = x[i] >> 1 | x[i + 1] << 31;
+	x[i] = x[i] >> 1 | (x[i] & 0x80000000UL);
+}
+
+/*
+ * Divide the n-word two's complement number x, which must be a multiple
+ * of three, by three.  Since the division is exact, it can be performed
+ * by multiplying each word by the inverse of three modulo 2^32 and
+ * carrying the excess into the next word.
+ */
+static void
+mpi_w_third(uint32_t *x, unsigned int n)
+{
+	unsigned int i;
+	uint64_t t;
+	uint32_t b, c;
+
+	for (c = i = 0; i < n; ++i) {
+		b = x[i] < c;
+		x[i] = (x[i] - c) * 0xaaaaaaabUL;
+		t = 3ULL * x[i];
+		c = (t >> 32) + b;
+	}
+}
+
+/*
+ * Store the product of the an-word a and the bn-word b in the
+ * (an + bn)-word r.
  *
  * Note: this is loosely based on HAC 14.2.3.  However, the first
  * paragraph speaks of x and y having n and t digits respectively, with
@@ -48,13 +210,306 @@
  * follow the former convention, but use a and b instead of n and t to
  * distance ourselves from this confusing text.
  */
+static void
+mpi_mul_base(uint32_t *r, const uint32_t *a, unsigned int an,
+    const uint32_t *b, unsigned int bn)
+{
+	uint64_t p;
+	unsigned int i, j;
+	uint32_t c;
+
+	memset(r, 0, (an + bn) * sizeof *r);
+	for (i = 0; i < bn; ++i) {
+		for (c = j = 0; j < an; ++j) {
+			p = 1ULL * a[j] * b[i] + r[i + j] + c;
+			r[i + j] = p & 0xffffffffUL;
+			c = p >> 32;
+		}
+		r[i + j] = c;
+	}
+}
+
+static void mpi_mul_rec(uint32_t *, const uint32_t *, const uint32_t *,
+    unsigned int, uint32_t *);
+
+/*
+ * Karatsuba multiplication of two n-word numbers.  Split each operand
+ * into a low half of m words and a high half of h words, so that
+ *
+ *   a * b = z2 * W^2m + (z0 + z2 - (a0 - a1) * (b0 - b1)) * W^m + z0
+ *
+ * where z0 = a0 * b0 and z2 = a1 * b1.  Using the difference rather than
+ * the sum of the halves keeps every product to m words per operand.
+ * The middle term is computed modulo W^(2m+1), which is enough to hold
+ * it since it is known to be non-negative and less than 2 * W^2m.
+ *
+ * Scratch space: 6m + 1 words, plus whatever the recursive calls need.
+ */
+static void
+mpi_mul_karatsuba(uint32_t *r, const uint32_t *a, const uint32_t *b,
+    unsigned int n, uint32_t *s)
+{
+	uint32_t *da, *db, *d, *t;
+	unsigned int m, h;
+	int neg;
+
+	m = (n + 1) / 2;
+	h = n - m;
+	da = s;
+	db = da + m;
+	d = db + m;
+	t = d + 2 * m;
+	s = t + 2 * m + 1;
+	neg = mpi_w_absdiff(da, a, m, a + m, h);
+	neg ^= mpi_w_absdiff(db, b, m, b + m, h);
+	mpi_mul_rec(r, a, b, m, s);
+	mpi_mul_rec(r + 2 * m, a + m, b + m, h, s);
+	mpi_mul_rec(d, da, db, m, s);
+	memcpy(t, r, 2 * m * sizeof *t);
+	t[2 * m] = 0;
+	mpi_w_addto(t, 2 * m + 1, r + 2 * m, 2 * h);
+	if (neg)
+		mpi_w_addto(t, 2 * m + 1, d, 2 * m);
+	else
+		mpi_w_subfrom(t, 2 * m + 1, d, 2 * m);
+	mpi_w_addto(r + m, 2 * n - m, t, 2 * m + 1);
+}
+
+/*
+ * Evaluate x2 * X^2 + x1 * X + x0, where x0 and x1 have k words and x2
+ * has h words, at 1, -1 and -2, storing the results in (k + 1)-word p1,
+ * pm1 and pm2.  The latter two are stored as absolute values; bits 0
+ * and 1 of the return value are set if they are negative.  The t and u
+ * arguments provide k + 1 words of scratch space each.
+ */
+static unsigned int
+mpi_toom3_eval(uint32_t *p1, uint32_t *pm1, uint32_t *pm2,
+    const uint32_t *x, unsigned int k, unsigned int h,
+    uint32_t *t, uint32_t *u)
+{
+	unsigned int i, neg;
+
+	/* p1 = x0 + x2, pm1 = |p1 - x1|, p1 = p1 + x1 */
+	memcpy(p1, x, k * sizeof *p1);
+	p1[k] = 0;
+	mpi_w_addto(p1, k + 1, x + 2 * k, h);
+	neg = mpi_w_absdiff(pm1, p1, k + 1, x + k, k);
+	mpi_w_addto(p1, k + 1, x + k, k);
+	/* pm2 = |(x0 + 4 * x2) - 2 * x1| */
+	memset(t, 0, (k + 1) * sizeof *t);
+	for (i = 0; i < h; ++i)
+		t[i] = x[2 * k + i] << 2 | (i > 0 ? x[2 * k + i - 1] >> 30 : 0);
+	t[h] = x[2 * k + h - 1] >> 30;
+	mpi_w_addto(t, k + 1, x, k);
+	for (i = 0; i < k; ++i)
+		u[i] = x[k + i] << 1 | (i > 0 ? x[k + i - 1] >> 31 : 0);
+	u[k] = x[2 * k - 1] >> 31;
+	neg |= mpi_w_absdiff(pm2, t, k + 1, u, k + 1) << 1;
+	return (neg);
+}
+
+/*
+ * Toom-Cook 3-way multiplication of two n-word numbers.  Split each
+ * operand into three parts of k, k and h words, treat them as
+ * polynomials of degree 2, evaluate them at 0, 1, -1, -2 and infinity,
+ * multiply pointwise, and interpolate the product using Bodrato's
+ * sequence.  The intermediate values are signed and are kept in
+ * two's complement form in 2k + 2 words; the final coefficients are
+ * non-negative and are added into the result modulo its size.
+ *
+ * Scratch space: 12k + 12 words, plus whatever the recursive calls
+ * need.
+ */
+static void
+mpi_mul_toom3(uint32_t *r, const uint32_t *a, const uint32_t *b,
+    unsigned int n, uint32_t *s)
+{
+	uint32_t *pa1, *pam1, *pam2, *pb1, *pbm1, *pbm2;
+	uint32_t *v1, *vm1, *vm2, *r0, *rinf;
+	unsigned int k, h, w, nega, negb;
+
+	k = (n + 2) / 3;
+	h = n - 2 * k;
+	w = 2 * k + 2;
+	pa1 = s;
+	pam1 = pa1 + k + 1;
+	pam2 = pam1 + k + 1;
+	pb1 = pam2 + k + 1;
+	pbm1 = pb1 + k + 1;
+	pbm2 = pbm1 + k + 1;
+	v1 = pbm2 + k + 1;
+	vm1 = v1 + w;
+	vm2 = vm1 + w;
+	s = vm2 + w;
+
+	/* evaluate, using the product space as scratch */
+	nega = mpi_toom3_eval(pa1, pam1, pam2, a, k, h, v1, vm1);
+	negb = mpi_toom3_eval(pb1, pbm1, pbm2, b, k, h, v1, vm1);
+
+	/* multiply; r0 and rinf go straight into the result */
+	r0 = r;
+	rinf = r + 4 * k;
+	mpi_mul_rec(r0, a, b, k, s);
+	mpi_mul_rec(rinf, a + 2 * k, b + 2 * k, h, s);
+	memset(r + 2 * k, 0, 2 * k * sizeof *r);
+	mpi_mul_rec(v1, pa1, pb1, k + 1, s);
+	mpi_mul_rec(vm1, pam1, pbm1, k + 1, s);
+	if ((nega ^ negb) & 1)
+		mpi_w_negate(vm1, w);
+	mpi_mul_rec(vm2, pam2, pbm2, k + 1, s);
+	if ((nega ^ negb) & 2)
+		mpi_w_negate(vm2, w);
+
+	/* vm2 = (vm2 - v1) / 3 */
+	mpi_w_sub(vm2, vm2, v1, w);
+	mpi_w_third(vm2, w);
+	/* v1 = (v1 - vm1) / 2 */
+	mpi_w_sub(v1, v1, vm1, w);
+	mpi_w_half(v1, w);
+	/* vm1 = vm1 - r0 */
+	mpi_w_subfrom(vm1, w, r0, 2 * k);
+	/* vm2 = (vm1 - vm2) / 2 + 2 * rinf */
+	mpi_w_sub(vm2, vm1, vm2, w);
+	mpi_w_half(vm2, w);
+	mpi_w_addto(vm2, w, rinf, 2 * h);
+	mpi_w_addto(vm2, w, rinf, 2 * h);
+	/* vm1 = vm1 + v1 - rinf */
+	mpi_w_add(vm1, vm1, v1, w);
+	mpi_w_subfrom(vm1, w, rinf, 2 * h);
+	/* v1 = v1 - vm2 */
+	mpi_w_sub(v1, v1, vm2, w);
+
+	/* recompose */
+	mpi_w_addto(r + k, 2 * n - k, v1, w);
+	mpi_w_addto(r + 2 * k, 2 * n - 2 * k, vm1, w);
+	mpi_w_addto(r + 3 * k, 2 * n - 3 * k, vm2, w);
+}
+
+/*
+ * Store the product of the n-word a and b in the 2n-word r, using
+ * whichever algorithm is appropriate for the size of the operands.
+ */
+static void
+mpi_mul_rec(uint32_t *r, const uint32_t *a, const uint32_t *b,
+    unsigned int n, uint32_t *s)
+{
+
+	if (n < CRYB_MPI_KARATSUBA_THRESHOLD)
+		mpi_mul_base(r, a, n, b, n);
+	else if (n < CRYB_MPI_TOOM3_THRESHOLD)
+		mpi_mul_karatsuba(r, a, b, n, s);
+	else
+		mpi_mul_toom3(r, a, b, n, s);
+}
+
+/*
+ * Amount of scratch space, in words, needed by mpi_mul_rec().
+ */
+static size_t
+mpi_mul_rec_scratch(unsigned int n)
+{
+	size_t s, t;
+	unsigned int k;
+
+	if (n < CRYB_MPI_KARATSUBA_THRESHOLD)
+		return (0);
+	if (n < CRYB_MPI_TOOM3_THRESHOLD) {
+		k = (n + 1) / 2;
+		s = mpi_mul_rec_scratch(k);
+		if ((t = mpi_mul_rec_scratch(n - k)) > s)
+			s = t;
+		return (6 * k + 1 + s);
+	}
+	k = (n + 2) / 3;
+	s = mpi_mul_rec_scratch(k + 1);
+	if ((t = mpi_mul_rec_scratch(k)) > s)
+		s = t;
+	if ((t = mpi_mul_rec_scratch(n - 2 * k)) > s)
+		s = t;
+	return (12 * k + 12 + s);
+}
+
+/*
+ * Store the product of the an-word a and the bn-word b in the
+ * (an + bn)-word r.  If the operands differ in size, the longer one is
+ * cut into slices the size of the shorter one, and the products of the
+ * slices are added up.
+ *
+ * Scratch space: twice the size of the shorter operand, plus whatever
+ * the recursive calls need.
+ */
+static void
+mpi_mul_unbalanced(uint32_t *r, const uint32_t *a, unsigned int an,
+    const uint32_t *b, unsigned int bn, uint32_t *s)
+{
+	const uint32_t *tp;
+	uint32_t *t;
+	unsigned int i, tn;
+
+	if (an < bn) {
+		tp = a;
+		a = b;
+		b = tp;
+		tn = an;
+		an = bn;
+		bn = tn;
+	}
+	if (bn < CRYB_MPI_KARATSUBA_THRESHOLD) {
+		mpi_mul_base(r, a, an, b, bn);
+		return;
+	}
+	if (an == bn) {
+		mpi_mul_rec(r, a, b, bn, s);
+		return;
+	}
+	t = s;
+	s = t + 2 * bn;
+	memset(r, 0, (an + bn) * sizeof *r);
+	for (i = 0; an - i >= bn; i += bn) {
+		mpi_mul_rec(t, a + i, b, bn, s);
+		mpi_w_addto(r + i, an + bn - i, t, 2 * bn);
+	}
+	if (i < an) {
+		mpi_mul_unbalanced(t, b, bn, a + i, an - i, s);
+		mpi_w_addto(r + i, an + bn - i, t, an - i + bn);
+	}
+}
+
+/*
+ * Amount of scratch space, in words, needed by mpi_mul_unbalanced().
+ */
+static size_t
+mpi_mul_unbalanced_scratch(unsigned int an, unsigned int bn)
+{
+	size_t s, t;
+
+	if (an < bn)
+		return (mpi_mul_unbalanced_scratch(bn, an));
+	if (bn < CRYB_MPI_KARATSUBA_THRESHOLD)
+		return (0);
+	if (an == bn)
+		return (mpi_mul_rec_scratch(bn));
+	s = mpi_mul_rec_scratch(bn);
+	if (an % bn != 0 &&
+	    (t = mpi_mul_unbalanced_scratch(bn, an % bn)) > s)
+		s = t;
+	return (2 * bn + s);
+}
+
+/*
+ * Store the product of the absolutes values of A and B in X.
+ *
+ * Small operands are multiplied using the schoolbook method; larger
+ * ones using Karatsuba or Toom-3 depending on their size.  The scratch
+ * space needed by the latter is allocated once, up front.
+ */
 int
 mpi_mul_abs(cryb_mpi *X, const cryb_mpi *A, const cryb_mpi *B)
 {
 	cryb_mpi *P, T = CRYB_MPI_ZERO;
-	uint64_t p;
-	unsigned int a, b, i, j;
-	uint32_t c;
+	uint32_t *S;
+	size_t sz;
+	unsigned int a, b, i;
 
 	/*
 	 * Trivial cases: A and / or B is zero.
@@ -80,13 +535,18 @@ mpi_mul_abs(cryb_mpi *X, const cryb_mpi *A, const cryb_mpi *B)
 	/*
 	 * Multiply...
 	 */
-	for (i = 0; i < b; ++i) {
-		for (c = j = 0; j < a; ++j) {
-			p = 1ULL * A->words[j] * B->words[i] + c;
-			P->words[i + j] += p & 0xffffffffUL;
-			c = p >> 32;
+	if (a < CRYB_MPI_KARATSUBA_THRESHOLD ||
+	    b < CRYB_MPI_KARATSUBA_THRESHOLD) {
+		mpi_mul_base(P->words, A->words, a, B->words, b);
+	} else {
+		sz = mpi_mul_unbalanced_scratch(a, b) * sizeof *S;
+		if ((S = malloc(sz)) == NULL) {
+			cryb_mpi_destroy(&T);
+			return (-1);
 		}
-		P->words[i + j] = c;
+		mpi_mul_unbalanced(P->words, A->words, a, B->words, b, S);
+		memset_s(S, sz, 0, sz);
+		free(S);
 	}
 	if (P->words[i = a + b - 1] == 0)
 		--i;
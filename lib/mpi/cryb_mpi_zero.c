@@ -47,7 +47,7 @@ mpi_zero(cryb_mpi *X)
 	if (X->words == NULL) {
 		MPI_FAST_INIT(X);
 	} else if (X->msb != 0) {
-		memset(X->words, 0, X->size);
+		memset(X->words, 0, X->size * sizeof *X->words);
 		X->msb = 0;
 	}
 	X->neg = 0;
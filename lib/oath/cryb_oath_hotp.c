@@ -34,51 +34,22 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <cryb/memset_s.h>
+
 #include <cryb/hmac_sha1.h>
 #include <cryb/oath.h>
 
-#define StToNum(St) (St)
-
-static uint32_t
-DT(const uint8_t *String)
-{
-	uint8_t OffsetBits;
-	int Offset;
-	uint32_t P;
-
-	OffsetBits = String[19] & 0x0f;
-	Offset = StToNum(OffsetBits);
-	P = (uint32_t)String[Offset + 0] << 24 |
-	    (uint32_t)String[Offset + 1] << 16 |
-	    (uint32_t)String[Offset + 2] << 8 |
-	    (uint32_t)String[Offset + 3];
-	return (P & 0x7fffffffUL);
-}
+#include "cryb_oath_impl.h"
 
 unsigned int
 oath_hotp(const uint8_t *K, size_t Klen, uint64_t seq, unsigned int Digit)
 {
-	hmac_sha1_ctx ctx;
-	uint8_t C[8];
-	uint8_t HS[20];
-	uint32_t Sbits, Snum;
-	unsigned int mod, D;
-
-	for (int i = 7; i >= 0; --i) {
-		C[i] = seq & 0xff;
-		seq >>= 8;
-	}
-
-	/* HS = HMAC-SHA-1(K,C) */
-	hmac_sha1_init(&ctx, K, Klen);
-	hmac_sha1_update(&ctx, (const uint8_t *)&C, sizeof C);
-	hmac_sha1_final(&ctx, HS);
+	hmac_sha1_key hk;
+	unsigned int D;
 
-	Sbits = DT(HS);
-	Snum = StToNum(Sbits);
-	for (mod = 1; Digit > 0; --Digit)
-		mod *= 10;
-	D = Snum % mod;
+	hmac_sha1_setkey(&hk, K, Klen);
+	D = oath_hotp_keyed(&hk, seq, Digit);
+	memset_s(&hk, sizeof hk, 0, sizeof hk);
 	return (D);
 }
 
@@ -109,7 +80,9 @@ oath_hotp_current(oath_key *k)
 int
 oath_hotp_match(oath_key *k, unsigned int response, int window)
 {
+	hmac_sha1_key hk;
 	unsigned int code;
+	int ret;
 
 	if (k == NULL)
 		return (-1);
@@ -119,12 +92,16 @@ oath_hotp_match(oath_key *k, unsigned int response, int window)
 		return (-1);
 	if (k->counter >= UINT64_MAX - window - 1)
 		return (-1);
+	hmac_sha1_setkey(&hk, k->key, k->keylen);
+	ret = 0;
 	for (int i = 0; i <= window; ++i) {
-		code = oath_hotp(k->key, k->keylen, k->counter + i, k->digits);
+		code = oath_hotp_keyed(&hk, k->counter + i, k->digits);
 		if (code == response && !k->dummy) {
 			k->counter = k->counter + i;
-			return (1);
+			ret = 1;
+			break;
 		}
 	}
-	return (0);
+	memset_s(&hk, sizeof hk, 0, sizeof hk);
+	return (ret);
 }
@@ -35,8 +35,13 @@
 #include <string.h>
 #include <time.h>
 
+#include <cryb/memset_s.h>
+
+#include <cryb/hmac_sha1.h>
 #include <cryb/oath.h>
 
+#include "cryb_oath_impl.h"
+
 #define TOTP_TIME_STEP 30
 
 unsigned int
@@ -73,8 +78,10 @@ oath_totp_current(const oath_key *k)
 int
 oath_totp_match(oath_key *k, unsigned int response, int window)
 {
+	hmac_sha1_key hk;
 	unsigned int code;
 	uint64_t seq;
+	int ret;
 
 	if (k == NULL)
 		return (-1);
@@ -85,14 +92,18 @@ oath_totp_match(oath_key *k, unsigned int response, int window)
 	if (k->timestep == 0)
 		return (-1);
 	seq = time(NULL) / k->timestep;
+	hmac_sha1_setkey(&hk, k->key, k->keylen);
+	ret = 0;
 	for (int i = -window; i <= window; ++i) {
 		if (seq + i <= k->lastused)
 			continue;
-		code = oath_hotp(k->key, k->keylen, seq + i, k->digits);
+		code = oath_hotp_keyed(&hk, seq + i, k->digits);
 		if (code == response && !k->dummy) {
 			k->lastused = seq;
-			return (1);
+			ret = 1;
+			break;
 		}
 	}
-	return (0);
+	memset_s(&hk, sizeof hk, 0, sizeof hk);
+	return (ret);
 }
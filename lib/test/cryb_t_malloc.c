@@ -220,6 +220,8 @@ t_malloc_mapped(size_t size)
 	/* insert into linked list */
 	m->next = mappings;
 	m->prev = NULL;
+	if (mappings != NULL)
+		mappings->prev = m;
 	mappings = m;
 
 	/* fill the slop */
@@ -42,6 +42,7 @@
 #define TRI(n)			(n * (n + 1) / 2)
 
 static uint8_t ones8[65536];
+static uint8_t ff8[65536];
 
 struct t_case {
 	const char *desc;
@@ -113,6 +114,35 @@ static struct t_case t_cases[] = {
 		.len	= 65521,
 		.sum	= ((TRIpN(65520U) + 1) % 65521U) << 16 | 1U,
 	},
+	/*
+	 * The largest possible input bytes, to verify that the sums are
+	 * reduced before they can overflow.  The implementation reduces
+	 * them every 5552 bytes.
+	 */
+	{
+		.desc	= "deferred reduction - 1",
+		.data	= ff8,
+		.len	= 5551,
+		.sum	= 0x56039a8d,
+	},
+	{
+		.desc	= "deferred reduction",
+		.data	= ff8,
+		.len	= 5552,
+		.sum	= 0xf18f9b8c,
+	},
+	{
+		.desc	= "deferred reduction + 1",
+		.data	= ff8,
+		.len	= 5553,
+		.sum	= 0x8e299c8b,
+	},
+	{
+		.desc	= "deferred reduction, long",
+		.data	= ff8,
+		.len	= 65536,
+		.sum	= 0x77970ef2,
+	},
 };
 
 /***************************************************************************
@@ -126,6 +156,52 @@ t_adler32(char **desc CRYB_UNUSED, void *arg)
 	return (t_compare_x32(t->sum, adler32_hash(t->data, t->len)));
 }
 
+/*
+ * Feed the same input to the streaming interface in chunks which do not
+ * line up with the reduction interval.
+ */
+static int
+t_adler32_stream(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_case *t = arg;
+	adler32_ctx ctx;
+	const uint8_t *p;
+	size_t len, n;
+
+	adler32_init(&ctx);
+	for (p = t->data, len = t->len; len > 0; p += n, len -= n) {
+		n = len < 1237 ? len : 1237;
+		adler32_update(&ctx, p, n);
+	}
+	return (t_compare_x32(t->sum, adler32_final(&ctx)));
+}
+
+/*
+ * Split the input at a few points, checksum the pieces separately and
+ * combine the results.
+ */
+static int
+t_adler32_combine(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_case *t = arg;
+	const uint8_t *p = t->data;
+	size_t splits[4], k;
+	unsigned int i;
+	int ret = 1;
+
+	splits[0] = 0;
+	splits[1] = t->len < 1 ? 0 : 1;
+	splits[2] = t->len / 2;
+	splits[3] = t->len;
+	for (i = 0; i < sizeof splits / sizeof splits[0]; ++i) {
+		k = splits[i];
+		ret &= t_compare_x32(t->sum, adler32_combine(
+		    adler32_hash(p, k), adler32_hash(p + k, t->len - k),
+		    t->len - k));
+	}
+	return (ret);
+}
+
 
 /***************************************************************************
  * Boilerplate
@@ -139,11 +215,20 @@ t_prepare(int argc, char *argv[])
 	(void)argc;
 	(void)argv;
 	memset(&ones8, 1, sizeof ones8);
+	memset(&ff8, 0xff, sizeof ff8);
 	n = sizeof t_cases / sizeof t_cases[0];
 	for (i = 0; i < n; ++i)
 		if (t_cases[i].sum != 0xffffffffLU)
 			t_add_test(t_adler32, &t_cases[i], "%s",
 			    t_cases[i].desc);
+	for (i = 0; i < n; ++i)
+		if (t_cases[i].sum != 0xffffffffLU)
+			t_add_test(t_adler32_stream, &t_cases[i],
+			    "%s (streaming)", t_cases[i].desc);
+	for (i = 0; i < n; ++i)
+		if (t_cases[i].sum != 0xffffffffLU)
+			t_add_test(t_adler32_combine, &t_cases[i],
+			    "%s (combine)", t_cases[i].desc);
 	return (0);
 }
 
@@ -0,0 +1,248 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <cryb/aes_cmac.h>
+
+#include <cryb/test.h>
+
+/*
+ * Test message from RFC 4493 and NIST SP 800-38B
+ */
+static const uint8_t t_aes_cmac_msg[64] =
+{
+	0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96,
+	0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+	0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c,
+	0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+	0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11,
+	0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+	0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17,
+	0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10,
+};
+
+/*
+ * Test vectors from RFC 4493 and NIST SP 800-38B
+ */
+static struct t_vector {
+	const char *desc;
+	const uint8_t key[32];
+	size_t keylen;
+	size_t msglen;
+	const uint8_t mac[AES_CMAC_MAC_LEN];
+} t_aes_cmac_vectors[] = {
+	{
+		"RFC 4493 example 1 (empty message)",
+		{
+			0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+			0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+		},
+		16,
+		0,
+		{
+			0xbb, 0x1d, 0x69, 0x29, 0xe9, 0x59, 0x37, 0x28,
+			0x7f, 0xa3, 0x7d, 0x12, 0x9b, 0x75, 0x67, 0x46,
+		},
+	},
+	{
+		"RFC 4493 example 2 (one block)",
+		{
+			0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+			0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+		},
+		16,
+		16,
+		{
+			0x07, 0x0a, 0x16, 0xb4, 0x6b, 0x4d, 0x41, 0x44,
+			0xf7, 0x9b, 0xdd, 0x9d, 0xd0, 0x4a, 0x28, 0x7c,
+		},
+	},
+	{
+		"RFC 4493 example 3 (partial block)",
+		{
+			0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+			0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+		},
+		16,
+		40,
+		{
+			0xdf, 0xa6, 0x67, 0x47, 0xde, 0x9a, 0xe6, 0x30,
+			0x30, 0xca, 0x32, 0x61, 0x14, 0x97, 0xc8, 0x27,
+		},
+	},
+	{
+		"RFC 4493 example 4 (four blocks)",
+		{
+			0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+			0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+		},
+		16,
+		64,
+		{
+			0x51, 0xf0, 0xbe, 0xbf, 0x7e, 0x3b, 0x9d, 0x92,
+			0xfc, 0x49, 0x74, 0x17, 0x79, 0x36, 0x3c, 0xfe,
+		},
+	},
+	{
+		"SP 800-38B AES-192 example 1",
+		{
+			0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52,
+			0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+			0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b,
+		},
+		24,
+		0,
+		{
+			0xd1, 0x7d, 0xdf, 0x46, 0xad, 0xaa, 0xcd, 0xe5,
+			0x31, 0xca, 0xc4, 0x83, 0xde, 0x7a, 0x93, 0x67,
+		},
+	},
+	{
+		"SP 800-38B AES-192 example 4",
+		{
+			0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52,
+			0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+			0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b,
+		},
+		24,
+		64,
+		{
+			0xa1, 0xd5, 0xdf, 0x0e, 0xed, 0x79, 0x0f, 0x79,
+			0x4d, 0x77, 0x58, 0x96, 0x59, 0xf3, 0x9a, 0x11,
+		},
+	},
+	{
+		"SP 800-38B AES-256 example 1",
+		{
+			0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe,
+			0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+			0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7,
+			0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4,
+		},
+		32,
+		0,
+		{
+			0x02, 0x89, 0x62, 0xf6, 0x1b, 0x7b, 0xf8, 0x9e,
+			0xfc, 0x6b, 0x55, 0x1f, 0x46, 0x67, 0xd9, 0x83,
+		},
+	},
+	{
+		"SP 800-38B AES-256 example 4",
+		{
+			0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe,
+			0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+			0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7,
+			0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4,
+		},
+		32,
+		64,
+		{
+			0xe1, 0x99, 0x21, 0x90, 0x54, 0x9f, 0x6e, 0xd5,
+			0x69, 0x6a, 0x2c, 0x05, 0x6c, 0x31, 0x54, 0x10,
+		},
+	},
+};
+
+/*
+ * Unit test: compute the MAC in one go.
+ */
+static int
+t_aes_cmac_vector(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_vector *vector = (struct t_vector *)arg;
+	uint8_t mac[AES_CMAC_MAC_LEN];
+
+	aes_cmac_complete(vector->key, vector->keylen,
+	    t_aes_cmac_msg, vector->msglen, mac);
+	return (t_compare_mem(vector->mac, mac, AES_CMAC_MAC_LEN));
+}
+
+/*
+ * Unit test: feed the message in pieces of every size from one byte to
+ * the entire message, reusing the key state.
+ */
+static int
+t_aes_cmac_pieces(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_vector *vector = (struct t_vector *)arg;
+	uint8_t mac[AES_CMAC_MAC_LEN];
+	aes_cmac_key hk;
+	aes_cmac_ctx ctx;
+	size_t i, n, step;
+	int ret = 1;
+
+	aes_cmac_setkey(&hk, vector->key, vector->keylen);
+	for (step = 1; step <= vector->msglen; ++step) {
+		aes_cmac_reset(&ctx, &hk);
+		for (i = 0; i < vector->msglen; i += n) {
+			n = vector->msglen - i < step ? vector->msglen - i : step;
+			aes_cmac_update(&ctx, t_aes_cmac_msg + i, n);
+		}
+		aes_cmac_final(&ctx, mac);
+		if (!t_compare_mem(vector->mac, mac, AES_CMAC_MAC_LEN)) {
+			t_printv("failed with step %zu\n", step);
+			ret = 0;
+		}
+	}
+	return (ret);
+}
+
+
+/***************************************************************************
+ * Boilerplate
+ */
+
+static int
+t_prepare(int argc, char *argv[])
+{
+	int i, n;
+
+	(void)argc;
+	(void)argv;
+	n = sizeof t_aes_cmac_vectors / sizeof t_aes_cmac_vectors[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_aes_cmac_vector, &t_aes_cmac_vectors[i],
+		    "%s", t_aes_cmac_vectors[i].desc);
+	for (i = 0; i < n; ++i)
+		t_add_test(t_aes_cmac_pieces, &t_aes_cmac_vectors[i],
+		    "%s (piecewise)", t_aes_cmac_vectors[i].desc);
+	return (0);
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	t_main(t_prepare, NULL, argc, argv);
+}
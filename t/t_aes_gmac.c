@@ -0,0 +1,235 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <cryb/aes_gmac.h>
+
+#include <cryb/test.h>
+
+/*
+ * Test vectors from the GCM specification, and computed with an
+ * independent implementation.
+ */
+static struct t_vector {
+	const char *desc;
+	const uint8_t key[32];
+	size_t keylen;
+	const uint8_t iv[60];
+	size_t ivlen;
+	const uint8_t msg[100];
+	size_t msglen;
+	const uint8_t mac[AES_GMAC_MAC_LEN];
+} t_aes_gmac_vectors[] = {
+	{
+		"GCM test case 1 (empty message)",
+		{
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		},
+		16,
+		{
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00,
+		},
+		12,
+		{ 0 },
+		0,
+		{
+			0x58, 0xe2, 0xfc, 0xce, 0xfa, 0x7e, 0x30, 0x61,
+			0x36, 0x7f, 0x1d, 0x57, 0xa4, 0xe7, 0x45, 0x5a,
+		},
+	},
+	{
+		"96-bit IV",
+		{
+			0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c,
+			0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08,
+		},
+		16,
+		{
+			0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad,
+			0xde, 0xca, 0xf8, 0x88,
+		},
+		12,
+		{
+			0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+			0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+			0xab, 0xad, 0xda, 0xd2,
+		},
+		20,
+		{
+			0x34, 0x64, 0x34, 0xfd, 0x51, 0xd5, 0xcd, 0x0c,
+			0x58, 0x87, 0xec, 0x63, 0xe3, 0x9b, 0x90, 0x7a,
+		},
+	},
+	{
+		"64-bit IV",
+		{
+			0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c,
+			0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08,
+		},
+		16,
+		{
+			0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad,
+		},
+		8,
+		{
+			0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+			0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+			0xab, 0xad, 0xda, 0xd2,
+		},
+		20,
+		{
+			0xef, 0x69, 0x95, 0xe5, 0x31, 0xe8, 0x1a, 0x01,
+			0xf5, 0xb2, 0xf7, 0x76, 0x2c, 0xc6, 0x0b, 0xd2,
+		},
+	},
+	{
+		"480-bit IV",
+		{
+			0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c,
+			0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08,
+		},
+		16,
+		{
+			0x93, 0x13, 0x22, 0x5d, 0xf8, 0x84, 0x06, 0xe5,
+			0x55, 0x90, 0x9c, 0x5a, 0xff, 0x52, 0x69, 0xaa,
+			0x6a, 0x7a, 0x95, 0x38, 0x53, 0x4f, 0x7d, 0xa1,
+			0xe4, 0xc3, 0x03, 0xd2, 0xa3, 0x18, 0xa7, 0x28,
+			0xc3, 0xc0, 0xc9, 0x51, 0x56, 0x80, 0x95, 0x39,
+			0xfc, 0xf0, 0xe2, 0x42, 0x9a, 0x6b, 0x52, 0x54,
+			0x16, 0xae, 0xdb, 0xf5, 0xa0, 0xde, 0x6a, 0x57,
+			0xa6, 0x37, 0xb3, 0x9b,
+		},
+		60,
+		{
+			0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+			0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+			0xab, 0xad, 0xda, 0xd2,
+		},
+		20,
+		{
+			0x7b, 0xe5, 0x17, 0x8f, 0xf2, 0xb7, 0x3c, 0x7d,
+			0x6f, 0x8b, 0x4d, 0xfd, 0xde, 0x84, 0x37, 0xec,
+		},
+	},
+	{
+		"AES-256, 100-byte message",
+		{
+			0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c,
+			0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08,
+			0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c,
+			0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08,
+		},
+		32,
+		{
+			0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad,
+			0xde, 0xca, 0xf8, 0x88,
+		},
+		12,
+		{
+			0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61,
+			0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61,
+			0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61,
+			0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61,
+			0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61,
+			0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61,
+			0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61,
+			0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61,
+			0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61,
+			0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61,
+			0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61,
+			0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61,
+			0x61, 0x61, 0x61, 0x61,
+		},
+		100,
+		{
+			0xcb, 0xc2, 0xf6, 0x4a, 0x15, 0xdb, 0xdf, 0x48,
+			0x48, 0xa0, 0xef, 0x06, 0x21, 0xe0, 0xff, 0x14,
+		},
+	},
+};
+
+/*
+ * Unit test: compute the MAC in one go and byte by byte, and check that
+ * the context is wiped afterwards.
+ */
+static int
+t_aes_gmac_vector(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_vector *vector = (struct t_vector *)arg;
+	uint8_t zero[sizeof(aes_gmac_ctx)] = { 0 };
+	uint8_t mac[AES_GMAC_MAC_LEN];
+	aes_gmac_ctx ctx;
+	size_t i;
+	int ret = 1;
+
+	aes_gmac_complete(vector->key, vector->keylen,
+	    vector->iv, vector->ivlen, vector->msg, vector->msglen, mac);
+	ret &= t_compare_mem(vector->mac, mac, AES_GMAC_MAC_LEN);
+	aes_gmac_init(&ctx, vector->key, vector->keylen,
+	    vector->iv, vector->ivlen);
+	for (i = 0; i < vector->msglen; ++i)
+		aes_gmac_update(&ctx, vector->msg + i, 1);
+	aes_gmac_final(&ctx, mac);
+	ret &= t_compare_mem(vector->mac, mac, AES_GMAC_MAC_LEN);
+	ret &= t_compare_mem(zero, &ctx, sizeof ctx);
+	return (ret);
+}
+
+
+/***************************************************************************
+ * Boilerplate
+ */
+
+static int
+t_prepare(int argc, char *argv[])
+{
+	int i, n;
+
+	(void)argc;
+	(void)argv;
+	n = sizeof t_aes_gmac_vectors / sizeof t_aes_gmac_vectors[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_aes_gmac_vector, &t_aes_gmac_vectors[i],
+		    "%s", t_aes_gmac_vectors[i].desc);
+	return (0);
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	t_main(t_prepare, NULL, argc, argv);
+}
@@ -0,0 +1,181 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <cryb/hash.h>
+
+#include <cryb/test.h>
+
+#define T_BUF_LEN	10240
+
+/* T_BUF_LEN bytes of 00 01 02 ... ff 00 01 ..., plus room to misalign */
+static uint8_t t_buf[T_BUF_LEN + 8];
+
+static const uint8_t t_ones[32] = {
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+
+static const uint8_t t_desc[32] = {
+	0x1f, 0x1e, 0x1d, 0x1c, 0x1b, 0x1a, 0x19, 0x18,
+	0x17, 0x16, 0x15, 0x14, 0x13, 0x12, 0x11, 0x10,
+	0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08,
+	0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00,
+};
+
+struct t_case {
+	const char *desc;
+	const uint8_t *data;
+	size_t len;
+	uint32_t crc32;
+	uint32_t crc32c;
+};
+
+/***************************************************************************
+ * Test cases
+ *
+ * The CRC-32C vectors for 32-byte inputs are from RFC 3720, B.4.  The
+ * others were generated with zlib and a bitwise CRC-32C implementation.
+ */
+static struct t_case t_cases[] = {
+	{ "empty",		t_buf,		0,	0x00000000, 0x00000000 },
+	{ "check",		(const uint8_t *)"123456789",
+						9,	0xcbf43926, 0xe3069283 },
+	{ "32 zeroes",		t_zero,		32,	0x190a55ad, 0x8a9136aa },
+	{ "32 ones",		t_ones,		32,	0xff6cab0b, 0x62a8ab43 },
+	{ "32 ascending",	t_buf,		32,	0x91267e8a, 0x46dd794e },
+	{ "32 descending",	t_desc,		32,	0x9ab0ef72, 0x113fdb5c },
+	{ "1 byte",		t_buf,		1,	0xd202ef8d, 0x527d5351 },
+	{ "7 bytes",		t_buf,		7,	0xad5809f9, 0xa359ed4c },
+	{ "8 bytes",		t_buf,		8,	0x88aa689f, 0x8a2cbc3b },
+	{ "9 bytes",		t_buf,		9,	0xbce14302, 0x7144c5a8 },
+	{ "63 bytes",		t_buf,		63,	0xdbdea683, 0x7a873004 },
+	{ "256 bytes",		t_buf,		256,	0x29058c73, 0x9c44184b },
+	{ "1000 bytes",		t_buf,		1000,	0x74e3fb41, 0x1a318e30 },
+	{ "10240 bytes",	t_buf,		10240,	0xbbce3b9d, 0xbd846cd7 },
+};
+
+/***************************************************************************
+ * Test functions
+ */
+
+static int
+t_crc32(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_case *t = arg;
+
+	return (t_compare_x32(t->crc32, crc32_hash(t->data, t->len)));
+}
+
+static int
+t_crc32c(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_case *t = arg;
+
+	return (t_compare_x32(t->crc32c, crc32c_hash(t->data, t->len)));
+}
+
+/*
+ * Compute the CRC of a misaligned copy of the input in two pieces, once
+ * with the streaming interface and once by combining the CRCs of the
+ * pieces.
+ */
+static int
+t_crc32_split(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_case *t = arg;
+	uint8_t buf[T_BUF_LEN + 8];
+	crc32_ctx ctx;
+	size_t k, len2;
+	unsigned int off;
+	int ret = 1;
+
+	for (off = 0; off < 8; off += 3) {
+		memcpy(buf + off, t->data, t->len);
+		for (k = 0; k <= t->len; k += t->len < 16 ? 1 : t->len / 7) {
+			len2 = t->len - k;
+			crc32_init(&ctx);
+			crc32_update(&ctx, buf + off, k);
+			crc32_update(&ctx, buf + off + k, len2);
+			ret &= t_compare_x32(t->crc32, crc32_final(&ctx));
+			ret &= t_compare_x32(t->crc32, crc32_combine(
+			    crc32_hash(buf + off, k),
+			    crc32_hash(buf + off + k, len2), len2));
+			crc32c_init(&ctx);
+			crc32c_update(&ctx, buf + off, k);
+			crc32c_update(&ctx, buf + off + k, len2);
+			ret &= t_compare_x32(t->crc32c, crc32c_final(&ctx));
+			ret &= t_compare_x32(t->crc32c, crc32c_combine(
+			    crc32c_hash(buf + off, k),
+			    crc32c_hash(buf + off + k, len2), len2));
+		}
+	}
+	return (ret);
+}
+
+
+/***************************************************************************
+ * Boilerplate
+ */
+
+static int
+t_prepare(int argc, char *argv[])
+{
+	unsigned int i, n;
+
+	(void)argc;
+	(void)argv;
+	for (i = 0; i < sizeof t_buf; ++i)
+		t_buf[i] = i & 0xff;
+	n = sizeof t_cases / sizeof t_cases[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_crc32, &t_cases[i], "CRC-32 %s",
+		    t_cases[i].desc);
+	for (i = 0; i < n; ++i)
+		t_add_test(t_crc32c, &t_cases[i], "CRC-32C %s",
+		    t_cases[i].desc);
+	for (i = 0; i < n; ++i)
+		t_add_test(t_crc32_split, &t_cases[i], "split %s",
+		    t_cases[i].desc);
+	return (0);
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	t_main(t_prepare, NULL, argc, argv);
+}
@@ -29,11 +29,20 @@
 
 #include "cryb/impl.h"
 
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <errno.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
 #include <cryb/digest.h>
+#include <cryb/md5.h>
+#include <cryb/sha256.h>
 
 #include <cryb/test.h>
 
@@ -44,19 +53,200 @@ t_digest_version(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
 	return (t_compare_str(PACKAGE_VERSION, cryb_digest_version()));
 }
 
+static const char *t_digest_names[] = {
+	"md2", "md4", "md5", "sha1", "sha224", "sha256", "sha384", "sha512",
+};
+
+/*
+ * Verify that every algorithm is registered and fits within the limits
+ * advertised in <cryb/digest.h>.
+ */
+static int
+t_digest_limits(char **desc CRYB_UNUSED, void *arg)
+{
+	const char *name = *(const char **)arg;
+	const digest_algorithm *alg;
+	int ret = 1;
+
+	if ((alg = get_digest_algorithm(name)) == NULL) {
+		t_printv("%s not found\n", name);
+		return (0);
+	}
+	ret &= t_compare_str(name, alg->name);
+	if (alg->contextlen > DIGEST_MAX_CONTEXT_LEN ||
+	    alg->blocklen > DIGEST_MAX_BLOCK_LEN ||
+	    alg->digestlen > DIGEST_MAX_DIGEST_LEN) {
+		t_printv("%s exceeds limits\n", name);
+		ret = 0;
+	}
+	return (ret);
+}
+
+/*
+ * Test data for the file tests, large enough to span several windows.
+ */
+#define T_FILE_LEN	(2 * 8 * 1024 * 1024 + 12345)
+static uint8_t *t_file_data;
+
+struct t_file_case {
+	const char *desc;
+	const digest_algorithm *alg;
+	size_t len;
+	off_t off;
+};
+
+static struct t_file_case t_file_cases[] = {
+	{ "empty file",			&sha256_digest,	0,		0 },
+	{ "short file",			&sha256_digest,	1000,		0 },
+	{ "short file, offset",		&sha256_digest,	1000,		123 },
+	{ "offset at end of file",	&sha256_digest,	1000,		1000 },
+	{ "long file",			&md5_digest,	T_FILE_LEN,	0 },
+	{ "long file, offset",		&md5_digest,	T_FILE_LEN,	4097 },
+};
+
+/*
+ * Write test data to a temporary file and compare the digest of the
+ * file to the digest of the data.
+ */
+static int
+t_digest_file(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_file_case *tc = arg;
+	uint8_t md[DIGEST_MAX_DIGEST_LEN], emd[DIGEST_MAX_DIGEST_LEN];
+	struct t_file *tf;
+	int fd, ret = 1;
+
+	tf = t_fopen(NULL);
+	if (fwrite(t_file_data, 1, tc->len, tf->file) != tc->len ||
+	    fflush(tf->file) != 0) {
+		t_fclose(tf);
+		return (0);
+	}
+	fd = fileno(tf->file);
+	digest_complete(tc->alg, t_file_data + tc->off, tc->len - tc->off,
+	    emd);
+	if (tc->off == 0) {
+		ret &= t_is_zero_i(digest_file(tc->alg, tf->name, md));
+		ret &= t_compare_mem(emd, md, tc->alg->digestlen);
+	}
+	ret &= t_compare_ssz(tc->off, lseek(fd, tc->off, SEEK_SET));
+	ret &= t_is_zero_i(digest_fd(tc->alg, fd, md));
+	ret &= t_compare_mem(emd, md, tc->alg->digestlen);
+	ret &= t_compare_ssz(tc->len, lseek(fd, 0, SEEK_CUR));
+	t_fclose(tf);
+	return (ret);
+}
+
+/*
+ * Compare the digest of data read from a pipe to the digest of the data.
+ */
+static int
+t_digest_pipe(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	uint8_t md[SHA256_DIGEST_LEN], emd[SHA256_DIGEST_LEN];
+	int pd[2], ret = 1;
+
+	if (pipe(pd) != 0)
+		return (0);
+	ret &= t_compare_ssz(1000, write(pd[1], t_file_data, 1000));
+	close(pd[1]);
+	sha256_complete(t_file_data, 1000, emd);
+	ret &= t_is_zero_i(digest_fd(&sha256_digest, pd[0], md));
+	ret &= t_compare_mem(emd, md, sizeof md);
+	close(pd[0]);
+	return (ret);
+}
+
+/*
+ * Verify that errors are reported.
+ */
+static int
+t_digest_file_errors(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	uint8_t md[SHA256_DIGEST_LEN];
+	int ret = 1;
+
+	ret &= t_compare_i(-1, digest_file(&sha256_digest,
+	    "/nonexistent/file", md));
+	ret &= t_compare_i(ENOENT, errno);
+	ret &= t_compare_i(-1, digest_fd(&sha256_digest, -1, md));
+	ret &= t_compare_i(EBADF, errno);
+	return (ret);
+}
+
+/*
+ * Hash a buffer split into fragments of awkward sizes and compare with
+ * the digest of the whole buffer.  This uses the file test data.
+ */
+static const size_t t_updatev_frags[] = {
+	0, 1, 63, 64, 65, 0, 127, 128, 129, 3, 1000, 5,
+};
+#define T_UPDATEV_NFRAGS \
+	(sizeof t_updatev_frags / sizeof t_updatev_frags[0])
+
+static int
+t_digest_updatev(char **desc CRYB_UNUSED, void *arg)
+{
+	const char *name = *(const char **)arg;
+	const digest_algorithm *alg;
+	uint64_t ctx[DIGEST_MAX_CONTEXT_LEN / sizeof(uint64_t)];
+	uint8_t md[DIGEST_MAX_DIGEST_LEN], emd[DIGEST_MAX_DIGEST_LEN];
+	struct iovec iov[T_UPDATEV_NFRAGS];
+	size_t len;
+	unsigned int i;
+
+	if ((alg = get_digest_algorithm(name)) == NULL)
+		return (0);
+	for (i = 0, len = 0; i < T_UPDATEV_NFRAGS; ++i) {
+		iov[i].iov_base = t_file_data + len;
+		iov[i].iov_len = t_updatev_frags[i];
+		len += t_updatev_frags[i];
+	}
+	digest_complete(alg, t_file_data, len, emd);
+	digest_init(alg, ctx);
+	digest_updatev(alg, ctx, iov, T_UPDATEV_NFRAGS);
+	digest_final(alg, ctx, md);
+	return (t_compare_mem(emd, md, alg->digestlen));
+}
+
 static int
 t_prepare(int argc, char *argv[])
 {
+	unsigned int i, n;
 
 	(void)argc;
 	(void)argv;
 	t_add_test(t_digest_version, NULL, "version");
+	n = sizeof t_digest_names / sizeof t_digest_names[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_digest_limits, &t_digest_names[i],
+		    "%s limits", t_digest_names[i]);
+	for (i = 0; i < n; ++i)
+		t_add_test(t_digest_updatev, &t_digest_names[i],
+		    "%s updatev", t_digest_names[i]);
+	if ((t_file_data = malloc(T_FILE_LEN)) == NULL)
+		return (-1);
+	for (i = 0; i < T_FILE_LEN; ++i)
+		t_file_data[i] = t_seq8[i % sizeof t_seq8] ^ (i >> 8);
+	n = sizeof t_file_cases / sizeof t_file_cases[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_digest_file, &t_file_cases[i],
+		    "%s", t_file_cases[i].desc);
+	t_add_test(t_digest_pipe, NULL, "pipe");
+	t_add_test(t_digest_file_errors, NULL, "errors");
 	return (0);
 }
 
+static void
+t_cleanup(void)
+{
+
+	free(t_file_data);
+}
+
 int
 main(int argc, char *argv[])
 {
 
-	t_main(t_prepare, NULL, argc, argv);
+	t_main(t_prepare, t_cleanup, argc, argv);
 }
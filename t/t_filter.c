@@ -0,0 +1,344 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cryb/hash.h>
+#include <cryb/filter.h>
+
+#include <cryb/test.h>
+
+/*
+ * Keys 0 through T_NKEYS - 1 are added to the filters, the rest are
+ * used to measure the false positive rate.
+ */
+#define T_NKEYS		10000
+#define T_NPROBES	20000
+
+static uint32_t t_keys[T_NKEYS + T_NPROBES];
+static hash_key t_hkeys[T_NKEYS + T_NPROBES];
+
+/*
+ * Check that every key in [lo, hi) is reported as present and that the
+ * false positive rate over the probe keys does not exceed maxfp per
+ * thousand, using both the single and the batch interface.
+ */
+typedef int (*t_query_func)(const void *, const void *, size_t);
+typedef size_t (*t_query_many_func)(const void *, const hash_key *, size_t,
+    int *);
+
+static int
+t_filter_check(const void *f, t_query_func query, t_query_many_func many,
+    size_t lo, size_t hi, unsigned int maxfp)
+{
+	static int results[T_NKEYS + T_NPROBES];
+	size_t i, n, fp;
+	int ret = 1;
+
+	n = T_NKEYS + T_NPROBES;
+	for (i = lo; i < hi; ++i)
+		if (!query(f, &t_keys[i], sizeof t_keys[i]))
+			break;
+	ret &= t_compare_sz(hi, i);
+	for (i = T_NKEYS, fp = 0; i < n; ++i)
+		fp += query(f, &t_keys[i], sizeof t_keys[i]);
+	if (fp * 1000 > (size_t)maxfp * T_NPROBES) {
+		t_printv("%zu false positives\n", fp);
+		ret = 0;
+	}
+	/* the batch interface must agree on every key, including odd counts */
+	ret &= t_compare_sz(hi - lo + fp, many(f, t_hkeys + lo, n - lo, results));
+	for (i = lo; i < n; ++i)
+		if (results[i - lo] != query(f, &t_keys[i], sizeof t_keys[i]))
+			break;
+	ret &= t_compare_sz(n, i);
+	ret &= t_compare_sz(0, many(f, t_hkeys, 0, NULL));
+	return (ret);
+}
+
+/*
+ * Bloom filters
+ */
+static int
+t_bloom_query_wrap(const void *f, const void *key, size_t len)
+{
+
+	return (bloom_query(f, key, len));
+}
+
+static size_t
+t_bloom_query_many_wrap(const void *f, const hash_key *keys, size_t n,
+    int *results)
+{
+
+	return (bloom_query_many(f, keys, n, results));
+}
+
+static int
+t_bloom(char **desc CRYB_UNUSED, void *arg)
+{
+	unsigned int flags = *(unsigned int *)arg;
+	bloom *bf, *lbf;
+	const void *image;
+	uint8_t *copy;
+	size_t i, len;
+	int ret = 1;
+
+	/* 10 bits per key and 7 hash functions: under 1% false positives */
+	if (!t_is_not_null(bf = bloom_new(T_NKEYS * 10, 7, 42, flags)))
+		return (0);
+	for (i = 0; i < T_NKEYS; ++i)
+		bloom_add(bf, &t_keys[i], sizeof t_keys[i]);
+	ret &= t_filter_check(bf, t_bloom_query_wrap, t_bloom_query_many_wrap,
+	    0, T_NKEYS, 15);
+	/* save and reload */
+	image = bloom_image(bf, &len);
+	if (!t_is_not_null(copy = malloc(len))) {
+		bloom_delete(bf);
+		return (0);
+	}
+	memcpy(copy, image, len);
+	bloom_delete(bf);
+	if (t_is_not_null(lbf = bloom_load(copy, len))) {
+		ret &= t_filter_check(lbf, t_bloom_query_wrap,
+		    t_bloom_query_many_wrap, 0, T_NKEYS, 15);
+		bloom_delete(lbf);
+	} else {
+		ret = 0;
+	}
+	/* truncated and corrupted images */
+	ret &= t_is_null(bloom_load(copy, len - 1));
+	ret &= t_compare_i(EINVAL, errno);
+	ret &= t_is_null(bloom_load(copy, 10));
+	ret &= t_compare_i(EINVAL, errno);
+	copy[0] ^= 1;
+	ret &= t_is_null(bloom_load(copy, len));
+	ret &= t_compare_i(EINVAL, errno);
+	free(copy);
+	return (ret);
+}
+
+static unsigned int t_bloom_classic = 0;
+static unsigned int t_bloom_blocked = BLOOM_BLOCKED;
+
+static int
+t_bloom_errors(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	int ret = 1;
+
+	ret &= t_is_null(bloom_new(0, 1, 0, 0));
+	ret &= t_compare_i(EINVAL, errno);
+	ret &= t_is_null(bloom_new(1000, 0, 0, 0));
+	ret &= t_compare_i(EINVAL, errno);
+	ret &= t_is_null(bloom_new(1000, BLOOM_MAX_HASHES + 1, 0, 0));
+	ret &= t_compare_i(EINVAL, errno);
+	ret &= t_is_null(bloom_new(1000, 1, 0, ~0U));
+	ret &= t_compare_i(EINVAL, errno);
+	t_malloc_fail = 1;
+	ret &= t_is_null(bloom_new(1000, 1, 0, 0));
+	ret &= t_compare_i(ENOMEM, errno);
+	t_malloc_fail = 0;
+	t_malloc_fail_after = 1;
+	ret &= t_is_null(bloom_new(1000, 1, 0, 0));
+	ret &= t_compare_i(ENOMEM, errno);
+	t_malloc_fail = t_malloc_fail_after = 0;
+	return (ret);
+}
+
+/*
+ * Cuckoo filters
+ */
+static int
+t_cuckoo_query_wrap(const void *f, const void *key, size_t len)
+{
+
+	return (cuckoo_query(f, key, len));
+}
+
+static size_t
+t_cuckoo_query_many_wrap(const void *f, const hash_key *keys, size_t n,
+    int *results)
+{
+
+	return (cuckoo_query_many(f, keys, n, results));
+}
+
+static int
+t_cuckoo(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	cuckoo *cf, *lcf;
+	const void *image;
+	uint8_t *copy;
+	size_t i, len;
+	int ret = 1;
+
+	if (!t_is_not_null(cf = cuckoo_new(T_NKEYS, 42)))
+		return (0);
+	for (i = 0; i < T_NKEYS; ++i)
+		if (cuckoo_add(cf, &t_keys[i], sizeof t_keys[i]) != 0)
+			break;
+	ret &= t_compare_sz(T_NKEYS, i);
+	ret &= t_compare_sz(T_NKEYS, cuckoo_count(cf));
+	/* 16-bit fingerprints and 8 candidates: about 0.1% */
+	ret &= t_filter_check(cf, t_cuckoo_query_wrap,
+	    t_cuckoo_query_many_wrap, 0, T_NKEYS, 3);
+	/* remove the first half */
+	for (i = 0; i < T_NKEYS / 2; ++i)
+		if (cuckoo_remove(cf, &t_keys[i], sizeof t_keys[i]) != 0)
+			break;
+	ret &= t_compare_sz(T_NKEYS / 2, i);
+	ret &= t_compare_sz(T_NKEYS - T_NKEYS / 2, cuckoo_count(cf));
+	ret &= t_filter_check(cf, t_cuckoo_query_wrap,
+	    t_cuckoo_query_many_wrap, T_NKEYS / 2, T_NKEYS, 3);
+	/* find a key which is not present and try to remove it */
+	for (i = T_NKEYS; cuckoo_query(cf, &t_keys[i], sizeof t_keys[i]); ++i)
+		/* nothing */ ;
+	ret &= t_compare_i(-1, cuckoo_remove(cf, &t_keys[i],
+	    sizeof t_keys[i]));
+	ret &= t_compare_i(ENOENT, errno);
+	/* save and reload */
+	image = cuckoo_image(cf, &len);
+	if (!t_is_not_null(copy = malloc(len))) {
+		cuckoo_delete(cf);
+		return (0);
+	}
+	memcpy(copy, image, len);
+	cuckoo_delete(cf);
+	if (t_is_not_null(lcf = cuckoo_load(copy, len))) {
+		ret &= t_compare_sz(T_NKEYS - T_NKEYS / 2, cuckoo_count(lcf));
+		ret &= t_filter_check(lcf, t_cuckoo_query_wrap,
+		    t_cuckoo_query_many_wrap, T_NKEYS / 2, T_NKEYS, 3);
+		/* a loaded filter is writable if its image is */
+		ret &= t_compare_i(0, cuckoo_remove(lcf, &t_keys[T_NKEYS - 1],
+		    sizeof t_keys[T_NKEYS - 1]));
+		cuckoo_delete(lcf);
+	} else {
+		ret = 0;
+	}
+	ret &= t_is_null(cuckoo_load(copy, len - 1));
+	ret &= t_compare_i(EINVAL, errno);
+	copy[8] ^= 1;
+	ret &= t_is_null(cuckoo_load(copy, len));
+	ret &= t_compare_i(EINVAL, errno);
+	free(copy);
+	return (ret);
+}
+
+/*
+ * Fill a small filter to capacity and verify that it refuses further
+ * keys without losing any it has accepted, then make room and verify
+ * that it accepts keys again.
+ */
+static int
+t_cuckoo_full(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	cuckoo *cf;
+	size_t i, j, n;
+	int ret = 1;
+
+	if (!t_is_not_null(cf = cuckoo_new(16, 42)))
+		return (0);
+	for (n = 0; n < T_NKEYS; ++n)
+		if (cuckoo_add(cf, &t_keys[n], sizeof t_keys[n]) != 0)
+			break;
+	ret &= t_compare_i(ENOSPC, errno);
+	/* 32 slots; the last key added may be the victim */
+	if (n < 16 || n > 33) {
+		t_printv("filter full after %zu keys\n", n);
+		ret = 0;
+	}
+	ret &= t_compare_sz(n, cuckoo_count(cf));
+	for (i = 0; i < n; ++i)
+		ret &= t_compare_i(1, cuckoo_query(cf, &t_keys[i],
+		    sizeof t_keys[i]));
+	for (i = 0; i < n; i += 2)
+		ret &= t_compare_i(0, cuckoo_remove(cf, &t_keys[i],
+		    sizeof t_keys[i]));
+	for (i = 1; i < n; i += 2)
+		ret &= t_compare_i(1, cuckoo_query(cf, &t_keys[i],
+		    sizeof t_keys[i]));
+	for (j = n; j < n + 4; ++j)
+		ret &= t_compare_i(0, cuckoo_add(cf, &t_keys[j],
+		    sizeof t_keys[j]));
+	ret &= t_compare_sz(n / 2 + 4, cuckoo_count(cf));
+	cuckoo_delete(cf);
+	return (ret);
+}
+
+static int
+t_cuckoo_errors(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	int ret = 1;
+
+	ret &= t_is_null(cuckoo_new(0, 0));
+	ret &= t_compare_i(EINVAL, errno);
+	t_malloc_fail = 1;
+	ret &= t_is_null(cuckoo_new(1000, 0));
+	ret &= t_compare_i(ENOMEM, errno);
+	t_malloc_fail = 0;
+	t_malloc_fail_after = 1;
+	ret &= t_is_null(cuckoo_new(1000, 0));
+	ret &= t_compare_i(ENOMEM, errno);
+	t_malloc_fail = t_malloc_fail_after = 0;
+	return (ret);
+}
+
+static int
+t_prepare(int argc, char *argv[])
+{
+	unsigned int i;
+
+	(void)argc;
+	(void)argv;
+	for (i = 0; i < T_NKEYS + T_NPROBES; ++i) {
+		t_keys[i] = i * 2654435761U;
+		t_hkeys[i].data = &t_keys[i];
+		t_hkeys[i].len = sizeof t_keys[i];
+	}
+	t_add_test(t_bloom, &t_bloom_classic, "bloom");
+	t_add_test(t_bloom, &t_bloom_blocked, "blocked bloom");
+	t_add_test(t_bloom_errors, NULL, "bloom errors");
+	t_add_test(t_cuckoo, NULL, "cuckoo");
+	t_add_test(t_cuckoo_full, NULL, "cuckoo full");
+	t_add_test(t_cuckoo_errors, NULL, "cuckoo errors");
+	return (0);
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	t_main(t_prepare, NULL, argc, argv);
+}
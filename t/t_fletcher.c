@@ -44,6 +44,7 @@
 static uint8_t ones8[65536];
 static uint16_t ones16[65536];
 static uint32_t ones32[65536];
+static const uint8_t odd3[] = { 0x80, 0x00, 0x90 };
 
 struct t_case {
 	const char *desc;
@@ -234,6 +235,16 @@ static struct t_case t_cases[] = {
 		.sum64	= FLETCHER64_INVALID,
 	},
 
+	/* overflow in the zero-padded final word */
+	{
+		.desc	= "padded word overflow",
+		.data	= odd3,
+		.len	= sizeof odd3,
+		.sum16	= 0x1211,
+		.sum32	= 0x90011001,
+		.sum64	= 0x8000900080009000,
+	},
+
 	/* overflow (64-bit checksum */
 	/*
 	 * This is currently not realistic.  We need to change the
@@ -273,6 +284,53 @@ t_fletcher64(char **desc, void *arg)
 	return (t_compare_x64(t->sum64, fletcher64_hash(t->data, t->len)));
 }
 
+/*
+ * Split the input at a few points, rounded down to a multiple of each
+ * algorithm's word size, checksum the pieces separately and combine the
+ * results.  The split points are chosen so that the second piece is of
+ * odd length whenever the input is.
+ */
+static int
+t_fletcher_combine(char **desc, void *arg)
+{
+	struct t_case *t = arg;
+	const uint8_t *p = t->data;
+	size_t splits[6], k, len2;
+	unsigned int i;
+	int ret = 1;
+
+	(void)asprintf(desc, "(combine) %s", t->desc);
+	splits[0] = 0;
+	splits[1] = 1;
+	splits[2] = 2;
+	splits[3] = 4;
+	splits[4] = t->len / 2;
+	splits[5] = t->len;
+	for (i = 0; i < sizeof splits / sizeof splits[0]; ++i) {
+		if (splits[i] > t->len)
+			continue;
+		k = splits[i];
+		len2 = t->len - k;
+		if (t->sum16 != 0xffffU)
+			ret &= t_compare_x16(t->sum16, fletcher16_combine(
+			    fletcher16_hash(p, k),
+			    fletcher16_hash(p + k, len2), len2));
+		k = splits[i] & ~(size_t)1;
+		len2 = t->len - k;
+		if (t->sum32 != 0xffffffffLU)
+			ret &= t_compare_x32(t->sum32, fletcher32_combine(
+			    fletcher32_hash(p, k),
+			    fletcher32_hash(p + k, len2), len2));
+		k = splits[i] & ~(size_t)3;
+		len2 = t->len - k;
+		if (t->sum64 != 0xffffffffffffffffLLU)
+			ret &= t_compare_x64(t->sum64, fletcher64_combine(
+			    fletcher64_hash(p, k),
+			    fletcher64_hash(p + k, len2), len2));
+	}
+	return (ret);
+}
+
 
 /***************************************************************************
  * Boilerplate
@@ -306,6 +364,9 @@ t_prepare(int argc, char *argv[])
 		if (t_cases[i].sum64 != 0xffffffffffffffffLLU)
 			t_add_test(t_fletcher64, &t_cases[i], "%s",
 			    t_cases[i].desc);
+	for (i = 0; i < n; ++i)
+		t_add_test(t_fletcher_combine, &t_cases[i], "%s",
+		    t_cases[i].desc);
 	return (0);
 }
 
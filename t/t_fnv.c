@@ -117,6 +117,37 @@ T_FNV(1, 64)
 T_FNV(1a, 32)
 T_FNV(1a, 64)
 
+/*
+ * Hash batches of keys of assorted lengths, including empty ones, and
+ * compare with hashing them one at a time.  Every batch size up to the
+ * total is tried so that all ways of draining the lanes are covered.
+ */
+#define T_MANY_NKEYS	37
+
+static hash_key t_many_keys[T_MANY_NKEYS];
+
+#define T_FNV1A_MANY(B)							\
+	static int							\
+	t_fnv1a_##B##_many(char **desc CRYB_UNUSED,			\
+	    void *arg CRYB_UNUSED)					\
+	{								\
+		uint##B##_t h[T_MANY_NKEYS];				\
+		size_t i, n;						\
+		int ret = 1;						\
+									\
+		for (n = 0; n <= T_MANY_NKEYS; ++n) {			\
+			fnv1a_##B##_hash_many(t_many_keys, n, h);	\
+			for (i = 0; i < n; ++i)				\
+				ret &= t_compare_x##B(fnv1a_##B##_hash(	\
+				    t_many_keys[i].data,		\
+				    t_many_keys[i].len), h[i]);		\
+		}							\
+		return (ret);						\
+	}
+
+T_FNV1A_MANY(32)
+T_FNV1A_MANY(64)
+
 
 /***************************************************************************
  * Boilerplate
@@ -140,6 +171,12 @@ t_prepare(int argc, char *argv[])
 		t_add_test(t_fnv1a_32, &t_cases[i], "FNV-1a-32");
 		t_add_test(t_fnv1a_64, &t_cases[i], "FNV-1a-64");
 	}
+	for (i = 0; i < T_MANY_NKEYS; ++i) {
+		t_many_keys[i].data = t_seq8 + i;
+		t_many_keys[i].len = (i * 29) % 71;
+	}
+	t_add_test(t_fnv1a_32_many, NULL, "FNV-1a-32 batch");
+	t_add_test(t_fnv1a_64_many, NULL, "FNV-1a-64 batch");
 	return (0);
 }
 
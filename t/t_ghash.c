@@ -0,0 +1,132 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <cryb/ghash.h>
+
+#include <cryb/test.h>
+
+/*
+ * GCM specification test case 2: H = E(0^128, 0^128), one block of
+ * ciphertext, no additional data.
+ */
+static const uint8_t t_ghash_h[GHASH_BLOCK_LEN] =
+{
+	0x66, 0xe9, 0x4b, 0xd4, 0xef, 0x8a, 0x2c, 0x3b,
+	0x88, 0x4c, 0xfa, 0x59, 0xca, 0x34, 0x2b, 0x2e,
+};
+
+static const uint8_t t_ghash_msg[2 * GHASH_BLOCK_LEN] =
+{
+	0x03, 0x88, 0xda, 0xce, 0x60, 0xb6, 0xa3, 0x92,
+	0xf3, 0x28, 0xc2, 0xb9, 0x71, 0xb2, 0xfe, 0x78,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80,
+};
+
+static const uint8_t t_ghash_out[GHASH_BLOCK_LEN] =
+{
+	0xf3, 0x8c, 0xbb, 0x1a, 0xd6, 0x92, 0x23, 0xdc,
+	0xc3, 0x45, 0x7a, 0xe5, 0xb6, 0xb0, 0xf8, 0x85,
+};
+
+static int
+t_ghash_vector(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	uint8_t out[GHASH_BLOCK_LEN];
+	ghash_ctx ctx;
+
+	ghash_init(&ctx, t_ghash_h);
+	ghash_update(&ctx, t_ghash_msg, sizeof t_ghash_msg);
+	ghash_final(&ctx, out);
+	return (t_compare_mem(t_ghash_out, out, sizeof out));
+}
+
+/*
+ * Partial blocks are accumulated across calls, and padded only when
+ * explicitly requested.
+ */
+static int
+t_ghash_pieces(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	uint8_t out[GHASH_BLOCK_LEN], eout[GHASH_BLOCK_LEN];
+	uint8_t padded[2 * GHASH_BLOCK_LEN];
+	ghash_ctx ctx;
+	int ret = 1;
+
+	ghash_init(&ctx, t_ghash_h);
+	ghash_update(&ctx, t_ghash_msg, 3);
+	ghash_update(&ctx, t_ghash_msg + 3, 20);
+	ghash_update(&ctx, t_ghash_msg + 23, 9);
+	ghash_final(&ctx, out);
+	ret &= t_compare_mem(t_ghash_out, out, sizeof out);
+
+	memset(padded, 0, sizeof padded);
+	memcpy(padded, t_ghash_msg, 5);
+	memcpy(padded + GHASH_BLOCK_LEN, t_ghash_msg, 7);
+	ghash_init(&ctx, t_ghash_h);
+	ghash_update(&ctx, padded, sizeof padded);
+	ghash_final(&ctx, eout);
+	ghash_init(&ctx, t_ghash_h);
+	ghash_update(&ctx, t_ghash_msg, 5);
+	ghash_pad(&ctx);
+	ghash_pad(&ctx);
+	ghash_update(&ctx, t_ghash_msg, 7);
+	ghash_final(&ctx, out);
+	ret &= t_compare_mem(eout, out, sizeof out);
+	return (ret);
+}
+
+
+/***************************************************************************
+ * Boilerplate
+ */
+
+static int
+t_prepare(int argc, char *argv[])
+{
+
+	(void)argc;
+	(void)argv;
+	t_add_test(t_ghash_vector, NULL, "GCM test case 2");
+	t_add_test(t_ghash_pieces, NULL, "partial blocks");
+	return (0);
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	t_main(t_prepare, NULL, argc, argv);
+}
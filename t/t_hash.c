@@ -44,13 +44,171 @@ t_hash_version(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
 	return (t_compare_str(PACKAGE_VERSION, cryb_hash_version()));
 }
 
+static const char *t_hash_names[] = {
+	"adler32",
+	"buzhash",
+	"crc32", "crc32c",
+	"fletcher16", "fletcher32", "fletcher64",
+	"fnv0-32", "fnv0-64", "fnv1-32", "fnv1-64", "fnv1a-32", "fnv1a-64",
+	"halfsiphash24", "halfsiphash24-64",
+	"murmur3-32",
+	"pearson",
+	"siphash13", "siphash24",
+	"xxh3-64", "xxh64",
+};
+
+/*
+ * Verify that every algorithm is registered and fits within the limits
+ * advertised in <cryb/hash.h>.
+ */
+static int
+t_hash_limits(char **desc CRYB_UNUSED, void *arg)
+{
+	const char *name = *(const char **)arg;
+	const hash_algorithm *alg;
+	int ret = 1;
+
+	if ((alg = get_hash_algorithm(name)) == NULL) {
+		t_printv("%s not found\n", name);
+		return (0);
+	}
+	ret &= t_compare_str(name, alg->name);
+	if (alg->contextlen > HASH_MAX_CONTEXT_LEN ||
+	    alg->keylen > HASH_MAX_KEY_LEN ||
+	    alg->hashlen > sizeof(uint64_t)) {
+		t_printv("%s exceeds limits\n", name);
+		ret = 0;
+	}
+	return (ret);
+}
+
+/*
+ * Split inputs of every length up to T_STREAM_LEN into three pieces at
+ * every possible pair of points, feed them to the streaming interface
+ * and compare the result with that of the one-shot function.
+ */
+#define T_STREAM_LEN	20
+
+static int
+t_hash_stream(char **desc CRYB_UNUSED, void *arg)
+{
+	const char *name = *(const char **)arg;
+	const hash_algorithm *alg;
+	uint64_t ctx[HASH_MAX_CONTEXT_LEN / sizeof(uint64_t)];
+	uint64_t h, eh;
+	size_t len, i, j;
+	int ret = 1;
+
+	if ((alg = get_hash_algorithm(name)) == NULL)
+		return (0);
+	for (len = 0; len <= T_STREAM_LEN; ++len) {
+		eh = hash_complete(alg, t_seq8 + 1, len, t_seq8);
+		for (i = 0; i <= len; ++i) {
+			for (j = i; j <= len; ++j) {
+				hash_init(alg, ctx, t_seq8);
+				hash_update(alg, ctx, t_seq8 + 1, i);
+				hash_update(alg, ctx, t_seq8 + 1 + i, j - i);
+				hash_update(alg, ctx, t_seq8 + 1 + j, len - j);
+				h = hash_final(alg, ctx);
+				if (h != eh) {
+					t_printv("%zu = %zu + %zu + %zu: ",
+					    len, i, j - i, len - j);
+					ret &= t_compare_x64(eh, h);
+				}
+			}
+		}
+	}
+	return (ret);
+}
+
+/*
+ * Verify that the generic interface gives the same result as the
+ * algorithm-specific one.
+ */
+static int
+t_hash_generic(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	const hash_algorithm *alg;
+	int ret = 1;
+
+	alg = get_hash_algorithm("fnv1a-64");
+	ret &= t_compare_x64(fnv1a_64_hash(t_seq8, sizeof t_seq8),
+	    hash_complete(alg, t_seq8, sizeof t_seq8, NULL));
+	alg = get_hash_algorithm("murmur3-32");
+	ret &= t_compare_x64(murmur3_32_hash(t_seq8, sizeof t_seq8,
+	    0x03020100), hash_complete(alg, t_seq8, sizeof t_seq8, t_seq8));
+	ret &= t_compare_x64(murmur3_32_hash(t_seq8, sizeof t_seq8, 0),
+	    hash_complete(alg, t_seq8, sizeof t_seq8, NULL));
+	alg = get_hash_algorithm("siphash24");
+	ret &= t_compare_x64(siphash24_hash(t_seq8, sizeof t_seq8, t_seq8),
+	    hash_complete(alg, t_seq8, sizeof t_seq8, t_seq8));
+	return (ret);
+}
+
+/*
+ * The 128-bit SipHash and 64-bit HalfSipHash variants are not
+ * registered, so test their streaming interfaces directly.
+ */
+static int
+t_hash_siphash_wide(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	siphash_ctx sctx;
+	halfsiphash_ctx hctx;
+	uint8_t out[16], e24[16], e13[16];
+	uint64_t ehalf;
+	size_t len, i;
+	int ret = 1;
+
+	for (len = 0; len <= T_STREAM_LEN; ++len) {
+		siphash24_128_hash(t_seq8, len, t_seq8, e24);
+		siphash13_128_hash(t_seq8, len, t_seq8, e13);
+		ehalf = halfsiphash24_64_hash(t_seq8, len, t_seq8);
+		for (i = 0; i <= len; ++i) {
+			siphash24_128_init(&sctx, t_seq8);
+			siphash24_update(&sctx, t_seq8, i);
+			siphash24_update(&sctx, t_seq8 + i, len - i);
+			siphash24_128_final(&sctx, out);
+			ret &= t_compare_mem(e24, out, sizeof out);
+			siphash13_128_init(&sctx, t_seq8);
+			siphash13_update(&sctx, t_seq8, i);
+			siphash13_update(&sctx, t_seq8 + i, len - i);
+			siphash13_128_final(&sctx, out);
+			ret &= t_compare_mem(e13, out, sizeof out);
+			halfsiphash24_64_init(&hctx, t_seq8);
+			halfsiphash24_update(&hctx, t_seq8, i);
+			halfsiphash24_update(&hctx, t_seq8 + i, len - i);
+			ret &= t_compare_x64(ehalf,
+			    halfsiphash24_64_final(&hctx));
+		}
+	}
+	return (ret);
+}
+
+static int
+t_hash_unknown(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+
+	return (t_is_null(get_hash_algorithm("nonexistent")));
+}
+
 static int
 t_prepare(int argc, char *argv[])
 {
+	unsigned int i, n;
 
 	(void)argc;
 	(void)argv;
 	t_add_test(t_hash_version, NULL, "version");
+	n = sizeof t_hash_names / sizeof t_hash_names[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_hash_limits, &t_hash_names[i],
+		    "%s limits", t_hash_names[i]);
+	for (i = 0; i < n; ++i)
+		t_add_test(t_hash_stream, &t_hash_names[i],
+		    "%s streaming", t_hash_names[i]);
+	t_add_test(t_hash_generic, NULL, "generic interface");
+	t_add_test(t_hash_siphash_wide, NULL, "wide siphash streaming");
+	t_add_test(t_hash_unknown, NULL, "unknown algorithm");
 	return (0);
 }
 
@@ -0,0 +1,270 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <cryb/hash.h>
+#include <cryb/hashmap.h>
+
+#include <cryb/test.h>
+
+/*
+ * Basic operations on a map with a single key
+ */
+static int
+t_hashmap_basic(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	hashmap *map;
+	void **vp, *v;
+	int a, b, ret = 1;
+
+	if (!t_is_not_null(map = hashmap_new(NULL, t_seq8, 0)))
+		return (0);
+	ret &= t_compare_sz(0, hashmap_count(map));
+	ret &= t_is_null(hashmap_get(map, "foo", 3));
+	ret &= t_compare_i(0, hashmap_put(map, "foo", 3, &a));
+	ret &= t_compare_sz(1, hashmap_count(map));
+	if (t_is_not_null(vp = hashmap_get(map, "foo", 3)))
+		ret &= t_compare_ptr(&a, *vp);
+	ret &= t_is_null(hashmap_get(map, "foo", 2));
+	ret &= t_is_null(hashmap_get(map, "bar", 3));
+	ret &= t_compare_i(0, hashmap_put(map, "foo", 3, &b));
+	ret &= t_compare_sz(1, hashmap_count(map));
+	if (t_is_not_null(vp = hashmap_get(map, "foo", 3)))
+		ret &= t_compare_ptr(&b, *vp);
+	ret &= t_compare_i(-1, hashmap_remove(map, "bar", 3, &v));
+	ret &= t_compare_i(ENOENT, errno);
+	ret &= t_compare_i(0, hashmap_remove(map, "foo", 3, &v));
+	ret &= t_compare_ptr(&b, v);
+	ret &= t_compare_sz(0, hashmap_count(map));
+	ret &= t_is_null(hashmap_get(map, "foo", 3));
+	/* the empty key is a valid key */
+	ret &= t_compare_i(0, hashmap_put(map, NULL, 0, &a));
+	if (t_is_not_null(vp = hashmap_get(map, "", 0)))
+		ret &= t_compare_ptr(&a, *vp);
+	ret &= t_compare_i(0, hashmap_remove(map, NULL, 0, NULL));
+	hashmap_delete(map);
+	hashmap_delete(NULL);
+	return (ret);
+}
+
+/*
+ * Insert, look up, iterate over and remove a large number of keys,
+ * using either the default algorithm or one which produces a great
+ * many collisions, with and without copying the keys.  Every key maps
+ * to its own index in the key array.
+ */
+#define T_NKEYS		20000
+
+static uint32_t t_keys[T_NKEYS];
+
+struct t_bulk_case {
+	const char	*desc;
+	const char	*alg;
+	unsigned int	 flags;
+};
+
+static struct t_bulk_case t_bulk_cases[] = {
+	{ "siphash13",			NULL,		0 },
+	{ "siphash13, copied keys",	NULL,		HASHMAP_COPY_KEYS },
+	{ "fnv1a-64",			"fnv1a-64",	0 },
+	{ "pearson, copied keys",	"pearson",	HASHMAP_COPY_KEYS },
+};
+
+static int
+t_hashmap_check(hashmap *map, size_t n, size_t lo, size_t hi)
+{
+	uint32_t key;
+	void **vp;
+	size_t i;
+
+	for (i = 0; i < n; ++i) {
+		/* use a copy to make sure we don't compare pointers */
+		key = t_keys[i];
+		vp = hashmap_get(map, &key, sizeof key);
+		if (i >= lo && i < hi) {
+			if (vp == NULL || *vp != &t_keys[i]) {
+				t_printv("key %zu missing or wrong\n", i);
+				return (0);
+			}
+		} else if (vp != NULL) {
+			t_printv("key %zu unexpectedly present\n", i);
+			return (0);
+		}
+	}
+	return (1);
+}
+
+static int
+t_hashmap_bulk(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_bulk_case *t = arg;
+	const hash_algorithm *alg = NULL;
+	const void *key;
+	hashmap *map;
+	size_t i, iter, keylen, n;
+	void *v;
+	int ret = 1;
+
+	if (t->alg != NULL && (alg = get_hash_algorithm(t->alg)) == NULL)
+		return (0);
+	n = alg != NULL && alg->hashlen == 1 ? T_NKEYS / 10 : T_NKEYS;
+	if (!t_is_not_null(map = hashmap_new(alg, t_seq8, t->flags)))
+		return (0);
+	for (i = 0; i < n && ret; ++i) {
+		ret &= t_compare_i(0, hashmap_put(map, &t_keys[i],
+		    sizeof t_keys[i], &t_keys[i]));
+		/* spot-check while rehashing is in progress */
+		if ((i & (i - 1)) == 0 || i % 997 == 0)
+			ret &= t_hashmap_check(map, i + 1, 0, i + 1);
+	}
+	ret &= t_compare_sz(n, hashmap_count(map));
+	ret &= t_hashmap_check(map, n, 0, n);
+	/* iterate over everything */
+	for (i = iter = 0; hashmap_next(map, &iter, &key, &keylen, &v); ++i) {
+		ret &= t_compare_sz(sizeof(uint32_t), keylen);
+		ret &= t_compare_mem(v, key, keylen);
+		if ((t->flags & HASHMAP_COPY_KEYS) == 0)
+			ret &= t_compare_ptr(v, key);
+	}
+	ret &= t_compare_sz(n, i);
+	/* remove the first half */
+	for (i = 0; i < n / 2; ++i) {
+		ret &= t_compare_i(0, hashmap_remove(map, &t_keys[i],
+		    sizeof t_keys[i], &v));
+		ret &= t_compare_ptr(&t_keys[i], v);
+	}
+	ret &= t_compare_sz(n - n / 2, hashmap_count(map));
+	ret &= t_hashmap_check(map, n, n / 2, n);
+	/* put it back, forcing several rehashes into a table of the same size */
+	for (i = 0; i < n / 2; ++i)
+		ret &= t_compare_i(0, hashmap_put(map, &t_keys[i],
+		    sizeof t_keys[i], &t_keys[i]));
+	ret &= t_compare_sz(n, hashmap_count(map));
+	ret &= t_hashmap_check(map, n, 0, n);
+	/* remove everything */
+	for (i = 0; i < n; ++i)
+		ret &= t_compare_i(0, hashmap_remove(map, &t_keys[i],
+		    sizeof t_keys[i], NULL));
+	ret &= t_compare_sz(0, hashmap_count(map));
+	iter = 0;
+	ret &= t_compare_i(0, hashmap_next(map, &iter, NULL, NULL, NULL));
+	hashmap_delete(map);
+	return (ret);
+}
+
+/*
+ * A keyed algorithm requires a key, an unkeyed one does not
+ */
+static int
+t_hashmap_nokey(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	const hash_algorithm *alg;
+	hashmap *map;
+	int ret = 1;
+
+	errno = 0;
+	ret &= t_is_null(hashmap_new(NULL, NULL, 0));
+	ret &= t_compare_i(EINVAL, errno);
+	if (!t_is_not_null(alg = get_hash_algorithm("fnv1a-64")))
+		return (0);
+	ret &= t_compare_sz(0, alg->keylen);
+	if (!t_is_not_null(map = hashmap_new(alg, NULL, 0)))
+		return (0);
+	ret &= t_compare_i(0, hashmap_put(map, "foo", 3, map));
+	ret &= t_is_not_null(hashmap_get(map, "foo", 3));
+	hashmap_delete(map);
+	return (ret);
+}
+
+/*
+ * Memory allocation failures
+ */
+static int
+t_hashmap_nomem(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	hashmap *map;
+	size_t i;
+	int ret = 1;
+
+	t_malloc_fail = 1;
+	ret &= t_is_null(hashmap_new(NULL, t_seq8, 0));
+	ret &= t_compare_i(ENOMEM, errno);
+	t_malloc_fail = 0;
+	if (!t_is_not_null(map = hashmap_new(NULL, t_seq8, HASHMAP_COPY_KEYS)))
+		return (0);
+	/* fail allocating the table, then the slots, then the key */
+	for (i = 0; i < 3; ++i) {
+		if (i == 0)
+			t_malloc_fail = 1;
+		else
+			t_malloc_fail_after = i;
+		ret &= t_compare_i(-1, hashmap_put(map, "foo", 3, map));
+		ret &= t_compare_i(ENOMEM, errno);
+		t_malloc_fail = t_malloc_fail_after = 0;
+		ret &= t_compare_sz(0, hashmap_count(map));
+		ret &= t_is_null(hashmap_get(map, "foo", 3));
+	}
+	ret &= t_compare_i(0, hashmap_put(map, "foo", 3, map));
+	ret &= t_compare_sz(1, hashmap_count(map));
+	hashmap_delete(map);
+	return (ret);
+}
+
+static int
+t_prepare(int argc, char *argv[])
+{
+	unsigned int i, n;
+
+	(void)argc;
+	(void)argv;
+	for (i = 0; i < T_NKEYS; ++i)
+		t_keys[i] = i * 2654435761U;
+	t_add_test(t_hashmap_basic, NULL, "basic");
+	n = sizeof t_bulk_cases / sizeof t_bulk_cases[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_hashmap_bulk, &t_bulk_cases[i],
+		    "bulk (%s)", t_bulk_cases[i].desc);
+	t_add_test(t_hashmap_nokey, NULL, "missing key");
+	t_add_test(t_hashmap_nomem, NULL, "out of memory");
+	return (0);
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	t_main(t_prepare, NULL, argc, argv);
+}
@@ -0,0 +1,308 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cryb/endian.h>
+#include <cryb/hash.h>
+#include <cryb/hll.h>
+
+#include <cryb/test.h>
+
+#define T_MAX_KEYS	200000
+
+static uint8_t t_keys[T_MAX_KEYS][8];
+static hash_key t_hkeys[T_MAX_KEYS];
+
+/*
+ * Serialize two sketches and compare the results
+ */
+static int
+t_hll_compare(const hll *a, const hll *b)
+{
+	static uint8_t abuf[262144], bbuf[262144];
+	size_t alen, blen;
+	int ret = 1;
+
+	alen = hll_export(a, abuf, sizeof abuf);
+	blen = hll_export(b, bbuf, sizeof bbuf);
+	ret &= t_compare_sz(alen, blen);
+	if (ret && alen <= sizeof abuf)
+		ret &= t_compare_mem(abuf, bbuf, alen);
+	return (ret);
+}
+
+/*
+ * Add n distinct keys, each several times, one at a time and in bulk,
+ * and check that both sketches are identical and that the estimate is
+ * within six standard errors.
+ */
+struct t_estimate_case {
+	unsigned int	 p;
+	size_t		 n;
+};
+
+static struct t_estimate_case t_estimate_cases[] = {
+	{  4,      0 }, {  4,     10 }, {  4,   1000 }, {  4, 200000 },
+	{ 10,      0 }, { 10,      1 }, { 10,    100 }, { 10,   1000 },
+	{ 10,  10000 }, { 10, 200000 },
+	{ 14,      1 }, { 14,    100 }, { 14,   1000 }, { 14,   5000 },
+	{ 14,  20000 }, { 14, 200000 },
+	{ 18,   1000 }, { 18, 200000 },
+};
+
+static int
+t_hll_estimate(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_estimate_case *t = arg;
+	hll *h1, *h2;
+	uint64_t est;
+	double err, maxerr;
+	size_t i;
+	int ret = 1;
+
+	h1 = hll_new(t->p, 42);
+	h2 = hll_new(t->p, 42);
+	if (!t_is_not_null(h1) || !t_is_not_null(h2)) {
+		hll_delete(h1);
+		hll_delete(h2);
+		return (0);
+	}
+	for (i = 0; i < t->n; ++i) {
+		ret &= t_is_zero_i(hll_add(h1, t_keys[i], sizeof t_keys[i]));
+		if (i % 3 == 0)
+			ret &= t_is_zero_i(hll_add(h1, t_keys[i],
+			    sizeof t_keys[i]));
+	}
+	ret &= t_is_zero_i(hll_add_many(h2, t_hkeys, t->n));
+	ret &= t_is_zero_i(hll_add_many(h2, t_hkeys, t->n / 2));
+	ret &= t_hll_compare(h1, h2);
+	est = hll_estimate(h1);
+	maxerr = 6 * 1.04 / (1 << t->p / 2) * t->n;
+	if (t->p % 2)
+		maxerr /= 1.4142;
+	err = est > t->n ? est - t->n : t->n - est;
+	if (err > maxerr + 1) {
+		t_printv("estimated %llu for %zu\n",
+		    (unsigned long long)est, t->n);
+		ret = 0;
+	}
+	hll_delete(h1);
+	hll_delete(h2);
+	return (ret);
+}
+
+/*
+ * Build sketches of the first and second half of a set of keys and of
+ * the whole set, merge the first two and compare with the third.
+ */
+struct t_merge_case {
+	const char	*desc;
+	unsigned int	 p;
+	size_t		 n1, n2;
+};
+
+static struct t_merge_case t_merge_cases[] = {
+	{ "sparse into sparse",		14,	100,	100 },
+	{ "sparse into sparse, grow",	14,	1000,	1000 },
+	{ "dense into sparse",		12,	100,	50000 },
+	{ "sparse into dense",		12,	50000,	100 },
+	{ "dense into dense",		12,	50000,	50000 },
+	{ "dense into dense, p = 4",	4,	100,	100 },
+	{ "empty into empty",		12,	0,	0 },
+};
+
+static int
+t_hll_merge(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_merge_case *t = arg;
+	hll *h1, *h2, *h;
+	int ret = 1;
+
+	h1 = hll_new(t->p, 42);
+	h2 = hll_new(t->p, 42);
+	h = hll_new(t->p, 42);
+	if (t_is_not_null(h1) && t_is_not_null(h2) && t_is_not_null(h)) {
+		ret &= t_is_zero_i(hll_add_many(h1, t_hkeys, t->n1));
+		ret &= t_is_zero_i(hll_add_many(h2, t_hkeys + t->n1, t->n2));
+		ret &= t_is_zero_i(hll_add_many(h, t_hkeys, t->n1 + t->n2));
+		ret &= t_is_zero_i(hll_merge(h1, h2));
+		ret &= t_hll_compare(h, h1);
+		/* merging with itself or again changes nothing */
+		ret &= t_is_zero_i(hll_merge(h1, h1));
+		ret &= t_is_zero_i(hll_merge(h1, h2));
+		ret &= t_hll_compare(h, h1);
+		ret &= t_compare_u64(hll_estimate(h), hll_estimate(h1));
+	} else {
+		ret = 0;
+	}
+	hll_delete(h1);
+	hll_delete(h2);
+	hll_delete(h);
+	return (ret);
+}
+
+static int
+t_hll_merge_mismatch(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	hll *h1, *h2, *h3;
+	int ret = 1;
+
+	h1 = hll_new(10, 42);
+	h2 = hll_new(11, 42);
+	h3 = hll_new(10, 43);
+	if (t_is_not_null(h1) && t_is_not_null(h2) && t_is_not_null(h3)) {
+		ret &= t_compare_i(-1, hll_merge(h1, h2));
+		ret &= t_compare_i(EINVAL, errno);
+		ret &= t_compare_i(-1, hll_merge(h1, h3));
+		ret &= t_compare_i(EINVAL, errno);
+	} else {
+		ret = 0;
+	}
+	hll_delete(h1);
+	hll_delete(h2);
+	hll_delete(h3);
+	return (ret);
+}
+
+/*
+ * Export and import sparse and dense sketches, and check that invalid
+ * input is rejected.
+ */
+static int
+t_hll_serialize(char **desc CRYB_UNUSED, void *arg)
+{
+	size_t n = *(size_t *)arg;
+	uint8_t buf[16384];
+	hll *h, *ih;
+	size_t len;
+	int ret = 1;
+
+	if (!t_is_not_null(h = hll_new(12, 0x0123456789abcdefULL)))
+		return (0);
+	ret &= t_is_zero_i(hll_add_many(h, t_hkeys, n));
+	len = hll_export(h, NULL, 0);
+	ret &= t_compare_sz(len, hll_export(h, buf, len));
+	if (t_is_not_null(ih = hll_import(buf, len))) {
+		ret &= t_hll_compare(h, ih);
+		ret &= t_compare_u64(hll_estimate(h), hll_estimate(ih));
+		/* an imported sketch can be added to */
+		ret &= t_is_zero_i(hll_add_many(ih, t_hkeys, n + 10));
+		ret &= t_is_zero_i(hll_add_many(h, t_hkeys + n, 10));
+		ret &= t_hll_compare(h, ih);
+		hll_delete(ih);
+	} else {
+		ret = 0;
+	}
+	ret &= t_is_null(hll_import(buf, len - 1));
+	ret &= t_compare_i(EINVAL, errno);
+	ret &= t_is_null(hll_import(buf, 10));
+	ret &= t_compare_i(EINVAL, errno);
+	buf[8] = 3;
+	ret &= t_is_null(hll_import(buf, len));
+	ret &= t_compare_i(EINVAL, errno);
+	buf[8] = 12;
+	if (buf[9] == 1 && n > 0) {
+		/* a zero entry */
+		memset(buf + 24, 0, 4);
+		ret &= t_is_null(hll_import(buf, len));
+		ret &= t_compare_i(EINVAL, errno);
+	}
+	hll_delete(h);
+	return (ret);
+}
+
+static size_t t_serialize_sparse = 100;
+static size_t t_serialize_dense = 100000;
+
+static int
+t_hll_errors(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	hll *h;
+	int ret = 1;
+
+	ret &= t_is_null(hll_new(HLL_MIN_PRECISION - 1, 0));
+	ret &= t_compare_i(EINVAL, errno);
+	ret &= t_is_null(hll_new(HLL_MAX_PRECISION + 1, 0));
+	ret &= t_compare_i(EINVAL, errno);
+	t_malloc_fail = 1;
+	ret &= t_is_null(hll_new(10, 0));
+	ret &= t_compare_i(ENOMEM, errno);
+	t_malloc_fail = 0;
+	/* fail to grow the sparse table */
+	if (t_is_not_null(h = hll_new(14, 0))) {
+		t_malloc_fail = 1;
+		ret &= t_compare_i(-1, hll_add_many(h, t_hkeys, 1000));
+		ret &= t_compare_i(ENOMEM, errno);
+		t_malloc_fail = 0;
+		hll_delete(h);
+	}
+	return (ret);
+}
+
+static int
+t_prepare(int argc, char *argv[])
+{
+	unsigned int i, n;
+
+	(void)argc;
+	(void)argv;
+	for (i = 0; i < T_MAX_KEYS; ++i) {
+		le64enc(t_keys[i], i * 0x9e3779b97f4a7c15ULL + 1);
+		t_hkeys[i].data = t_keys[i];
+		t_hkeys[i].len = sizeof t_keys[i];
+	}
+	n = sizeof t_estimate_cases / sizeof t_estimate_cases[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_hll_estimate, &t_estimate_cases[i],
+		    "p = %u, n = %zu", t_estimate_cases[i].p,
+		    t_estimate_cases[i].n);
+	n = sizeof t_merge_cases / sizeof t_merge_cases[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_hll_merge, &t_merge_cases[i],
+		    "merge %s", t_merge_cases[i].desc);
+	t_add_test(t_hll_merge_mismatch, NULL, "merge mismatch");
+	t_add_test(t_hll_serialize, &t_serialize_sparse, "serialize sparse");
+	t_add_test(t_hll_serialize, &t_serialize_dense, "serialize dense");
+	t_add_test(t_hll_errors, NULL, "errors");
+	return (0);
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	t_main(t_prepare, NULL, argc, argv);
+}
@@ -0,0 +1,202 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cryb/digest.h>
+#include <cryb/md5.h>
+#include <cryb/sha256.h>
+#include <cryb/hmac.h>
+
+#include <cryb/test.h>
+
+/*
+ * Test vectors from RFC 2202 for HMAC-MD5, which has no specialized
+ * implementation.
+ */
+static struct t_vector {
+	const char *desc;
+	const uint8_t *key;
+	size_t keylen;
+	const char *msg;
+	const uint8_t mac[MD5_DIGEST_LEN];
+} t_hmac_md5_vectors[] = {
+	{
+		"RFC 2202 test case 1",
+		(const uint8_t *)
+		"\x0b\x0b\x0b\x0b\x0b\x0b\x0b\x0b"
+		"\x0b\x0b\x0b\x0b\x0b\x0b\x0b\x0b",
+		16,
+		"Hi There",
+		{
+			0x92, 0x94, 0x72, 0x7a, 0x36, 0x38, 0xbb, 0x1c,
+			0x13, 0xf4, 0x8e, 0xf8, 0x15, 0x8b, 0xfc, 0x9d,
+		},
+	},
+	{
+		"RFC 2202 test case 2",
+		(const uint8_t *)"Jefe",
+		4,
+		"what do ya want for nothing?",
+		{
+			0x75, 0x0c, 0x78, 0x3e, 0x6a, 0xb0, 0xb5, 0x03,
+			0xea, 0xa8, 0x6e, 0x31, 0x0a, 0x5d, 0xb7, 0x38,
+		},
+	},
+	{
+		"RFC 2202 test case 6",
+		(const uint8_t *)
+		"\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa"
+		"\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa"
+		"\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa"
+		"\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa"
+		"\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa\xaa",
+		80,
+		"Test Using Larger Than Block-Size Key - Hash Key First",
+		{
+			0x6b, 0x1a, 0xb7, 0xfe, 0x4b, 0xd7, 0xbf, 0x8f,
+			0x0b, 0x62, 0xe6, 0xce, 0x61, 0xb9, 0xd0, 0xcd,
+		},
+	},
+};
+
+static int
+t_hmac_md5_vector(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_vector *vector = (struct t_vector *)arg;
+	uint8_t mac[MD5_DIGEST_LEN];
+	hmac_key hk;
+	hmac_ctx ctx;
+	int ret = 1;
+
+	ret &= t_is_zero_i(hmac_complete(&md5_digest, vector->key,
+	    vector->keylen, vector->msg, strlen(vector->msg), mac));
+	ret &= t_compare_mem(vector->mac, mac, sizeof mac);
+	ret &= t_is_zero_i(hmac_setkey(&hk, &md5_digest, vector->key,
+	    vector->keylen));
+	hmac_reset(&ctx, &hk);
+	hmac_update(&ctx, vector->msg, strlen(vector->msg));
+	hmac_final(&ctx, mac);
+	ret &= t_compare_mem(vector->mac, mac, sizeof mac);
+	return (ret);
+}
+
+/*
+ * Compare the generic implementation with the specialized ones, using
+ * keys shorter than, equal to and longer than the block length.
+ */
+static struct t_specialized {
+	const char *digest;
+	void (*complete)(const void *, size_t, const void *, size_t,
+	    uint8_t *);
+} t_specialized[] = {
+	{ "sha1",	hmac_sha1_complete },
+	{ "sha224",	hmac_sha224_complete },
+	{ "sha256",	hmac_sha256_complete },
+	{ "sha384",	hmac_sha384_complete },
+	{ "sha512",	hmac_sha512_complete },
+};
+
+static const size_t t_keylens[] = { 0, 20, 64, 100, 128, 200 };
+
+static int
+t_hmac_specialized(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_specialized *ts = arg;
+	const digest_algorithm *alg;
+	uint8_t mac[HMAC_MAX_MAC_LEN], emac[HMAC_MAX_MAC_LEN];
+	unsigned int i;
+	int ret = 1;
+
+	if ((alg = get_digest_algorithm(ts->digest)) == NULL)
+		return (0);
+	for (i = 0; i < sizeof t_keylens / sizeof t_keylens[0]; ++i) {
+		ts->complete(t_seq8, t_keylens[i], t_seq8, sizeof t_seq8,
+		    emac);
+		ret &= t_is_zero_i(hmac_complete(alg, t_seq8, t_keylens[i],
+		    t_seq8, sizeof t_seq8, mac));
+		ret &= t_compare_mem(emac, mac, alg->digestlen);
+	}
+	return (ret);
+}
+/*
+ * Verify that the generic context is wiped once the MAC has been
+ * computed.
+ */
+static int
+t_hmac_wipe(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	uint8_t zero[sizeof(hmac_ctx)] = { 0 };
+	uint8_t mac[HMAC_MAX_MAC_LEN];
+	hmac_ctx ctx;
+	int ret = 1;
+
+	ret &= t_is_zero_i(hmac_init(&ctx, &sha256_digest, t_seq8, 32));
+	hmac_update(&ctx, t_seq8, sizeof t_seq8);
+	hmac_final(&ctx, mac);
+	ret &= t_compare_mem(zero, &ctx, sizeof ctx);
+	return (ret);
+}
+
+
+
+/***************************************************************************
+ * Boilerplate
+ */
+
+static int
+t_prepare(int argc, char *argv[])
+{
+	int i, n;
+
+	(void)argc;
+	(void)argv;
+	n = sizeof t_hmac_md5_vectors / sizeof t_hmac_md5_vectors[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_hmac_md5_vector, &t_hmac_md5_vectors[i],
+		    "%s", t_hmac_md5_vectors[i].desc);
+	n = sizeof t_specialized / sizeof t_specialized[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_hmac_specialized, &t_specialized[i],
+		    "generic vs. hmac_%s", t_specialized[i].digest);
+	t_add_test(t_hmac_wipe, NULL, "wipe");
+	return (0);
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	t_main(t_prepare, NULL, argc, argv);
+}
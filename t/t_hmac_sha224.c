@@ -158,6 +158,32 @@ t_hmac_sha224_vector(char **desc CRYB_UNUSED, void *arg)
 	return (t_compare_mem(vector->mac, mac, HMAC_SHA224_MAC_LEN));
 }
 
+#if !WITH_OPENSSL
+/*
+ * Unit test: precompute the key state once, then compute the HMAC
+ * signature of the specified string several times using it.
+ */
+static int
+t_hmac_sha224_reset(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_vector *vector = (struct t_vector *)arg;
+	uint8_t mac[HMAC_SHA224_MAC_LEN];
+	hmac_sha224_key hk;
+	hmac_sha224_ctx ctx;
+	int i, ret = 1;
+
+	hmac_sha224_setkey(&hk, vector->key, vector->keylen);
+	for (i = 0; i < 3; ++i) {
+		hmac_sha224_reset(&ctx, &hk);
+		hmac_sha224_update(&ctx, vector->msg, strlen(vector->msg));
+		hmac_sha224_final(&ctx, mac);
+		ret &= t_compare_mem(vector->mac, mac, HMAC_SHA224_MAC_LEN);
+	}
+	return (ret);
+}
+#endif
+
+
 
 /***************************************************************************
  * Boilerplate
@@ -174,6 +200,11 @@ t_prepare(int argc, char *argv[])
 	for (i = 0; i < n; ++i)
 		t_add_test(t_hmac_sha224_vector, &t_hmac_sha224_vectors[i],
 		    "%s", t_hmac_sha224_vectors[i].desc);
+#if !WITH_OPENSSL
+	for (i = 0; i < n; ++i)
+		t_add_test(t_hmac_sha224_reset, &t_hmac_sha224_vectors[i],
+		    "%s (reset)", t_hmac_sha224_vectors[i].desc);
+#endif
 	return (0);
 }
 
@@ -29,8 +29,10 @@
 
 #include "cryb/impl.h"
 
+#include <errno.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include <unistd.h>
 
 #include <cryb/mac.h>
@@ -44,13 +46,197 @@ t_mac_version(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
 	return (t_compare_str(PACKAGE_VERSION, cryb_mac_version()));
 }
 
+static const char *t_mac_names[] = {
+	"aes-cmac",
+	"hmac-sha1", "hmac-sha224", "hmac-sha256", "hmac-sha384", "hmac-sha512",
+};
+
+/*
+ * Verify that every algorithm is registered, fits within the limits
+ * advertised in <cryb/mac.h>, and gives the same result whether or not
+ * the key state is precomputed.
+ */
+static int
+t_mac_algorithm(char **desc CRYB_UNUSED, void *arg)
+{
+	const char *name = *(const char **)arg;
+	const mac_algorithm *alg;
+	uint64_t ctx[MAC_MAX_CONTEXT_LEN / sizeof(uint64_t)];
+	uint64_t hk[MAC_MAX_CONTEXT_LEN / sizeof(uint64_t)];
+	uint8_t mac[MAC_MAX_MAC_LEN], emac[MAC_MAX_MAC_LEN];
+	int ret = 1;
+
+	if ((alg = get_mac_algorithm(name)) == NULL) {
+		t_printv("%s not found\n", name);
+		return (0);
+	}
+	ret &= t_compare_str(name, alg->name);
+	if (alg->contextlen > MAC_MAX_CONTEXT_LEN ||
+	    alg->keystatelen > MAC_MAX_CONTEXT_LEN ||
+	    alg->maclen > MAC_MAX_MAC_LEN) {
+		t_printv("%s exceeds limits\n", name);
+		return (0);
+	}
+	mac_complete(alg, t_seq8, 32, t_seq8, sizeof t_seq8, emac);
+	mac_init(alg, ctx, t_seq8, 32);
+	mac_update(alg, ctx, t_seq8, sizeof t_seq8);
+	mac_final(alg, ctx, mac);
+	ret &= t_compare_mem(emac, mac, alg->maclen);
+	mac_setkey(alg, hk, t_seq8, 32);
+	mac_reset(alg, ctx, hk);
+	mac_update(alg, ctx, t_seq8, sizeof t_seq8);
+	mac_final(alg, ctx, mac);
+	ret &= t_compare_mem(emac, mac, alg->maclen);
+	return (ret);
+}
+
+static int
+t_mac_unknown(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+
+	return (t_is_null(get_mac_algorithm("hmac-nonexistent")));
+}
+
+/*
+ * Verify single and batched MAC verification, including truncated and
+ * corrupted tags and batches that switch keys midway.
+ */
+#define T_VERIFY_NITEMS 6
+
+static int
+t_mac_verify(char **desc CRYB_UNUSED, void *arg)
+{
+	const char *name = *(const char **)arg;
+	const mac_algorithm *alg;
+	mac_verify_item items[T_VERIFY_NITEMS];
+	uint8_t tags[T_VERIFY_NITEMS][MAC_MAX_MAC_LEN];
+	uint8_t key1[32], key2[32];
+	int results[T_VERIFY_NITEMS];
+	unsigned int i;
+	size_t minlen;
+	int ret = 1;
+
+	if ((alg = get_mac_algorithm(name)) == NULL)
+		return (0);
+	minlen = alg->maclen / 2 < MAC_MIN_TAG_LEN ?
+	    MAC_MIN_TAG_LEN : alg->maclen / 2;
+	memcpy(key1, t_seq8, sizeof key1);
+	memcpy(key2, t_seq8 + sizeof key1, sizeof key2);
+	for (i = 0; i < T_VERIFY_NITEMS; ++i) {
+		items[i].key = i < T_VERIFY_NITEMS / 2 ? key1 : key2;
+		items[i].keylen = i < T_VERIFY_NITEMS / 2 ? sizeof key1 : 16;
+		items[i].msg = t_seq8 + i;
+		items[i].msglen = sizeof t_seq8 - i * 17;
+		mac_complete(alg, items[i].key, items[i].keylen,
+		    items[i].msg, items[i].msglen, tags[i]);
+		items[i].tag = tags[i];
+		items[i].taglen = alg->maclen;
+		ret &= t_compare_i(1, mac_verify(alg, items[i].key,
+		    items[i].keylen, items[i].msg, items[i].msglen,
+		    items[i].tag, items[i].taglen));
+	}
+	ret &= t_compare_sz(T_VERIFY_NITEMS,
+	    mac_verify_many(alg, items, T_VERIFY_NITEMS, results));
+	for (i = 0; i < T_VERIFY_NITEMS; ++i)
+		ret &= t_compare_i(1, results[i]);
+	/* corrupt the last byte of one tag */
+	tags[1][alg->maclen - 1] ^= 0x80;
+	/* truncate another as far as allowed */
+	items[3].taglen = minlen;
+	/* reject empty, overtruncated and overlong tags */
+	items[4].taglen = 0;
+	items[5].taglen = alg->maclen + 1;
+	ret &= t_compare_i(0, mac_verify(alg, items[3].key, items[3].keylen,
+	    items[3].msg, items[3].msglen, items[3].tag, 1));
+	ret &= t_compare_i(0, mac_verify(alg, items[3].key, items[3].keylen,
+	    items[3].msg, items[3].msglen, items[3].tag, minlen - 1));
+	ret &= t_compare_i(0, mac_verify(alg, items[1].key, items[1].keylen,
+	    items[1].msg, items[1].msglen, items[1].tag, items[1].taglen));
+	ret &= t_compare_sz(3,
+	    mac_verify_many(alg, items, T_VERIFY_NITEMS, results));
+	ret &= t_compare_i(1, results[0]);
+	ret &= t_compare_i(0, results[1]);
+	ret &= t_compare_i(1, results[2]);
+	ret &= t_compare_i(1, results[3]);
+	ret &= t_compare_i(0, results[4]);
+	ret &= t_compare_i(0, results[5]);
+	return (ret);
+}
+
+/*
+ * Verify that an algorithm whose state does not fit in the verification
+ * buffers is rejected.
+ */
+static int
+t_mac_verify_toolarge(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	mac_algorithm alg;
+	mac_verify_item item;
+	uint8_t tag[MAC_MAX_MAC_LEN];
+	int result, ret = 1;
+
+	alg = *get_mac_algorithm("hmac-sha256");
+	mac_complete(&alg, t_seq8, 32, t_seq8, sizeof t_seq8, tag);
+	item.key = t_seq8;
+	item.keylen = 32;
+	item.msg = t_seq8;
+	item.msglen = sizeof t_seq8;
+	item.tag = tag;
+	item.taglen = alg.maclen;
+	alg.contextlen = MAC_MAX_CONTEXT_LEN + 1;
+	errno = 0;
+	ret &= t_compare_i(-1, mac_verify(&alg, item.key, item.keylen,
+	    item.msg, item.msglen, item.tag, item.taglen));
+	ret &= t_compare_i(EINVAL, errno);
+	errno = 0;
+	result = 1;
+	ret &= t_compare_sz((size_t)-1, mac_verify_many(&alg, &item, 1,
+	    &result));
+	ret &= t_compare_i(EINVAL, errno);
+	ret &= t_compare_i(0, result);
+	return (ret);
+}
+
+/*
+ * Verify that the context is wiped once the MAC has been computed.
+ */
+static int
+t_mac_wipe(char **desc CRYB_UNUSED, void *arg)
+{
+	const char *name = *(const char **)arg;
+	const mac_algorithm *alg;
+	uint64_t ctx[MAC_MAX_CONTEXT_LEN / sizeof(uint64_t)];
+	uint8_t zero[MAC_MAX_CONTEXT_LEN] = { 0 };
+	uint8_t mac[MAC_MAX_MAC_LEN];
+
+	if ((alg = get_mac_algorithm(name)) == NULL)
+		return (0);
+	mac_init(alg, ctx, t_seq8, 32);
+	mac_update(alg, ctx, t_seq8, sizeof t_seq8);
+	mac_final(alg, ctx, mac);
+	return (t_compare_mem(zero, ctx, alg->contextlen));
+}
+
 static int
 t_prepare(int argc, char *argv[])
 {
+	unsigned int i, n;
 
 	(void)argc;
 	(void)argv;
 	t_add_test(t_mac_version, NULL, "version");
+	n = sizeof t_mac_names / sizeof t_mac_names[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_mac_algorithm, &t_mac_names[i],
+		    "%s", t_mac_names[i]);
+	for (i = 0; i < n; ++i)
+		t_add_test(t_mac_verify, &t_mac_names[i],
+		    "%s verify", t_mac_names[i]);
+	for (i = 0; i < n; ++i)
+		t_add_test(t_mac_wipe, &t_mac_names[i],
+		    "%s wipe", t_mac_names[i]);
+	t_add_test(t_mac_verify_toolarge, NULL, "verify oversized algorithm");
+	t_add_test(t_mac_unknown, NULL, "unknown algorithm");
 	return (0);
 }
 
@@ -0,0 +1,323 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cryb/sha256.h>
+#include <cryb/merkle.h>
+
+#include <cryb/test.h>
+
+/*
+ * Test vectors from the Certificate Transparency reference
+ * implementation: roots of trees built from the first n of eight
+ * variable-length leaves.
+ */
+static const uint8_t t_ct_leaf_data[] = {
+	0x00,
+	0x10,
+	0x20, 0x21,
+	0x30, 0x31,
+	0x40, 0x41, 0x42, 0x43,
+	0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57,
+	0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67,
+	0x68, 0x69, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f,
+};
+
+static const size_t t_ct_leaf_len[] = { 0, 1, 1, 2, 2, 4, 8, 16 };
+
+static struct t_ct_vector {
+	const char *desc;
+	unsigned int nleaves;
+	uint8_t root[SHA256_DIGEST_LEN];
+} t_ct_vectors[] = {
+	{
+		"empty tree",
+		0,
+		{
+			0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14,
+			0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24,
+			0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c,
+			0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55,
+		},
+	},
+	{
+		"one leaf",
+		1,
+		{
+			0x6e, 0x34, 0x0b, 0x9c, 0xff, 0xb3, 0x7a, 0x98,
+			0x9c, 0xa5, 0x44, 0xe6, 0xbb, 0x78, 0x0a, 0x2c,
+			0x78, 0x90, 0x1d, 0x3f, 0xb3, 0x37, 0x38, 0x76,
+			0x85, 0x11, 0xa3, 0x06, 0x17, 0xaf, 0xa0, 0x1d,
+		},
+	},
+	{
+		"three leaves",
+		3,
+		{
+			0xae, 0xb6, 0xbc, 0xfe, 0x27, 0x4b, 0x70, 0xa1,
+			0x4f, 0xb0, 0x67, 0xa5, 0xe5, 0x57, 0x82, 0x64,
+			0xdb, 0x0f, 0xa9, 0xb5, 0x1a, 0xf5, 0xe0, 0xba,
+			0x15, 0x91, 0x58, 0xf3, 0x29, 0xe0, 0x6e, 0x77,
+		},
+	},
+	{
+		"seven leaves",
+		7,
+		{
+			0xdd, 0xb8, 0x9b, 0xe4, 0x03, 0x80, 0x9e, 0x32,
+			0x57, 0x50, 0xd3, 0xd2, 0x63, 0xcd, 0x78, 0x92,
+			0x9c, 0x29, 0x42, 0xb7, 0x94, 0x2a, 0x34, 0xb7,
+			0x7e, 0x12, 0x2c, 0x95, 0x94, 0xa7, 0x4c, 0x8c,
+		},
+	},
+	{
+		"eight leaves",
+		8,
+		{
+			0x5d, 0xc9, 0xda, 0x79, 0xa7, 0x06, 0x59, 0xa9,
+			0xad, 0x55, 0x9c, 0xb7, 0x01, 0xde, 0xd9, 0xa2,
+			0xab, 0x9d, 0x82, 0x3a, 0xad, 0x2f, 0x49, 0x60,
+			0xcf, 0xe3, 0x70, 0xef, 0xf4, 0x60, 0x43, 0x28,
+		},
+	},
+};
+
+/*
+ * Unit test: build a tree from precomputed leaf hashes and compare the
+ * root to the expected result.
+ */
+static int
+t_merkle_ct_vector(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_ct_vector *vector = arg;
+	uint8_t md[SHA256_DIGEST_LEN], root[SHA256_DIGEST_LEN];
+	const uint8_t *data;
+	merkle_ctx ctx;
+	unsigned int i;
+
+	if (!t_is_zero_i(merkle_init(&ctx, &sha256_digest, 1, 2)))
+		return (0);
+	for (data = t_ct_leaf_data, i = 0; i < vector->nleaves; ++i) {
+		merkle_leaf(&sha256_digest, data, t_ct_leaf_len[i], md);
+		merkle_update_leaf(&ctx, md);
+		data += t_ct_leaf_len[i];
+	}
+	merkle_final(&ctx, root);
+	return (t_compare_mem(vector->root, root, SHA256_DIGEST_LEN));
+}
+
+/*
+ * Reference implementation of the tree hash, following the recursive
+ * definition directly.
+ */
+static void
+t_merkle_ref(const uint8_t *data, size_t len, size_t leaflen,
+    unsigned int fanout, uint8_t *md)
+{
+	uint8_t child[SHA256_DIGEST_LEN];
+	sha256_ctx ctx;
+	size_t nleaves, step, off, end;
+
+	nleaves = (len + leaflen - 1) / leaflen;
+	sha256_init(&ctx);
+	if (nleaves == 0) {
+		sha256_final(&ctx, md);
+		return;
+	}
+	if (nleaves == 1) {
+		sha256_update(&ctx, "\x00", 1);
+		sha256_update(&ctx, data, len);
+		sha256_final(&ctx, md);
+		return;
+	}
+	for (step = 1; step * fanout < nleaves; step *= fanout)
+		/* nothing */ ;
+	sha256_update(&ctx, "\x01", 1);
+	for (off = 0; off < len; off = end) {
+		end = off + step * leaflen;
+		if (end > len)
+			end = len;
+		t_merkle_ref(data + off, end - off, leaflen, fanout, child);
+		sha256_update(&ctx, child, sizeof child);
+	}
+	sha256_final(&ctx, md);
+}
+
+#define T_MAX_LEAVES	40
+#define T_LEAF_LEN	7
+
+static uint8_t t_data[T_MAX_LEAVES * T_LEAF_LEN];
+
+struct t_shape {
+	unsigned int fanout;
+	size_t len;
+};
+
+/*
+ * Unit test: compare the streaming implementation to the reference
+ * implementation, feeding the data in odd-sized chunks.
+ */
+static int
+t_merkle_shape(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_shape *shape = arg;
+	uint8_t md[SHA256_DIGEST_LEN], ref[SHA256_DIGEST_LEN];
+	merkle_ctx ctx;
+	size_t off, n;
+
+	t_merkle_ref(t_data, shape->len, T_LEAF_LEN, shape->fanout, ref);
+	if (!t_is_zero_i(merkle_init(&ctx, &sha256_digest, T_LEAF_LEN,
+	    shape->fanout)))
+		return (0);
+	for (off = 0; off < shape->len; off += n) {
+		n = shape->len - off < 5 ? shape->len - off : 5;
+		merkle_update(&ctx, t_data + off, n);
+	}
+	merkle_final(&ctx, md);
+	return (t_compare_mem(ref, md, SHA256_DIGEST_LEN));
+}
+
+/*
+ * Unit test: generate and verify an inclusion proof for every leaf, then
+ * verify that a corrupted proof is rejected.
+ */
+static int
+t_merkle_proofs(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_shape *shape = arg;
+	uint8_t root[SHA256_DIGEST_LEN], leaf[SHA256_DIGEST_LEN];
+	uint8_t proof[MERKLE_MAX_DEPTH * 16 * SHA256_DIGEST_LEN];
+	uint64_t i, nleaves;
+	size_t off, end, prooflen;
+	int ret = 1;
+
+	nleaves = (shape->len + T_LEAF_LEN - 1) / T_LEAF_LEN;
+	ret &= t_is_zero_i(merkle_complete(&sha256_digest, T_LEAF_LEN,
+	    shape->fanout, t_data, shape->len, root));
+	for (i = 0; i < nleaves && ret; ++i) {
+		off = i * T_LEAF_LEN;
+		end = off + T_LEAF_LEN < shape->len ?
+		    off + T_LEAF_LEN : shape->len;
+		merkle_leaf(&sha256_digest, t_data + off, end - off, leaf);
+		prooflen = sizeof proof;
+		ret &= t_is_zero_i(merkle_proof(&sha256_digest, T_LEAF_LEN,
+		    shape->fanout, t_data, shape->len, i, proof, &prooflen));
+		ret &= t_compare_i(1, merkle_verify(&sha256_digest,
+		    shape->fanout, leaf, i, nleaves, proof, prooflen, root));
+		if (prooflen > 0) {
+			proof[prooflen / 2] ^= 0x01;
+			ret &= t_compare_i(0, merkle_verify(&sha256_digest,
+			    shape->fanout, leaf, i, nleaves, proof, prooflen,
+			    root));
+		}
+		leaf[0] ^= 0x01;
+		ret &= t_compare_i(0, merkle_verify(&sha256_digest,
+		    shape->fanout, leaf, i, nleaves, proof, prooflen, root));
+	}
+	return (ret);
+}
+
+/*
+ * Unit test: verify that invalid parameters are rejected.
+ */
+static int
+t_merkle_invalid(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	uint8_t md[SHA256_DIGEST_LEN], proof[SHA256_DIGEST_LEN];
+	merkle_ctx ctx;
+	size_t prooflen;
+	int ret = 1;
+
+	ret &= t_compare_i(-1, merkle_init(&ctx, &sha256_digest, 0, 2));
+	ret &= t_compare_i(-1, merkle_init(&ctx, &sha256_digest, 1, 1));
+	prooflen = sizeof proof;
+	ret &= t_compare_i(-1, merkle_proof(&sha256_digest, T_LEAF_LEN, 2,
+	    t_data, 2 * T_LEAF_LEN, 2, proof, &prooflen));
+	prooflen = 0;
+	ret &= t_compare_i(-1, merkle_proof(&sha256_digest, T_LEAF_LEN, 2,
+	    t_data, 2 * T_LEAF_LEN, 1, proof, &prooflen));
+	memset(md, 0, sizeof md);
+	ret &= t_compare_i(-1, merkle_verify(&sha256_digest, 2, md, 2, 2,
+	    proof, sizeof proof, md));
+	return (ret);
+}
+
+
+/***************************************************************************
+ * Boilerplate
+ */
+
+static int
+t_prepare(int argc, char *argv[])
+{
+	static const unsigned int fanouts[] = { 2, 3, 4, 16 };
+	static const size_t lens[] = {
+		0, 1, T_LEAF_LEN, T_LEAF_LEN + 1, 3 * T_LEAF_LEN,
+		4 * T_LEAF_LEN, 5 * T_LEAF_LEN - 3, 9 * T_LEAF_LEN,
+		16 * T_LEAF_LEN + 1, T_MAX_LEAVES * T_LEAF_LEN,
+	};
+	static struct t_shape shapes[sizeof fanouts / sizeof fanouts[0]]
+	    [sizeof lens / sizeof lens[0]];
+	unsigned int i, j, n;
+
+	(void)argc;
+	(void)argv;
+	for (i = 0; i < sizeof t_data; ++i)
+		t_data[i] = t_seq8[i % sizeof t_seq8];
+	n = sizeof t_ct_vectors / sizeof t_ct_vectors[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_merkle_ct_vector, &t_ct_vectors[i],
+		    "%s", t_ct_vectors[i].desc);
+	for (i = 0; i < sizeof fanouts / sizeof fanouts[0]; ++i) {
+		for (j = 0; j < sizeof lens / sizeof lens[0]; ++j) {
+			shapes[i][j].fanout = fanouts[i];
+			shapes[i][j].len = lens[j];
+			t_add_test(t_merkle_shape, &shapes[i][j],
+			    "fan-out %u, %zu bytes", fanouts[i], lens[j]);
+			if (lens[j] > 0)
+				t_add_test(t_merkle_proofs, &shapes[i][j],
+				    "fan-out %u, %zu bytes, proofs",
+				    fanouts[i], lens[j]);
+		}
+	}
+	t_add_test(t_merkle_invalid, NULL, "invalid parameters");
+	return (0);
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	t_main(t_prepare, NULL, argc, argv);
+}
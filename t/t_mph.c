@@ -0,0 +1,302 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cryb/endian.h>
+#include <cryb/hash.h>
+#include <cryb/mph.h>
+
+#include <cryb/test.h>
+
+#define T_MAX_KEYS	1000000
+
+static uint8_t (*t_keys)[8];
+static char (*t_strs)[16];
+static hash_key *t_hkeys;
+static hash_key *t_hstrs;
+static size_t *t_results;
+static uint8_t *t_seen;
+
+/*
+ * Check that every key maps to a distinct index below n, that the
+ * batch interface agrees with the single-key one, and that a function
+ * loaded from a copy of the image gives the same results.
+ */
+static int
+t_mph_check(const mph *f, const hash_key *keys, size_t n)
+{
+	const void *image;
+	void *copy;
+	mph *g;
+	size_t i, idx, len;
+	int ret = 1;
+
+	ret &= t_compare_sz(n, mph_count(f));
+	memset(t_seen, 0, n);
+	mph_lookup_many(f, keys, n, t_results);
+	for (i = 0; i < n && ret; ++i) {
+		idx = mph_lookup(f, keys[i].data, keys[i].len);
+		ret &= t_compare_sz(idx, t_results[i]);
+		if (idx >= n || t_seen[idx]) {
+			t_printv("key %zu maps to %zu\n", i, idx);
+			ret = 0;
+		} else {
+			t_seen[idx] = 1;
+		}
+	}
+	image = mph_image(f, &len);
+	if (n >= 1000)
+		t_printv("%zu keys, %.2f bits per key\n", n,
+		    (double)len * 8 / n);
+	if ((copy = malloc(len)) == NULL)
+		return (0);
+	memcpy(copy, image, len);
+	if ((g = mph_load(copy, len)) == NULL) {
+		t_printv("failed to load image\n");
+		ret = 0;
+	} else {
+		for (i = 0; i < n && ret; ++i)
+			ret &= t_compare_sz(t_results[i],
+			    mph_lookup(g, keys[i].data, keys[i].len));
+		mph_delete(g);
+	}
+	free(copy);
+	return (ret);
+}
+
+static size_t t_mph_sizes[] = {
+	0, 1, 2, 3, 5, 10, 100, 1000, 12345, 100000, T_MAX_KEYS,
+};
+
+static int
+t_mph_build(char **desc CRYB_UNUSED, void *arg)
+{
+	size_t n = *(size_t *)arg;
+	mph *f;
+	int ret = 1;
+
+	if ((f = mph_build(t_hkeys, n, 0)) == NULL)
+		return (0);
+	ret &= t_mph_check(f, t_hkeys, n);
+	mph_delete(f);
+	return (ret);
+}
+
+static int
+t_mph_strings(char **desc CRYB_UNUSED, void *arg)
+{
+	size_t n = *(size_t *)arg;
+	mph *f;
+	int ret = 1;
+
+	if ((f = mph_build(t_hstrs, n, 0x0123456789abcdefULL)) == NULL)
+		return (0);
+	ret &= t_mph_check(f, t_hstrs, n);
+	mph_delete(f);
+	return (ret);
+}
+
+/*
+ * The same keys and seed must always produce the same image, so that
+ * it can be generated at build time.
+ */
+static int
+t_mph_deterministic(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	const void *ia, *ib;
+	mph *a, *b;
+	size_t alen, blen;
+	int ret = 1;
+
+	a = mph_build(t_hkeys, 10000, 42);
+	b = mph_build(t_hkeys, 10000, 42);
+	if (a != NULL && b != NULL) {
+		ia = mph_image(a, &alen);
+		ib = mph_image(b, &blen);
+		ret &= t_compare_sz(alen, blen);
+		if (ret)
+			ret &= t_compare_mem(ia, ib, alen);
+	} else {
+		ret = 0;
+	}
+	mph_delete(b);
+	mph_delete(a);
+	return (ret);
+}
+
+static int
+t_mph_duplicates(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	hash_key keys[100];
+	char dup[sizeof t_strs[0]];
+	int ret = 1;
+
+	memcpy(keys, t_hstrs, sizeof keys);
+	keys[77] = keys[23];
+	ret &= t_is_null(mph_build(keys, 100, 0));
+	ret &= t_compare_i(EINVAL, errno);
+	/* same contents at a different address */
+	memcpy(dup, t_strs[23], sizeof dup);
+	keys[77].data = dup;
+	ret &= t_is_null(mph_build(keys, 100, 0));
+	ret &= t_compare_i(EINVAL, errno);
+	return (ret);
+}
+
+static int
+t_mph_load_errors(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	const void *image;
+	uint8_t *copy;
+	mph *f;
+	size_t len;
+	int ret = 1;
+
+	if ((f = mph_build(t_hkeys, 1000, 0)) == NULL)
+		return (0);
+	image = mph_image(f, &len);
+	if ((copy = malloc(len + 4)) == NULL) {
+		mph_delete(f);
+		return (0);
+	}
+	memcpy(copy, image, len);
+	/* short */
+	ret &= t_is_null(mph_load(copy, 16));
+	ret &= t_compare_i(EINVAL, errno);
+	ret &= t_is_null(mph_load(copy, len - 1));
+	ret &= t_compare_i(EINVAL, errno);
+	/* long */
+	ret &= t_is_null(mph_load(copy, len + 4));
+	ret &= t_compare_i(EINVAL, errno);
+	/* bad magic */
+	copy[0] ^= 1;
+	ret &= t_is_null(mph_load(copy, len));
+	ret &= t_compare_i(EINVAL, errno);
+	copy[0] ^= 1;
+	/* inconsistent count */
+	le32enc(copy + 8, 999);
+	ret &= t_is_null(mph_load(copy, len));
+	ret &= t_compare_i(EINVAL, errno);
+	le32enc(copy + 8, 1000);
+	/* remap entry out of range */
+	le32enc(copy + len - 4, 1000);
+	ret &= t_is_null(mph_load(copy, len));
+	ret &= t_compare_i(EINVAL, errno);
+	memcpy(copy, image, len);
+	mph_delete(f);
+	f = mph_load(copy, len);
+	ret &= t_is_not_null(f);
+	mph_delete(f);
+	free(copy);
+	return (ret);
+}
+
+static int
+t_mph_nomem(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	int ret = 1;
+	int i;
+
+	for (i = 0; i < 9; ++i) {
+		if (i == 0)
+			t_malloc_fail = 1;
+		else
+			t_malloc_fail_after = i;
+		ret &= t_is_null(mph_build(t_hkeys, 1000, 0));
+		ret &= t_compare_i(ENOMEM, errno);
+		t_malloc_fail = 0;
+		t_malloc_fail_after = 0;
+	}
+	ret &= t_is_null(mph_build(t_hkeys, (size_t)MPH_MAX_KEYS + 1, 0));
+	ret &= t_compare_i(EINVAL, errno);
+	return (ret);
+}
+
+static int
+t_prepare(int argc, char *argv[])
+{
+	unsigned int i, n;
+
+	(void)argc;
+	(void)argv;
+	if ((t_keys = calloc(T_MAX_KEYS, sizeof *t_keys)) == NULL ||
+	    (t_strs = calloc(T_MAX_KEYS, sizeof *t_strs)) == NULL ||
+	    (t_hkeys = calloc(T_MAX_KEYS, sizeof *t_hkeys)) == NULL ||
+	    (t_hstrs = calloc(T_MAX_KEYS, sizeof *t_hstrs)) == NULL ||
+	    (t_results = calloc(T_MAX_KEYS, sizeof *t_results)) == NULL ||
+	    (t_seen = calloc(T_MAX_KEYS, 1)) == NULL)
+		return (-1);
+	for (i = 0; i < T_MAX_KEYS; ++i) {
+		le64enc(t_keys[i], (uint64_t)i * 0x9e3779b97f4a7c15ULL);
+		t_hkeys[i].data = t_keys[i];
+		t_hkeys[i].len = sizeof t_keys[i];
+		t_hstrs[i].data = t_strs[i];
+		t_hstrs[i].len = snprintf(t_strs[i], sizeof t_strs[i],
+		    "key%u", i);
+	}
+	n = sizeof t_mph_sizes / sizeof t_mph_sizes[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_mph_build, &t_mph_sizes[i],
+		    "%zu keys", t_mph_sizes[i]);
+	for (i = 0; i < n; ++i)
+		t_add_test(t_mph_strings, &t_mph_sizes[i],
+		    "%zu strings", t_mph_sizes[i]);
+	t_add_test(t_mph_deterministic, NULL, "deterministic");
+	t_add_test(t_mph_duplicates, NULL, "duplicate keys");
+	t_add_test(t_mph_load_errors, NULL, "invalid images");
+	t_add_test(t_mph_nomem, NULL, "errors");
+	return (0);
+}
+
+static void
+t_cleanup(void)
+{
+
+	free(t_seen);
+	free(t_results);
+	free(t_hstrs);
+	free(t_hkeys);
+	free(t_strs);
+	free(t_keys);
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	t_main(t_prepare, t_cleanup, argc, argv);
+}
@@ -208,7 +208,57 @@ static struct t_div_case {
 		{                                                 0x02 },  2, 0,
 		{                                                 0x03 },  2, 0,
 	},
-	/* XXX needs lots more tests! */
+	{
+		"(2^96 - 1) / (2^32 - 1) == 2^64 + 2^32 + 1",              0,
+		{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		  0xff, 0xff, 0xff, 0xff },                               96, 0,
+		{                               0xff, 0xff, 0xff, 0xff }, 32, 0,
+		{ 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01 }, 65, 0,
+		{                                                      },  0, 0,
+	},
+	{
+		"(2^128 - 1) / (2^64 - 1) == 2^64 + 1",                    0,
+		{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff },      128, 0,
+		{       0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }, 64, 0,
+		{ 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 }, 65, 0,
+		{                                                      },  0, 0,
+	},
+	{
+		"single-word divisor with remainder",                      0,
+		{ 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef,
+		  0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10 },      121, 0,
+		{                               0x9e, 0x37, 0x79, 0xb9 }, 32, 0,
+		{ 0x01, 0xd7, 0x49, 0x5b, 0xda, 0x39, 0x81, 0xb7,
+		  0x7c, 0x11, 0x30, 0x10 },                               89, 0,
+		{                               0x7a, 0xc0, 0xe6, 0x80 }, 31, 0,
+	},
+	{
+		"multi-word divisor with remainder",                       0,
+		{ 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef,
+		  0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10 },      121, 0,
+		{ 0x01, 0x23, 0x45, 0x67, 0x89, 0x0a, 0xbc, 0xde, 0xf1 }, 65, 0,
+		{       0x01, 0x00, 0x00, 0x00, 0x00, 0x8d, 0x8f, 0xff }, 57, 0,
+		{ 0x01, 0x20, 0x6a, 0x22, 0x10, 0x78, 0xec, 0x81, 0x01 }, 65, 0,
+	},
+	{
+		"add back (1)",                                            0,
+		{ 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00,
+		  0x00, 0x00, 0x00, 0x00, 0x80, 0x00 },                  112, 0,
+		{ 0x80, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00,
+		  0x7f, 0xff },                                           80, 0,
+		{                               0xff, 0xff, 0x00, 0x00 }, 32, 0,
+		{ 0x80, 0x00, 0x7f, 0xff, 0x80, 0x01, 0x7f, 0xff,
+		  0x80, 0x00 },                                           80, 0,
+	},
+	{
+		"add back (2)",                                            0,
+		{ 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+		  0x00, 0xff, 0xff, 0xff, 0xff },                         97, 0,
+		{ 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01 }, 65, 0,
+		{                               0xff, 0xff, 0xff, 0xff }, 32, 0,
+		{ 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00 }, 65, 0,
+	},
 };
 
 static int
@@ -242,6 +292,167 @@ t_mpi_div_tc(char **desc CRYB_UNUSED, void *arg)
 	return (ret);
 }
 
+/*
+ * Divide pseudo-random numbers of the given sizes and check that
+ * A == Q * B + R and R < B, then repeat with the quotient and
+ * remainder stored in the dividend and divisor.
+ */
+static struct t_div_random_case {
+	unsigned int amsb;
+	unsigned int bmsb;
+} t_div_random_cases[] = {
+	{   64,   32 },
+	{  521,   32 },
+	{ 2048,   33 },
+	{ 2048,   64 },
+	{ 1024, 1000 },
+	{ 2048, 1024 },
+	{ 4096, 2048 },
+	{ 4096, 4095 },
+};
+
+static void
+t_mpi_random(cryb_mpi *x, unsigned int msb, uint64_t *state)
+{
+	uint8_t buf[2048];
+	size_t i, len;
+
+	len = (msb + 7) / 8;
+	for (i = 0; i < len; ++i) {
+		*state ^= *state << 13;
+		*state ^= *state >> 7;
+		*state ^= *state << 17;
+		buf[i] = *state >> 56;
+	}
+	/* set the top bit and clear those above it */
+	buf[0] &= 0xff >> (len * 8 - msb);
+	buf[0] |= 0x80 >> (len * 8 - msb);
+	mpi_load(x, buf, len);
+}
+
+static int
+t_mpi_div_random(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_div_random_case *tc = arg;
+	cryb_mpi a = CRYB_MPI_ZERO, b = CRYB_MPI_ZERO;
+	cryb_mpi q = CRYB_MPI_ZERO, r = CRYB_MPI_ZERO, x = CRYB_MPI_ZERO;
+	uint64_t state;
+	unsigned int i;
+	int ret = 1;
+
+	state = 0x0123456789abcdefULL ^ (uint64_t)tc->amsb << 16 ^ tc->bmsb;
+	for (i = 0; i < 32 && ret; ++i) {
+		t_mpi_random(&a, tc->amsb, &state);
+		t_mpi_random(&b, tc->bmsb - i % 8, &state);
+		ret &= t_is_zero_i(mpi_div_abs(&q, &r, &a, &b));
+		ret &= t_compare_i(-1, mpi_cmp_abs(&r, &b));
+		ret &= t_is_zero_i(mpi_mul_abs(&x, &q, &b));
+		ret &= t_is_zero_i(mpi_add_abs(&x, &x, &r));
+		ret &= t_compare_mpi(&a, &x);
+		/* in place */
+		ret &= t_is_zero_i(mpi_div_abs(&a, &b, &a, &b));
+		ret &= t_compare_mpi(&q, &a);
+		ret &= t_compare_mpi(&r, &b);
+	}
+	mpi_destroy(&a);
+	mpi_destroy(&b);
+	mpi_destroy(&q);
+	mpi_destroy(&r);
+	mpi_destroy(&x);
+	return (ret);
+}
+
+
+
+/***************************************************************************
+ * Multiplication of large numbers
+ */
+
+/*
+ * Multiply pseudo-random numbers of sizes chosen to exercise the
+ * Karatsuba and Toom-3 code paths as well as unbalanced operands, and
+ * check the product by dividing it by each of the factors.
+ */
+static struct t_mul_random_case {
+	unsigned int amsb;
+	unsigned int bmsb;
+} t_mul_random_cases[] = {
+	{  1024,  1024 },
+	{  1056,  1024 },
+	{  2048,  2016 },
+	{  3000,  3000 },
+	{  4096,  4096 },
+	{  4127,  4127 },
+	{  8192,  8192 },
+	{ 12345, 12000 },
+	{  8192,  1024 },
+	{  9000,  1500 },
+	{  4096,   992 },
+};
+
+static int
+t_mpi_mul_random(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_mul_random_case *tc = arg;
+	cryb_mpi a = CRYB_MPI_ZERO, b = CRYB_MPI_ZERO, x = CRYB_MPI_ZERO;
+	cryb_mpi q = CRYB_MPI_ZERO, r = CRYB_MPI_ZERO, y = CRYB_MPI_ZERO;
+	uint64_t state;
+	unsigned int i;
+	int ret = 1;
+
+	state = 0xfedcba9876543210ULL ^ (uint64_t)tc->amsb << 16 ^ tc->bmsb;
+	for (i = 0; i < 8 && ret; ++i) {
+		t_mpi_random(&a, tc->amsb - i % 4, &state);
+		t_mpi_random(&b, tc->bmsb, &state);
+		ret &= t_is_zero_i(mpi_mul_abs(&x, &a, &b));
+		ret &= t_is_zero_i(mpi_div_abs(&q, &r, &x, &a));
+		ret &= t_compare_mpi(&b, &q);
+		ret &= t_is_zero_i(r.msb);
+		ret &= t_is_zero_i(mpi_div_abs(&q, &r, &x, &b));
+		ret &= t_compare_mpi(&a, &q);
+		ret &= t_is_zero_i(r.msb);
+		/* commuted and in place */
+		ret &= t_is_zero_i(mpi_copy(&y, &b));
+		ret &= t_is_zero_i(mpi_mul_abs(&y, &y, &a));
+		ret &= t_compare_mpi(&x, &y);
+		/* square */
+		ret &= t_is_zero_i(mpi_mul_abs(&x, &a, &a));
+		ret &= t_is_zero_i(mpi_div_abs(&q, &r, &x, &a));
+		ret &= t_compare_mpi(&a, &q);
+		ret &= t_is_zero_i(r.msb);
+	}
+	mpi_destroy(&a);
+	mpi_destroy(&b);
+	mpi_destroy(&q);
+	mpi_destroy(&r);
+	mpi_destroy(&x);
+	mpi_destroy(&y);
+	return (ret);
+}
+
+/*
+ * Verify that a failure to allocate scratch space is reported.
+ */
+static int
+t_mpi_mul_fail(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	cryb_mpi a = CRYB_MPI_ZERO, b = CRYB_MPI_ZERO, x = CRYB_MPI_ZERO;
+	uint64_t state = 1;
+	int ret = 1;
+
+	t_mpi_random(&a, 4096, &state);
+	t_mpi_random(&b, 4096, &state);
+	ret &= t_is_zero_i(mpi_grow(&x, 8192));
+	t_malloc_fail = 1;
+	ret &= t_compare_i(-1, mpi_mul_abs(&x, &a, &b));
+	t_malloc_fail = 0;
+	ret &= t_is_zero_i(mpi_mul_abs(&a, &a, &b));
+	mpi_destroy(&a);
+	mpi_destroy(&b);
+	mpi_destroy(&x);
+	return (ret);
+}
+
 
 /***************************************************************************
  * Boilerplate
@@ -266,6 +477,19 @@ t_prepare(int argc, char *argv[])
 	for (i = 0; i < sizeof t_div_cases / sizeof t_div_cases[0]; ++i)
 		t_add_test(t_mpi_div_tc, &t_div_cases[i],
 		    "%s", t_div_cases[i].desc);
+	for (i = 0; i < sizeof t_div_random_cases /
+		 sizeof t_div_random_cases[0]; ++i)
+		t_add_test(t_mpi_div_random, &t_div_random_cases[i],
+		    "random %u / %u", t_div_random_cases[i].amsb,
+		    t_div_random_cases[i].bmsb);
+
+	/* multiplication of large numbers */
+	for (i = 0; i < sizeof t_mul_random_cases /
+		 sizeof t_mul_random_cases[0]; ++i)
+		t_add_test(t_mpi_mul_random, &t_mul_random_cases[i],
+		    "random %u * %u", t_mul_random_cases[i].amsb,
+		    t_mul_random_cases[i].bmsb);
+	t_add_test(t_mpi_mul_fail, NULL, "allocation failure");
 
 	return (0);
 }
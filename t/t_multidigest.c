@@ -0,0 +1,187 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cryb/md5.h>
+#include <cryb/sha1.h>
+#include <cryb/sha256.h>
+#include <cryb/sha512.h>
+#include <cryb/multidigest.h>
+
+#include <cryb/test.h>
+
+static const digest_algorithm *t_algs[] = {
+	&md5_digest, &sha1_digest, &sha256_digest, &sha512_digest,
+};
+#define T_NALGS (sizeof t_algs / sizeof t_algs[0])
+
+/*
+ * Known answers for "abc"
+ */
+static const uint8_t t_abc_md5[MD5_DIGEST_LEN] = {
+	0x90, 0x01, 0x50, 0x98, 0x3c, 0xd2, 0x4f, 0xb0,
+	0xd6, 0x96, 0x3f, 0x7d, 0x28, 0xe1, 0x7f, 0x72,
+};
+static const uint8_t t_abc_sha1[SHA1_DIGEST_LEN] = {
+	0xa9, 0x99, 0x3e, 0x36, 0x47, 0x06, 0x81, 0x6a,
+	0xba, 0x3e, 0x25, 0x71, 0x78, 0x50, 0xc2, 0x6c,
+	0x9c, 0xd0, 0xd8, 0x9d,
+};
+static const uint8_t t_abc_sha256[SHA256_DIGEST_LEN] = {
+	0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea,
+	0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+	0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c,
+	0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad,
+};
+
+static int
+t_multidigest_abc(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	uint8_t md5[MD5_DIGEST_LEN], sha1[SHA1_DIGEST_LEN];
+	uint8_t sha256[SHA256_DIGEST_LEN];
+	uint8_t *md[] = { md5, sha1, sha256 };
+	int ret = 1;
+
+	ret &= t_is_zero_i(multidigest_complete(t_algs, 3, "abc", 3, md));
+	ret &= t_compare_mem(t_abc_md5, md5, sizeof md5);
+	ret &= t_compare_mem(t_abc_sha1, sha1, sizeof sha1);
+	ret &= t_compare_mem(t_abc_sha256, sha256, sizeof sha256);
+	return (ret);
+}
+
+/*
+ * Compare against each algorithm's own one-shot function, feeding the
+ * message in pieces of the given size.
+ */
+struct t_case {
+	const char *desc;
+	size_t len;
+	size_t step;
+};
+
+static struct t_case t_cases[] = {
+	{ "empty",				0,	1 },
+	{ "one block",				64,	64 },
+	{ "long, one call",			100000,	100000 },
+	{ "long, odd pieces",			100000,	4999 },
+	{ "long, pieces larger than chunk",	100000,	33333 },
+	{ "long, byte by byte",			20000,	1 },
+};
+
+static uint8_t *t_buf;
+
+static int
+t_multidigest_cmp(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_case *tc = arg;
+	uint8_t mdbuf[T_NALGS][DIGEST_MAX_DIGEST_LEN];
+	uint8_t emd[DIGEST_MAX_DIGEST_LEN];
+	uint8_t *md[T_NALGS];
+	multidigest_ctx ctx;
+	size_t i, n;
+	int ret = 1;
+
+	for (i = 0; i < T_NALGS; ++i)
+		md[i] = mdbuf[i];
+	if (!t_is_zero_i(multidigest_init(&ctx, t_algs, T_NALGS)))
+		return (0);
+	for (i = 0; i < tc->len; i += n) {
+		n = tc->len - i < tc->step ? tc->len - i : tc->step;
+		multidigest_update(&ctx, t_buf + i, n);
+	}
+	multidigest_final(&ctx, md);
+	for (i = 0; i < T_NALGS; ++i) {
+		digest_complete(t_algs[i], t_buf, tc->len, emd);
+		ret &= t_compare_mem(emd, md[i], t_algs[i]->digestlen);
+	}
+	return (ret);
+}
+
+static int
+t_multidigest_invalid(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	const digest_algorithm *algs[MULTIDIGEST_MAX_ALGS + 1];
+	multidigest_ctx ctx;
+	unsigned int i;
+	int ret = 1;
+
+	for (i = 0; i < MULTIDIGEST_MAX_ALGS + 1; ++i)
+		algs[i] = &sha256_digest;
+	ret &= t_compare_i(-1, multidigest_init(&ctx, algs, 0));
+	ret &= t_compare_i(EINVAL, errno);
+	ret &= t_compare_i(-1,
+	    multidigest_init(&ctx, algs, MULTIDIGEST_MAX_ALGS + 1));
+	ret &= t_compare_i(EINVAL, errno);
+	ret &= t_is_zero_i(multidigest_init(&ctx, algs, MULTIDIGEST_MAX_ALGS));
+	return (ret);
+}
+
+
+/***************************************************************************
+ * Boilerplate
+ */
+
+static int
+t_prepare(int argc, char *argv[])
+{
+	unsigned int i, n;
+
+	(void)argc;
+	(void)argv;
+	if ((t_buf = malloc(100000)) == NULL)
+		return (-1);
+	for (i = 0; i < 100000; ++i)
+		t_buf[i] = t_seq8[i % sizeof t_seq8] ^ (i >> 8);
+	t_add_test(t_multidigest_abc, NULL, "abc");
+	n = sizeof t_cases / sizeof t_cases[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_multidigest_cmp, &t_cases[i], "%s", t_cases[i].desc);
+	t_add_test(t_multidigest_invalid, NULL, "invalid parameters");
+	return (0);
+}
+
+static void
+t_cleanup(void)
+{
+
+	free(t_buf);
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	t_main(t_prepare, t_cleanup, argc, argv);
+}
@@ -0,0 +1,563 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <cryb/endian.h>
+#include <cryb/hash.h>
+
+#include <cryb/test.h>
+
+struct t_case {
+	const char *desc;
+	size_t len;
+	uint32_t seed;
+	const char *hash;
+};
+
+static const char t_data[] = "The quick brown fox jumps over the lazy dog";
+
+/***************************************************************************
+ * Test cases
+ */
+static struct t_case t_x86_cases[] = {
+	{
+		.desc	= "00000000 0 bytes",
+		.len	= 0,
+		.seed	= 0x00000000,
+		.hash	= "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00",
+	},
+	{
+		.desc	= "ffffffff 0 bytes",
+		.len	= 0,
+		.seed	= 0xffffffff,
+		.hash	= "\xa9\x08\x1e\x05\xf7\x49\x9d\x98"
+			  "\xf7\x49\x9d\x98\xf7\x49\x9d\x98",
+	},
+	{
+		.desc	= "00000000 1 bytes",
+		.len	= 1,
+		.seed	= 0x00000000,
+		.hash	= "\xd4\x58\x26\x31\x11\xba\x2c\xd3"
+			  "\x11\xba\x2c\xd3\x11\xba\x2c\xd3",
+	},
+	{
+		.desc	= "ffffffff 1 bytes",
+		.len	= 1,
+		.seed	= 0xffffffff,
+		.hash	= "\x4f\x17\x44\x2e\x94\xec\x23\x1f"
+			  "\x94\xec\x23\x1f\x94\xec\x23\x1f",
+	},
+	{
+		.desc	= "00000000 3 bytes",
+		.len	= 3,
+		.seed	= 0x00000000,
+		.hash	= "\x79\xbf\xd0\x41\x5e\xe8\x7b\xd2"
+			  "\x5e\xe8\x7b\xd2\x5e\xe8\x7b\xd2",
+	},
+	{
+		.desc	= "ffffffff 3 bytes",
+		.len	= 3,
+		.seed	= 0xffffffff,
+		.hash	= "\x02\x99\xe8\x7e\xd8\x04\x54\xdd"
+			  "\xd8\x04\x54\xdd\xd8\x04\x54\xdd",
+	},
+	{
+		.desc	= "00000000 4 bytes",
+		.len	= 4,
+		.seed	= 0x00000000,
+		.hash	= "\x65\x1e\x25\x00\xa2\x1e\x6e\xaa"
+			  "\xa2\x1e\x6e\xaa\xa2\x1e\x6e\xaa",
+	},
+	{
+		.desc	= "ffffffff 4 bytes",
+		.len	= 4,
+		.seed	= 0xffffffff,
+		.hash	= "\xa0\x7f\x98\x07\x50\x45\x4b\xcd"
+			  "\x50\x45\x4b\xcd\x50\x45\x4b\xcd",
+	},
+	{
+		.desc	= "00000000 7 bytes",
+		.len	= 7,
+		.seed	= 0x00000000,
+		.hash	= "\x3b\x76\x9f\xa0\x9c\x7f\x52\x35"
+			  "\x6e\x97\xf6\xdd\x6e\x97\xf6\xdd",
+	},
+	{
+		.desc	= "ffffffff 7 bytes",
+		.len	= 7,
+		.seed	= 0xffffffff,
+		.hash	= "\x6f\x2b\xa0\xf3\xac\xe3\x4f\xaf"
+			  "\xa7\xd1\x14\x2d\xa7\xd1\x14\x2d",
+	},
+	{
+		.desc	= "00000000 8 bytes",
+		.len	= 8,
+		.seed	= 0x00000000,
+		.hash	= "\x0a\xc8\xb6\x66\x6d\x1f\x6f\xc9"
+			  "\x80\x09\x8a\x6d\x80\x09\x8a\x6d",
+	},
+	{
+		.desc	= "ffffffff 8 bytes",
+		.len	= 8,
+		.seed	= 0xffffffff,
+		.hash	= "\x93\xe3\x86\x1e\x22\x1d\x73\x90"
+			  "\x91\xdc\x43\x28\x91\xdc\x43\x28",
+	},
+	{
+		.desc	= "00000000 9 bytes",
+		.len	= 9,
+		.seed	= 0x00000000,
+		.hash	= "\x73\xd6\xc5\xba\xf3\xcf\xc4\xcb"
+			  "\x09\x8d\xb6\xde\x8f\x52\xc8\x69",
+	},
+	{
+		.desc	= "ffffffff 9 bytes",
+		.len	= 9,
+		.seed	= 0xffffffff,
+		.hash	= "\x17\xd2\x90\xb7\xba\x7e\x1b\xcc"
+			  "\x48\xcc\x32\xee\x4a\x29\xf6\x63",
+	},
+	{
+		.desc	= "00000000 12 bytes",
+		.len	= 12,
+		.seed	= 0x00000000,
+		.hash	= "\x5f\x76\x28\xc6\xa8\x98\x43\x4e"
+			  "\x5e\xdf\xb5\xeb\x22\xe2\x59\x5b",
+	},
+	{
+		.desc	= "ffffffff 12 bytes",
+		.len	= 12,
+		.seed	= 0xffffffff,
+		.hash	= "\x82\xbb\xe9\x61\x6a\xa3\x6b\xb9"
+			  "\x15\x7d\x10\x0d\x30\x71\x95\xfd",
+	},
+	{
+		.desc	= "00000000 15 bytes",
+		.len	= 15,
+		.seed	= 0x00000000,
+		.hash	= "\xcf\x56\xd3\xca\x93\xe4\xdb\xeb"
+			  "\x22\xcb\x9f\x5f\x86\xa2\xc8\x2c",
+	},
+	{
+		.desc	= "ffffffff 15 bytes",
+		.len	= 15,
+		.seed	= 0xffffffff,
+		.hash	= "\x09\xd7\xff\xdd\x4e\x37\x61\x8a"
+			  "\x8e\x24\xd3\xfc\x34\x88\x69\x2c",
+	},
+	{
+		.desc	= "00000000 16 bytes",
+		.len	= 16,
+		.seed	= 0x00000000,
+		.hash	= "\x98\x2e\xaf\x05\x00\x9f\xdc\x85"
+			  "\x93\x0e\x56\x7a\x2a\xcf\x05\x10",
+	},
+	{
+		.desc	= "ffffffff 16 bytes",
+		.len	= 16,
+		.seed	= 0xffffffff,
+		.hash	= "\x33\xcd\xc9\xde\xbc\x4b\xa9\xb5"
+			  "\x2c\x88\x22\x07\x9b\x36\x5a\x27",
+	},
+	{
+		.desc	= "00000000 17 bytes",
+		.len	= 17,
+		.seed	= 0x00000000,
+		.hash	= "\xc3\x57\x50\x31\xa3\x3c\xc1\x66"
+			  "\x41\x69\x8c\x82\x39\x76\x70\xb7",
+	},
+	{
+		.desc	= "ffffffff 17 bytes",
+		.len	= 17,
+		.seed	= 0xffffffff,
+		.hash	= "\x50\x97\xb4\x4a\xdb\xfe\x64\x39"
+			  "\x92\xf6\xce\xe0\x53\x58\xb5\x9e",
+	},
+	{
+		.desc	= "00000000 31 bytes",
+		.len	= 31,
+		.seed	= 0x00000000,
+		.hash	= "\xdd\xd6\x56\x97\x89\x81\xee\x03"
+			  "\x6e\xf5\xd1\xb6\xf6\x27\xa8\x23",
+	},
+	{
+		.desc	= "ffffffff 31 bytes",
+		.len	= 31,
+		.seed	= 0xffffffff,
+		.hash	= "\xfd\xf9\x19\xe5\x8b\x8c\xfd\x62"
+			  "\x8f\x3a\xf9\x9a\x9a\x61\x0e\xe1",
+	},
+	{
+		.desc	= "00000000 32 bytes",
+		.len	= 32,
+		.seed	= 0x00000000,
+		.hash	= "\xad\x8a\xc7\x7f\x02\x72\x53\x2d"
+			  "\x2c\x76\x2e\x10\xc1\xf0\x3e\x39",
+	},
+	{
+		.desc	= "ffffffff 32 bytes",
+		.len	= 32,
+		.seed	= 0xffffffff,
+		.hash	= "\x92\xd9\xb4\x02\xcb\xa8\xe6\xd7"
+			  "\x18\xec\x6c\xf4\xe2\xcc\xc0\x94",
+	},
+	{
+		.desc	= "00000000 43 bytes",
+		.len	= 43,
+		.seed	= 0x00000000,
+		.hash	= "\xc3\x83\x15\x2f\x67\x2c\xee\xec"
+			  "\x6c\xf6\x7b\x5d\x2c\x1d\xe9\xe5",
+	},
+	{
+		.desc	= "ffffffff 43 bytes",
+		.len	= 43,
+		.seed	= 0xffffffff,
+		.hash	= "\x8a\xc6\xf8\x79\x2d\xae\x2c\x07"
+			  "\x46\x4a\x07\xda\xe4\xdb\xc7\xc7",
+	},
+};
+
+static struct t_case t_x64_cases[] = {
+	{
+		.desc	= "00000000 0 bytes",
+		.len	= 0,
+		.seed	= 0x00000000,
+		.hash	= "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00",
+	},
+	{
+		.desc	= "ffffffff 0 bytes",
+		.len	= 0,
+		.seed	= 0xffffffff,
+		.hash	= "\xec\xc9\x3b\x9d\x4d\xdf\xf1\x6a"
+			  "\x6b\x44\xe6\x1e\x12\x21\x74\x85",
+	},
+	{
+		.desc	= "00000000 1 bytes",
+		.len	= 1,
+		.seed	= 0x00000000,
+		.hash	= "\x9a\x68\x84\x91\x7e\x77\x03\x8c"
+			  "\x79\x3e\x29\xba\xb4\xd6\xb5\x3a",
+	},
+	{
+		.desc	= "ffffffff 1 bytes",
+		.len	= 1,
+		.seed	= 0xffffffff,
+		.hash	= "\x93\xb6\x32\xe8\x1b\xb6\x3d\x53"
+			  "\x64\xb8\xf3\x8b\xb4\xae\x5c\xa3",
+	},
+	{
+		.desc	= "00000000 3 bytes",
+		.len	= 3,
+		.seed	= 0x00000000,
+		.hash	= "\x9a\x6d\xd6\xdc\x52\x26\x4f\x30"
+			  "\x42\xbf\xea\x15\x5d\x5e\x38\xef",
+	},
+	{
+		.desc	= "ffffffff 3 bytes",
+		.len	= 3,
+		.seed	= 0xffffffff,
+		.hash	= "\x40\x37\x73\x8a\xe5\xf8\x07\xa7"
+			  "\x0b\xb9\xdf\x0e\xfd\xec\xb3\xa9",
+	},
+	{
+		.desc	= "00000000 4 bytes",
+		.len	= 4,
+		.seed	= 0x00000000,
+		.hash	= "\x9c\x7d\xa0\xab\xbe\x01\x43\xbd"
+			  "\x1c\xdd\x26\x80\x4b\x3c\xae\xdf",
+	},
+	{
+		.desc	= "ffffffff 4 bytes",
+		.len	= 4,
+		.seed	= 0xffffffff,
+		.hash	= "\x7c\x66\x18\x31\x54\xe8\x77\xba"
+			  "\xb6\x8b\x5f\x15\x07\xd8\xe9\xc2",
+	},
+	{
+		.desc	= "00000000 7 bytes",
+		.len	= 7,
+		.seed	= 0x00000000,
+		.hash	= "\xc9\xd5\xbc\x5a\x3a\x84\xd3\xf0"
+			  "\x73\x60\x6d\xc8\xf9\xb7\x94\x93",
+	},
+	{
+		.desc	= "ffffffff 7 bytes",
+		.len	= 7,
+		.seed	= 0xffffffff,
+		.hash	= "\xea\x9c\xd2\xe1\x61\x29\x04\x31"
+			  "\xba\x49\x40\xff\x22\xed\x75\x73",
+	},
+	{
+		.desc	= "00000000 8 bytes",
+		.len	= 8,
+		.seed	= 0x00000000,
+		.hash	= "\xcd\x71\x5b\xad\xe4\xaa\x4b\x64"
+			  "\xdf\x1c\x88\xe2\x97\xf9\xee\x8e",
+	},
+	{
+		.desc	= "ffffffff 8 bytes",
+		.len	= 8,
+		.seed	= 0xffffffff,
+		.hash	= "\xa5\xff\xdc\x68\x99\x6c\x62\x5e"
+			  "\x08\xcc\x86\x30\x47\x73\xa8\xbc",
+	},
+	{
+		.desc	= "00000000 9 bytes",
+		.len	= 9,
+		.seed	= 0x00000000,
+		.hash	= "\x55\xf1\xa8\xb2\x04\x64\xa0\x37"
+			  "\xc0\xcc\x6e\x3d\xff\xc8\xbc\xad",
+	},
+	{
+		.desc	= "ffffffff 9 bytes",
+		.len	= 9,
+		.seed	= 0xffffffff,
+		.hash	= "\x63\xe0\x5c\x1c\x4f\x70\xd6\x53"
+			  "\x2c\x47\x47\x88\x83\x30\xb9\xf7",
+	},
+	{
+		.desc	= "00000000 12 bytes",
+		.len	= 12,
+		.seed	= 0x00000000,
+		.hash	= "\xcb\xf9\x90\x2f\x37\xa1\xd6\x61"
+			  "\x29\x25\x00\x7c\xea\x53\x63\xb6",
+	},
+	{
+		.desc	= "ffffffff 12 bytes",
+		.len	= 12,
+		.seed	= 0xffffffff,
+		.hash	= "\x8a\xf1\xd3\xc5\x51\x23\xce\xa0"
+			  "\xe4\xe3\x2c\xf9\x29\x84\xe4\x8c",
+	},
+	{
+		.desc	= "00000000 15 bytes",
+		.len	= 15,
+		.seed	= 0x00000000,
+		.hash	= "\x16\x92\xe3\x64\xb8\x7c\x13\x48"
+			  "\x4b\xd6\x7a\x39\x64\xaf\x7b\xfd",
+	},
+	{
+		.desc	= "ffffffff 15 bytes",
+		.len	= 15,
+		.seed	= 0xffffffff,
+		.hash	= "\xcf\x54\xff\xfa\x30\x23\xe2\x21"
+			  "\x0e\x22\x81\x21\x03\xb6\x3e\x3e",
+	},
+	{
+		.desc	= "00000000 16 bytes",
+		.len	= 16,
+		.seed	= 0x00000000,
+		.hash	= "\xc4\x32\x9b\xaf\xf4\x44\x12\x9d"
+			  "\xa6\x3a\x2a\x2c\x8b\x3c\x15\x3d",
+	},
+	{
+		.desc	= "ffffffff 16 bytes",
+		.len	= 16,
+		.seed	= 0xffffffff,
+		.hash	= "\xe8\x15\xc4\xd7\xdb\xb6\x6d\x19"
+			  "\x61\xe1\x76\xcc\x47\xea\xb0\x3b",
+	},
+	{
+		.desc	= "00000000 17 bytes",
+		.len	= 17,
+		.seed	= 0x00000000,
+		.hash	= "\xae\xe9\x57\xe7\x76\x63\xf9\x91"
+			  "\x0c\xeb\x83\xae\x8d\xe5\x44\x9b",
+	},
+	{
+		.desc	= "ffffffff 17 bytes",
+		.len	= 17,
+		.seed	= 0xffffffff,
+		.hash	= "\x1d\x7b\xac\x01\xe7\x86\xdd\xa0"
+			  "\x81\x35\xe0\xc4\xbc\x5c\x82\xcf",
+	},
+	{
+		.desc	= "00000000 31 bytes",
+		.len	= 31,
+		.seed	= 0x00000000,
+		.hash	= "\x09\xc5\xc4\xd9\xdd\xb5\x28\x9b"
+			  "\x64\xf9\xe2\x0f\xb8\x1c\x3c\x0d",
+	},
+	{
+		.desc	= "ffffffff 31 bytes",
+		.len	= 31,
+		.seed	= 0xffffffff,
+		.hash	= "\x1b\x10\x16\x62\xb4\x19\xfd\x2b"
+			  "\x40\x64\xd9\xbc\xb8\x81\x02\x3c",
+	},
+	{
+		.desc	= "00000000 32 bytes",
+		.len	= 32,
+		.seed	= 0x00000000,
+		.hash	= "\xcf\xda\x9b\xb2\x1b\xf9\x6a\xdf"
+			  "\xa6\xf3\xf1\x8d\xc5\x41\xa3\x91",
+	},
+	{
+		.desc	= "ffffffff 32 bytes",
+		.len	= 32,
+		.seed	= 0xffffffff,
+		.hash	= "\x51\x01\x2f\x27\x15\x63\xbd\x09"
+			  "\x6e\x81\x10\xa1\xc1\xf2\xca\xf0",
+	},
+	{
+		.desc	= "00000000 43 bytes",
+		.len	= 43,
+		.seed	= 0x00000000,
+		.hash	= "\x6c\x1b\x07\xbc\x7b\xbc\x4b\xe3"
+			  "\x47\x93\x9a\xc4\xa9\x3c\x43\x7a",
+	},
+	{
+		.desc	= "ffffffff 43 bytes",
+		.len	= 43,
+		.seed	= 0xffffffff,
+		.hash	= "\x8a\xa1\x00\xa8\x73\x1d\x1c\x69"
+			  "\x12\xb4\x40\x64\x09\x67\x7d\x64",
+	},
+};
+
+/***************************************************************************
+ * Test functions
+ */
+static int
+t_murmur3_x86_128(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_case *t = arg;
+	uint8_t hash[MURMUR3_128_HASH_LEN];
+
+	murmur3_x86_128_hash(t_data, t->len, t->seed, hash);
+	return (t_compare_mem(t->hash, hash, sizeof hash));
+}
+
+static int
+t_murmur3_x64_128(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_case *t = arg;
+	uint8_t hash[MURMUR3_128_HASH_LEN];
+
+	murmur3_x64_128_hash(t_data, t->len, t->seed, hash);
+	return (t_compare_mem(t->hash, hash, sizeof hash));
+}
+
+/*
+ * The verification test from the reference implementation: hash keys
+ * of the form { 0, 1, ..., n - 1 } with seed 256 - n for n from 0 to
+ * 255, then hash the concatenated results with seed 0.  The first four
+ * bytes of the final hash, read as a little-endian integer, must match
+ * the published verification value.
+ */
+struct t_verify_case {
+	const char *desc;
+	void (*func)(const void *, size_t, uint32_t, uint8_t *);
+	uint32_t verification;
+};
+
+static struct t_verify_case t_verify_cases[] = {
+	{ "x86_128 verification", murmur3_x86_128_hash, 0xb3ece62a },
+	{ "x64_128 verification", murmur3_x64_128_hash, 0x6384ba69 },
+};
+
+static int
+t_murmur3_128_verify(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_verify_case *t = arg;
+	uint8_t hashes[256 * MURMUR3_128_HASH_LEN];
+	uint8_t hash[MURMUR3_128_HASH_LEN];
+	unsigned int i;
+
+	for (i = 0; i < 256; ++i)
+		t->func(t_seq8, i, 256 - i, hashes + i * MURMUR3_128_HASH_LEN);
+	t->func(hashes, sizeof hashes, 0, hash);
+	return (t_compare_x32(t->verification, le32dec(hash)));
+}
+
+/*
+ * Verify that the result does not depend on the alignment of the input.
+ */
+static int
+t_murmur3_128_unaligned(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	uint8_t buf[sizeof t_data + 8];
+	uint8_t e86[MURMUR3_128_HASH_LEN], e64[MURMUR3_128_HASH_LEN];
+	uint8_t hash[MURMUR3_128_HASH_LEN];
+	unsigned int i;
+	int ret = 1;
+
+	murmur3_x86_128_hash(t_data, sizeof t_data, 0, e86);
+	murmur3_x64_128_hash(t_data, sizeof t_data, 0, e64);
+	for (i = 1; i < 8; ++i) {
+		memcpy(buf + i, t_data, sizeof t_data);
+		murmur3_x86_128_hash(buf + i, sizeof t_data, 0, hash);
+		ret &= t_compare_mem(e86, hash, sizeof hash);
+		murmur3_x64_128_hash(buf + i, sizeof t_data, 0, hash);
+		ret &= t_compare_mem(e64, hash, sizeof hash);
+	}
+	return (ret);
+}
+
+
+/***************************************************************************
+ * Boilerplate
+ */
+
+static int
+t_prepare(int argc, char *argv[])
+{
+	int i, n;
+
+	(void)argc;
+	(void)argv;
+	n = sizeof t_x86_cases / sizeof t_x86_cases[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_murmur3_x86_128, &t_x86_cases[i],
+		    "x86_128 %s", t_x86_cases[i].desc);
+	n = sizeof t_x64_cases / sizeof t_x64_cases[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_murmur3_x64_128, &t_x64_cases[i],
+		    "x64_128 %s", t_x64_cases[i].desc);
+	n = sizeof t_verify_cases / sizeof t_verify_cases[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_murmur3_128_verify, &t_verify_cases[i],
+		    "%s", t_verify_cases[i].desc);
+	t_add_test(t_murmur3_128_unaligned, NULL, "unaligned input");
+	return (0);
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	t_main(t_prepare, NULL, argc, argv);
+}
@@ -33,6 +33,7 @@
 #include <string.h>
 #include <unistd.h>
 
+#include <cryb/endian.h>
 #include <cryb/hash.h>
 
 #include <cryb/test.h>
@@ -190,6 +191,68 @@ t_murmur3_32(char **desc CRYB_UNUSED, void *arg)
 	return (t_compare_x32(t->hash, hash));
 }
 
+/*
+ * The verification test from the reference implementation; see
+ * t_murmur3_128.c for a description.
+ */
+static int
+t_murmur3_32_verify(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	uint8_t hashes[256 * 4];
+	unsigned int i;
+
+	for (i = 0; i < 256; ++i)
+		le32enc(hashes + i * 4, murmur3_32_hash(t_seq8, i, 256 - i));
+	return (t_compare_x32(0xb0f57ee3,
+	    murmur3_32_hash(hashes, sizeof hashes, 0)));
+}
+
+/*
+ * Hash batches of keys of assorted lengths and alignments and compare
+ * with hashing them one at a time; see t_fnv.c.
+ */
+#define T_MANY_NKEYS	37
+
+static int
+t_murmur3_32_many(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	hash_key keys[T_MANY_NKEYS];
+	uint32_t h[T_MANY_NKEYS];
+	size_t i, n;
+	int ret = 1;
+
+	for (i = 0; i < T_MANY_NKEYS; ++i) {
+		keys[i].data = t_seq8 + i;
+		keys[i].len = (i * 29) % 71;
+	}
+	for (n = 0; n <= T_MANY_NKEYS; ++n) {
+		murmur3_32_hash_many(keys, n, 0x5eed, h);
+		for (i = 0; i < n; ++i)
+			ret &= t_compare_x32(murmur3_32_hash(keys[i].data,
+			    keys[i].len, 0x5eed), h[i]);
+	}
+	return (ret);
+}
+
+/*
+ * Verify that the result does not depend on the alignment of the input.
+ */
+static int
+t_murmur3_32_unaligned(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	uint8_t buf[64 + 4];
+	uint32_t hash;
+	unsigned int i;
+	int ret = 1;
+
+	hash = murmur3_32_hash(t_seq8, 63, 0);
+	for (i = 1; i < 4; ++i) {
+		memcpy(buf + i, t_seq8, 63);
+		ret &= t_compare_x32(hash, murmur3_32_hash(buf + i, 63, 0));
+	}
+	return (ret);
+}
+
 
 /***************************************************************************
  * Boilerplate
@@ -205,6 +268,9 @@ t_prepare(int argc, char *argv[])
 	n = sizeof t_cases / sizeof t_cases[0];
 	for (i = 0; i < n; ++i)
 		t_add_test(t_murmur3_32, &t_cases[i], "%s", t_cases[i].desc);
+	t_add_test(t_murmur3_32_verify, NULL, "verification");
+	t_add_test(t_murmur3_32_unaligned, NULL, "unaligned input");
+	t_add_test(t_murmur3_32_many, NULL, "batch");
 	return (0);
 }
 
@@ -0,0 +1,298 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <cryb/digest.h>
+#include <cryb/pbkdf2.h>
+
+#include <cryb/test.h>
+
+/*
+ * Test vectors from RFC 6070 for SHA-1, and computed with an independent
+ * implementation for the others.
+ */
+static struct t_vector {
+	const char *desc;
+	const char *digest;
+	const char *password;
+	size_t pwlen;
+	const char *salt;
+	size_t saltlen;
+	unsigned int iterations;
+	size_t dklen;
+	const uint8_t dk[100];
+} t_pbkdf2_vectors[] = {
+	{
+		"RFC 6070 test case 1",
+		"sha1",
+		"password", 8,
+		"salt", 4,
+		1,
+		20,
+		{
+			0x0c, 0x60, 0xc8, 0x0f, 0x96, 0x1f, 0x0e, 0x71,
+			0xf3, 0xa9, 0xb5, 0x24, 0xaf, 0x60, 0x12, 0x06,
+			0x2f, 0xe0, 0x37, 0xa6,
+		},
+	},
+	{
+		"RFC 6070 test case 2",
+		"sha1",
+		"password", 8,
+		"salt", 4,
+		2,
+		20,
+		{
+			0xea, 0x6c, 0x01, 0x4d, 0xc7, 0x2d, 0x6f, 0x8c,
+			0xcd, 0x1e, 0xd9, 0x2a, 0xce, 0x1d, 0x41, 0xf0,
+			0xd8, 0xde, 0x89, 0x57,
+		},
+	},
+	{
+		"RFC 6070 test case 3",
+		"sha1",
+		"password", 8,
+		"salt", 4,
+		4096,
+		20,
+		{
+			0x4b, 0x00, 0x79, 0x01, 0xb7, 0x65, 0x48, 0x9a,
+			0xbe, 0xad, 0x49, 0xd9, 0x26, 0xf7, 0x21, 0xd0,
+			0x65, 0xa4, 0x29, 0xc1,
+		},
+	},
+	{
+		"RFC 6070 test case 5",
+		"sha1",
+		"passwordPASSWORDpassword", 24,
+		"saltSALTsaltSALTsaltSALTsaltSALTsalt", 36,
+		4096,
+		25,
+		{
+			0x3d, 0x2e, 0xec, 0x4f, 0xe4, 0x1c, 0x84, 0x9b,
+			0x80, 0xc8, 0xd8, 0x36, 0x62, 0xc0, 0xe4, 0x4a,
+			0x8b, 0x29, 0x1a, 0x96, 0x4c, 0xf2, 0xf0, 0x70,
+			0x38,
+		},
+	},
+	{
+		"RFC 6070 test case 6",
+		"sha1",
+		"pass\x00word", 9,
+		"sa\x00lt", 5,
+		4096,
+		16,
+		{
+			0x56, 0xfa, 0x6a, 0xa7, 0x55, 0x48, 0x09, 0x9d,
+			0xcc, 0x37, 0xd7, 0xf0, 0x34, 0x25, 0xe0, 0xc3,
+		},
+	},
+	{
+		"sha224, two blocks",
+		"sha224",
+		"password", 8,
+		"salt", 4,
+		2,
+		40,
+		{
+			0x93, 0x20, 0x0f, 0xfa, 0x96, 0xc5, 0x77, 0x6d,
+			0x38, 0xfa, 0x10, 0xab, 0xdf, 0x8f, 0x5b, 0xfc,
+			0x00, 0x54, 0xb9, 0x71, 0x85, 0x13, 0xdf, 0x47,
+			0x2d, 0x23, 0x31, 0xd2, 0xd1, 0xe6, 0x6a, 0x3f,
+			0x97, 0xb5, 0x10, 0x22, 0x4f, 0x70, 0x0c, 0xe7,
+		},
+	},
+	{
+		"sha256, one iteration",
+		"sha256",
+		"password", 8,
+		"salt", 4,
+		1,
+		32,
+		{
+			0x12, 0x0f, 0xb6, 0xcf, 0xfc, 0xf8, 0xb3, 0x2c,
+			0x43, 0xe7, 0x22, 0x52, 0x56, 0xc4, 0xf8, 0x37,
+			0xa8, 0x65, 0x48, 0xc9, 0x2c, 0xcc, 0x35, 0x48,
+			0x08, 0x05, 0x98, 0x7c, 0xb7, 0x0b, 0xe1, 0x7b,
+		},
+	},
+	{
+		"sha256, 4096 iterations",
+		"sha256",
+		"password", 8,
+		"salt", 4,
+		4096,
+		32,
+		{
+			0xc5, 0xe4, 0x78, 0xd5, 0x92, 0x88, 0xc8, 0x41,
+			0xaa, 0x53, 0x0d, 0xb6, 0x84, 0x5c, 0x4c, 0x8d,
+			0x96, 0x28, 0x93, 0xa0, 0x01, 0xce, 0x4e, 0x11,
+			0xa4, 0x96, 0x38, 0x73, 0xaa, 0x98, 0x13, 0x4a,
+		},
+	},
+	{
+		"sha256, two blocks",
+		"sha256",
+		"passwordPASSWORDpassword", 24,
+		"saltSALTsaltSALTsaltSALTsaltSALTsalt", 36,
+		4096,
+		40,
+		{
+			0x34, 0x8c, 0x89, 0xdb, 0xcb, 0xd3, 0x2b, 0x2f,
+			0x32, 0xd8, 0x14, 0xb8, 0x11, 0x6e, 0x84, 0xcf,
+			0x2b, 0x17, 0x34, 0x7e, 0xbc, 0x18, 0x00, 0x18,
+			0x1c, 0x4e, 0x2a, 0x1f, 0xb8, 0xdd, 0x53, 0xe1,
+			0xc6, 0x35, 0x51, 0x8c, 0x7d, 0xac, 0x47, 0xe9,
+		},
+	},
+	{
+		"sha384, three blocks",
+		"sha384",
+		"password", 8,
+		"salt", 4,
+		2,
+		100,
+		{
+			0x54, 0xf7, 0x75, 0xc6, 0xd7, 0x90, 0xf2, 0x19,
+			0x30, 0x45, 0x91, 0x62, 0xfc, 0x53, 0x5d, 0xbf,
+			0x04, 0xa9, 0x39, 0x18, 0x51, 0x27, 0x01, 0x6a,
+			0x04, 0x17, 0x6a, 0x07, 0x30, 0xc6, 0xf1, 0xf4,
+			0xfb, 0x48, 0x83, 0x2a, 0xd1, 0x26, 0x1b, 0xaa,
+			0xdd, 0x2c, 0xed, 0xd5, 0x08, 0x14, 0xb1, 0xc8,
+			0x06, 0xad, 0x1b, 0xbf, 0x43, 0xeb, 0xdc, 0x9d,
+			0x04, 0x79, 0x04, 0xbf, 0x7c, 0xea, 0xfe, 0x1e,
+			0xbe, 0xeb, 0xa0, 0x1a, 0x91, 0xd1, 0x2a, 0x60,
+			0x0a, 0x76, 0x06, 0x04, 0x6e, 0xde, 0xaa, 0xae,
+			0x8d, 0x02, 0xe8, 0x71, 0x46, 0xe3, 0xfc, 0x7f,
+			0x2f, 0xda, 0x35, 0x96, 0xdb, 0xbe, 0x61, 0x12,
+			0xad, 0x59, 0x99, 0x12,
+		},
+	},
+	{
+		"sha512, one iteration",
+		"sha512",
+		"password", 8,
+		"salt", 4,
+		1,
+		64,
+		{
+			0x86, 0x7f, 0x70, 0xcf, 0x1a, 0xde, 0x02, 0xcf,
+			0xf3, 0x75, 0x25, 0x99, 0xa3, 0xa5, 0x3d, 0xc4,
+			0xaf, 0x34, 0xc7, 0xa6, 0x69, 0x81, 0x5a, 0xe5,
+			0xd5, 0x13, 0x55, 0x4e, 0x1c, 0x8c, 0xf2, 0x52,
+			0xc0, 0x2d, 0x47, 0x0a, 0x28, 0x5a, 0x05, 0x01,
+			0xba, 0xd9, 0x99, 0xbf, 0xe9, 0x43, 0xc0, 0x8f,
+			0x05, 0x02, 0x35, 0xd7, 0xd6, 0x8b, 0x1d, 0xa5,
+			0x5e, 0x63, 0xf7, 0x3b, 0x60, 0xa5, 0x7f, 0xce,
+		},
+	},
+	{
+		"sha512, 4096 iterations",
+		"sha512",
+		"passwordPASSWORDpassword", 24,
+		"saltSALTsaltSALTsaltSALTsaltSALTsalt", 36,
+		4096,
+		64,
+		{
+			0x8c, 0x05, 0x11, 0xf4, 0xc6, 0xe5, 0x97, 0xc6,
+			0xac, 0x63, 0x15, 0xd8, 0xf0, 0x36, 0x2e, 0x22,
+			0x5f, 0x3c, 0x50, 0x14, 0x95, 0xba, 0x23, 0xb8,
+			0x68, 0xc0, 0x05, 0x17, 0x4d, 0xc4, 0xee, 0x71,
+			0x11, 0x5b, 0x59, 0xf9, 0xe6, 0x0c, 0xd9, 0x53,
+			0x2f, 0xa3, 0x3e, 0x0f, 0x75, 0xae, 0xfe, 0x30,
+			0x22, 0x5c, 0x58, 0x3a, 0x18, 0x6c, 0xd8, 0x2b,
+			0xd4, 0xda, 0xea, 0x97, 0x24, 0xa3, 0xd3, 0xb8,
+		},
+	},
+};
+
+static int
+t_pbkdf2_vector(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_vector *vector = (struct t_vector *)arg;
+	const digest_algorithm *alg;
+	uint8_t dk[sizeof vector->dk];
+	int ret = 1;
+
+	if ((alg = get_digest_algorithm(vector->digest)) == NULL)
+		return (0);
+	ret &= t_is_zero_i(pbkdf2_hmac(alg, vector->password, vector->pwlen,
+	    vector->salt, vector->saltlen, vector->iterations,
+	    dk, vector->dklen));
+	ret &= t_compare_mem(vector->dk, dk, vector->dklen);
+	return (ret);
+}
+
+static int
+t_pbkdf2_invalid(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	const digest_algorithm *alg;
+	uint8_t dk[32];
+	int ret = 1;
+
+	if ((alg = get_digest_algorithm("sha256")) == NULL)
+		return (0);
+	ret &= t_compare_i(-1, pbkdf2_hmac(alg, "password", 8, "salt", 4,
+	    0, dk, sizeof dk));
+	ret &= t_compare_i(EINVAL, errno);
+	return (ret);
+}
+
+
+/***************************************************************************
+ * Boilerplate
+ */
+
+static int
+t_prepare(int argc, char *argv[])
+{
+	int i, n;
+
+	(void)argc;
+	(void)argv;
+	n = sizeof t_pbkdf2_vectors / sizeof t_pbkdf2_vectors[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_pbkdf2_vector, &t_pbkdf2_vectors[i],
+		    "%s", t_pbkdf2_vectors[i].desc);
+	t_add_test(t_pbkdf2_invalid, NULL, "zero iterations");
+	return (0);
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	t_main(t_prepare, NULL, argc, argv);
+}
@@ -0,0 +1,322 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cryb/cdc.h>
+#include <cryb/hash.h>
+
+#include <cryb/test.h>
+
+#define T_DATA_LEN	(4 * 1024 * 1024)
+
+static uint8_t *t_data;
+static uint8_t *t_ones;
+
+/*
+ * Roll a window of each size across the data and compare the rolling
+ * checksum with that of the window at regular intervals.
+ */
+static size_t t_windows[] = {
+	1, 2, 16, 63, 64, 65, 4096, 5552, 5553, 70000,
+};
+
+static int
+t_rolling_adler32(char **desc CRYB_UNUSED, void *arg)
+{
+	size_t w = *(size_t *)arg;
+	const uint8_t *data;
+	adler32_ctx ctx;
+	size_t i, pass;
+	int ret = 1;
+
+	for (pass = 0; pass < 2; ++pass) {
+		data = pass ? t_ones : t_data;
+		adler32_init(&ctx);
+		adler32_update(&ctx, data, w);
+		for (i = w; i < 4 * w + 1000; ++i) {
+			if (i % 97 == 0 || i < w + 100)
+				ret &= t_compare_x32(adler32_hash(data + i - w, w),
+				    adler32_final(&ctx));
+			adler32_roll_out(&ctx, data[i - w], w);
+			adler32_roll_in(&ctx, data[i]);
+		}
+	}
+	return (ret);
+}
+
+static int
+t_rolling_buzhash(char **desc CRYB_UNUSED, void *arg)
+{
+	size_t w = *(size_t *)arg;
+	buzhash_ctx ctx;
+	size_t i;
+	int ret = 1;
+
+	buzhash_init(&ctx);
+	buzhash_update(&ctx, t_data, w);
+	for (i = w; i < 4 * w + 1000; ++i) {
+		if (i % 97 == 0 || i < w + 100)
+			ret &= t_compare_x64(buzhash_hash(t_data + i - w, w),
+			    buzhash_final(&ctx));
+		buzhash_roll_out(&ctx, t_data[i - w], w);
+		buzhash_roll_in(&ctx, t_data[i]);
+	}
+	return (ret);
+}
+
+/*
+ * Chunk the data in one pass, check the chunk sizes, then chunk it
+ * again in pieces of varying size and check that the boundaries are the
+ * same.
+ */
+struct t_cdc_case {
+	size_t	 min, avg, max;
+};
+
+static struct t_cdc_case t_cdc_cases[] = {
+	{    0,    64,     64 },
+	{   64,    64,     64 },
+	{   16,    64,    256 },
+	{  256,  1024,   8192 },
+	{ 2048,  8192,  65536 },
+	{ 8192, 65536, 262144 },
+};
+
+static size_t *t_ends;
+
+static size_t
+t_cdc_chunk(const struct t_cdc_case *tc, const uint8_t *data, size_t len,
+    size_t *ends)
+{
+	cdc_ctx ctx;
+
+	if (cdc_init(&ctx, tc->min, tc->avg, tc->max) != 0)
+		return (0);
+	return (cdc_scan(&ctx, data, len, ends, T_DATA_LEN));
+}
+
+static int
+t_cdc_sizes(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_cdc_case *tc = arg;
+	size_t i, n, prev, size;
+	int ret = 1;
+
+	n = t_cdc_chunk(tc, t_data, T_DATA_LEN, t_ends);
+	ret &= t_compare_sz(1, n > 0);
+	for (i = 0, prev = 0; i < n && ret; prev = t_ends[i++]) {
+		size = t_ends[i] - prev;
+		if (size < tc->min || size > tc->max || size == 0) {
+			t_printv("chunk %zu is %zu bytes\n", i, size);
+			ret = 0;
+		}
+	}
+	if (n > 0) {
+		/* the mean chunk size should be close to the target */
+		size = t_ends[n - 1] / n;
+		t_printv("mean chunk size %zu\n", size);
+		if (size < tc->avg / 2 || size > tc->min + 2 * tc->avg)
+			ret = 0;
+		/* only the remainder can be left over */
+		ret &= t_compare_sz(1, T_DATA_LEN - t_ends[n - 1] < tc->max);
+	}
+	return (ret);
+}
+
+#define T_NENDS		64
+
+static int
+t_cdc_stream(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_cdc_case *tc = arg;
+	cdc_ctx ctx;
+	size_t ends[T_NENDS];
+	size_t i, j, k, m, n, off, len, piece;
+
+	n = t_cdc_chunk(tc, t_data, T_DATA_LEN, t_ends);
+	if (cdc_init(&ctx, tc->min, tc->avg, tc->max) != 0)
+		return (0);
+	/* feed it pieces of 0 to 12,000 bytes */
+	for (i = 0, off = 0, piece = 1; off < T_DATA_LEN; off += len) {
+		len = piece % 12001;
+		if (len > T_DATA_LEN - off)
+			len = T_DATA_LEN - off;
+		piece = piece * 7919 + 1;
+		/* resume after the last chunk whenever ends[] fills up */
+		for (j = 0; ; j = ends[T_NENDS - 1]) {
+			m = cdc_scan(&ctx, t_data + off + j, len - j, ends,
+			    T_NENDS);
+			for (k = 0; k < m; ++k, ++i) {
+				ends[k] += j;
+				if (i >= n || off + ends[k] != t_ends[i]) {
+					t_printv("chunk %zu ends at %zu\n",
+					    i, off + ends[k]);
+					return (0);
+				}
+			}
+			if (m < T_NENDS)
+				break;
+		}
+	}
+	return (t_compare_sz(n, i));
+}
+
+/*
+ * Insert a byte near the start of the data and check that the chunks
+ * resynchronize, so that most chunk boundaries are unaffected.
+ */
+static int
+t_cdc_shift(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_cdc_case *tc = arg;
+	uint8_t *shifted;
+	size_t *ends;
+	size_t i, j, n, sn, common;
+	int ret = 1;
+
+	if ((shifted = malloc(T_DATA_LEN + 1)) == NULL ||
+	    (ends = malloc(T_DATA_LEN * sizeof *ends)) == NULL) {
+		free(shifted);
+		return (0);
+	}
+	memcpy(shifted, t_data, 1000);
+	shifted[1000] = 0x5a;
+	memcpy(shifted + 1001, t_data + 1000, T_DATA_LEN - 1000);
+	n = t_cdc_chunk(tc, t_data, T_DATA_LEN, t_ends);
+	sn = t_cdc_chunk(tc, shifted, T_DATA_LEN + 1, ends);
+	for (i = j = common = 0; i < n && j < sn; ) {
+		if (t_ends[i] + 1 == ends[j]) {
+			++common;
+			++i;
+			++j;
+		} else if (t_ends[i] + 1 < ends[j]) {
+			++i;
+		} else {
+			++j;
+		}
+	}
+	t_printv("%zu of %zu chunk boundaries unaffected\n", common, n);
+	ret &= t_compare_sz(1, common + 4 + n / 100 >= n);
+	free(ends);
+	free(shifted);
+	return (ret);
+}
+
+static int
+t_cdc_errors(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	cdc_ctx ctx;
+	int ret = 1;
+
+	ret &= t_compare_i(-1, cdc_init(&ctx, 0, 32, 64));
+	ret &= t_compare_i(EINVAL, errno);
+	ret &= t_compare_i(-1, cdc_init(&ctx, 0, 1000, 2000));
+	ret &= t_compare_i(EINVAL, errno);
+	ret &= t_compare_i(-1, cdc_init(&ctx, 2048, 1024, 2048));
+	ret &= t_compare_i(EINVAL, errno);
+	ret &= t_compare_i(-1, cdc_init(&ctx, 0, 1024, 512));
+	ret &= t_compare_i(EINVAL, errno);
+	ret &= t_compare_i(-1, cdc_init(&ctx, 0, (size_t)CDC_MAX_AVG_SIZE * 2,
+	    (size_t)CDC_MAX_AVG_SIZE * 2));
+	ret &= t_compare_i(EINVAL, errno);
+	ret &= t_is_zero_i(cdc_init(&ctx, 1024, 1024, 1024));
+	ret &= t_compare_sz(0, cdc_next(&ctx, t_data, 0));
+	ret &= t_compare_sz(0, cdc_next(&ctx, t_data, 1023));
+	ret &= t_compare_sz(1, cdc_next(&ctx, t_data + 1023, 5));
+	ret &= t_compare_sz(1024, cdc_next(&ctx, t_data, 5000));
+	return (ret);
+}
+
+static int
+t_prepare(int argc, char *argv[])
+{
+	uint64_t x;
+	unsigned int i, n;
+
+	(void)argc;
+	(void)argv;
+	if ((t_data = malloc(T_DATA_LEN)) == NULL ||
+	    (t_ones = malloc(T_DATA_LEN)) == NULL ||
+	    (t_ends = malloc(T_DATA_LEN * sizeof *t_ends)) == NULL)
+		return (-1);
+	/* xorshift64 */
+	for (i = 0, x = 0x0123456789abcdefULL; i < T_DATA_LEN; ++i) {
+		x ^= x << 13;
+		x ^= x >> 7;
+		x ^= x << 17;
+		t_data[i] = x >> 56;
+	}
+	memset(t_ones, 0xff, T_DATA_LEN);
+	n = sizeof t_windows / sizeof t_windows[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_rolling_adler32, &t_windows[i],
+		    "adler32 window %zu", t_windows[i]);
+	for (i = 0; i < n; ++i)
+		t_add_test(t_rolling_buzhash, &t_windows[i],
+		    "buzhash window %zu", t_windows[i]);
+	n = sizeof t_cdc_cases / sizeof t_cdc_cases[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_cdc_sizes, &t_cdc_cases[i],
+		    "cdc %zu/%zu/%zu sizes", t_cdc_cases[i].min,
+		    t_cdc_cases[i].avg, t_cdc_cases[i].max);
+	for (i = 0; i < n; ++i)
+		t_add_test(t_cdc_stream, &t_cdc_cases[i],
+		    "cdc %zu/%zu/%zu streaming", t_cdc_cases[i].min,
+		    t_cdc_cases[i].avg, t_cdc_cases[i].max);
+	for (i = 0; i < n; ++i)
+		if (t_cdc_cases[i].max > t_cdc_cases[i].avg)
+			t_add_test(t_cdc_shift, &t_cdc_cases[i],
+			    "cdc %zu/%zu/%zu shift", t_cdc_cases[i].min,
+			    t_cdc_cases[i].avg, t_cdc_cases[i].max);
+	t_add_test(t_cdc_errors, NULL, "cdc errors");
+	return (0);
+}
+
+static void
+t_cleanup(void)
+{
+
+	free(t_ends);
+	free(t_ones);
+	free(t_data);
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	t_main(t_prepare, t_cleanup, argc, argv);
+}
@@ -0,0 +1,534 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <cryb/hash.h>
+
+#include <cryb/test.h>
+
+/*
+ * Test vectors from the SipHash reference implementation: the key is the
+ * sequence 00 01 02 ... and the message of length n is the sequence
+ * 00 01 02 ... n-1.  The SipHash-1-3 vectors were generated with an
+ * independent implementation and cross-checked against Python's hash().
+ */
+#define T_NVECTORS	64
+
+static const uint64_t t_siphash24_vectors[T_NVECTORS] = {
+	0x726fdb47dd0e0e31ULL, 0x74f839c593dc67fdULL, 0x0d6c8009d9a94f5aULL,
+	0x85676696d7fb7e2dULL, 0xcf2794e0277187b7ULL, 0x18765564cd99a68dULL,
+	0xcbc9466e58fee3ceULL, 0xab0200f58b01d137ULL, 0x93f5f5799a932462ULL,
+	0x9e0082df0ba9e4b0ULL, 0x7a5dbbc594ddb9f3ULL, 0xf4b32f46226bada7ULL,
+	0x751e8fbc860ee5fbULL, 0x14ea5627c0843d90ULL, 0xf723ca908e7af2eeULL,
+	0xa129ca6149be45e5ULL, 0x3f2acc7f57c29bdbULL, 0x699ae9f52cbe4794ULL,
+	0x4bc1b3f0968dd39cULL, 0xbb6dc91da77961bdULL, 0xbed65cf21aa2ee98ULL,
+	0xd0f2cbb02e3b67c7ULL, 0x93536795e3a33e88ULL, 0xa80c038ccd5ccec8ULL,
+	0xb8ad50c6f649af94ULL, 0xbce192de8a85b8eaULL, 0x17d835b85bbb15f3ULL,
+	0x2f2e6163076bcfadULL, 0xde4daaaca71dc9a5ULL, 0xa6a2506687956571ULL,
+	0xad87a3535c49ef28ULL, 0x32d892fad841c342ULL, 0x7127512f72f27cceULL,
+	0xa7f32346f95978e3ULL, 0x12e0b01abb051238ULL, 0x15e034d40fa197aeULL,
+	0x314dffbe0815a3b4ULL, 0x027990f029623981ULL, 0xcadcd4e59ef40c4dULL,
+	0x9abfd8766a33735cULL, 0x0e3ea96b5304a7d0ULL, 0xad0c42d6fc585992ULL,
+	0x187306c89bc215a9ULL, 0xd4a60abcf3792b95ULL, 0xf935451de4f21df2ULL,
+	0xa9538f0419755787ULL, 0xdb9acddff56ca510ULL, 0xd06c98cd5c0975ebULL,
+	0xe612a3cb9ecba951ULL, 0xc766e62cfcadaf96ULL, 0xee64435a9752fe72ULL,
+	0xa192d576b245165aULL, 0x0a8787bf8ecb74b2ULL, 0x81b3e73d20b49b6fULL,
+	0x7fa8220ba3b2eceaULL, 0x245731c13ca42499ULL, 0xb78dbfaf3a8d83bdULL,
+	0xea1ad565322a1a0bULL, 0x60e61c23a3795013ULL, 0x6606d7e446282b93ULL,
+	0x6ca4ecb15c5f91e1ULL, 0x9f626da15c9625f3ULL, 0xe51b38608ef25f57ULL,
+	0x958a324ceb064572ULL,
+};
+
+static const uint8_t t_siphash24_128_vectors[T_NVECTORS][16] = {
+	{ 0xa3, 0x81, 0x7f, 0x04, 0xba, 0x25, 0xa8, 0xe6,
+	  0x6d, 0xf6, 0x72, 0x14, 0xc7, 0x55, 0x02, 0x93 },
+	{ 0xda, 0x87, 0xc1, 0xd8, 0x6b, 0x99, 0xaf, 0x44,
+	  0x34, 0x76, 0x59, 0x11, 0x9b, 0x22, 0xfc, 0x45 },
+	{ 0x81, 0x77, 0x22, 0x8d, 0xa4, 0xa4, 0x5d, 0xc7,
+	  0xfc, 0xa3, 0x8b, 0xde, 0xf6, 0x0a, 0xff, 0xe4 },
+	{ 0x9c, 0x70, 0xb6, 0x0c, 0x52, 0x67, 0xa9, 0x4e,
+	  0x5f, 0x33, 0xb6, 0xb0, 0x29, 0x85, 0xed, 0x51 },
+	{ 0xf8, 0x81, 0x64, 0xc1, 0x2d, 0x9c, 0x8f, 0xaf,
+	  0x7d, 0x0f, 0x6e, 0x7c, 0x7b, 0xcd, 0x55, 0x79 },
+	{ 0x13, 0x68, 0x87, 0x59, 0x80, 0x77, 0x6f, 0x88,
+	  0x54, 0x52, 0x7a, 0x07, 0x69, 0x0e, 0x96, 0x27 },
+	{ 0x14, 0xee, 0xca, 0x33, 0x8b, 0x20, 0x86, 0x13,
+	  0x48, 0x5e, 0xa0, 0x30, 0x8f, 0xd7, 0xa1, 0x5e },
+	{ 0xa1, 0xf1, 0xeb, 0xbe, 0xd8, 0xdb, 0xc1, 0x53,
+	  0xc0, 0xb8, 0x4a, 0xa6, 0x1f, 0xf0, 0x82, 0x39 },
+	{ 0x3b, 0x62, 0xa9, 0xba, 0x62, 0x58, 0xf5, 0x61,
+	  0x0f, 0x83, 0xe2, 0x64, 0xf3, 0x14, 0x97, 0xb4 },
+	{ 0x26, 0x44, 0x99, 0x06, 0x0a, 0xd9, 0xba, 0xab,
+	  0xc4, 0x7f, 0x8b, 0x02, 0xbb, 0x6d, 0x71, 0xed },
+	{ 0x00, 0x11, 0x0d, 0xc3, 0x78, 0x14, 0x69, 0x56,
+	  0xc9, 0x54, 0x47, 0xd3, 0xf3, 0xd0, 0xfb, 0xba },
+	{ 0x01, 0x51, 0xc5, 0x68, 0x38, 0x6b, 0x66, 0x77,
+	  0xa2, 0xb4, 0xdc, 0x6f, 0x81, 0xe5, 0xdc, 0x18 },
+	{ 0xd6, 0x26, 0xb2, 0x66, 0x90, 0x5e, 0xf3, 0x58,
+	  0x82, 0x63, 0x4d, 0xf6, 0x85, 0x32, 0xc1, 0x25 },
+	{ 0x98, 0x69, 0xe2, 0x47, 0xe9, 0xc0, 0x8b, 0x10,
+	  0xd0, 0x29, 0x93, 0x4f, 0xc4, 0xb9, 0x52, 0xf7 },
+	{ 0x31, 0xfc, 0xef, 0xac, 0x66, 0xd7, 0xde, 0x9c,
+	  0x7e, 0xc7, 0x48, 0x5f, 0xe4, 0x49, 0x49, 0x02 },
+	{ 0x54, 0x93, 0xe9, 0x99, 0x33, 0xb0, 0xa8, 0x11,
+	  0x7e, 0x08, 0xec, 0x0f, 0x97, 0xcf, 0xc3, 0xd9 },
+	{ 0x6e, 0xe2, 0xa4, 0xca, 0x67, 0xb0, 0x54, 0xbb,
+	  0xfd, 0x33, 0x15, 0xbf, 0x85, 0x23, 0x05, 0x77 },
+	{ 0x47, 0x3d, 0x06, 0xe8, 0x73, 0x8d, 0xb8, 0x98,
+	  0x54, 0xc0, 0x66, 0xc4, 0x7a, 0xe4, 0x77, 0x40 },
+	{ 0xa4, 0x26, 0xe5, 0xe4, 0x23, 0xbf, 0x48, 0x85,
+	  0x29, 0x4d, 0xa4, 0x81, 0xfe, 0xae, 0xf7, 0x23 },
+	{ 0x78, 0x01, 0x77, 0x31, 0xcf, 0x65, 0xfa, 0xb0,
+	  0x74, 0xd5, 0x20, 0x89, 0x52, 0x51, 0x2e, 0xb1 },
+	{ 0x9e, 0x25, 0xfc, 0x83, 0x3f, 0x22, 0x90, 0x73,
+	  0x3e, 0x93, 0x44, 0xa5, 0xe8, 0x38, 0x39, 0xeb },
+	{ 0x56, 0x8e, 0x49, 0x5a, 0xbe, 0x52, 0x5a, 0x21,
+	  0x8a, 0x22, 0x14, 0xcd, 0x3e, 0x07, 0x1d, 0x12 },
+	{ 0x4a, 0x29, 0xb5, 0x45, 0x52, 0xd1, 0x6b, 0x9a,
+	  0x46, 0x9c, 0x10, 0x52, 0x8e, 0xff, 0x0a, 0xae },
+	{ 0xc9, 0xd1, 0x84, 0xdd, 0xd5, 0xa9, 0xf5, 0xe0,
+	  0xcf, 0x8c, 0xe2, 0x9a, 0x9a, 0xbf, 0x69, 0x1c },
+	{ 0x2d, 0xb4, 0x79, 0xae, 0x78, 0xbd, 0x50, 0xd8,
+	  0x88, 0x2a, 0x8a, 0x17, 0x8a, 0x61, 0x32, 0xad },
+	{ 0x8e, 0xce, 0x5f, 0x04, 0x2d, 0x5e, 0x44, 0x7b,
+	  0x50, 0x51, 0xb9, 0xea, 0xcb, 0x8d, 0x8f, 0x6f },
+	{ 0x9c, 0x0b, 0x53, 0xb4, 0xb3, 0xc3, 0x07, 0xe8,
+	  0x7e, 0xae, 0xe0, 0x86, 0x78, 0x14, 0x1f, 0x66 },
+	{ 0xab, 0xf2, 0x48, 0xaf, 0x69, 0xa6, 0xea, 0xe4,
+	  0xbf, 0xd3, 0xeb, 0x2f, 0x12, 0x9e, 0xeb, 0x94 },
+	{ 0x06, 0x64, 0xda, 0x16, 0x68, 0x57, 0x4b, 0x88,
+	  0xb9, 0x35, 0xf3, 0x02, 0x73, 0x58, 0xae, 0xf4 },
+	{ 0xaa, 0x4b, 0x9d, 0xc4, 0xbf, 0x33, 0x7d, 0xe9,
+	  0x0c, 0xd4, 0xfd, 0x3c, 0x46, 0x7c, 0x6a, 0xb7 },
+	{ 0xea, 0x5c, 0x7f, 0x47, 0x1f, 0xaf, 0x6b, 0xde,
+	  0x2b, 0x1a, 0xd7, 0xd4, 0x68, 0x6d, 0x22, 0x87 },
+	{ 0x29, 0x39, 0xb0, 0x18, 0x32, 0x23, 0xfa, 0xfc,
+	  0x17, 0x23, 0xde, 0x4f, 0x52, 0xc4, 0x3d, 0x35 },
+	{ 0x7c, 0x39, 0x56, 0xca, 0x5e, 0xea, 0xfc, 0x3e,
+	  0x36, 0x3e, 0x9d, 0x55, 0x65, 0x46, 0xeb, 0x68 },
+	{ 0x77, 0xc6, 0x07, 0x71, 0x46, 0xf0, 0x1c, 0x32,
+	  0xb6, 0xb6, 0x9d, 0x5f, 0x4e, 0xa9, 0xff, 0xcf },
+	{ 0x37, 0xa6, 0x98, 0x6c, 0xb8, 0x84, 0x7e, 0xdf,
+	  0x09, 0x25, 0xf0, 0xf1, 0x30, 0x9b, 0x54, 0xde },
+	{ 0xa7, 0x05, 0xf0, 0xe6, 0x9d, 0xa9, 0xa8, 0xf9,
+	  0x07, 0x24, 0x1a, 0x2e, 0x92, 0x3c, 0x8c, 0xc8 },
+	{ 0x3d, 0xc4, 0x7d, 0x1f, 0x29, 0xc4, 0x48, 0x46,
+	  0x1e, 0x9e, 0x76, 0xed, 0x90, 0x4f, 0x67, 0x11 },
+	{ 0x0d, 0x62, 0xbf, 0x01, 0xe6, 0xfc, 0x0e, 0x1a,
+	  0x0d, 0x3c, 0x47, 0x51, 0xc5, 0xd3, 0x69, 0x2b },
+	{ 0x8c, 0x03, 0x46, 0x8b, 0xca, 0x7c, 0x66, 0x9e,
+	  0xe4, 0xfd, 0x5e, 0x08, 0x4b, 0xbe, 0xe7, 0xb5 },
+	{ 0x52, 0x8a, 0x5b, 0xb9, 0x3b, 0xaf, 0x2c, 0x9c,
+	  0x44, 0x73, 0xcc, 0xe5, 0xd0, 0xd2, 0x2b, 0xd9 },
+	{ 0xdf, 0x6a, 0x30, 0x1e, 0x95, 0xc9, 0x5d, 0xad,
+	  0x97, 0xae, 0x0c, 0xc8, 0xc6, 0x91, 0x3b, 0xd8 },
+	{ 0x80, 0x11, 0x89, 0x90, 0x2c, 0x85, 0x7f, 0x39,
+	  0xe7, 0x35, 0x91, 0x28, 0x5e, 0x70, 0xb6, 0xdb },
+	{ 0xe6, 0x17, 0x34, 0x6a, 0xc9, 0xc2, 0x31, 0xbb,
+	  0x36, 0x50, 0xae, 0x34, 0xcc, 0xca, 0x0c, 0x5b },
+	{ 0x27, 0xd9, 0x34, 0x37, 0xef, 0xb7, 0x21, 0xaa,
+	  0x40, 0x18, 0x21, 0xdc, 0xec, 0x5a, 0xdf, 0x89 },
+	{ 0x89, 0x23, 0x7d, 0x9d, 0xed, 0x9c, 0x5e, 0x78,
+	  0xd8, 0xb1, 0xc9, 0xb1, 0x66, 0xcc, 0x73, 0x42 },
+	{ 0x4a, 0x6d, 0x80, 0x91, 0xbf, 0x5e, 0x7d, 0x65,
+	  0x11, 0x89, 0xfa, 0x94, 0xa2, 0x50, 0xb1, 0x4c },
+	{ 0x0e, 0x33, 0xf9, 0x60, 0x55, 0xe7, 0xae, 0x89,
+	  0x3f, 0xfc, 0x0e, 0x3d, 0xcf, 0x49, 0x29, 0x02 },
+	{ 0xe6, 0x1c, 0x43, 0x2b, 0x72, 0x0b, 0x19, 0xd1,
+	  0x8e, 0xc8, 0xd8, 0x4b, 0xdc, 0x63, 0x15, 0x1b },
+	{ 0xf7, 0xe5, 0xae, 0xf5, 0x49, 0xf7, 0x82, 0xcf,
+	  0x37, 0x90, 0x55, 0xa6, 0x08, 0x26, 0x9b, 0x16 },
+	{ 0x43, 0x8d, 0x03, 0x0f, 0xd0, 0xb7, 0xa5, 0x4f,
+	  0xa8, 0x37, 0xf2, 0xad, 0x20, 0x1a, 0x64, 0x03 },
+	{ 0xa5, 0x90, 0xd3, 0xee, 0x4f, 0xbf, 0x04, 0xe3,
+	  0x24, 0x7e, 0x0d, 0x27, 0xf2, 0x86, 0x42, 0x3f },
+	{ 0x5f, 0xe2, 0xc1, 0xa1, 0x72, 0xfe, 0x93, 0xc4,
+	  0xb1, 0x5c, 0xd3, 0x7c, 0xae, 0xf9, 0xf5, 0x38 },
+	{ 0x2c, 0x97, 0x32, 0x5c, 0xbd, 0x06, 0xb3, 0x6e,
+	  0xb2, 0x13, 0x3d, 0xd0, 0x8b, 0x3a, 0x01, 0x7c },
+	{ 0x92, 0xc8, 0x14, 0x22, 0x7a, 0x6b, 0xca, 0x94,
+	  0x9f, 0xf0, 0x65, 0x9f, 0x00, 0x2a, 0xd3, 0x9e },
+	{ 0xdc, 0xe8, 0x50, 0x11, 0x0b, 0xd8, 0x32, 0x8c,
+	  0xfb, 0xd5, 0x08, 0x41, 0xd6, 0x91, 0x1d, 0x87 },
+	{ 0x67, 0xf1, 0x49, 0x84, 0xc7, 0xda, 0x79, 0x12,
+	  0x48, 0xe3, 0x2b, 0xb5, 0x92, 0x25, 0x83, 0xda },
+	{ 0x19, 0x38, 0xf2, 0xcf, 0x72, 0xd5, 0x4e, 0xe9,
+	  0x7e, 0x94, 0x16, 0x6f, 0xa9, 0x1d, 0x2a, 0x36 },
+	{ 0x74, 0x48, 0x1e, 0x96, 0x46, 0xed, 0x49, 0xfe,
+	  0x0f, 0x62, 0x24, 0x30, 0x16, 0x04, 0x69, 0x8e },
+	{ 0x57, 0xfc, 0xa5, 0xde, 0x98, 0xa9, 0xd6, 0xd8,
+	  0x00, 0x64, 0x38, 0xd0, 0x58, 0x3d, 0x8a, 0x1d },
+	{ 0x9f, 0xec, 0xde, 0x1c, 0xef, 0xdc, 0x1c, 0xbe,
+	  0xd4, 0x76, 0x36, 0x74, 0xd9, 0x57, 0x53, 0x59 },
+	{ 0xe3, 0x04, 0x0c, 0x00, 0xeb, 0x28, 0xf1, 0x53,
+	  0x66, 0xca, 0x73, 0xcb, 0xd8, 0x72, 0xe7, 0x40 },
+	{ 0x76, 0x97, 0x00, 0x9a, 0x6a, 0x83, 0x1d, 0xfe,
+	  0xcc, 0xa9, 0x1c, 0x59, 0x93, 0x67, 0x0f, 0x7a },
+	{ 0x58, 0x53, 0x54, 0x23, 0x21, 0xf5, 0x67, 0xa0,
+	  0x05, 0xd5, 0x47, 0xa4, 0xf0, 0x47, 0x59, 0xbd },
+	{ 0x51, 0x50, 0xd1, 0x77, 0x2f, 0x50, 0x83, 0x4a,
+	  0x50, 0x3e, 0x06, 0x9a, 0x97, 0x3f, 0xbd, 0x7c },
+};
+
+static const uint64_t t_siphash13_vectors[T_NVECTORS] = {
+	0xabac0158050fc4dcULL, 0xc9f49bf37d57ca93ULL, 0x82cb9b024dc7d44dULL,
+	0x8bf80ab8e7ddf7fbULL, 0xcf75576088d38328ULL, 0xdef9d52f49533b67ULL,
+	0xc50d2b50c59f22a7ULL, 0xd3927d989bb11140ULL, 0x369095118d299a8eULL,
+	0x25a48eb36c063de4ULL, 0x79de85ee92ff097fULL, 0x70c118c1f94dc352ULL,
+	0x78a384b157b4d9a2ULL, 0x306f760c1229ffa7ULL, 0x605aa111c0f95d34ULL,
+	0xd320d86d2a519956ULL, 0xcc4fdd1a7d908b66ULL, 0x9cf2689063dbd80cULL,
+	0x8ffc389cb473e63eULL, 0xf21f9de58d297d1cULL, 0xc0dc2f46a6cce040ULL,
+	0xb992abfe2b45f844ULL, 0x7ffe7b9ba320872eULL, 0x525a0e7fdae6c123ULL,
+	0xf464aeb267349c8cULL, 0x45cd5928705b0979ULL, 0x3a3e35e3ca9913a5ULL,
+	0xa91dc74e4ade3b35ULL, 0xfb0bed02ef6cd00dULL, 0x88d93cb44ab1e1f4ULL,
+	0x540f11d643c5e663ULL, 0x2370dd1f8c21d1bcULL, 0x81157b6c16a7b60dULL,
+	0x4d54b9e57a8ff9bfULL, 0x759f12781f2a753eULL, 0xcea1a3bebf186b91ULL,
+	0x2cf508d3ada26206ULL, 0xb6101c2da3c33057ULL, 0xb3f47496ae3a36a1ULL,
+	0x626b57547b108392ULL, 0xc1d2363299e41531ULL, 0x667cc1923f1ad944ULL,
+	0x65704ffec8138825ULL, 0x24f280d1c28949a6ULL, 0xc2ca1cedfaf8876bULL,
+	0xc2164bfc9f042196ULL, 0xa16e9c9368b1d623ULL, 0x49fb169c8b5114fdULL,
+	0x9f3143f8df074c46ULL, 0xc6fdaf2412cc86b3ULL, 0x7eaf49d10a52098fULL,
+	0x1cf313559d292f9aULL, 0xc44a30dda2f41f12ULL, 0x36fae98943a71ed0ULL,
+	0x318fb34c73f0bce6ULL, 0xa27abf3670a7e980ULL, 0xb4bcc0db243c6d75ULL,
+	0x23f8d852fdb71513ULL, 0x8f035f4da67d8a08ULL, 0xd89cd0e5b7e8f148ULL,
+	0xf6f4e6bcf7a644eeULL, 0xaec59ad80f1837f2ULL, 0xc3b2f6154b6694e0ULL,
+	0x9d199062b7bbb3a8ULL,
+};
+
+static const uint8_t t_siphash13_128_vectors[T_NVECTORS][16] = {
+	{ 0xe7, 0x7e, 0xbc, 0xb2, 0x27, 0x88, 0xa5, 0xbe,
+	  0xfd, 0x62, 0xdb, 0x6a, 0xdd, 0x30, 0x30, 0x01 },
+	{ 0xfc, 0x6f, 0x37, 0x04, 0x60, 0xd3, 0xed, 0xa8,
+	  0x5e, 0x05, 0x73, 0xcc, 0x2b, 0x2f, 0xf0, 0x63 },
+	{ 0x75, 0x78, 0x7f, 0x09, 0x05, 0x69, 0x83, 0x9b,
+	  0x85, 0x5b, 0xc9, 0x54, 0x8c, 0x6a, 0xea, 0x95 },
+	{ 0x6b, 0xc5, 0xcc, 0xfa, 0x1e, 0xdc, 0xf7, 0x9f,
+	  0x48, 0x23, 0x18, 0x77, 0x12, 0xeb, 0xd7, 0x43 },
+	{ 0x0c, 0x78, 0x4e, 0x71, 0xac, 0x2b, 0x28, 0x5a,
+	  0x9f, 0x8e, 0x92, 0xe7, 0x8f, 0xbf, 0x2c, 0x25 },
+	{ 0xf3, 0x28, 0xdb, 0x89, 0x34, 0x5b, 0x62, 0x0c,
+	  0x79, 0x52, 0x29, 0xa4, 0x26, 0x95, 0x84, 0x3e },
+	{ 0xdc, 0xd0, 0x3d, 0x29, 0xf7, 0x43, 0xe7, 0x10,
+	  0x09, 0x51, 0xb0, 0xe8, 0x39, 0x85, 0xa6, 0xf8 },
+	{ 0x10, 0x84, 0xb9, 0x23, 0xf2, 0xaa, 0xe0, 0xc3,
+	  0xa6, 0x2f, 0x2e, 0xc8, 0x08, 0x48, 0xab, 0x77 },
+	{ 0xaa, 0x12, 0xfe, 0xe1, 0xd5, 0xe3, 0xda, 0xb4,
+	  0x72, 0x4f, 0x16, 0xab, 0x35, 0xf9, 0xc7, 0x99 },
+	{ 0x81, 0xdd, 0xb8, 0x04, 0x2c, 0xf3, 0x39, 0x94,
+	  0xf4, 0x72, 0x0e, 0x00, 0x94, 0x13, 0x7c, 0x42 },
+	{ 0x4f, 0xaa, 0x54, 0x1d, 0x5d, 0x49, 0x8e, 0x89,
+	  0xba, 0x0e, 0xa4, 0xc3, 0x87, 0xb2, 0x2f, 0xb4 },
+	{ 0x72, 0x3b, 0x9a, 0xf3, 0x55, 0x44, 0x91, 0xdb,
+	  0xb1, 0xd6, 0x63, 0x3d, 0xfc, 0x6e, 0x0c, 0x4e },
+	{ 0xe5, 0x3f, 0x92, 0x85, 0x9e, 0x48, 0x19, 0xa8,
+	  0xdc, 0x06, 0x95, 0x73, 0x9f, 0xea, 0x8c, 0x65 },
+	{ 0xb2, 0xf8, 0x58, 0xc7, 0xc9, 0xea, 0x80, 0x1d,
+	  0x53, 0xd6, 0x03, 0x59, 0x6d, 0x65, 0x78, 0x44 },
+	{ 0x87, 0xe7, 0x62, 0x68, 0xdb, 0xc9, 0x22, 0x72,
+	  0x26, 0xb0, 0xca, 0x66, 0x5f, 0x64, 0xe3, 0x78 },
+	{ 0xc1, 0x7e, 0x55, 0x05, 0xb2, 0xbd, 0x52, 0x6c,
+	  0x29, 0x21, 0xcd, 0xec, 0x1e, 0x7e, 0x01, 0x09 },
+	{ 0xd0, 0xa8, 0xd9, 0x57, 0x15, 0x51, 0x8e, 0xeb,
+	  0xb5, 0x13, 0xb0, 0xf8, 0x3d, 0x9e, 0x17, 0x93 },
+	{ 0x23, 0x41, 0x26, 0xf9, 0x3f, 0xbb, 0x66, 0x8d,
+	  0x97, 0x51, 0x12, 0xe8, 0xfe, 0xbd, 0xf7, 0xec },
+	{ 0xef, 0x42, 0xf0, 0x3d, 0xb7, 0x8f, 0x70, 0x4d,
+	  0x02, 0x3c, 0x44, 0x9f, 0x16, 0xb7, 0x09, 0x2b },
+	{ 0xab, 0xf7, 0x62, 0x38, 0xc2, 0x0a, 0xf1, 0x61,
+	  0xb2, 0x31, 0x4b, 0x4d, 0x55, 0x26, 0xbc, 0xe9 },
+	{ 0x3c, 0x2c, 0x2f, 0x11, 0xbb, 0x90, 0xcf, 0x0b,
+	  0xe3, 0x35, 0xca, 0x9b, 0x2e, 0x91, 0xe9, 0xb7 },
+	{ 0x2a, 0x7a, 0x68, 0x0f, 0x22, 0xa0, 0x2a, 0x92,
+	  0xf4, 0x51, 0x49, 0xd2, 0x0f, 0xec, 0xe0, 0xef },
+	{ 0xc9, 0xa8, 0xd1, 0x30, 0x23, 0x1d, 0xd4, 0x3e,
+	  0x42, 0xe6, 0x45, 0x69, 0x57, 0xf8, 0x37, 0x79 },
+	{ 0x1d, 0x12, 0x7b, 0x84, 0x40, 0x5c, 0xea, 0xb9,
+	  0x9f, 0xd8, 0x77, 0x5a, 0x9b, 0xe6, 0xc5, 0x59 },
+	{ 0x9e, 0x4b, 0xf8, 0x37, 0xbc, 0xfd, 0x92, 0xca,
+	  0xce, 0x09, 0xd2, 0x06, 0x1a, 0x84, 0xd0, 0x4a },
+	{ 0x39, 0x03, 0x1a, 0x96, 0x5d, 0x73, 0xb4, 0xaf,
+	  0x5a, 0x27, 0x4d, 0x18, 0xf9, 0x73, 0xb1, 0xd2 },
+	{ 0x7f, 0x4d, 0x0a, 0x12, 0x09, 0xd6, 0x7e, 0x4e,
+	  0xd0, 0x6f, 0x75, 0x38, 0xe1, 0xcf, 0xad, 0x64 },
+	{ 0xe6, 0x1e, 0xe2, 0x40, 0xfb, 0xdc, 0xce, 0x38,
+	  0x96, 0x9f, 0x4c, 0xd2, 0x49, 0x27, 0xdd, 0x93 },
+	{ 0x4c, 0x3b, 0xa2, 0xb3, 0x7b, 0x0f, 0xdd, 0x8c,
+	  0xfa, 0x5e, 0x95, 0xc1, 0x89, 0xb2, 0x94, 0x14 },
+	{ 0xe0, 0x6f, 0xd4, 0xca, 0x06, 0x6f, 0xec, 0xdd,
+	  0x54, 0x06, 0x8a, 0x5a, 0xd8, 0x89, 0x6f, 0x86 },
+	{ 0x5c, 0xa8, 0x4c, 0x34, 0x13, 0x9c, 0x65, 0x80,
+	  0xa8, 0x8a, 0xf2, 0x49, 0x90, 0x72, 0x07, 0x06 },
+	{ 0x42, 0xea, 0x96, 0x1c, 0x5b, 0x3c, 0x85, 0x8b,
+	  0x17, 0xc3, 0xe5, 0x50, 0xdf, 0xa7, 0x90, 0x10 },
+	{ 0x40, 0x6c, 0x44, 0xde, 0xe6, 0x78, 0x57, 0xb2,
+	  0x94, 0x31, 0x60, 0xf3, 0x0c, 0x74, 0x17, 0xd3 },
+	{ 0xc5, 0xf5, 0x7b, 0xae, 0x13, 0x20, 0xfc, 0xf4,
+	  0xb4, 0xe8, 0x68, 0xe7, 0x1d, 0x56, 0xc6, 0x6b },
+	{ 0x04, 0xbf, 0x73, 0x7a, 0x5b, 0x67, 0x6b, 0xe7,
+	  0xc3, 0xde, 0x05, 0x01, 0x7d, 0xf4, 0xbf, 0xf9 },
+	{ 0x51, 0x63, 0xc9, 0xc0, 0x3f, 0x19, 0x07, 0xea,
+	  0x10, 0x44, 0xed, 0x5c, 0x30, 0x72, 0x7b, 0x4f },
+	{ 0x37, 0xa1, 0x10, 0xf0, 0x02, 0x71, 0x8e, 0xda,
+	  0xd2, 0x4b, 0x3f, 0x9e, 0xe4, 0x53, 0xf1, 0x40 },
+	{ 0xb9, 0x87, 0x7e, 0x38, 0x1a, 0xed, 0xd3, 0xda,
+	  0x08, 0xc3, 0x3e, 0x75, 0xff, 0x23, 0xac, 0x10 },
+	{ 0x7c, 0x50, 0x04, 0x00, 0x5e, 0xc5, 0xda, 0x4c,
+	  0x5a, 0xc9, 0x44, 0x0e, 0x5c, 0x72, 0x31, 0x93 },
+	{ 0x81, 0xb8, 0x24, 0x37, 0x83, 0xdb, 0xc6, 0x46,
+	  0xca, 0x9d, 0x0c, 0xd8, 0x2a, 0xbd, 0xb4, 0x6c },
+	{ 0x50, 0x57, 0x20, 0x54, 0x3e, 0xb9, 0xb4, 0x13,
+	  0xd5, 0x0b, 0x3c, 0xfa, 0xd9, 0xee, 0xf9, 0x38 },
+	{ 0x94, 0x5f, 0x59, 0x4d, 0xe7, 0x24, 0x11, 0xe4,
+	  0xd3, 0x35, 0xbe, 0x87, 0x44, 0x56, 0xd8, 0xf3 },
+	{ 0x37, 0x92, 0x3b, 0x3e, 0x37, 0x17, 0x77, 0xb2,
+	  0x11, 0x70, 0xbf, 0x9d, 0x7e, 0x62, 0xf6, 0x02 },
+	{ 0x3a, 0xd4, 0xe7, 0xc8, 0x57, 0x64, 0x96, 0x46,
+	  0x11, 0xeb, 0x0a, 0x6c, 0x4d, 0x62, 0xde, 0x56 },
+	{ 0xcd, 0x91, 0x39, 0x6c, 0x44, 0xaf, 0x4f, 0x51,
+	  0x85, 0x57, 0x8d, 0x9d, 0xd9, 0x80, 0x3f, 0x0a },
+	{ 0xfe, 0x28, 0x15, 0x8e, 0x72, 0x7b, 0x86, 0x8f,
+	  0x39, 0x03, 0xc9, 0xac, 0xda, 0x64, 0xa2, 0x58 },
+	{ 0x40, 0xcc, 0x10, 0xb8, 0x28, 0x8c, 0xe5, 0xf0,
+	  0xbc, 0x3a, 0xc0, 0xb6, 0x8a, 0x0e, 0xeb, 0xc8 },
+	{ 0x6f, 0x14, 0x90, 0xf5, 0x40, 0x69, 0x9a, 0x3c,
+	  0xd4, 0x97, 0x44, 0x20, 0xec, 0xc9, 0x27, 0x37 },
+	{ 0xd5, 0x05, 0xf1, 0xb7, 0x5e, 0x1a, 0x84, 0xa6,
+	  0x03, 0xc4, 0x35, 0x83, 0xb2, 0xed, 0x03, 0x08 },
+	{ 0x49, 0x15, 0x73, 0xcf, 0xd7, 0x2b, 0xb4, 0x68,
+	  0x2b, 0x7c, 0xa5, 0x88, 0x0e, 0x1c, 0x8d, 0x6f },
+	{ 0x3e, 0xd6, 0x9c, 0xfe, 0x45, 0xab, 0x40, 0x3f,
+	  0x2f, 0xd2, 0xad, 0x95, 0x9b, 0xa2, 0x76, 0x66 },
+	{ 0x8b, 0xe8, 0x39, 0xef, 0x1b, 0x20, 0xb5, 0x7c,
+	  0x83, 0xba, 0x7e, 0xb6, 0xa8, 0xc2, 0x2b, 0x6a },
+	{ 0x14, 0x09, 0x18, 0x6a, 0xb4, 0x22, 0x31, 0xfe,
+	  0xde, 0xe1, 0x81, 0x62, 0xcf, 0x1c, 0xb4, 0xca },
+	{ 0x2b, 0xf3, 0xcc, 0xc2, 0x4a, 0xb6, 0x72, 0xcf,
+	  0x15, 0x1f, 0xb8, 0xd2, 0xf3, 0xf3, 0x06, 0x9b },
+	{ 0xb9, 0xb9, 0x3a, 0x28, 0x82, 0xd6, 0x02, 0x5c,
+	  0xdb, 0x8c, 0x56, 0xfa, 0x13, 0xf7, 0x53, 0x7b },
+	{ 0xd9, 0x7c, 0xca, 0x36, 0x94, 0xfb, 0x20, 0x6d,
+	  0xb8, 0xbd, 0x1f, 0x36, 0x50, 0xc3, 0x33, 0x22 },
+	{ 0x94, 0xec, 0x2e, 0x19, 0xa4, 0x0b, 0xe4, 0x1a,
+	  0xf3, 0x94, 0x0d, 0x6b, 0x30, 0xc4, 0x93, 0x84 },
+	{ 0x4b, 0x41, 0x60, 0x3f, 0x20, 0x9a, 0x04, 0x5b,
+	  0xe1, 0x40, 0xa3, 0x41, 0xa3, 0xdf, 0xfe, 0x10 },
+	{ 0x23, 0xfb, 0xcb, 0x30, 0x9f, 0x1c, 0xf0, 0x94,
+	  0x89, 0x07, 0x55, 0xab, 0x1b, 0x42, 0x65, 0x69 },
+	{ 0xe7, 0xd9, 0xb6, 0x56, 0x90, 0x91, 0x8a, 0x2b,
+	  0x23, 0x2f, 0x2f, 0x5c, 0x12, 0xc8, 0x30, 0x0e },
+	{ 0xad, 0xe8, 0x3c, 0xf7, 0xe7, 0xf3, 0x84, 0x7b,
+	  0x36, 0xfa, 0x4b, 0x54, 0xb0, 0x0d, 0xce, 0x61 },
+	{ 0x06, 0x10, 0xc5, 0xf2, 0xee, 0x57, 0x1c, 0x8a,
+	  0xc8, 0x0c, 0xbf, 0xe5, 0x38, 0xbd, 0xf1, 0xc7 },
+	{ 0x27, 0x1d, 0x5d, 0x00, 0xfb, 0xdb, 0x5d, 0x15,
+	  0x5d, 0x9d, 0xce, 0xa9, 0x7c, 0xb4, 0x02, 0x18 },
+	{ 0x4c, 0x58, 0x00, 0xe3, 0x4e, 0xfe, 0x42, 0x6f,
+	  0x07, 0x9f, 0x6b, 0x0a, 0xa7, 0x52, 0x60, 0xad },
+};
+
+static const uint32_t t_halfsiphash24_vectors[T_NVECTORS] = {
+	0x5b9f35a9U, 0xb85a4727U, 0x03a662faU, 0x04e7fe8aU,
+	0x89466e2aU, 0x69b6fac5U, 0x23fc6358U, 0xc563cf8bU,
+	0x8f84b8d0U, 0x79e706f8U, 0x3479b094U, 0x50300808U,
+	0x2f87f057U, 0xff63e677U, 0x7cf8ffd6U, 0x972bfe74U,
+	0x84acb5d9U, 0x5b6474c4U, 0x9b8d5b46U, 0x87e3ef7bU,
+	0x45104de3U, 0xb3623f61U, 0xfe67f370U, 0xbdb8ade6U,
+	0x630c4027U, 0x75787826U, 0x5f7b564fU, 0x69e6b03aU,
+	0x004064b0U, 0xb40f67ffU, 0x8b339e50U, 0x1a9f585dU,
+	0x1221e7feU, 0x59327533U, 0x8c4f436aU, 0x29b728feU,
+	0xecc65ce7U, 0x548d7e69U, 0x0f8b6863U, 0xb4620b65U,
+	0x4018bcb6U, 0x0545075dU, 0x2efd4224U, 0x3a86b77bU,
+	0x48d50577U, 0xb10852d7U, 0xc899d4b6U, 0x2e209208U,
+	0xe32ce169U, 0xe580b58dU, 0xc6649736U, 0x04026e01U,
+	0xd4f3853bU, 0xbe66dbfeU, 0x3a2a691eU, 0xc08489c6U,
+	0x40b9c5a5U, 0x8ce8e99bU, 0x4081bc7dU, 0xc58e077cU,
+	0x736ce7d4U, 0xb9cb8f42U, 0x7a9983bdU, 0x744aea59U,
+};
+
+static const uint64_t t_halfsiphash24_64_vectors[T_NVECTORS] = {
+	0xc83cb8b9591f8d21ULL, 0x157338f8122455beULL, 0x57eb507cef394f06ULL,
+	0x790606f7451a0fceULL, 0xa12ee55b178ae7d5ULL, 0x80b53d2f3f7c9dcbULL,
+	0x25bca28a35913eceULL, 0x84c67bb0282720ffULL, 0x8c85e4bc20e8feedULL,
+	0x07838813cccc515bULL, 0xeef2a6069f46b095ULL, 0x48cddd94393326aeULL,
+	0x99c7f5ae9f1fc77bULL, 0x44370c5ad752235aULL, 0x58e6e8ea70a8b13bULL,
+	0x02c9814ecb0b7d21ULL, 0xb5f37b5fd2aa3673ULL, 0x6a4f4c1c64c0ad37ULL,
+	0xf9423e9a2bdbb2c9ULL, 0x3c36ab2080e410f9ULL, 0xdba7ee6f0a2bf51bULL,
+	0xefb3e869c21d7400ULL, 0xef76a71bfa0301e2ULL, 0x731d684be510224cULL,
+	0xf1a63fae45107470ULL, 0x384071393740860cULL, 0xf0232911d89e890dULL,
+	0xb8e11eb8faf56b22ULL, 0xb516001efb5f922dULL, 0xf110ee2cd5581936ULL,
+	0x9d17984886af1a29ULL, 0x7c11345c157f3c86ULL, 0x6c6211d8469d7028ULL,
+	0x9cf8281d68778424ULL, 0x30988f52d7e42483ULL, 0xd86bea3ae1d4eff9ULL,
+	0xdc7642ec407ad686ULL, 0x357ea9ccec92623fULL, 0x0921d424e72ed9cbULL,
+	0x793d408d80f68d36ULL, 0x4caec8671cc8385bULL, 0xb3ac39d48971ab95ULL,
+	0x24703225c0521aa9ULL, 0xeaac2895c687005bULL, 0x5ab1dc27adf3301eULL,
+	0xd44e32909a5c7f69ULL, 0x38dc5755990f5c49ULL, 0x4df9293c2a202794ULL,
+	0x3e3ea94bc0a8eaa9ULL, 0x1812017d73c1a4eeULL, 0x495af6d88f562d91ULL,
+	0x975cffb096959156ULL, 0xe150f598795a4402ULL, 0xb21f1de76c46ec86ULL,
+	0xbce389d2e7699535ULL, 0x967cbb62ca051b87ULL, 0x1d5ff142f992a4a1ULL,
+	0x6e5b09f67f26ec12ULL, 0x9dd831b2a15e1b5dULL, 0x54ee923f45b4cfd8ULL,
+	0x60e426bf902876d6ULL, 0xf35cedb7a4633531ULL, 0x9366d472b53a0bf9ULL,
+	0x876032bf713ca62eULL,
+};
+
+/***************************************************************************
+ * Test functions
+ */
+
+static int
+t_siphash24(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	unsigned int i;
+	int ret = 1;
+
+	for (i = 0; i < T_NVECTORS; ++i)
+		ret &= t_compare_x64(t_siphash24_vectors[i],
+		    siphash24_hash(t_seq8, i, t_seq8));
+	return (ret);
+}
+
+static int
+t_siphash24_128(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	uint8_t out[16];
+	unsigned int i;
+	int ret = 1;
+
+	for (i = 0; i < T_NVECTORS; ++i) {
+		siphash24_128_hash(t_seq8, i, t_seq8, out);
+		ret &= t_compare_mem(t_siphash24_128_vectors[i], out,
+		    sizeof out);
+	}
+	return (ret);
+}
+
+static int
+t_siphash13(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	unsigned int i;
+	int ret = 1;
+
+	for (i = 0; i < T_NVECTORS; ++i)
+		ret &= t_compare_x64(t_siphash13_vectors[i],
+		    siphash13_hash(t_seq8, i, t_seq8));
+	return (ret);
+}
+
+static int
+t_siphash13_128(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	uint8_t out[16];
+	unsigned int i;
+	int ret = 1;
+
+	for (i = 0; i < T_NVECTORS; ++i) {
+		siphash13_128_hash(t_seq8, i, t_seq8, out);
+		ret &= t_compare_mem(t_siphash13_128_vectors[i], out,
+		    sizeof out);
+	}
+	return (ret);
+}
+
+static int
+t_halfsiphash24(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	unsigned int i;
+	int ret = 1;
+
+	for (i = 0; i < T_NVECTORS; ++i)
+		ret &= t_compare_x32(t_halfsiphash24_vectors[i],
+		    halfsiphash24_hash(t_seq8, i, t_seq8));
+	return (ret);
+}
+
+static int
+t_halfsiphash24_64(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	unsigned int i;
+	int ret = 1;
+
+	for (i = 0; i < T_NVECTORS; ++i)
+		ret &= t_compare_x64(t_halfsiphash24_64_vectors[i],
+		    halfsiphash24_64_hash(t_seq8, i, t_seq8));
+	return (ret);
+}
+
+/*
+ * Verify that the result does not depend on the alignment of the input.
+ */
+static int
+t_siphash_unaligned(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	uint8_t buf[T_NVECTORS + 8];
+	unsigned int i, off;
+	int ret = 1;
+
+	for (off = 1; off < 8; ++off) {
+		memcpy(buf + off, t_seq8, T_NVECTORS);
+		for (i = 0; i < T_NVECTORS; ++i) {
+			ret &= t_compare_x64(t_siphash24_vectors[i],
+			    siphash24_hash(buf + off, i, t_seq8));
+			ret &= t_compare_x32(t_halfsiphash24_vectors[i],
+			    halfsiphash24_hash(buf + off, i, t_seq8));
+		}
+	}
+	return (ret);
+}
+
+
+/***************************************************************************
+ * Boilerplate
+ */
+
+static int
+t_prepare(int argc, char *argv[])
+{
+
+	(void)argc;
+	(void)argv;
+	t_add_test(t_siphash24, NULL, "SipHash-2-4");
+	t_add_test(t_siphash24_128, NULL, "SipHash-2-4-128");
+	t_add_test(t_siphash13, NULL, "SipHash-1-3");
+	t_add_test(t_siphash13_128, NULL, "SipHash-1-3-128");
+	t_add_test(t_halfsiphash24, NULL, "HalfSipHash-2-4");
+	t_add_test(t_halfsiphash24_64, NULL, "HalfSipHash-2-4-64");
+	t_add_test(t_siphash_unaligned, NULL, "unaligned input");
+	return (0);
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	t_main(t_prepare, NULL, argc, argv);
+}
@@ -0,0 +1,123 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#undef HAVE_TIMINGSAFE_BCMP
+#include <cryb/timingsafe_bcmp.h>
+
+#include <cryb/test.h>
+
+#define T_BUFSIZE	80
+
+struct t_case {
+	const char *desc;
+	size_t len;
+	size_t off1;
+	size_t off2;
+};
+
+/***************************************************************************
+ * Test cases
+ */
+static struct t_case t_cases[] = {
+	{ "empty",			 0,	0,	0 },
+	{ "one byte",			 1,	0,	0 },
+	{ "seven bytes",		 7,	0,	0 },
+	{ "one word",			 8,	0,	0 },
+	{ "one word plus one",		 9,	0,	0 },
+	{ "several words",		64,	0,	0 },
+	{ "several words plus tail",	67,	0,	0 },
+	{ "unaligned",			67,	1,	1 },
+	{ "misaligned",			67,	3,	6 },
+};
+
+/***************************************************************************
+ * Test function
+ */
+
+/*
+ * Compare two identical buffers, then flip each bit of each byte in turn
+ * and verify that the difference is detected.
+ */
+static int
+t_timingsafe_bcmp(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_case *t = arg;
+	uint8_t buf1[T_BUFSIZE], buf2[T_BUFSIZE];
+	uint8_t *p1, *p2;
+	unsigned int bit;
+	size_t i;
+	int ret = 1;
+
+	p1 = buf1 + t->off1;
+	p2 = buf2 + t->off2;
+	for (i = 0; i < t->len; ++i)
+		p1[i] = p2[i] = t_seq8[i % sizeof t_seq8];
+	ret &= t_is_zero_i(timingsafe_bcmp(p1, p2, t->len));
+	for (i = 0; i < t->len && ret; ++i) {
+		for (bit = 0; bit < 8 && ret; ++bit) {
+			p2[i] ^= 1U << bit;
+			ret &= t_compare_i(1, timingsafe_bcmp(p1, p2, t->len));
+			ret &= t_compare_i(1, timingsafe_bcmp(p2, p1, t->len));
+			p2[i] ^= 1U << bit;
+		}
+	}
+	return (ret);
+}
+
+
+/***************************************************************************
+ * Boilerplate
+ */
+
+static int
+t_prepare(int argc, char *argv[])
+{
+	int i, n;
+
+	(void)argc;
+	(void)argv;
+	n = sizeof t_cases / sizeof t_cases[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_timingsafe_bcmp, &t_cases[i], "%s", t_cases[i].desc);
+	return (0);
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	t_main(t_prepare, NULL, argc, argv);
+}
@@ -0,0 +1,816 @@
+/*-
+ * Copyright (c) 2026 The Cryb.to Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cryb/impl.h"
+
+#include <sys/wait.h>
+
+#if HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <cryb/endian.h>
+#include <cryb/hash.h>
+
+#include <cryb/test.h>
+
+/*
+ * Test data: bytes 0 through 255 in sequence, each block of 256 XORed
+ * with its block number.
+ */
+#define T_DATA_LEN	12345
+static uint8_t *t_data;
+
+struct t_case {
+	size_t len;
+	uint64_t seed;
+	uint64_t xxh64;
+	uint64_t xxh3_64;
+	const char *xxh3_128;
+};
+
+/***************************************************************************
+ * Test cases
+ */
+static struct t_case t_cases[] = {
+	{
+		.len		= 0,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0xef46db3751d8e999ULL,
+		.xxh3_64	= 0x2d06800538d394c2ULL,
+		.xxh3_128	= "\x99\xaa\x06\xd3\x01\x47\x98\xd8"
+				  "\x60\x01\xc3\x24\x46\x8d\x49\x7f",
+	},
+	{
+		.len		= 0,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0x51e24c0e9077a48cULL,
+		.xxh3_64	= 0xcc1ca35a1b089c5cULL,
+		.xxh3_128	= "\xa4\xcb\x05\xdb\xbf\x09\x90\x7a"
+				  "\xaa\xa2\x87\xaf\x24\xa9\xbb\x3a",
+	},
+	{
+		.len		= 1,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0xe934a84adb052768ULL,
+		.xxh3_64	= 0xc44bdff4074eecdbULL,
+		.xxh3_128	= "\xa6\xcd\x5e\x93\x92\x00\x0f\x6a"
+				  "\xc4\x4b\xdf\xf4\x07\x4e\xec\xdb",
+	},
+	{
+		.len		= 1,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0xaffd9d6bd53cf137ULL,
+		.xxh3_64	= 0xd5dd68911c7f195dULL,
+		.xxh3_128	= "\xcf\xed\xa1\x48\x08\x38\x2a\xd3"
+				  "\xd5\xdd\x68\x91\x1c\x7f\x19\x5d",
+	},
+	{
+		.len		= 3,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0xe5c7bb4533bc65ddULL,
+		.xxh3_64	= 0x5f4299fc161c9cbbULL,
+		.xxh3_128	= "\xe3\xb5\x5f\x57\x94\x5a\x17\xcf"
+				  "\x5f\x42\x99\xfc\x16\x1c\x9c\xbb",
+	},
+	{
+		.len		= 3,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0x786233c2fa006029ULL,
+		.xxh3_64	= 0x6db0802353336496ULL,
+		.xxh3_128	= "\x59\x10\x9e\x2c\x75\x80\xe6\xe6"
+				  "\x6d\xb0\x80\x23\x53\x33\x64\x96",
+	},
+	{
+		.len		= 4,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0xffced8604453cc1eULL,
+		.xxh3_64	= 0x60dab036a58211f2ULL,
+		.xxh3_128	= "\xeb\x70\xbf\x5f\xc7\x79\xe9\xe6"
+				  "\xa6\x11\x1d\x53\xe8\x0a\x3d\xb5",
+	},
+	{
+		.len		= 4,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0x55b121e934df4f1cULL,
+		.xxh3_64	= 0xbb981e431fa9e4e3ULL,
+		.xxh3_128	= "\x23\x4a\x84\x5e\x73\x1e\xe8\xc3"
+				  "\xc2\x26\xd1\xf5\xa5\x6d\xec\x1a",
+	},
+	{
+		.len		= 8,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0x884a173614b81b8dULL,
+		.xxh3_64	= 0x3a1c2d7c85af88f8ULL,
+		.xxh3_128	= "\xe1\xe4\x43\x2a\x62\x21\x7f\xe4"
+				  "\xcf\xd5\x0c\x61\xc8\xbb\x98\xc1",
+	},
+	{
+		.len		= 8,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0x726ecd68a8b5846dULL,
+		.xxh3_64	= 0xd204fc26419c7d22ULL,
+		.xxh3_128	= "\x31\xb6\x00\xd2\x5b\x84\xb1\xdd"
+				  "\x82\x0d\x57\xbe\x67\xd0\xdd\x52",
+	},
+	{
+		.len		= 9,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0x67d85784a7c78c5bULL,
+		.xxh3_64	= 0xe9612598145bb9dcULL,
+		.xxh3_128	= "\x16\xc7\x69\xd8\x3e\x4a\xeb\xce"
+				  "\x90\x79\x31\x97\x9d\xca\x37\x46",
+	},
+	{
+		.len		= 9,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0x6b369e287a575da2ULL,
+		.xxh3_64	= 0xd813523b210d751bULL,
+		.xxh3_128	= "\x36\x03\xce\x02\x1f\x0b\x88\xf4"
+				  "\x38\xd6\x48\xd4\xce\x49\xfa\x1b",
+	},
+	{
+		.len		= 16,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0x44b6ef2fb84169f7ULL,
+		.xxh3_64	= 0x8355e3a6f61770dbULL,
+		.xxh3_128	= "\x72\x95\x06\x31\x82\x76\x07\xe2"
+				  "\x84\x28\x12\xcc\x87\x0d\xca\xe2",
+	},
+	{
+		.len		= 16,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0x4c86f5e612d7e905ULL,
+		.xxh3_64	= 0x1dca78f4947ed52cULL,
+		.xxh3_128	= "\xb1\x4d\x0b\x33\xae\xdc\x79\xcb"
+				  "\xfd\xb5\x7b\x7f\x91\x52\xaa\x8d",
+	},
+	{
+		.len		= 17,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0x5603e60c527599b6ULL,
+		.xxh3_64	= 0x9ef341a99de37328ULL,
+		.xxh3_128	= "\x68\x5b\xc4\x58\xb3\x7d\x05\x7f"
+				  "\xc0\x6e\x23\x3d\xf7\x72\x92\x17",
+	},
+	{
+		.len		= 17,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0xec61e08f76edad25ULL,
+		.xxh3_64	= 0xebce4845f0c75f02ULL,
+		.xxh3_128	= "\xf7\x5a\x26\x5d\x04\x0e\x8f\xb9"
+				  "\xc4\xe9\x10\x51\x86\x4d\xf3\x90",
+	},
+	{
+		.len		= 32,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0xcbf59c5116ff32b4ULL,
+		.xxh3_64	= 0x3523581fe96e4c05ULL,
+		.xxh3_128	= "\x25\xe7\xc9\xb3\x42\x4c\xee\xd2"
+				  "\x45\x7d\x95\x66\xb6\xfc\xd6\x97",
+	},
+	{
+		.len		= 32,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0xc0477f7fc098e14bULL,
+		.xxh3_64	= 0x16edd62fe60d6804ULL,
+		.xxh3_128	= "\x58\x36\xf5\x75\x60\xad\xe5\xdd"
+				  "\x92\xde\xc1\x40\x6c\xe7\x23\x34",
+	},
+	{
+		.len		= 33,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0x0c535d1acafb8eadULL,
+		.xxh3_64	= 0xe68c56ba88991e58ULL,
+		.xxh3_128	= "\x02\x17\x5c\x3a\xab\xb0\x06\x37"
+				  "\xe0\x8d\x84\x95\x13\x39\xde\x86",
+	},
+	{
+		.len		= 33,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0x9e878be7464b55b0ULL,
+		.xxh3_64	= 0x236e0c14fbbba73dULL,
+		.xxh3_128	= "\xf7\x43\xa7\x0e\xa3\x1e\x45\xaa"
+				  "\x5d\xe0\x91\x44\xaf\xe3\xa3\x02",
+	},
+	{
+		.len		= 64,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0xf7c67301db6713f0ULL,
+		.xxh3_64	= 0x6187eb9089b0ed55ULL,
+		.xxh3_128	= "\x9c\x6e\x14\x0a\x46\x55\x45\xe5"
+				  "\x90\xc1\x97\x1d\xdb\x04\xce\x74",
+	},
+	{
+		.len		= 64,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0xa0a4e3e697d61870ULL,
+		.xxh3_64	= 0x0f4a7f9a546d586dULL,
+		.xxh3_128	= "\x00\xa4\x7a\xd3\x32\x68\x49\x1d"
+				  "\xba\x49\x49\xa0\x15\xa4\x4b\x1a",
+	},
+	{
+		.len		= 65,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0xc31eb63b2ae4465bULL,
+		.xxh3_64	= 0x6928c76ce90422d0ULL,
+		.xxh3_128	= "\xeb\xed\xf0\x5e\xea\xdc\x28\xf1"
+				  "\x1a\xee\x64\xa1\x61\x5d\xe8\x8f",
+	},
+	{
+		.len		= 65,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0xc5790c6bb9e648e9ULL,
+		.xxh3_64	= 0x5cb868bfc48f6d55ULL,
+		.xxh3_128	= "\xae\x4c\x50\x12\xcc\x7f\x1b\xb7"
+				  "\x68\x0c\xff\x01\x7a\xc1\xda\xea",
+	},
+	{
+		.len		= 96,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0x450baa11f6739216ULL,
+		.xxh3_64	= 0x278a3e12ea046dfbULL,
+		.xxh3_128	= "\xc5\x75\x56\xe9\xcc\xb9\x7e\xfa"
+				  "\x6e\x53\xab\x55\xb4\xf5\x55\x8b",
+	},
+	{
+		.len		= 96,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0xef18e09ae09e603cULL,
+		.xxh3_64	= 0x2f58ecbefd5d4abfULL,
+		.xxh3_128	= "\xba\x6c\xc1\x43\x03\xca\xc4\xac"
+				  "\xc2\x12\x08\x0b\xc7\xf2\x34\x67",
+	},
+	{
+		.len		= 97,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0xc93ec3db0dd47e34ULL,
+		.xxh3_64	= 0xe7220282dc4e14f4ULL,
+		.xxh3_128	= "\x9b\x09\x22\x7e\x06\x3d\xa5\xa2"
+				  "\x5b\x32\x84\xa6\x1f\x91\xe9\x7d",
+	},
+	{
+		.len		= 97,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0xea8d04a792c247e6ULL,
+		.xxh3_64	= 0xc012c9900ba5c02dULL,
+		.xxh3_128	= "\x0f\xcf\x95\x54\xe3\x6a\x72\x95"
+				  "\x54\x52\x71\x90\xb8\x9d\x65\x09",
+	},
+	{
+		.len		= 128,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0x7a7fe14647b9ab92ULL,
+		.xxh3_64	= 0x85c6174c7ff4c46bULL,
+		.xxh3_128	= "\x14\x79\x2f\xc3\xaf\x88\xdc\x6c"
+				  "\x05\x32\x1a\x0b\x64\xd6\x7b\x41",
+	},
+	{
+		.len		= 128,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0x0fc2b5cec9adf0beULL,
+		.xxh3_64	= 0xde26ec476dc43954ULL,
+		.xxh3_128	= "\xa7\x35\xb0\xd3\xcc\xe9\x3e\x16"
+				  "\xb8\x48\x93\x2b\xfc\x16\x7a\xdb",
+	},
+	{
+		.len		= 129,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0x0ba25dfd6e891fcfULL,
+		.xxh3_64	= 0xec7642b431ba3e5aULL,
+		.xxh3_128	= "\xdd\x5e\x74\xac\x6b\x45\xf5\x4e"
+				  "\xbc\x30\xb6\x33\x82\xb0\x9a\x3b",
+	},
+	{
+		.len		= 129,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0x35dcfd14835a487aULL,
+		.xxh3_64	= 0x75bc8ed192c9cc73ULL,
+		.xxh3_128	= "\x75\x93\x90\xb2\x4b\xe5\xeb\xc2"
+				  "\x1d\xdd\xad\x78\xad\x26\xc2\x6c",
+	},
+	{
+		.len		= 160,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0x9ba821897a2bb299ULL,
+		.xxh3_64	= 0x5bea9075ec9401b8ULL,
+		.xxh3_128	= "\x4e\x95\xc1\xcd\x6d\xc7\xbb\x85"
+				  "\xc6\x7f\xcd\x13\xc3\x1b\x09\xf4",
+	},
+	{
+		.len		= 160,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0x3065239f95704c63ULL,
+		.xxh3_64	= 0xc7b56731b756d741ULL,
+		.xxh3_128	= "\x6c\xe6\xbe\x9c\x8c\x0a\xc7\xa3"
+				  "\x8e\x2b\xcf\x77\xe3\xb5\xa5\xcf",
+	},
+	{
+		.len		= 240,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0x012947f0da6a27b1ULL,
+		.xxh3_64	= 0x375a384d957fe865ULL,
+		.xxh3_128	= "\x65\xb5\xbe\x86\xda\x55\x40\xe7"
+				  "\xc9\x2b\x68\xe1\x6f\x83\xbb\xb6",
+	},
+	{
+		.len		= 240,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0x0c636373263d2b72ULL,
+		.xxh3_64	= 0x4b1593ee9603224aULL,
+		.xxh3_128	= "\xc7\x74\x99\x34\x43\x6f\xbf\x97"
+				  "\xb8\xff\x7d\x7b\x21\x0b\xf7\xd8",
+	},
+	{
+		.len		= 241,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0x8d643f23bf2808e1ULL,
+		.xxh3_64	= 0x02e8cd95421c6d02ULL,
+		.xxh3_128	= "\x1d\xa1\xcb\x61\xbc\xb8\xa2\xa1"
+				  "\x02\xe8\xcd\x95\x42\x1c\x6d\x02",
+	},
+	{
+		.len		= 241,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0xffa53cd807734af0ULL,
+		.xxh3_64	= 0xace3afe84c9adf7cULL,
+		.xxh3_128	= "\x1e\xc5\xac\x16\x12\xac\xb5\xda"
+				  "\xac\xe3\xaf\xe8\x4c\x9a\xdf\x7c",
+	},
+	{
+		.len		= 255,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0x0f7d97507caad693ULL,
+		.xxh3_64	= 0xb85fd37a0a050e63ULL,
+		.xxh3_128	= "\x59\x14\x86\x8a\xa8\x05\x41\xd9"
+				  "\xb8\x5f\xd3\x7a\x0a\x05\x0e\x63",
+	},
+	{
+		.len		= 255,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0x0411457327fedddeULL,
+		.xxh3_64	= 0xe6776c3a9521e22bULL,
+		.xxh3_128	= "\x4d\xf7\xe1\x84\xd4\xc9\xe9\x67"
+				  "\xe6\x77\x6c\x3a\x95\x21\xe2\x2b",
+	},
+	{
+		.len		= 256,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0x1facbe8406cd904bULL,
+		.xxh3_64	= 0x9408a4433b952d71ULL,
+		.xxh3_128	= "\xf1\xf8\xa9\x3f\x50\x84\x9a\xc3"
+				  "\x94\x08\xa4\x43\x3b\x95\x2d\x71",
+	},
+	{
+		.len		= 256,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0x795aeafacb0b983bULL,
+		.xxh3_64	= 0x475a0bae01c2895cULL,
+		.xxh3_128	= "\xe2\xd5\x06\x00\x6e\x24\xb7\x8e"
+				  "\x47\x5a\x0b\xae\x01\xc2\x89\x5c",
+	},
+	{
+		.len		= 257,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0x2922bafd2bc89d96ULL,
+		.xxh3_64	= 0x5196db521c09d727ULL,
+		.xxh3_128	= "\x31\x35\x97\x16\xc9\x67\xaa\xd5"
+				  "\x51\x96\xdb\x52\x1c\x09\xd7\x27",
+	},
+	{
+		.len		= 257,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0xfa1160ca1bc5673bULL,
+		.xxh3_64	= 0x59fb8b0f9333457aULL,
+		.xxh3_128	= "\x92\xa7\x5d\x5f\x49\x5f\x5b\x52"
+				  "\x59\xfb\x8b\x0f\x93\x33\x45\x7a",
+	},
+	{
+		.len		= 1024,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0x6ebcb4c9d7e1351eULL,
+		.xxh3_64	= 0xfd025ac6da17f84bULL,
+		.xxh3_128	= "\x60\x17\xd2\x96\x90\xe9\x79\x1d"
+				  "\xfd\x02\x5a\xc6\xda\x17\xf8\x4b",
+	},
+	{
+		.len		= 1024,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0xb11fbd0edb0e4bb9ULL,
+		.xxh3_64	= 0x71dfb0861cb2b9cbULL,
+		.xxh3_128	= "\x6b\x94\xd8\x1a\x38\x41\xb1\xe4"
+				  "\x71\xdf\xb0\x86\x1c\xb2\xb9\xcb",
+	},
+	{
+		.len		= 1025,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0xc64ea330954577f1ULL,
+		.xxh3_64	= 0xc3aa0d006ba7b345ULL,
+		.xxh3_128	= "\x0d\xe4\x44\x50\x67\x80\x24\x92"
+				  "\xc3\xaa\x0d\x00\x6b\xa7\xb3\x45",
+	},
+	{
+		.len		= 1025,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0xb8c88f227e61203dULL,
+		.xxh3_64	= 0xc2ad92ce5a6c8c1bULL,
+		.xxh3_128	= "\xcf\xa0\x9d\x1f\x7c\x9d\xbe\x96"
+				  "\xc2\xad\x92\xce\x5a\x6c\x8c\x1b",
+	},
+	{
+		.len		= 2048,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0x62d491c8e6cb131dULL,
+		.xxh3_64	= 0x00c5b9828b91d195ULL,
+		.xxh3_128	= "\xa2\xd3\x16\xfc\x70\x44\xca\x73"
+				  "\x00\xc5\xb9\x82\x8b\x91\xd1\x95",
+	},
+	{
+		.len		= 2048,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0x044e2a1f23ce985aULL,
+		.xxh3_64	= 0x724b56353eeb9eb2ULL,
+		.xxh3_128	= "\xdc\x1b\xc6\x2c\x59\x59\xe9\xed"
+				  "\x72\x4b\x56\x35\x3e\xeb\x9e\xb2",
+	},
+	{
+		.len		= 4097,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0x03b25105dff503d0ULL,
+		.xxh3_64	= 0x10008a5b0bc3d51fULL,
+		.xxh3_128	= "\xa3\x9b\x90\x47\x7f\x1d\x2c\x0c"
+				  "\x10\x00\x8a\x5b\x0b\xc3\xd5\x1f",
+	},
+	{
+		.len		= 4097,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0x83af1f061e53551eULL,
+		.xxh3_64	= 0xe2daa222e081af93ULL,
+		.xxh3_128	= "\xe7\x8a\x49\x46\xf3\x58\x42\x04"
+				  "\xe2\xda\xa2\x22\xe0\x81\xaf\x93",
+	},
+	{
+		.len		= 12345,
+		.seed		= 0x0000000000000000ULL,
+		.xxh64		= 0xb5545bcaf1d12375ULL,
+		.xxh3_64	= 0x7c17a050fe2172cbULL,
+		.xxh3_128	= "\xc7\x84\xb9\x1b\xc9\x21\x6b\xe4"
+				  "\x7c\x17\xa0\x50\xfe\x21\x72\xcb",
+	},
+	{
+		.len		= 12345,
+		.seed		= 0x0123456789abcdefULL,
+		.xxh64		= 0xf4396780693f7a7bULL,
+		.xxh3_64	= 0x16529600d13bf182ULL,
+		.xxh3_128	= "\x35\x95\xdd\x63\x1d\x63\xc7\x53"
+				  "\x16\x52\x96\x00\xd1\x3b\xf1\x82",
+	},
+};
+
+/* the XXH3 default secret, which is part of the specification */
+static const uint8_t t_default_secret[XXH3_SECRET_LEN] = {
+	0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe,
+	0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+	0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb,
+	0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+	0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78,
+	0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+	0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e,
+	0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+	0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb,
+	0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+	0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e,
+	0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+	0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f,
+	0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+	0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31,
+	0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+	0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3,
+	0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+	0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49,
+	0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+	0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc,
+	0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+	0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28,
+	0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+/* chunk sizes for the streaming tests */
+static const size_t t_chunks[] = {
+	1, 7, 64, 100, 255, 256, 257, 1000, 4096,
+};
+
+/***************************************************************************
+ * Test functions
+ */
+static int
+t_xxh64(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_case *t = arg;
+
+	return (t_compare_x64(t->xxh64, xxh64_hash(t_data, t->len, t->seed)));
+}
+
+static int
+t_xxh3_64(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_case *t = arg;
+
+	return (t_compare_x64(t->xxh3_64,
+	    xxh3_64_hash(t_data, t->len, t->seed)));
+}
+
+static int
+t_xxh3_128(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_case *t = arg;
+	uint8_t out[XXH3_128_HASH_LEN];
+
+	xxh3_128_hash(t_data, t->len, t->seed, out);
+	return (t_compare_mem(t->xxh3_128, out, sizeof out));
+}
+
+/*
+ * Feed the input to the streaming interfaces in chunks of various sizes.
+ * Finalize after every chunk to check that finalizing does not disturb
+ * the context.
+ */
+static int
+t_xxhash_stream(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_case *t = arg;
+	uint8_t out[XXH3_128_HASH_LEN];
+	xxh64_ctx ctx64;
+	xxh3_ctx ctx3;
+	size_t i, n, len;
+	int ret = 1;
+
+	for (i = 0; i < sizeof t_chunks / sizeof t_chunks[0]; ++i) {
+		xxh64_init(&ctx64, t->seed);
+		xxh3_init(&ctx3, t->seed);
+		for (len = 0; len < t->len; len += n) {
+			n = t->len - len < t_chunks[i] ?
+			    t->len - len : t_chunks[i];
+			xxh64_update(&ctx64, t_data + len, n);
+			xxh3_update(&ctx3, t_data + len, n);
+			(void)xxh3_64_final(&ctx3);
+		}
+		ret &= t_compare_x64(t->xxh64, xxh64_final(&ctx64));
+		ret &= t_compare_x64(t->xxh3_64, xxh3_64_final(&ctx3));
+		xxh3_128_final(&ctx3, out);
+		ret &= t_compare_mem(t->xxh3_128, out, sizeof out);
+	}
+	return (ret);
+}
+
+/*
+ * Hashing with the default secret is the same as hashing with a zero
+ * seed, and hashing a long input with a seed is the same as hashing it
+ * with a secret derived from the seed.
+ */
+static int
+t_xxh3_secret(char **desc CRYB_UNUSED, void *arg)
+{
+	struct t_case *t = arg;
+	uint8_t secret[XXH3_SECRET_LEN], out[XXH3_128_HASH_LEN];
+	xxh3_ctx ctx;
+	unsigned int i;
+	int ret = 1;
+
+	if (t->seed == 0) {
+		memcpy(secret, t_default_secret, sizeof secret);
+	} else {
+		if (t->len <= 240)
+			return (1);
+		for (i = 0; i < sizeof secret; i += 16) {
+			le64enc(secret + i,
+			    le64dec(t_default_secret + i) + t->seed);
+			le64enc(secret + i + 8,
+			    le64dec(t_default_secret + i + 8) - t->seed);
+		}
+	}
+	ret &= t_compare_x64(t->xxh3_64,
+	    xxh3_64_hash_secret(t_data, t->len, secret, sizeof secret));
+	xxh3_128_hash_secret(t_data, t->len, secret, sizeof secret, out);
+	ret &= t_compare_mem(t->xxh3_128, out, sizeof out);
+	if (!t_compare_i(0, xxh3_init_secret(&ctx, secret, sizeof secret)))
+		return (0);
+	xxh3_update(&ctx, t_data, t->len / 3);
+	xxh3_update(&ctx, t_data + t->len / 3, t->len - t->len / 3);
+	ret &= t_compare_x64(t->xxh3_64, xxh3_64_final(&ctx));
+	return (ret);
+}
+
+/*
+ * With a custom secret of the minimum length, the streaming interface
+ * must agree with the one-shot functions.
+ */
+static int
+t_xxh3_short_secret(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	uint8_t out[XXH3_128_HASH_LEN], eout[XXH3_128_HASH_LEN];
+	const uint8_t *secret;
+	xxh3_ctx ctx;
+	uint64_t h;
+	size_t len, n;
+	int ret = 1;
+
+	secret = t_seq8 + 7;
+	for (len = 0; len <= T_DATA_LEN; len = len * 2 + 1) {
+		h = xxh3_64_hash_secret(t_data, len, secret,
+		    XXH3_SECRET_MIN_LEN);
+		xxh3_128_hash_secret(t_data, len, secret, XXH3_SECRET_MIN_LEN,
+		    eout);
+		if (!t_compare_i(0, xxh3_init_secret(&ctx, secret,
+		    XXH3_SECRET_MIN_LEN)))
+			return (0);
+		for (n = 0; n < len; n += 100)
+			xxh3_update(&ctx, t_data + n, len - n < 100 ?
+			    len - n : 100);
+		ret &= t_compare_x64(h, xxh3_64_final(&ctx));
+		xxh3_128_final(&ctx, out);
+		ret &= t_compare_mem(eout, out, sizeof out);
+	}
+	return (ret);
+}
+
+/*
+ * A secret shorter than the minimum is rejected by the streaming
+ * interface and triggers an assertion in the one-shot functions.
+ */
+static int
+t_xxh3_too_short_secret(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	xxh3_ctx ctx;
+	int ret = 1;
+
+	errno = 0;
+	ret &= t_compare_i(-1, xxh3_init_secret(&ctx, t_seq8,
+	    XXH3_SECRET_MIN_LEN - 1));
+	ret &= t_compare_i(EINVAL, errno);
+	errno = 0;
+	ret &= t_compare_i(-1, xxh3_init_secret(&ctx, NULL, 0));
+	ret &= t_compare_i(EINVAL, errno);
+	return (ret);
+}
+
+static unsigned int t_bits[] = { 64, 128 };
+
+static void
+t_xxh3_too_short_secret_child(unsigned int bits)
+{
+#if defined(HAVE_SETRLIMIT) && defined(RLIMIT_CORE)
+	struct rlimit crl = { 0, 0 };
+#endif
+	uint8_t out[XXH3_128_HASH_LEN];
+
+	signal(SIGABRT, SIG_DFL);
+#if defined(HAVE_SETRLIMIT) && defined(RLIMIT_CORE)
+	if (setrlimit(RLIMIT_CORE, &crl) != 0)
+		t_printv("failed to disable core dump\n");
+#endif
+	/* suppress assertion message */
+	fclose(stderr);
+	if (bits == 128)
+		xxh3_128_hash_secret(t_data, 1000, t_seq8,
+		    XXH3_SECRET_MIN_LEN - 1, out);
+	else
+		(void)xxh3_64_hash_secret(t_data, 1000, t_seq8,
+		    XXH3_SECRET_MIN_LEN - 1);
+}
+
+static int
+t_xxh3_too_short_secret_assert(char **desc CRYB_UNUSED, void *arg)
+{
+	unsigned int *bits = arg;
+	pid_t pid;
+	int status;
+
+	t_assert((pid = fork()) != -1);
+	if (pid == 0) {
+		t_xxh3_too_short_secret_child(*bits);
+		_exit(1);
+	}
+	t_assert(waitpid(pid, &status, 0) == pid);
+	if (!WIFSIGNALED(status) || WTERMSIG(status) != SIGABRT) {
+		t_printv("expected child to raise SIGABRT\n");
+		return (0);
+	}
+	return (1);
+}
+
+/*
+ * Verify that the result does not depend on the alignment of the input.
+ */
+static int
+t_xxhash_unaligned(char **desc CRYB_UNUSED, void *arg CRYB_UNUSED)
+{
+	uint8_t *buf;
+	uint64_t e64, e3;
+	size_t len;
+	unsigned int i;
+	int ret = 1;
+
+	len = 1000;
+	if ((buf = malloc(len + 8)) == NULL)
+		return (0);
+	e64 = xxh64_hash(t_data, len, 0);
+	e3 = xxh3_64_hash(t_data, len, 0);
+	for (i = 1; i < 8; ++i) {
+		memcpy(buf + i, t_data, len);
+		ret &= t_compare_x64(e64, xxh64_hash(buf + i, len, 0));
+		ret &= t_compare_x64(e3, xxh3_64_hash(buf + i, len, 0));
+	}
+	free(buf);
+	return (ret);
+}
+
+
+/***************************************************************************
+ * Boilerplate
+ */
+
+static int
+t_prepare(int argc, char *argv[])
+{
+	unsigned int i, n;
+
+	(void)argc;
+	(void)argv;
+	if ((t_data = malloc(T_DATA_LEN)) == NULL)
+		return (-1);
+	for (i = 0; i < T_DATA_LEN; ++i)
+		t_data[i] = t_seq8[i % sizeof t_seq8] ^ (i >> 8);
+	n = sizeof t_cases / sizeof t_cases[0];
+	for (i = 0; i < n; ++i)
+		t_add_test(t_xxh64, &t_cases[i], "xxh64 %zu/%016jx",
+		    t_cases[i].len, (uintmax_t)t_cases[i].seed);
+	for (i = 0; i < n; ++i)
+		t_add_test(t_xxh3_64, &t_cases[i], "xxh3-64 %zu/%016jx",
+		    t_cases[i].len, (uintmax_t)t_cases[i].seed);
+	for (i = 0; i < n; ++i)
+		t_add_test(t_xxh3_128, &t_cases[i], "xxh3-128 %zu/%016jx",
+		    t_cases[i].len, (uintmax_t)t_cases[i].seed);
+	for (i = 0; i < n; ++i)
+		t_add_test(t_xxhash_stream, &t_cases[i], "streaming %zu/%016jx",
+		    t_cases[i].len, (uintmax_t)t_cases[i].seed);
+	for (i = 0; i < n; ++i)
+		t_add_test(t_xxh3_secret, &t_cases[i], "secret %zu/%016jx",
+		    t_cases[i].len, (uintmax_t)t_cases[i].seed);
+	t_add_test(t_xxh3_short_secret, NULL, "minimum-length secret");
+	t_add_test(t_xxh3_too_short_secret, NULL, "too short secret");
+	t_add_test(t_xxh3_too_short_secret_assert, t_bits + 0,
+	    "too short secret (64-bit one-shot)");
+	t_add_test(t_xxh3_too_short_secret_assert, t_bits + 1,
+	    "too short secret (128-bit one-shot)");
+	t_add_test(t_xxhash_unaligned, NULL, "unaligned input");
+	return (0);
+}
+
+static void
+t_cleanup(void)
+{
+
+	free(t_data);
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	t_main(t_prepare, t_cleanup, argc, argv);
+}